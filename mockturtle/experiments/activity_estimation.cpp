@@ -0,0 +1,99 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/activity_estimation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares the switching activity from the signal probabilities of full
+   node signatures (simulate_nodes) to counting toggles with the activity
+   estimator; memory is the size of the simulation values */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double, double, double> exp( "activity_estimation", "benchmark", "gates", "patterns", "time signatures", "time toggles", "MB signatures", "MB toggles", "speedup", "max diff" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    for ( auto num_patterns : { 2048u, 65536u } )
+    {
+      stopwatch<>::duration t_signatures{};
+      const auto reference = call_with_stopwatch( t_signatures, [&]() {
+        std::vector<float> activity( aig.size() );
+        const partial_simulator sim( aig.num_pis(), num_patterns );
+        const auto tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+        aig.foreach_node( [&]( auto const& n ) {
+          const auto ones = static_cast<float>( kitty::count_ones( tts[n] ) );
+          activity[aig.node_to_index( n )] = 2.0f * ones / num_patterns * ( num_patterns - ones ) / num_patterns;
+        } );
+        return activity;
+      } );
+
+      activity_estimation_params ps;
+      ps.num_patterns = num_patterns;
+      activity_estimation_stats st;
+      const auto activity = estimate_switching_activity( aig, ps, &st );
+
+      double max_diff = 0.0;
+      for ( auto i = 0u; i < aig.size(); ++i )
+      {
+        max_diff = std::max( max_diff, static_cast<double>( std::abs( activity[i] - reference[i] ) ) );
+      }
+
+      const auto mb_signatures = aig.size() * ( num_patterns / 8.0 ) / ( 1 << 20 );
+      const auto mb_toggles = st.num_registers * ( ps.words_per_block * 8.0 ) / ( 1 << 20 ) + aig.size() * 8.0 / ( 1 << 20 );
+      exp( benchmark, aig.num_gates(), num_patterns, to_seconds( t_signatures ), to_seconds( st.time_total ), mb_signatures, mb_toggles, to_seconds( t_signatures ) / std::max( to_seconds( st.time_total ), 1e-6 ), max_diff );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
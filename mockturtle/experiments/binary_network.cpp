@@ -0,0 +1,98 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/binary_network.hpp>
+#include <mockturtle/io/serialize.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares loading a network with `deserialize_network` to the binary
+   format, which is copied in bulk into an `aig_network` or mapped in place
+   into an AIG with copy-on-write storage */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool> exp( "binary_network", "benchmark", "gates", "time deserialize", "time read", "time map", "time map trusted", "time map + strash", "speedup", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    const auto dump_file = fmt::format( "{}.dmp", benchmark );
+    const auto binary_file = fmt::format( "{}.bin", benchmark );
+    serialize_network( aig, dump_file );
+    write_binary_network( aig, binary_file );
+
+    stopwatch<>::duration t_deserialize{}, t_read{}, t_map{}, t_trusted{}, t_strash{};
+
+    const auto aig_deserialized = call_with_stopwatch( t_deserialize, [&]() { return deserialize_network( dump_file ); } );
+    const auto aig_read = call_with_stopwatch( t_read, [&]() { return *read_binary_network<aig_network>( binary_file ); } );
+    auto aig_mapped = call_with_stopwatch( t_map, [&]() { return *read_binary_network<aig_cow_network>( binary_file ); } );
+    const auto aig_trusted = call_with_stopwatch( t_trusted, [&]() { return *read_binary_network<aig_cow_network>( binary_file, false ); } );
+
+    /* first access to the structural hash table */
+    const auto num_strash = call_with_stopwatch( t_strash, [&]() { return aig_mapped._storage->hash.size(); } );
+    t_strash += t_map;
+
+    std::remove( dump_file.c_str() );
+    std::remove( binary_file.c_str() );
+
+    bool equivalent = aig_deserialized._storage->nodes == aig_read._storage->nodes &&
+                      aig_read._storage->hash.size() == num_strash &&
+                      aig_mapped.size() == aig.size() && aig_mapped.num_pos() == aig.num_pos() && aig_trusted.size() == aig.size();
+    aig.foreach_gate( [&]( auto const& n ) {
+      equivalent &= aig_mapped.fanout_size( n ) == aig.fanout_size( n );
+      aig.foreach_fanin( n, [&]( auto const&, auto i ) {
+        equivalent &= aig_mapped._storage->nodes[n].children[i] == aig._storage->nodes[n].children[i];
+      } );
+    } );
+
+    exp( benchmark, aig.num_gates(), to_seconds( t_deserialize ), to_seconds( t_read ), to_seconds( t_map ), to_seconds( t_trusted ), to_seconds( t_strash ),
+         to_seconds( t_deserialize ) / std::max( to_seconds( t_read ), 1e-6 ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
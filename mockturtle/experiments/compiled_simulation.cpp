@@ -0,0 +1,118 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* compares repeated simulation of fresh pattern batches with
+   `simulate_nodes<kitty::partial_truth_table>` to running a compiled
+   simulation program, for the AIG and its 6-LUT mapping */
+
+template<class Ntk>
+void run( experiments::experiment<std::string, std::string, uint32_t, uint32_t, uint32_t, uint32_t, double, double, double, double, double, bool>& exp, std::string const& benchmark, std::string const& name, Ntk const& ntk )
+{
+  using namespace mockturtle;
+
+  constexpr uint32_t num_batches = 10u;
+
+  for ( auto num_patterns : { 256u, 4096u } )
+  {
+    std::vector<std::vector<kitty::partial_truth_table>> batches( num_batches, std::vector<kitty::partial_truth_table>( ntk.num_pis(), kitty::partial_truth_table( num_patterns ) ) );
+    for ( auto b = 0u; b < num_batches; ++b )
+    {
+      for ( auto i = 0u; i < ntk.num_pis(); ++i )
+      {
+        kitty::create_random( batches[b][i], b * ntk.num_pis() + i );
+      }
+    }
+
+    stopwatch<>::duration t_nodes{}, t_pos{}, t_compiled{};
+    compiled_simulation_stats st;
+    auto program = compile_simulation( ntk, &st );
+
+    bool equivalent = true;
+    std::vector<kitty::partial_truth_table> outputs;
+    for ( auto const& inputs : batches )
+    {
+      const partial_simulator sim( inputs );
+      const auto tts = call_with_stopwatch( t_nodes, [&]() { return simulate_nodes<kitty::partial_truth_table>( ntk, sim ); } );
+      const auto pos = call_with_stopwatch( t_pos, [&]() { return simulate<kitty::partial_truth_table>( ntk, sim ); } );
+      call_with_stopwatch( t_compiled, [&]() { program.run( inputs, outputs ); } );
+      equivalent &= outputs == pos;
+      ntk.foreach_po( [&]( auto const& f, auto i ) {
+        equivalent &= ( ntk.is_complemented( f ) ? ~tts[f] : tts[f] ) == pos[i];
+      } );
+    }
+
+    exp( benchmark, name, ntk.num_gates(), num_patterns, st.num_instructions, st.num_registers, to_seconds( st.time_total ), to_seconds( t_nodes ), to_seconds( t_pos ), to_seconds( t_compiled ), to_seconds( t_nodes ) / std::max( to_seconds( t_compiled ), 1e-6 ), equivalent );
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, std::string, uint32_t, uint32_t, uint32_t, uint32_t, double, double, double, double, double, bool> exp( "compiled_simulation", "benchmark", "network", "gates", "patterns", "instructions", "registers", "time compile", "time nodes", "time POs", "time compiled", "speedup", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    run( exp, benchmark, "aig", aig );
+
+    mapping_view<aig_network, true> mapped{ aig };
+    lut_mapping<mapping_view<aig_network, true>, true>( mapped );
+    const auto klut = *collapse_mapped_network<klut_network>( mapped );
+    run( exp, benchmark, "klut", klut );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* builds a large AIG (many overlapping multipliers) with an increasing number
+   of threads that create gates concurrently in the same network */
+
+template<class Ntk>
+void build_multipliers( Ntk& ntk, std::vector<typename Ntk::signal> const& pis, uint32_t num_jobs, uint32_t num_threads )
+{
+  constexpr uint32_t width = 24u;
+
+  std::atomic<uint32_t> next_job{ 0u };
+  const auto worker = [&]() {
+    for ( auto job = next_job++; job < num_jobs; job = next_job++ )
+    {
+      /* operands are overlapping windows of the PIs, hence multipliers share logic */
+      std::vector<typename Ntk::signal> a( pis.begin() + job, pis.begin() + job + width );
+      std::vector<typename Ntk::signal> b( pis.begin() + 2 * job + 1, pis.begin() + 2 * job + 1 + width );
+      carry_ripple_multiplier( ntk, a, b );
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for ( auto t = 1u; t < num_threads; ++t )
+  {
+    threads.emplace_back( worker );
+  }
+  worker();
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using aig_concurrent_network = basic_aig_network<aig_concurrent_storage>;
+
+  constexpr uint32_t num_jobs = 256u;
+  constexpr uint32_t num_pis = 2u * num_jobs + 32u;
+
+  experiment<uint32_t, uint32_t, double, double, bool> exp( "concurrent_strash", "threads", "gates", "runtime", "speedup", "equivalent" );
+
+  /* sequential reference with the default storage */
+  aig_network ref;
+  std::vector<aig_network::signal> ref_pis( num_pis );
+  std::generate( ref_pis.begin(), ref_pis.end(), [&]() { return ref.create_pi(); } );
+  stopwatch<>::duration t_ref{};
+  call_with_stopwatch( t_ref, [&]() { build_multipliers( ref, ref_pis, num_jobs, 1u ); } );
+  fmt::print( "[i] sequential aig_network: {} gates in {:.2f}s\n", ref.num_gates(), to_seconds( t_ref ) );
+
+  for ( auto num_threads : { 1u, 2u, 4u, 8u, 16u, 32u } )
+  {
+    aig_concurrent_network aig;
+    std::vector<aig_concurrent_network::signal> pis( num_pis );
+    std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+    stopwatch<>::duration t{};
+    call_with_stopwatch( t, [&]() { build_multipliers( aig, pis, num_jobs, num_threads ); } );
+
+    /* structural hashing is canonical, hence the gate count does not depend on the number of threads */
+    exp( num_threads, aig.num_gates(), to_seconds( t ), to_seconds( t_ref ) / to_seconds( t ), aig.num_gates() == ref.num_gates() );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
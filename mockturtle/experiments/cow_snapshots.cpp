@@ -0,0 +1,118 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares speculative changes on a deep copy (clone) with changes on a
+   copy-on-write snapshot (fork) that are rolled back */
+
+template<class Ntk>
+void try_change( Ntk& ntk, uint32_t trial )
+{
+  /* add some logic between existing nodes */
+  const auto size = ntk.size();
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    const auto a = ntk.make_signal( 1u + ( trial * 7919u + i * 104729u ) % ( size - 1u ) );
+    const auto b = ntk.make_signal( 1u + ( trial * 15485863u + i * 32452843u ) % ( size - 1u ) );
+    ntk.create_po( ntk.create_and( a, !b ) );
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, bool> exp( "cow_snapshots", "benchmark", "gates", "time clone", "time fork", "speedup", "time sim", "time sim cow", "equivalent" );
+
+  constexpr auto num_trials = 16u;
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    aig_cow_network cow;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success ||
+         lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( cow ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    stopwatch<>::duration t_clone{}, t_fork{}, t_sim{}, t_sim_cow{};
+
+    uint64_t gates_clone{ 0 }, gates_fork{ 0 };
+    call_with_stopwatch( t_clone, [&]() {
+      for ( auto i = 0u; i < num_trials; ++i )
+      {
+        auto copy = aig.clone();
+        try_change( copy, i );
+        gates_clone += copy.num_gates();
+      }
+    } );
+
+    call_with_stopwatch( t_fork, [&]() {
+      for ( auto i = 0u; i < num_trials; ++i )
+      {
+        cow.fork();
+        try_change( cow, i );
+        gates_fork += cow.num_gates();
+        cow.rollback();
+      }
+    } );
+
+    /* same results and the original network is restored */
+    bool equivalent = gates_clone == gates_fork && cow.size() == aig.size() && cow.num_gates() == aig.num_gates();
+    aig.foreach_node( [&]( auto const& n ) {
+      equivalent &= cow.fanout_size( n ) == aig.fanout_size( n );
+    } );
+
+    /* traversal overhead of the paged storage */
+    const partial_simulator sim_ps( aig.num_pis(), 256u );
+    const auto sim = call_with_stopwatch( t_sim, [&]() { return simulate<kitty::partial_truth_table>( aig, sim_ps ); } );
+    const auto sim_cow = call_with_stopwatch( t_sim_cow, [&]() { return simulate<kitty::partial_truth_table>( cow, sim_ps ); } );
+    equivalent &= sim == sim_cow;
+
+    exp( benchmark, aig.num_gates(), to_seconds( t_clone ), to_seconds( t_fork ), to_seconds( t_clone ) / std::max( to_seconds( t_fork ), 1e-6 ), to_seconds( t_sim ), to_seconds( t_sim_cow ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
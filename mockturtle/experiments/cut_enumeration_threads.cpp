@@ -0,0 +1,84 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* enumerates 6-input cuts with truth tables on 1, 2, 4, and 8 threads; the
+   cut sets must not depend on the number of threads */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  constexpr std::array<uint32_t, 4> thread_counts{ 1u, 2u, 4u, 8u };
+
+  experiment<std::string, uint32_t, uint64_t, double, double, double, double, double, double, double, bool> exp( "cut_enumeration_threads", "benchmark", "gates", "cuts", "time 1", "time 2", "time 4", "time 8", "speedup 2", "speedup 4", "speedup 8", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    cut_enumeration_params ps;
+    ps.cut_size = 6u;
+    ps.cut_limit = 8u;
+
+    std::array<double, thread_counts.size()> times;
+    std::array<uint64_t, thread_counts.size()> num_cuts;
+    bool equivalent = true;
+    for ( auto i = 0u; i < thread_counts.size(); ++i )
+    {
+      ps.num_threads = thread_counts[i];
+      cut_enumeration_stats st;
+      const auto cuts = fast_cut_enumeration<aig_network, 6u, true>( aig, ps, &st );
+      times[i] = to_seconds( st.time_total );
+      num_cuts[i] = cuts.total_cuts();
+      equivalent &= num_cuts[i] == num_cuts[0];
+    }
+
+    const auto speedup = [&]( uint32_t i ) { return times[0] / std::max( times[i], 1e-6 ); };
+    exp( benchmark, aig.num_gates(), num_cuts[0], times[0], times[1], times[2], times[3], speedup( 1u ), speedup( 2u ), speedup( 3u ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
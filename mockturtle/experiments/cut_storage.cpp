@@ -0,0 +1,90 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/tech_map_cut.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* memory of the compact cut sets with the cut enumeration parameters of the
+   mapper, compared to cut sets that hold storage for the maximum number of
+   cuts with `max_cut_size` leaves each, and to cut sets that hold only their
+   cuts with `NumVars` leaves each */
+
+template<class NetworkCuts, class CutSet>
+uint64_t cut_set_memory( NetworkCuts const& cuts )
+{
+  using cut_t = typename CutSet::cut_t;
+
+  uint64_t bytes = cuts.nodes_size() * sizeof( CutSet );
+  for ( auto i = 0u; i < cuts.nodes_size(); ++i )
+  {
+    bytes += cuts.cuts( i ).size() * ( sizeof( cut_t ) + sizeof( cut_t* ) );
+  }
+  return bytes;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint64_t, double, double, double, double, double, double, double> exp( "cut_storage", "benchmark", "gates", "cuts", "cuts/node", "MB full", "MB cut sets", "MB compact", "ratio", "ratio cut sets", "time" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    map_params mps;
+    cut_enumeration_stats st;
+    const auto cuts = fast_cut_enumeration<aig_network, 6u, true, cut_enumeration_tech_map_cut>( aig, mps.cut_enumeration_ps, &st );
+
+    using network_cuts_t = std::decay_t<decltype( cuts )>;
+    using full_cut_t = cut_type<true, cut_enumeration_tech_map_cut>;
+    using cut_set_t = cut_set<cut_type<true, cut_enumeration_tech_map_cut, 6u>, network_cuts_t::max_cut_num>;
+    const auto full = static_cast<double>( cuts.nodes_size() ) * network_cuts_t::max_cut_num * ( sizeof( full_cut_t ) + sizeof( full_cut_t* ) );
+    const auto sets = static_cast<double>( cut_set_memory<network_cuts_t, cut_set_t>( cuts ) );
+    const auto compact = static_cast<double>( cuts.num_bytes() );
+
+    exp( benchmark, aig.num_gates(), cuts.total_cuts(), static_cast<double>( cuts.total_cuts() ) / aig.num_gates(), full / ( 1u << 20 ), sets / ( 1u << 20 ), compact / ( 1u << 20 ), full / compact, sets / compact, to_seconds( st.time_total ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* time to compute the truth tables of 6-input cuts on single words,
+   compared to the static truth tables of the fast cut enumeration */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint64_t, double, double, double, double> exp( "cut_truth_tables", "benchmark", "gates", "cuts", "tt words", "tt static", "speedup", "total" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    cut_enumeration_params ps;
+    ps.cut_size = 6u;
+    ps.cut_limit = 12u;
+    ps.minimize_truth_table = true;
+
+    cut_enumeration_stats st_words, st_static;
+    const auto cuts = cut_enumeration<aig_network, true>( aig, ps, &st_words );
+    fast_cut_enumeration<aig_network, 6u, true>( aig, ps, &st_static );
+
+    exp( benchmark, aig.num_gates(), cuts.total_cuts(), to_seconds( st_words.time_truth_table ), to_seconds( st_static.time_truth_table ),
+         to_seconds( st_static.time_truth_table ) / to_seconds( st_words.time_truth_table ), to_seconds( st_words.time_total ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,289 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/events.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <experiments.hpp>
+
+/* measures the throughput of create_and and of the dispatch of add events
+   with listeners that are registered at run-time (dynamic) and listeners that
+   are bound at compile-time (static), times are in seconds; the second
+   experiment compares a fanout view that registers run-time events with a
+   fanout view on a network with a static fanout listener */
+
+namespace
+{
+
+/* listeners that mirror some network state */
+struct gate_counter
+{
+  template<class Ntk>
+  void on_add( Ntk const&, mockturtle::node<Ntk> const& )
+  {
+    ++num_gates;
+  }
+
+  uint64_t num_gates{ 0 };
+};
+
+struct level_tracker
+{
+  template<class Ntk>
+  void on_add( Ntk const& ntk, mockturtle::node<Ntk> const& n )
+  {
+    if ( levels.size() < ntk.size() )
+    {
+      levels.resize( ntk.size() );
+    }
+    uint32_t level{ 0 };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.get_node( f )] + 1u );
+    } );
+    levels[n] = level;
+  }
+
+  std::vector<uint32_t> levels;
+};
+
+struct fanin_sum
+{
+  template<class Ntk>
+  void on_add( Ntk const& ntk, mockturtle::node<Ntk> const& n )
+  {
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      sum += ntk.get_node( f );
+    } );
+  }
+
+  uint64_t sum{ 0 };
+};
+
+constexpr uint32_t num_pis = 1024u;
+constexpr uint32_t num_ands = 1u << 20;
+constexpr uint32_t num_runs = 5u;
+constexpr uint32_t num_notify_rounds = 10u;
+
+template<class Ntk>
+void build( Ntk& ntk )
+{
+  std::vector<typename Ntk::signal> signals;
+  signals.reserve( num_pis + num_ands );
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    signals.push_back( ntk.create_pi() );
+  }
+
+  uint64_t state = UINT64_C( 0x853c49e6748fea9b );
+  const auto next = [&]() {
+    state = state * UINT64_C( 6364136223846793005 ) + UINT64_C( 1442695040888963407 );
+    return static_cast<uint32_t>( state >> 33 );
+  };
+
+  for ( auto i = 0u; i < num_ands; ++i )
+  {
+    /* prefer recent signals to obtain deep networks */
+    const auto size = static_cast<uint32_t>( signals.size() );
+    const auto a = signals[size - 1u - next() % std::min( size, 4096u )];
+    const auto b = signals[next() % size];
+    signals.push_back( ntk.create_and( a ^ ( next() & 1u ), b ^ ( next() & 1u ) ) );
+  }
+}
+
+struct timings
+{
+  double create{ std::numeric_limits<double>::max() };
+  double notify{ std::numeric_limits<double>::max() };
+};
+
+/* best of several runs on fresh networks, `setup` registers listeners;
+   besides building the network, the dispatch of add events is measured
+   in isolation by notifying the listeners about all gates again */
+template<class Ntk, class Setup>
+timings measure( Ntk& result, Setup&& setup )
+{
+  timings best;
+  for ( auto i = 0u; i < num_runs; ++i )
+  {
+    Ntk ntk;
+    auto teardown = setup( ntk );
+    mockturtle::stopwatch<>::duration time_create{}, time_notify{};
+    mockturtle::call_with_stopwatch( time_create, [&]() { build( ntk ); } );
+    mockturtle::call_with_stopwatch( time_notify, [&]() {
+      for ( auto j = 0u; j < num_notify_rounds; ++j )
+      {
+        ntk.foreach_gate( [&]( auto const& n ) {
+          ntk.events().notify_add( ntk, n );
+        } );
+      }
+    } );
+    teardown();
+    best.create = std::min( best.create, mockturtle::to_seconds( time_create ) );
+    best.notify = std::min( best.notify, mockturtle::to_seconds( time_notify ) );
+    result = ntk;
+  }
+  return best;
+}
+
+struct fanout_timings
+{
+  double create{ std::numeric_limits<double>::max() };
+  double substitute{ std::numeric_limits<double>::max() };
+  uint32_t num_gates{ 0 };
+};
+
+/* best of several runs, builds the network in a fanout view and then
+   substitutes every 16th gate by a new gate, which modifies and deletes
+   nodes; `fanouts` receives the final fanouts of all nodes */
+template<class Ntk>
+fanout_timings measure_fanouts( std::vector<std::vector<mockturtle::node<Ntk>>>& fanouts )
+{
+  fanout_timings best;
+  for ( auto i = 0u; i < num_runs; ++i )
+  {
+    Ntk ntk;
+    mockturtle::fanout_view fntk( ntk );
+    mockturtle::stopwatch<>::duration time_create{}, time_substitute{};
+    mockturtle::call_with_stopwatch( time_create, [&]() { build( fntk ); } );
+    mockturtle::call_with_stopwatch( time_substitute, [&]() {
+      const auto size = fntk.size();
+      for ( auto n = num_pis + 1u; n < size; n += 16u )
+      {
+        if ( fntk.is_dead( n ) )
+        {
+          continue;
+        }
+        std::vector<typename Ntk::signal> children;
+        fntk.foreach_fanin( n, [&]( auto const& f ) { children.push_back( f ); } );
+        fntk.substitute_node( n, fntk.create_and( children[0], !children[1] ) );
+      }
+    } );
+    best.create = std::min( best.create, mockturtle::to_seconds( time_create ) );
+    best.substitute = std::min( best.substitute, mockturtle::to_seconds( time_substitute ) );
+
+    best.num_gates = fntk.num_gates();
+    fanouts.assign( fntk.size(), {} );
+    fntk.foreach_node( [&]( auto const& n ) {
+      fanouts[n] = fntk.fanout( n );
+    } );
+  }
+  return best;
+}
+
+} // namespace
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<uint32_t, uint32_t, double, double, double, double, double, bool> exp( "event_listeners", "listeners", "gates", "create dynamic", "create static",
+                                                                                  "notify dynamic", "notify static", "notify speedup", "equivalent" );
+
+  const auto no_setup = []( auto& ) { return []() {}; };
+
+  /* no listeners */
+  {
+    aig_network dynamic_aig;
+    const auto t_dynamic = measure( dynamic_aig, no_setup );
+    basic_aig_network<aig_storage, no_listener> static_aig;
+    const auto t_static = measure( static_aig, no_setup );
+
+    exp( 0u, dynamic_aig.num_gates(), t_dynamic.create, t_static.create, t_dynamic.notify, t_static.notify, t_dynamic.notify / t_static.notify, dynamic_aig.size() == static_aig.size() );
+  }
+
+  /* one listener */
+  {
+    aig_network dynamic_aig;
+    gate_counter counter;
+    const auto t_dynamic = measure( dynamic_aig, [&]( auto& ntk ) {
+      counter = {};
+      auto add_event = ntk.events().register_add_event( [&]( auto const& n ) { counter.on_add( ntk, n ); } );
+      return [&ntk, add_event]() mutable { ntk.events().release_add_event( add_event ); };
+    } );
+
+    basic_aig_network<aig_storage, gate_counter> static_aig;
+    const auto t_static = measure( static_aig, no_setup );
+
+    exp( 1u, dynamic_aig.num_gates(), t_dynamic.create, t_static.create, t_dynamic.notify, t_static.notify, t_dynamic.notify / t_static.notify, counter.num_gates == static_aig.events().listener.num_gates );
+  }
+
+  /* three listeners */
+  {
+    aig_network dynamic_aig;
+    gate_counter counter;
+    level_tracker levels;
+    fanin_sum sum;
+    const auto t_dynamic = measure( dynamic_aig, [&]( auto& ntk ) {
+      counter = {};
+      levels = {};
+      sum = {};
+      auto add_event1 = ntk.events().register_add_event( [&]( auto const& n ) { counter.on_add( ntk, n ); } );
+      auto add_event2 = ntk.events().register_add_event( [&]( auto const& n ) { levels.on_add( ntk, n ); } );
+      auto add_event3 = ntk.events().register_add_event( [&]( auto const& n ) { sum.on_add( ntk, n ); } );
+      return [&ntk, add_event1, add_event2, add_event3]() mutable {
+        ntk.events().release_add_event( add_event1 );
+        ntk.events().release_add_event( add_event2 );
+        ntk.events().release_add_event( add_event3 );
+      };
+    } );
+
+    basic_aig_network<aig_storage, listeners<gate_counter, level_tracker, fanin_sum>> static_aig;
+    const auto t_static = measure( static_aig, no_setup );
+    auto const& l = static_aig.events().listener;
+
+    const auto equivalent = counter.num_gates == static_cast<gate_counter const&>( l ).num_gates &&
+                            levels.levels == static_cast<level_tracker const&>( l ).levels &&
+                            sum.sum == static_cast<fanin_sum const&>( l ).sum;
+    exp( 3u, dynamic_aig.num_gates(), t_dynamic.create, t_static.create, t_dynamic.notify, t_static.notify, t_dynamic.notify / t_static.notify, equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  experiment<uint32_t, double, double, double, double, double, bool> exp_fanouts( "fanout_listener", "gates", "create dynamic", "create static",
+                                                                                 "substitute dynamic", "substitute static", "speedup", "equivalent" );
+
+  {
+    std::vector<std::vector<node<aig_network>>> dynamic_fanouts, static_fanouts;
+    const auto t_dynamic = measure_fanouts<aig_network>( dynamic_fanouts );
+    const auto t_static = measure_fanouts<basic_aig_network<aig_storage, fanout_listener<>>>( static_fanouts );
+
+    exp_fanouts( t_static.num_gates, t_dynamic.create, t_static.create, t_dynamic.substitute, t_static.substitute,
+                 ( t_dynamic.create + t_dynamic.substitute ) / ( t_static.create + t_static.substitute ), t_dynamic.num_gates == t_static.num_gates && dynamic_fanouts == static_fanouts );
+  }
+
+  exp_fanouts.save();
+  exp_fanouts.table();
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/resubstitution.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <experiments.hpp>
+
+/* measures the construction of fanout views and resubstitution, which
+   updates the fanouts of a fanout view incrementally */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, uint32_t, double> exp( "fanout_index", "benchmark", "size_before", "fanout time", "size_after", "resub time" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    /* best of several constructions */
+    double fanout_time = std::numeric_limits<double>::max();
+    for ( auto i = 0u; i < 5u; ++i )
+    {
+      stopwatch<>::duration time{};
+      uint64_t num_fanouts{ 0 };
+      call_with_stopwatch( time, [&]() {
+        fanout_view faig{ aig };
+        faig.foreach_node( [&]( auto const& n ) {
+          faig.foreach_fanout( n, [&]( auto const& ) { ++num_fanouts; } );
+        } );
+      } );
+      fanout_time = std::min( fanout_time, to_seconds( time ) );
+    }
+
+    resubstitution_params ps;
+    resubstitution_stats st;
+    ps.max_pis = 8u;
+    ps.max_inserts = 1u;
+
+    const uint32_t size_before = aig.num_gates();
+    aig_resubstitution( aig, ps, &st );
+    aig = cleanup_dangling( aig );
+
+    exp( benchmark, size_before, fanout_time, aig.num_gates(), to_seconds( st.time_total ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/incremental_cuts.hpp>
+#include <mockturtle/algorithms/resubstitution.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* time to update the cuts after one round of resubstitution, compared to a
+   new cut enumeration of the resulting network; with a maximum depth, only
+   the cuts close to the rewritten nodes are recomputed */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint64_t, double, uint64_t, double, double> exp( "incremental_cuts", "benchmark", "gates", "gates after", "computed", "update", "computed depth 3", "update depth 3", "enumeration" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    incremental_cuts_params ps;
+    ps.cut_enumeration_ps.cut_size = 6u;
+    ps.cut_enumeration_ps.cut_limit = 12u;
+    ps.cut_enumeration_ps.minimize_truth_table = true;
+
+    const auto gates = aig.num_gates();
+    incremental_network_cuts<aig_network, true> cuts( aig, ps );
+
+    incremental_cuts_params ps_depth = ps;
+    ps_depth.max_depth = 3u;
+    incremental_network_cuts<aig_network, true> cuts_depth( aig, ps_depth );
+
+    resubstitution_params rps;
+    rps.max_pis = 8u;
+    rps.max_inserts = 1u;
+    aig_resubstitution( aig, rps );
+
+    stopwatch<>::duration time_update{ 0 }, time_update_depth{ 0 };
+    call_with_stopwatch( time_update, [&]() { cuts.update(); } );
+    call_with_stopwatch( time_update_depth, [&]() { cuts_depth.update(); } );
+
+    const auto cleaned = cleanup_dangling( aig );
+    cut_enumeration_stats st;
+    cut_enumeration<aig_network, true>( cleaned, ps.cut_enumeration_ps, &st );
+
+    exp( benchmark, gates, cleaned.num_gates(), cuts.stats().num_computed, to_seconds( time_update ),
+         cuts_depth.stats().num_computed, to_seconds( time_update_depth ), to_seconds( st.time_total ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
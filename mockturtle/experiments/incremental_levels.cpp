@@ -0,0 +1,86 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include <experiments.hpp>
+
+/* compares MIG depth rewriting with levels that are recomputed after each
+   rewrite to levels that are maintained incrementally */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, double, double, double, bool> exp( "incremental_levels", "benchmark", "depth before", "depth after", "size after", "time full", "time incremental", "speedup", "same result" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    /* recomputing all levels after each rewrite takes hours on hyp */
+    if ( benchmark == "hyp" )
+    {
+      continue;
+    }
+
+    fmt::print( "[i] processing {}\n", benchmark );
+    mig_network mig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( mig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    mig_algebraic_depth_rewriting_params ps;
+    ps.strategy = mig_algebraic_depth_rewriting_params::dfs;
+
+    auto mig_full = mig.clone();
+    depth_view depth_full{ mig_full };
+    const auto depth_before = depth_full.depth();
+    stopwatch<>::duration time_full{};
+    call_with_stopwatch( time_full, [&]() { mig_algebraic_depth_rewriting( depth_full, ps ); } );
+
+    depth_view_params dps;
+    dps.incremental = true;
+    stopwatch<>::duration time_incremental{};
+    depth_view depth_incremental{ mig, unit_cost<mig_network>(), dps };
+    call_with_stopwatch( time_incremental, [&]() { mig_algebraic_depth_rewriting( depth_incremental, ps ); } );
+
+    const auto same = depth_full.depth() == depth_incremental.depth() && depth_full.num_gates() == depth_incremental.num_gates();
+    exp( benchmark, depth_before, depth_incremental.depth(), depth_incremental.num_gates(), to_seconds( time_full ), to_seconds( time_incremental ),
+         to_seconds( time_full ) / to_seconds( time_incremental ), same );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* measures the construction and copy time of mapped k-LUT networks */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double> exp( "klut_storage", "benchmark", "luts", "time mapping", "time collapse", "time copy" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    stopwatch<>::duration t_map{}, t_collapse{}, t_copy{};
+
+    mapping_view<aig_network, true> mapped_aig{ aig };
+    lut_mapping_params ps;
+    ps.cut_enumeration_ps.cut_size = 6u;
+    call_with_stopwatch( t_map, [&]() {
+      lut_mapping<decltype( mapped_aig ), true>( mapped_aig, ps );
+    } );
+
+    const auto klut = call_with_stopwatch( t_collapse, [&]() {
+      return *collapse_mapped_network<klut_network>( mapped_aig );
+    } );
+
+    /* deep copies of the storage */
+    uint64_t checksum{ 0 };
+    call_with_stopwatch( t_copy, [&]() {
+      for ( auto i = 0u; i < 10u; ++i )
+      {
+        const auto copy = std::make_shared<klut_storage>( *klut._storage );
+        checksum += copy->nodes.size();
+      }
+    } );
+    (void)checksum;
+
+    exp( benchmark, klut.num_gates(), to_seconds( t_map ), to_seconds( t_collapse ), to_seconds( t_copy ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
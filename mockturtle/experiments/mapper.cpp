@@ -23,6 +23,8 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <array>
 #include <string>
 #include <vector>
 
@@ -75,6 +77,12 @@ int main()
   experiment<std::string, uint32_t, uint32_t, double, uint32_t, uint32_t, double, float, float, bool, bool> exp(
       "mapper", "benchmark", "size", "size_mig", "area_after", "depth", "depth_mig", "delay_after", "runtime1", "runtime2", "equivalent1", "equivalent2" );
 
+  /* technology mapping on 2, 4, and 8 threads; the results must not depend on the number of threads */
+  constexpr std::array<uint32_t, 3> thread_counts{ 2u, 4u, 8u };
+
+  experiment<std::string, double, double, double, double, double, double, double, double, double, bool> exp_threads(
+      "mapper_threads", "benchmark", "area 1", "area 8", "delay 1", "delay 8", "time 1", "time 2", "time 4", "time 8", "speedup 8", "deterministic" );
+
   fmt::print( "[i] processing technology library\n" );
 
   /* library to map to MIGs */
@@ -132,10 +140,25 @@ int main()
     const uint32_t depth_mig = depth_view( res1 ).depth();
 
     exp( benchmark, size_before, res1.num_gates(), st2.area, depth_before, depth_mig, st2.delay, to_seconds( st1.time_total ), to_seconds( st2.time_total ), cec1, cec2 );
+
+    std::array<map_stats, thread_counts.size()> st_threads;
+    bool deterministic = true;
+    for ( auto i = 0u; i < thread_counts.size(); ++i )
+    {
+      ps2.num_threads = thread_counts[i];
+      map( aig, tech_lib, ps2, &st_threads[i] );
+      deterministic &= st_threads[i].area == st_threads[0].area && st_threads[i].delay == st_threads[0].delay;
+    }
+
+    const auto time_8 = to_seconds( st_threads.back().time_total );
+    exp_threads( benchmark, st2.area, st_threads.back().area, st2.delay, st_threads.back().delay, to_seconds( st2.time_total ), to_seconds( st_threads[0].time_total ), to_seconds( st_threads[1].time_total ), time_8, to_seconds( st2.time_total ) / std::max( time_8, 1e-6 ), deterministic );
   }
 
   exp.save();
   exp.table();
 
+  exp_threads.save();
+  exp_threads.table();
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/parallel_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares simulating all nodes on one thread to simulating them with all
+   hardware threads, partitioned by levels and by words */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  const auto num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, double, double, double, double, double, bool> exp( "parallel_simulation", "benchmark", "gates", "levels", "threads", "time 1 thread", "time levels", "time words", "speedup levels", "speedup words", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    const simd_simulator<> sim( aig.num_pis(), 1u << 15 );
+
+    stopwatch<>::duration t_serial{};
+    const auto expected = call_with_stopwatch( t_serial, [&]() { return simulate_nodes<kitty::partial_truth_table>( aig, sim ); } );
+
+    parallel_simulation_params ps;
+    ps.num_threads = num_threads;
+    parallel_simulation_stats st_levels, st_words;
+
+    ps.partition = parallel_simulation_params::partition_t::levels;
+    const auto tts_levels = parallel_simulate_nodes<kitty::partial_truth_table>( aig, sim, ps, &st_levels );
+
+    ps.partition = parallel_simulation_params::partition_t::words;
+    const auto tts_words = parallel_simulate_nodes<kitty::partial_truth_table>( aig, sim, ps, &st_words );
+
+    bool equivalent = true;
+    aig.foreach_gate( [&]( auto const& n ) {
+      equivalent &= tts_levels[n] == expected[n] && tts_words[n] == expected[n];
+    } );
+
+    exp( benchmark, aig.num_gates(), st_levels.num_levels, num_threads, to_seconds( t_serial ), to_seconds( st_levels.time_total ), to_seconds( st_words.time_total ),
+         to_seconds( t_serial ) / std::max( to_seconds( st_levels.time_total ), 1e-6 ), to_seconds( t_serial ) / std::max( to_seconds( st_words.time_total ), 1e-6 ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* simulates 256 traces over 64 cycles and compares the measured toggle
+   rates to the switching activity estimated from independent patterns */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double> exp( "sequential_simulation", "benchmark", "gates", "registers", "time", "cycles/s", "activity comb.", "activity seq." );
+
+  for ( auto const& benchmark : iwls_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    sequential<aig_network> aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    sequential_simulation_params ps;
+    ps.num_traces = 256u;
+    ps.num_cycles = 64u;
+    ps.record_pos = false;
+    sequential_simulation_stats st;
+    const auto result = simulate_sequential( aig, ps, &st );
+
+    /* combinational estimate on the same network without registers */
+    aig_network comb = aig;
+    const auto comb_activity = detail::switching_activity( comb, ps.num_traces * ps.num_cycles );
+
+    double seq_sum = 0.0, comb_sum = 0.0;
+    aig.foreach_gate( [&]( auto const& n ) {
+      seq_sum += result.toggle_rates[aig.node_to_index( n )];
+      comb_sum += comb_activity[aig.node_to_index( n )];
+    } );
+
+    const auto time = to_seconds( st.time_total );
+    exp( benchmark, aig.num_gates(), aig.num_registers(), time, ps.num_cycles / std::max( time, 1e-6 ),
+         comb_sum / std::max( aig.num_gates(), 1u ), seq_sum / std::max( aig.num_gates(), 1u ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares simulating all nodes with `partial_simulator` (truth table
+   operators) to `simd_simulator` with each instruction set */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double, double, double, double, bool> exp( "simd_simulation", "benchmark", "gates", "patterns", "time partial", "time scalar", "time AVX2", "time AVX-512", "speedup", "time POs partial", "time POs simd", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    for ( auto num_patterns : { 256u, 4096u } )
+    {
+      const partial_simulator sim( aig.num_pis(), num_patterns );
+
+      stopwatch<>::duration t_partial{};
+      const auto expected = call_with_stopwatch( t_partial, [&]() { return simulate_nodes<kitty::partial_truth_table>( aig, sim ); } );
+
+      bool equivalent = true;
+      double times[3] = { 0.0, 0.0, 0.0 };
+      for ( auto level : { simd_level::scalar, simd_level::avx2, simd_level::avx512 } )
+      {
+        if ( level > simd_supported_level() )
+        {
+          continue;
+        }
+
+        simd_simulator<> simd_sim( sim );
+        simd_sim.set_level( level );
+
+        stopwatch<>::duration t_simd{};
+        const auto tts = call_with_stopwatch( t_simd, [&]() { return simulate_nodes<kitty::partial_truth_table>( aig, simd_sim ); } );
+        times[static_cast<uint32_t>( level )] = to_seconds( t_simd );
+
+        aig.foreach_gate( [&]( auto const& n ) {
+          equivalent &= tts[n] == expected[n];
+        } );
+      }
+
+      /* output values only */
+      stopwatch<>::duration t_pos{}, t_pos_simd{};
+      const auto pos = call_with_stopwatch( t_pos, [&]() { return simulate<kitty::partial_truth_table>( aig, sim ); } );
+      const auto pos_simd = call_with_stopwatch( t_pos_simd, [&]() { return simulate<kitty::partial_truth_table>( aig, simd_simulator<>( sim ) ); } );
+      equivalent &= pos == pos_simd;
+
+      const auto best = times[static_cast<uint32_t>( simd_supported_level() )];
+      exp( benchmark, aig.num_gates(), num_patterns, to_seconds( t_partial ), times[0], times[1], times[2], to_seconds( t_partial ) / std::max( best, 1e-6 ), to_seconds( t_pos ), to_seconds( t_pos_simd ), equivalent );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* compares the default array-of-structs AIG storage with the
+   structure-of-arrays layout on fan-in dominated traversals */
+
+struct traversal_result
+{
+  double time_gates{};
+  double time_sim{};
+  double time_cuts{};
+  uint64_t checksum{};
+};
+
+template<class Ntk>
+traversal_result run_traversals( Ntk const& ntk )
+{
+  using namespace mockturtle;
+
+  traversal_result res;
+  stopwatch<>::duration t_gates{}, t_sim{}, t_cuts{};
+
+  call_with_stopwatch( t_gates, [&]() {
+    for ( auto i = 0u; i < 20u; ++i )
+    {
+      ntk.foreach_gate( [&]( auto const& n ) {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          res.checksum += ntk.get_node( f ) ^ ntk.is_complemented( f );
+        } );
+      } );
+    }
+  } );
+
+  partial_simulator sim( ntk.num_pis(), 2048u );
+  const auto tts = call_with_stopwatch( t_sim, [&]() {
+    return simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+  } );
+  ntk.foreach_po( [&]( auto const& f ) {
+    res.checksum += tts[f]._bits[0];
+  } );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 6u;
+  ps.cut_limit = 8u;
+  const auto cuts = call_with_stopwatch( t_cuts, [&]() {
+    return cut_enumeration( ntk, ps );
+  } );
+  res.checksum += cuts.total_cuts();
+
+  /* in milliseconds */
+  res.time_gates = to_seconds( t_gates ) * 1000.0;
+  res.time_sim = to_seconds( t_sim ) * 1000.0;
+  res.time_cuts = to_seconds( t_cuts ) * 1000.0;
+  return res;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using aig_soa_network = basic_aig_network<aig_soa_storage>;
+
+  fmt::print( "[i] bytes per node in fan-in traversals: AoS = {}, SoA = {}\n",
+              sizeof( aig_storage::node_type ), sizeof( aig_soa_storage::node_type ) );
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool> exp( "storage_layout", "benchmark", "size",
+                                                                                               "gates AoS [ms]", "gates SoA [ms]", "sim AoS [ms]", "sim SoA [ms]", "cuts AoS [ms]", "cuts SoA [ms]", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    aig_soa_network soa;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( soa ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    const auto aos_res = run_traversals( aig );
+    const auto soa_res = run_traversals( soa );
+
+    exp( benchmark, aig.size(), aos_res.time_gates, soa_res.time_gates, aos_res.time_sim, soa_res.time_sim,
+         aos_res.time_cuts, soa_res.time_cuts, aos_res.checksum == soa_res.checksum );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
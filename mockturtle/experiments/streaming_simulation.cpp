@@ -0,0 +1,86 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/streaming_simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/read_patterns.hpp>
+#include <mockturtle/io/write_patterns.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* simulates 2^20 patterns from a file in blocks of 1024 words and compares
+   the memory of one block to the memory of full signatures */
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  constexpr uint32_t num_patterns = 1u << 20;
+  constexpr uint32_t words_per_block = 1024u;
+
+  experiment<std::string, uint32_t, uint64_t, uint64_t, double, double, double, double, bool> exp( "streaming_simulation", "benchmark", "gates", "patterns", "blocks", "MB block", "MB full", "time read", "time total", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    const std::string filename = fmt::format( "{}_patterns.txt", benchmark );
+    write_patterns( partial_simulator( aig.num_pis(), num_patterns ), filename );
+
+    pattern_block_reader reader( filename, words_per_block );
+    popcount_reducer<aig_network> ones( aig );
+    toggle_reducer<aig_network> toggles( aig );
+    mismatch_reducer<aig_network> mismatches( aig );
+    const auto st = simulate_stream( aig, reader, ones, toggles, mismatches );
+    std::remove( filename.c_str() );
+    if ( !st )
+    {
+      continue;
+    }
+
+    const auto bytes_per_word = 8.0 / ( 1 << 20 );
+    exp( benchmark, aig.num_gates(), st->num_patterns, st->num_blocks, aig.size() * words_per_block * bytes_per_word,
+         aig.size() * ( num_patterns / 64.0 ) * bytes_per_word, to_seconds( st->time_read ), to_seconds( st->time_total ), mismatches.equivalent() );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/balancing.hpp>
+#include <mockturtle/algorithms/balancing/sop_balancing.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/structural_choices.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+#include <experiments.hpp>
+
+std::string const mcnc_library = "GATE   inv1    1  O=!a;             PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                 "GATE   inv2    2  O=!a;             PIN * INV 2 999 1.0 0.1 1.0 0.1\n"
+                                 "GATE   inv3    3  O=!a;             PIN * INV 3 999 1.1 0.09 1.1 0.09\n"
+                                 "GATE   inv4    4  O=!a;             PIN * INV 4 999 1.2 0.07 1.2 0.07\n"
+                                 "GATE   nand2   2  O=!(a*b);         PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                 "GATE   nand3   3  O=!(a*b*c);       PIN * INV 1 999 1.1 0.3 1.1 0.3\n"
+                                 "GATE   nand4   4  O=!(a*b*c*d);     PIN * INV 1 999 1.4 0.4 1.4 0.4\n"
+                                 "GATE   nor2    2  O=!(a+b);         PIN * INV 1 999 1.4 0.5 1.4 0.5\n"
+                                 "GATE   nor3    3  O=!(a+b+c);       PIN * INV 1 999 2.4 0.7 2.4 0.7\n"
+                                 "GATE   nor4    4  O=!(a+b+c+d);     PIN * INV 1 999 3.8 1.0 3.8 1.0\n"
+                                 "GATE   and2    3  O=a*b;            PIN * NONINV 1 999 1.9 0.3 1.9 0.3\n"
+                                 "GATE   or2     3  O=a+b;            PIN * NONINV 1 999 2.4 0.3 2.4 0.3\n"
+                                 "GATE   xor2a   5  O=a*!b+!a*b;      PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                                 "GATE   xnor2a  5  O=a*b+!a*!b;      PIN * UNKNOWN 2 999 2.1 0.5 2.1 0.5\n"
+                                 "GATE   aoi21   3  O=!(a*b+c);       PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                                 "GATE   aoi22   4  O=!(a*b+c*d);     PIN * INV 1 999 2.0 0.4 2.0 0.4\n"
+                                 "GATE   oai21   3  O=!((a+b)*c);     PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                                 "GATE   oai22   4  O=!((a+b)*(c+d)); PIN * INV 1 999 2.0 0.4 2.0 0.4\n"
+                                 "GATE   buf     2  O=a;              PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                                 "GATE   zero    0  O=CONST0;\n"
+                                 "GATE   one     0  O=CONST1;";
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  /* technology mapping of three structures (original, SOP-balanced, and
+     cut-rewritten) separately and of their choice network */
+  experiment<std::string, uint32_t, uint32_t, uint32_t, double, double, double, double, double, double, float, bool> exp(
+      "structural_choices", "benchmark", "size", "size choices", "choices", "delay orig", "delay bal", "delay rw", "delay choices", "area best delay", "area choices", "time choices", "not worse" );
+
+  std::vector<gate> gates;
+  std::istringstream in( mcnc_library );
+  if ( lorina::read_genlib( in, genlib_reader( gates ) ) != lorina::return_code::success )
+  {
+    return 1;
+  }
+  tech_library<5> tech_lib( gates );
+
+  /* ISCAS and the smaller EPFL benchmarks */
+  auto benchmarks = iscas_benchmarks();
+  for ( auto const& benchmark : epfl_benchmarks( experiments::adder | experiments::bar | experiments::max | experiments::cavlc | experiments::ctrl | experiments::dec | experiments::i2c | experiments::int2float | experiments::priority | experiments::router ) )
+  {
+    benchmarks.push_back( benchmark );
+  }
+
+  for ( auto const& benchmark : benchmarks )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    aig = cleanup_dangling( aig );
+
+    sop_rebalancing<aig_network> balance_fn;
+    balancing_params bps;
+    bps.cut_enumeration_ps.cut_size = 6u;
+    const auto bal = balancing( aig, { balance_fn }, bps );
+
+    xag_npn_resynthesis<aig_network> resyn;
+    cut_rewriting_params cps;
+    cps.cut_enumeration_ps.cut_size = 4u;
+    const auto rw = cleanup_dangling( cut_rewriting( aig, resyn, cps ) );
+
+    const std::vector<aig_network> structures{ aig, bal, rw };
+    std::vector<map_stats> sts( structures.size() );
+    for ( auto i = 0u; i < structures.size(); ++i )
+    {
+      map( structures[i], tech_lib, {}, &sts[i] );
+    }
+    const auto best = std::min_element( sts.begin(), sts.end(), []( auto const& a, auto const& b ) { return a.delay < b.delay; } );
+
+    structural_choices_stats cst;
+    const auto choices = structural_choices( structures, {}, &cst );
+    map_stats st;
+    map( choices, tech_lib, {}, &st );
+
+    exp( benchmark, aig.num_gates(), choices.num_gates(), choices.num_choices(), sts[0].delay, sts[1].delay, sts[2].delay, st.delay, best->area, st.area, to_seconds( cst.time_total ), st.delay <= best->delay + 1e-6 );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
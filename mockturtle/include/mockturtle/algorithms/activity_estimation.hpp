@@ -0,0 +1,442 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file activity_estimation.hpp
+  \brief Switching activity estimation by counting toggles
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "compiled_simulation.hpp"
+#include "sequential_simulation.hpp"
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for estimate_switching_activity.
+ *
+ * The data structure `activity_estimation_params` holds configurable
+ * parameters with default arguments for `estimate_switching_activity`.
+ */
+struct activity_estimation_params
+{
+  /*! \brief Number of random patterns. */
+  uint32_t num_patterns{ 2048u };
+
+  /*! \brief Number of words per PI that are simulated at once. */
+  uint32_t words_per_block{ 16u };
+
+  /*! \brief Probability of each PI to be 1 (empty for 0.5). */
+  std::vector<double> input_probabilities{};
+
+  /*! \brief Number of threads (0 uses the hardware concurrency). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Seed for the random patterns. */
+  uint64_t seed{ 1u };
+};
+
+/*! \brief Statistics for estimate_switching_activity. */
+struct activity_estimation_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of simulated patterns (or cycles times traces). */
+  uint64_t num_patterns{ 0u };
+
+  /*! \brief Number of simulated blocks. */
+  uint64_t num_blocks{ 0u };
+
+  /*! \brief Number of simulation value buffers per thread. */
+  uint32_t num_registers{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] patterns     = {} in {} blocks\n", num_patterns, num_blocks );
+    fmt::print( "[i] registers    = {}\n", num_registers );
+    fmt::print( "[i] total time   = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+/* number of value changes between consecutive bits of the first `num_bits`
+   bits of `words` */
+inline uint64_t count_toggles( uint64_t const* words, uint64_t num_bits )
+{
+  if ( num_bits < 2u )
+  {
+    return 0u;
+  }
+
+  const auto last = ( num_bits - 1u ) >> 6u;
+  uint64_t count = 0u;
+  for ( auto i = 0u; i < last; ++i )
+  {
+    const auto diff = words[i] ^ ( ( words[i] >> 1u ) | ( words[i + 1u] << 63u ) );
+    count += std::bitset<64>( diff ).count();
+  }
+
+  /* transitions from bit j to bit j + 1 for the remaining bits */
+  const auto remaining = ( num_bits - 1u ) & 63u;
+  const auto diff = ( words[last] ^ ( words[last] >> 1u ) ) & ( ( UINT64_C( 1 ) << remaining ) - 1u );
+  count += std::bitset<64>( diff ).count();
+  return count;
+}
+
+/* random words whose bits are 1 with probability `p`, quantized to 16 bits:
+   starting from the least significant bit of the fixed-point value, a set
+   bit ORs and a cleared bit ANDs a uniform random word */
+template<class Rng>
+void random_words( uint64_t* words, uint64_t num_words, double p, Rng& rng )
+{
+  const auto fixed = static_cast<uint32_t>( std::clamp( p, 0.0, 1.0 ) * 65536.0 + 0.5 );
+  if ( fixed == 0u || fixed >= 65536u )
+  {
+    std::fill( words, words + num_words, fixed == 0u ? UINT64_C( 0 ) : ~UINT64_C( 0 ) );
+    return;
+  }
+
+  auto lowest = 0u;
+  while ( ( ( fixed >> lowest ) & 1u ) == 0u )
+  {
+    ++lowest;
+  }
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    uint64_t word = rng();
+    for ( auto bit = lowest + 1u; bit < 16u; ++bit )
+    {
+      word = ( ( fixed >> bit ) & 1u ) ? ( word | rng() ) : ( word & rng() );
+    }
+    words[i] = word;
+  }
+}
+
+} // namespace detail
+
+/*! \brief Estimates the switching activity by counting toggles.
+ *
+ * The network is compiled into a simulation program (see
+ * `compile_simulation`), which is run on blocks of patterns.  The number of
+ * value changes between consecutive patterns is counted with popcounts for
+ * each node while its value is in a register, such that neither the values
+ * of all nodes nor all patterns are stored at any time.  The switching
+ * activity of a node is its number of toggles divided by the number of
+ * transitions between patterns.
+ *
+ * Random patterns (`simulate_random`) are drawn independently for each
+ * pattern with the input probabilities of the parameters, such that the
+ * activity of a node with signal probability p approaches 2p(1-p).  Blocks
+ * of random patterns are independent and simulated in parallel.  Patterns
+ * of a trace (`simulate_trace`), e.g., the inputs of consecutive clock
+ * cycles read with `pattern_block_reader`, are simulated in order, such
+ * that the correlation between consecutive patterns is taken into account.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      activity_estimator est( aig );
+      est.simulate_random( 4096u );
+      pattern_block_reader trace( "trace.txt" );
+      est.simulate_trace( trace );
+      const auto activity = est.activities();
+   \endverbatim
+ */
+template<class Ntk>
+class activity_estimator
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit activity_estimator( Ntk const& ntk, activity_estimation_params const& ps = {} )
+      : ntk( ntk ), ps( ps ), pool( ps.num_threads )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+
+    assert( ps.input_probabilities.empty() || ps.input_probabilities.size() == ntk.num_pis() );
+
+    compiled_simulation_stats cst;
+    detail::simulation_compiler<Ntk> compiler( ntk, cst, true );
+    program = compiler.run();
+    num_values = ntk.num_pis() + 1u + static_cast<uint32_t>( program.instructions().size() );
+    node_values.resize( ntk.size() );
+    ntk.foreach_node( [&]( auto const& n ) {
+      node_values[ntk.node_to_index( n )] = compiler.node_value( n );
+    } );
+    toggle_counts.assign( num_values, 0u );
+    st.num_registers = program.num_registers();
+  }
+
+  /*! \brief Simulates `num_patterns` random patterns. */
+  void simulate_random( uint64_t num_patterns )
+  {
+    stopwatch t( st.time_total );
+
+    const uint64_t bits_per_block = std::max( ps.words_per_block, 1u ) * 64u;
+    const auto num_blocks = ( num_patterns + bits_per_block - 1u ) / bits_per_block;
+    const auto first_block = st.num_blocks;
+
+    std::vector<worker> workers( pool.num_threads(), worker( program, uint64_t( ntk.num_pis() ) * bits_per_block / 64u, num_values ) );
+    pool.parallel_for( 0u, num_blocks, 1u, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+      auto& w = workers[thread];
+      for ( auto b = begin; b < end; ++b )
+      {
+        const auto num_bits = std::min( bits_per_block, num_patterns - b * bits_per_block );
+        const auto num_words = ( num_bits + 63u ) >> 6u;
+
+        /* every block has its own seed, independent of the threads */
+        std::mt19937_64 rng( ps.seed + first_block + b );
+        for ( auto i = 0u; i < ntk.num_pis(); ++i )
+        {
+          detail::random_words( w.pi_words.data() + i * bits_per_block / 64u, num_words, ps.input_probabilities.empty() ? 0.5 : ps.input_probabilities[i], rng );
+        }
+        simulate_block( w, num_words, num_bits, bits_per_block / 64u );
+        w.num_transitions += num_bits - 1u;
+      }
+    } );
+
+    for ( auto const& w : workers )
+    {
+      for ( auto v = 0u; v < num_values; ++v )
+      {
+        toggle_counts[v] += w.toggles[v];
+      }
+      transitions += w.num_transitions;
+    }
+    st.num_blocks += num_blocks;
+    st.num_patterns += num_patterns;
+  }
+
+  /*! \brief Simulates the patterns of a source in order.
+   *
+   * The source must implement `bool next( std::vector<kitty::partial_truth_table>& block )`,
+   * which returns the PI values of the next block of patterns.  Toggles
+   * between the last pattern of a block and the first pattern of the next
+   * block are counted as well.
+   */
+  template<class Source>
+  void simulate_trace( Source& source )
+  {
+    stopwatch t( st.time_total );
+
+    worker w( program, 0u, num_values );
+    std::vector<uint8_t> last_bits( num_values, 0u );
+    bool first = true;
+
+    std::vector<kitty::partial_truth_table> block;
+    while ( source.next( block ) )
+    {
+      assert( block.size() == ntk.num_pis() );
+      const auto num_bits = block.empty() ? 0u : block.front().num_bits();
+      if ( num_bits == 0u )
+      {
+        continue;
+      }
+      const auto num_words = ( num_bits + 63u ) >> 6u;
+
+      /* count the toggles across the block boundary */
+      const auto observe = [&]( uint32_t value, uint64_t const* words ) {
+        w.toggles[value] += detail::count_toggles( words, num_bits );
+        if ( !first )
+        {
+          w.toggles[value] += ( words[0] & 1u ) != last_bits[value];
+        }
+        last_bits[value] = static_cast<uint8_t>( ( words[num_words - 1u] >> ( ( num_bits - 1u ) & 63u ) ) & 1u );
+      };
+
+      for ( auto i = 0u; i < block.size(); ++i )
+      {
+        observe( i + 1u, detail::simd_words( block[i] ) );
+      }
+      w.program.run_words(
+          num_words, [&]( uint32_t i ) { return detail::simd_words( block[i] ); },
+          [&]( uint32_t i, uint64_t const* words ) { observe( ntk.num_pis() + 1u + i, words ); } );
+
+      w.num_transitions += first ? num_bits - 1u : num_bits;
+      first = false;
+      ++st.num_blocks;
+      st.num_patterns += num_bits;
+    }
+
+    for ( auto v = 0u; v < num_values; ++v )
+    {
+      toggle_counts[v] += w.toggles[v];
+    }
+    transitions += w.num_transitions;
+  }
+
+  /*! \brief Number of value changes of a node between consecutive patterns. */
+  uint64_t toggles( node const& n ) const
+  {
+    return toggle_counts[node_values[ntk.node_to_index( n )]];
+  }
+
+  /*! \brief Number of pairs of consecutive patterns. */
+  uint64_t num_transitions() const
+  {
+    return transitions;
+  }
+
+  /*! \brief Switching activity of a node. */
+  float activity( node const& n ) const
+  {
+    return transitions == 0u ? 0.0f : static_cast<float>( static_cast<double>( toggles( n ) ) / transitions );
+  }
+
+  /*! \brief Switching activities of all nodes indexed by `node_to_index`. */
+  std::vector<float> activities() const
+  {
+    std::vector<float> result( ntk.size(), 0.0f );
+    ntk.foreach_node( [&]( auto const& n ) {
+      result[ntk.node_to_index( n )] = activity( n );
+    } );
+    return result;
+  }
+
+  activity_estimation_stats const& stats() const
+  {
+    return st;
+  }
+
+private:
+  struct worker
+  {
+    worker( simulation_program const& program, uint64_t num_pi_words, uint32_t num_values )
+        : program( program ), pi_words( num_pi_words ), toggles( num_values, 0u )
+    {
+    }
+
+    simulation_program program;
+    std::vector<uint64_t> pi_words;
+    std::vector<uint64_t> toggles;
+    uint64_t num_transitions{ 0u };
+  };
+
+  void simulate_block( worker& w, uint64_t num_words, uint64_t num_bits, uint64_t stride )
+  {
+    for ( auto i = 0u; i < ntk.num_pis(); ++i )
+    {
+      w.toggles[i + 1u] += detail::count_toggles( w.pi_words.data() + i * stride, num_bits );
+    }
+    w.program.run_words(
+        num_words, [&]( uint32_t i ) { return w.pi_words.data() + i * stride; },
+        [&]( uint32_t i, uint64_t const* words ) { w.toggles[ntk.num_pis() + 1u + i] += detail::count_toggles( words, num_bits ); } );
+  }
+
+private:
+  Ntk const& ntk;
+  activity_estimation_params ps;
+  activity_estimation_stats st;
+  thread_pool pool;
+
+  simulation_program program;
+  uint32_t num_values{ 0u };
+  std::vector<uint32_t> node_values;
+  std::vector<uint64_t> toggle_counts;
+  uint64_t transitions{ 0u };
+};
+
+/*! \brief Switching activity of all nodes.
+ *
+ * Returns the switching activity of each node indexed by `node_to_index`.
+ * Networks with registers are simulated cycle by cycle with
+ * `simulate_sequential` using `num_patterns / 256` cycles of 256 traces,
+ * such that the toggles of the registers are measured over time.
+ * Otherwise, `num_patterns` random patterns are simulated with an
+ * `activity_estimator`.
+ *
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+std::vector<float> estimate_switching_activity( Ntk const& ntk, activity_estimation_params const& ps = {}, activity_estimation_stats* pst = nullptr )
+{
+  if constexpr ( has_foreach_ro_v<Ntk> && has_num_registers_v<Ntk> )
+  {
+    if ( ntk.num_registers() > 0u )
+    {
+      /* no patterns, no toggles (as for combinational networks) */
+      if ( ps.num_patterns == 0u )
+      {
+        if ( pst )
+        {
+          *pst = {};
+        }
+        return std::vector<float>( ntk.size(), 0.0f );
+      }
+
+      sequential_simulation_params sps;
+      sps.num_traces = std::min( ps.num_patterns, 256u );
+      sps.num_cycles = ps.num_patterns / sps.num_traces + 1u;
+      sps.record_pos = false;
+      sps.seed = ps.seed;
+      sequential_simulation_stats sst;
+      auto result = simulate_sequential( ntk, sps, &sst );
+
+      if ( pst )
+      {
+        *pst = {};
+        pst->time_total = sst.time_total;
+        pst->num_patterns = uint64_t( sps.num_traces ) * sps.num_cycles;
+        pst->num_blocks = sps.num_cycles;
+      }
+      return result.toggle_rates;
+    }
+  }
+
+  activity_estimator<Ntk> est( ntk, ps );
+  est.simulate_random( ps.num_patterns );
+
+  if ( pst )
+  {
+    *pst = est.stats();
+  }
+  return est.activities();
+}
+
+} // namespace mockturtle
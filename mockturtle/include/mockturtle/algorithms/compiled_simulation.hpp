@@ -0,0 +1,684 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compiled_simulation.hpp
+  \brief Simulation of a network compiled to a flat instruction stream
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "detail/simd_kernels.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for compile_simulation. */
+struct compiled_simulation_stats
+{
+  /*! \brief Total runtime of the compilation. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of gates in the transitive fan-in of the POs. */
+  uint32_t num_gates{ 0u };
+
+  /*! \brief Number of instructions. */
+  uint32_t num_instructions{ 0u };
+
+  /*! \brief Number of registers (simulation value buffers). */
+  uint32_t num_registers{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] gates        = {}\n", num_gates );
+    fmt::print( "[i] instructions = {}\n", num_instructions );
+    fmt::print( "[i] registers    = {}\n", num_registers );
+    fmt::print( "[i] total time   = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+/*! \brief Instruction of a compiled simulation program.
+ *
+ * Computes `op` over the registers `src` into register `dst`, where bit `i`
+ * of `complement` complements source `i`.  Two-input operations only read
+ * the first two sources.
+ */
+struct simulation_instruction
+{
+  detail::simd_op op;
+  uint8_t complement;
+  uint32_t dst;
+  std::array<uint32_t, 3> src;
+};
+
+namespace detail
+{
+template<class Ntk>
+class simulation_compiler;
+} // namespace detail
+
+/*! \brief Network compiled for repeated bit-parallel simulation.
+ *
+ * A program is a flat array of instructions over a small number of
+ * registers, each of which holds the simulation values of one node for all
+ * patterns.  Registers are reused as soon as the value they hold is not
+ * read anymore, such that the working set is much smaller than one value
+ * per node.  Programs are created with `compile_simulation` and can be run
+ * on any number of patterns.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      auto program = compile_simulation( aig );
+      std::vector<kitty::partial_truth_table> inputs( aig.num_pis(), kitty::partial_truth_table( 4096u ) );
+      for ( auto& tt : inputs )
+      {
+        kitty::create_random( tt );
+      }
+      const auto outputs = program.run( inputs );
+   \endverbatim
+ */
+class simulation_program : public detail::simd_kernel_selection
+{
+  template<class Ntk>
+  friend class detail::simulation_compiler;
+
+public:
+  static constexpr uint32_t no_register = UINT32_MAX;
+
+  simulation_program() = default;
+
+  simulation_program( simulation_program const& other )
+      : detail::simd_kernel_selection( other ),
+        _instructions( other._instructions ),
+        _pi_registers( other._pi_registers ),
+        _po_registers( other._po_registers ),
+        _po_complements( other._po_complements ),
+        _constant_register( other._constant_register ),
+        _num_registers( other._num_registers )
+  {}
+
+  simulation_program( simulation_program&& other ) = default;
+
+  simulation_program& operator=( simulation_program const& other )
+  {
+    if ( this != &other )
+    {
+      *this = simulation_program( other );
+    }
+    return *this;
+  }
+
+  simulation_program& operator=( simulation_program&& other ) = default;
+
+  /*! \brief Simulates the program and returns the values of the POs.
+   *
+   * All PI values must have the same number of bits.
+   */
+  std::vector<kitty::partial_truth_table> run( std::vector<kitty::partial_truth_table> const& pi_values )
+  {
+    std::vector<kitty::partial_truth_table> po_values;
+    run( pi_values, po_values );
+    return po_values;
+  }
+
+  /*! \brief Simulates the program into `po_values`, reusing its storage. */
+  void run( std::vector<kitty::partial_truth_table> const& pi_values, std::vector<kitty::partial_truth_table>& po_values )
+  {
+    assert( pi_values.size() == _pi_registers.size() );
+    const auto num_bits = pi_values.empty() ? 0u : pi_values.front().num_bits();
+    const auto num_words = ( num_bits + 63u ) >> 6u;
+    run_words(
+        num_words, [&]( uint32_t i ) {
+          assert( pi_values[i].num_bits() == num_bits );
+          return detail::simd_words( pi_values[i] );
+        },
+        []( uint32_t, uint64_t const* ) {} );
+    auto const& arena = *_arena;
+
+    po_values.resize( _po_registers.size() );
+    for ( auto i = 0u; i < _po_registers.size(); ++i )
+    {
+      auto& tt = po_values[i];
+      if ( tt.num_bits() != num_bits )
+      {
+        tt = kitty::partial_truth_table( num_bits );
+      }
+      auto const* words = arena.row( _po_registers[i] );
+      auto* out = detail::simd_words( tt );
+      const auto mask = _po_complements[i] ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        out[w] = words[w] ^ mask;
+      }
+      tt.mask_bits();
+    }
+  }
+
+  /*! \brief Simulates `num_words` words per PI.
+   *
+   * The words of PI `i` are read from `pi_words( i )`.  After instruction
+   * `i` has been executed, `observe( i, words )` is called with the words of
+   * its result, which are only valid until the register is reused.  The
+   * result of PO `i` can be read from `po_words( i )` afterwards.
+   */
+  template<class PiWordsFn, class ObserveFn>
+  void run_words( uint64_t num_words, PiWordsFn&& pi_words, ObserveFn&& observe )
+  {
+    auto& arena = prepare( num_words );
+
+    if ( _constant_register != no_register )
+    {
+      std::fill( arena.row( _constant_register ), arena.row( _constant_register ) + num_words, UINT64_C( 0 ) );
+    }
+    for ( auto i = 0u; i < _pi_registers.size(); ++i )
+    {
+      if ( _pi_registers[i] != no_register )
+      {
+        uint64_t const* words = pi_words( i );
+        std::copy( words, words + num_words, arena.row( _pi_registers[i] ) );
+      }
+    }
+
+    execute( arena, observe );
+  }
+
+  /*! \brief Words of PO `index` after `run_words`, complemented if `po_complemented( index )`. */
+  uint64_t const* po_words( uint32_t index ) const
+  {
+    assert( _arena );
+    return _arena->row( _po_registers[index] );
+  }
+
+  bool po_complemented( uint32_t index ) const
+  {
+    return _po_complements[index];
+  }
+
+  std::vector<simulation_instruction> const& instructions() const
+  {
+    return _instructions;
+  }
+
+  uint32_t num_registers() const
+  {
+    return _num_registers;
+  }
+
+  uint32_t num_pis() const
+  {
+    return static_cast<uint32_t>( _pi_registers.size() );
+  }
+
+  uint32_t num_pos() const
+  {
+    return static_cast<uint32_t>( _po_registers.size() );
+  }
+
+private:
+  detail::simd_arena& prepare( uint64_t num_words )
+  {
+    if ( !_arena || _arena->num_words() != num_words )
+    {
+      _arena = std::make_unique<detail::simd_arena>( _num_registers, num_words );
+    }
+    return *_arena;
+  }
+
+  template<class ObserveFn>
+  void execute( detail::simd_arena& arena, ObserveFn&& observe ) const
+  {
+    const auto num_words = arena.num_words();
+
+    /* below one vector the call through the kernel pointer does not pay off */
+    if ( num_words < 8u )
+    {
+      for ( auto i = 0u; i < _instructions.size(); ++i )
+      {
+        auto const& ins = _instructions[i];
+        uint64_t const* fanins[3] = { arena.row( ins.src[0] ), arena.row( ins.src[1] ), arena.row( ins.src[2] ) };
+        const uint64_t masks[3] = { -static_cast<uint64_t>( ins.complement & 1u ), -static_cast<uint64_t>( ( ins.complement >> 1u ) & 1u ), -static_cast<uint64_t>( ( ins.complement >> 2u ) & 1u ) };
+        detail::simd_dispatch<uint64_t>( ins.op, arena.row( ins.dst ), fanins, masks, 0u, num_words );
+        observe( i, arena.row( ins.dst ) );
+      }
+      return;
+    }
+
+    const auto compute = kernel();
+    for ( auto i = 0u; i < _instructions.size(); ++i )
+    {
+      auto const& ins = _instructions[i];
+      uint64_t const* fanins[3] = { arena.row( ins.src[0] ), arena.row( ins.src[1] ), arena.row( ins.src[2] ) };
+      const uint64_t masks[3] = { -static_cast<uint64_t>( ins.complement & 1u ), -static_cast<uint64_t>( ( ins.complement >> 1u ) & 1u ), -static_cast<uint64_t>( ( ins.complement >> 2u ) & 1u ) };
+      compute( ins.op, arena.row( ins.dst ), fanins, masks, 0u, num_words );
+      observe( i, arena.row( ins.dst ) );
+    }
+  }
+
+private:
+  std::vector<simulation_instruction> _instructions;
+  std::vector<uint32_t> _pi_registers;
+  std::vector<uint32_t> _po_registers;
+  std::vector<bool> _po_complements;
+  uint32_t _constant_register{ no_register };
+  uint32_t _num_registers{ 0u };
+
+  /* workspace of `run`, not copied */
+  std::unique_ptr<detail::simd_arena> _arena;
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class simulation_compiler
+{
+public:
+  using node = typename Ntk::node;
+
+  /* value of a node: the constant (0), a PI (1, ...), or the result of an
+     instruction, possibly complemented */
+  struct operand
+  {
+    uint32_t value;
+    bool complement;
+
+    bool operator==( operand const& other ) const
+    {
+      return value == other.value && complement == other.complement;
+    }
+  };
+
+  /* instruction before register allocation, sources are values */
+  struct ssa_instruction
+  {
+    simd_op op;
+    std::array<operand, 3> src;
+  };
+
+  static constexpr uint32_t unused = UINT32_MAX;
+
+public:
+  /* compiles all gates instead of the transitive fan-in of the POs if
+     `all_gates` is set */
+  simulation_compiler( Ntk const& ntk, compiled_simulation_stats& st, bool all_gates = false )
+      : ntk( ntk ), st( st ), all_gates( all_gates ), node_values( ntk.size(), operand{ 0u, false } )
+  {
+  }
+
+  simulation_program run()
+  {
+    stopwatch t( st.time_total );
+
+    num_inputs = ntk.num_pis() + 1u;
+    node_values[ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) )] = { 0u, false };
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      node_values[ntk.node_to_index( ntk.get_node( ntk.get_constant( true ) ) )] = { 0u, true };
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      node_values[ntk.node_to_index( n )] = { i + 1u, false };
+    } );
+
+    /* only the transitive fan-in of the POs is compiled */
+    std::vector<node> gates;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+    std::vector<bool> needed( ntk.size(), all_gates );
+    ntk.foreach_po( [&]( auto const& f ) {
+      needed[ntk.node_to_index( ntk.get_node( f ) )] = true;
+    } );
+    for ( auto it = gates.rbegin(); it != gates.rend(); ++it )
+    {
+      if ( needed[ntk.node_to_index( *it )] )
+      {
+        ntk.foreach_fanin( *it, [&]( auto const& f ) {
+          needed[ntk.node_to_index( ntk.get_node( f ) )] = true;
+        } );
+      }
+    }
+
+    for ( auto const& n : gates )
+    {
+      if ( needed[ntk.node_to_index( n )] )
+      {
+        ++st.num_gates;
+        node_values[ntk.node_to_index( n )] = compile_gate( n );
+      }
+    }
+
+    simulation_program program;
+    ntk.foreach_po( [&]( auto const& f ) {
+      auto value = node_values[ntk.node_to_index( ntk.get_node( f ) )];
+      outputs.push_back( { value.value, value.complement != ntk.is_complemented( f ) } );
+    } );
+    allocate( program );
+
+    st.num_instructions = static_cast<uint32_t>( program._instructions.size() );
+    st.num_registers = program._num_registers;
+    return program;
+  }
+
+  /* value of a node after `run`: 0 is the constant, 1 to `num_pis` are the
+     PIs, and larger values are results of instruction `value - num_pis - 1` */
+  uint32_t node_value( node const& n ) const
+  {
+    return node_values[ntk.node_to_index( n )].value;
+  }
+
+private:
+  operand compile_gate( node const& n )
+  {
+    std::array<operand, 3> fanins{};
+    uint32_t num_fanins = 0u;
+    std::vector<operand> lut_fanins;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto value = node_values[ntk.node_to_index( ntk.get_node( f ) )];
+      value.complement = value.complement != ntk.is_complemented( f );
+      if ( num_fanins < 3u )
+      {
+        fanins[num_fanins] = value;
+      }
+      ++num_fanins;
+      lut_fanins.push_back( value );
+    } );
+
+    const auto op = simd_op_of( ntk, n );
+    if ( op != simd_op::none )
+    {
+      if ( op == simd_op::and2 || op == simd_op::xor2 )
+      {
+        fanins[2] = fanins[0];
+      }
+      return emit( op, fanins[0], fanins[1], fanins[2] );
+    }
+
+    if constexpr ( has_node_function_v<Ntk> )
+    {
+      function_cache.clear();
+      return compile_function( ntk.node_function( n ), lut_fanins );
+    }
+    else
+    {
+      assert( false && "gate is neither supported by the kernels nor has a node function" );
+      return { 0u, false };
+    }
+  }
+
+  /* Shannon decomposition into multiplexers, and-gates, and xor-gates over
+     the top-most support variable; cofactors are shared up to complement */
+  operand compile_function( kitty::dynamic_truth_table const& tt, std::vector<operand> const& fanins )
+  {
+    if ( kitty::is_const0( tt ) )
+    {
+      return { 0u, false };
+    }
+    if ( kitty::is_const0( ~tt ) )
+    {
+      return { 0u, true };
+    }
+    if ( const auto it = function_cache.find( tt ); it != function_cache.end() )
+    {
+      return it->second;
+    }
+    if ( const auto it = function_cache.find( ~tt ); it != function_cache.end() )
+    {
+      return { it->second.value, !it->second.complement };
+    }
+
+    auto var = tt.num_vars() - 1u;
+    while ( !kitty::has_var( tt, var ) )
+    {
+      --var;
+    }
+    const auto x = fanins[var];
+    const auto f1 = compile_function( kitty::cofactor1( tt, var ), fanins );
+    const auto f0 = compile_function( kitty::cofactor0( tt, var ), fanins );
+
+    operand result;
+    if ( f1.value == 0u && f0.value == 0u )
+    {
+      /* literal */
+      result = f1.complement ? x : complement( x );
+    }
+    else if ( f1.value == f0.value && f1.complement != f0.complement )
+    {
+      /* x ? !g : g */
+      result = emit( simd_op::xor2, x, f0, x );
+    }
+    else if ( f0.value == 0u && f0.complement == false )
+    {
+      result = emit( simd_op::and2, x, f1, x );
+    }
+    else if ( f1.value == 0u && f1.complement == false )
+    {
+      result = emit( simd_op::and2, complement( x ), f0, x );
+    }
+    else if ( f1.value == 0u )
+    {
+      /* x | g = !( !x & !g ) */
+      result = complement( emit( simd_op::and2, complement( x ), complement( f0 ), x ) );
+    }
+    else if ( f0.value == 0u )
+    {
+      /* !x | g = !( x & !g ) */
+      result = complement( emit( simd_op::and2, x, complement( f1 ), x ) );
+    }
+    else
+    {
+      result = emit( simd_op::ite3, x, f1, f0 );
+    }
+
+    function_cache.emplace( tt, result );
+    return result;
+  }
+
+  static operand complement( operand const& o )
+  {
+    return { o.value, !o.complement };
+  }
+
+  operand emit( simd_op op, operand const& a, operand const& b, operand const& c )
+  {
+    instructions.push_back( { op, { a, b, c } } );
+    return { num_inputs + static_cast<uint32_t>( instructions.size() ) - 1u, false };
+  }
+
+  static uint32_t arity( simd_op op )
+  {
+    return ( op == simd_op::and2 || op == simd_op::xor2 ) ? 2u : 3u;
+  }
+
+  /* assigns registers in a linear scan: the register of a value is released
+     after the last instruction that reads it and reused by the next result */
+  void allocate( simulation_program& program )
+  {
+    const auto num_values = num_inputs + static_cast<uint32_t>( instructions.size() );
+    const auto end = static_cast<uint32_t>( instructions.size() );
+
+    std::vector<uint32_t> last_use( num_values, unused );
+    for ( auto i = 0u; i < instructions.size(); ++i )
+    {
+      for ( auto j = 0u; j < arity( instructions[i].op ); ++j )
+      {
+        last_use[instructions[i].src[j].value] = i;
+      }
+    }
+    for ( auto const& o : outputs )
+    {
+      last_use[o.value] = end;
+    }
+
+    std::vector<uint32_t> registers( num_values, unused );
+    std::vector<uint32_t> free_registers;
+    auto& num_registers = program._num_registers;
+
+    const auto acquire = [&]() {
+      if ( free_registers.empty() )
+      {
+        return num_registers++;
+      }
+      const auto r = free_registers.back();
+      free_registers.pop_back();
+      return r;
+    };
+
+    /* inputs are written before the first instruction */
+    for ( auto v = 0u; v < num_inputs; ++v )
+    {
+      if ( last_use[v] != unused )
+      {
+        registers[v] = acquire();
+      }
+    }
+    program._constant_register = registers[0u];
+    program._pi_registers.assign( registers.begin() + 1u, registers.begin() + num_inputs );
+
+    program._instructions.reserve( instructions.size() );
+    for ( auto i = 0u; i < instructions.size(); ++i )
+    {
+      auto const& ins = instructions[i];
+      simulation_instruction compiled{ ins.op, 0u, 0u, {} };
+      for ( auto j = 0u; j < 3u; ++j )
+      {
+        compiled.src[j] = registers[ins.src[j].value];
+        compiled.complement |= ins.src[j].complement ? ( 1u << j ) : 0u;
+      }
+
+      /* the kernels read all sources before writing the result, such that
+         the result may take the register of a source that dies here */
+      for ( auto j = 0u; j < arity( ins.op ); ++j )
+      {
+        const auto v = ins.src[j].value;
+        if ( last_use[v] == i )
+        {
+          free_registers.push_back( registers[v] );
+          last_use[v] = unused;
+        }
+      }
+
+      const auto v = num_inputs + i;
+      compiled.dst = registers[v] = acquire();
+      if ( last_use[v] == unused )
+      {
+        free_registers.push_back( registers[v] );
+      }
+      program._instructions.push_back( compiled );
+    }
+
+    for ( auto const& o : outputs )
+    {
+      program._po_registers.push_back( registers[o.value] );
+      program._po_complements.push_back( o.complement );
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  compiled_simulation_stats& st;
+  bool all_gates;
+
+  uint32_t num_inputs{ 0u };
+  std::vector<operand> node_values;
+  std::vector<ssa_instruction> instructions;
+  std::vector<operand> outputs;
+  std::unordered_map<kitty::dynamic_truth_table, operand, kitty::hash<kitty::dynamic_truth_table>> function_cache;
+};
+
+} // namespace detail
+
+/*! \brief Compiles a network into a simulation program.
+ *
+ * Gates supported by the kernels of `simd_simulator` (AND, XOR, MAJ, XOR3,
+ * ITE) become one instruction each, any other gate is decomposed from its
+ * node function into multiplexers, such that also k-LUT networks can be
+ * compiled.  Only gates in the transitive fan-in of the POs are compiled.
+ * Gates are visited in the order of `foreach_gate`, which must be a
+ * topological order.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `get_node`
+ * - `node_to_index`
+ * - `is_complemented`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `node_function` (for gates not supported by the kernels)
+ *
+ * \param ntk Network
+ * \param pst Statistics
+ */
+template<class Ntk>
+simulation_program compile_simulation( Ntk const& ntk, compiled_simulation_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+
+  compiled_simulation_stats st;
+  detail::simulation_compiler<Ntk> compiler( ntk, st );
+  auto program = compiler.run();
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return program;
+}
+
+} // namespace mockturtle
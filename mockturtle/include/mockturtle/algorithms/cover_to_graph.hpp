@@ -161,17 +161,19 @@ public:
   {
     std::vector<signal<Ntk>> signals;
 
-    for ( auto j = 0u; j < Nde.children.size(); j++ )
+    const auto children = _cover_ntk._storage->fanins.begin() + Nde.fanin_offset;
+
+    for ( auto j = 0u; j < Nde.fanin_size; j++ )
     {
       if ( cb.get_mask( j ) == 1 )
       {
         if ( cb.get_bit( j ) == 1 )
         {
-          signals.emplace_back( ( is_sop ) ? _connector.signals[Nde.children[j].index] : !_connector.signals[Nde.children[j].index] );
+          signals.emplace_back( ( is_sop ) ? _connector.signals[children[j].index] : !_connector.signals[children[j].index] );
         }
         else
         {
-          signals.emplace_back( ( is_sop ) ? !_connector.signals[Nde.children[j].index] : _connector.signals[Nde.children[j].index] );
+          signals.emplace_back( ( is_sop ) ? !_connector.signals[children[j].index] : _connector.signals[children[j].index] );
         }
       }
     }
@@ -219,24 +221,24 @@ public:
     }
 
     /* convert the nodes */
-    for ( auto const& nde : _cover_ntk._storage->nodes )
+    for ( uint64_t index = 0u; index < _cover_ntk._storage->nodes.size(); ++index )
     {
-      uint64_t index = _cover_ntk._storage->hash[nde];
+      auto const& nde = _cover_ntk._storage->nodes[index];
       bool condition1 = ( std::find( _cover_ntk._storage->inputs.begin(), _cover_ntk._storage->inputs.end(), index ) != _cover_ntk._storage->inputs.end() );
       bool condition2 = nde.data[1].h1 == 0 || nde.data[1].h1 == 1;
 
       /* convert only the nodes that are neither inputs nor constants */
       if ( !condition1 && !condition2 )
       {
-        _connector.insert( convert_node_to_graph( nde ), _cover_ntk._storage->hash[nde] );
+        _connector.insert( convert_node_to_graph( nde ), index );
       } /* convert separately the constant 0 */
       else if ( nde.data[1].h1 == 0 )
       {
-        _connector.insert( _ntk.get_constant( false ), _cover_ntk._storage->hash[nde] );
+        _connector.insert( _ntk.get_constant( false ), index );
       } /* convert separately the constant 1 */
       else if ( nde.data[1].h1 == 1 )
       {
-        _connector.insert( _ntk.get_constant( true ), _cover_ntk._storage->hash[nde] );
+        _connector.insert( _ntk.get_constant( true ), index );
       }
     }
 
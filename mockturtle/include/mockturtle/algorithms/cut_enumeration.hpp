@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
@@ -48,14 +49,19 @@
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/bit_operations.hpp>
+#include <kitty/static_truth_table.hpp>
 
 #include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
 
 #include "../traits.hpp"
 #include "../utils/cuts.hpp"
 #include "../utils/mixed_radix.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../utils/truth_table_cache.hpp"
+#include "detail/truth_table6.hpp"
+#include "simulation.hpp"
 
 namespace mockturtle
 {
@@ -79,6 +85,18 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{ false };
 
+  /*! \brief Number of threads (0 uses the hardware concurrency).
+   *
+   * If set, the nodes are processed level by level and the nodes of one
+   * level are processed concurrently (only in `cut_enumeration` and
+   * `fast_cut_enumeration`).  The cuts, truth tables, and function ids do
+   * not depend on the number of threads, also for a single thread.  If not
+   * set, the nodes are processed in topological order by the calling
+   * thread, which results in the same cuts and truth tables, but may
+   * result in different function ids.
+   */
+  std::optional<uint32_t> num_threads{ std::nullopt };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 
@@ -120,8 +138,8 @@ struct cut_data<false, T>
   T data;
 };
 
-template<bool ComputeTruth, typename T>
-using cut_type = cut<max_cut_size, cut_data<ComputeTruth, T>>;
+template<bool ComputeTruth, typename T, int MaxLeaves = max_cut_size>
+using cut_type = cut<MaxLeaves, cut_data<ComputeTruth, T>>;
 
 /* forward declarations */
 /*! \cond PRIVATE */
@@ -148,6 +166,14 @@ struct cut_enumeration_update_cut
   }
 };
 
+/* whether cuts of nodes on the same level may be updated concurrently, which
+   requires that the update reads only the leaves of the cut and their cut
+   sets, but not the truth table of the cut */
+template<typename CutData>
+struct cut_enumeration_concurrent_update : std::true_type
+{
+};
+
 namespace detail
 {
 template<typename Ntk, bool ComputeTruth, typename CutData>
@@ -156,6 +182,9 @@ class cut_enumeration_impl;
 template<typename Ntk, bool ComputeTruth, typename CutData>
 class custom_cut_enumeration_impl;
 }
+
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class incremental_network_cuts;
 /*! \endcond */
 
 /*! \brief Cut database for a network.
@@ -265,6 +294,9 @@ private:
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> custom_cut_enumeration( _Ntk& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
 
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend class incremental_network_cuts;
+
 private:
   void add_zero_cut( uint32_t index )
   {
@@ -278,7 +310,12 @@ private:
 
   void add_unit_cut( uint32_t index )
   {
-    auto& cut = _cuts[index].add_cut( &index, &index + 1 );
+    add_unit_cut( _cuts[index], index );
+  }
+
+  void add_unit_cut( cut_set_t& set, uint32_t index )
+  {
+    auto& cut = set.add_cut( &index, &index + 1 );
 
     if constexpr ( ComputeTruth )
     {
@@ -302,12 +339,92 @@ private:
 namespace detail
 {
 
+/* indices of the gates grouped by level, in the order of `foreach_node`
+   within each level */
+template<typename Ntk>
+std::vector<std::vector<uint32_t>> cut_enumeration_levels( Ntk const& ntk )
+{
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  std::vector<std::vector<uint32_t>> gates;
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+    {
+      return;
+    }
+
+    uint32_t level{ 0u };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+    } );
+    if constexpr ( has_foreach_choice_v<Ntk> )
+    {
+      /* a representative takes the cuts of its alternatives */
+      ntk.foreach_choice( n, [&]( auto const& a ) {
+        level = std::max( level, levels[ntk.node_to_index( a )] );
+      } );
+    }
+
+    const auto index = ntk.node_to_index( n );
+    levels[index] = level + 1u;
+    if ( gates.size() <= level )
+    {
+      gates.resize( level + 1u );
+    }
+    gates[level].push_back( index );
+  } );
+  return gates;
+}
+
+/* adds the cuts of the alternatives of a representative in a choice
+   network, complementing their functions if the phases differ */
+template<bool ComputeTruth, typename CutData, typename Ntk, typename NetworkCuts, typename CutSet>
+void add_choice_cuts( Ntk const& ntk, NetworkCuts& cuts, uint32_t index, CutSet& rcuts )
+{
+  if constexpr ( has_foreach_choice_v<Ntk> )
+  {
+    ntk.foreach_choice( ntk.index_to_node( index ), [&]( auto const& a ) {
+      const auto a_index = ntk.node_to_index( a );
+      for ( auto const& cut : cuts.cuts( a_index ) )
+      {
+        /* ignore unit cut */
+        if ( cut->size() == 1u && *cut->begin() == a_index )
+        {
+          continue;
+        }
+
+        if ( rcuts.is_dominated( *cut ) )
+        {
+          continue;
+        }
+
+        typename CutSet::cut_t new_cut( *cut );
+        if constexpr ( ComputeTruth )
+        {
+          new_cut->func_id ^= ntk.get_choice_phase( a ) ? 1u : 0u;
+        }
+
+        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+
+        rcuts.insert( new_cut );
+      }
+    } );
+  }
+  else
+  {
+    (void)ntk;
+    (void)cuts;
+    (void)index;
+    (void)rcuts;
+  }
+}
+
 template<typename Ntk, bool ComputeTruth, typename CutData>
 class cut_enumeration_impl
 {
 public:
   using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using TT = kitty::dynamic_truth_table;
 
   explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -323,40 +440,331 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    if constexpr ( ComputeTruth )
+    {
+      if ( ps.cut_size <= 6u )
+      {
+        init_word_literals();
+      }
+    }
+
+    if ( ps.num_threads && cut_enumeration_concurrent_update<CutData>::value )
+    {
+      run_by_levels();
+    }
+    else
+    {
+      workers.resize( 1u );
+      ntk.foreach_node( [this]( auto node ) {
+        const auto index = ntk.node_to_index( node );
+
+        if ( ps.very_verbose )
+        {
+          std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+        }
 
-      if ( ps.very_verbose )
+        if ( ntk.is_constant( node ) )
+        {
+          cuts.add_zero_cut( index );
+        }
+        else if ( ntk.is_pi( node ) )
+        {
+          cuts.add_unit_cut( index );
+        }
+        else
+        {
+          compute_cuts( index, workers[0] );
+        }
+      } );
+    }
+
+    for ( auto const& w : workers )
+    {
+      cuts._total_tuples += static_cast<uint32_t>( w.total_tuples );
+      cuts._total_cuts += w.total_cuts;
+      st.time_truth_table += w.time_truth_table;
+    }
+  }
+
+  /* computes the cuts of a single node from the cuts of its fan-ins */
+  void compute_node( uint32_t index )
+  {
+    if ( workers.empty() )
+    {
+      workers.resize( 1u );
+      if constexpr ( ComputeTruth )
       {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+        if ( ps.cut_size <= 6u )
+        {
+          init_word_literals();
+        }
       }
+    }
+
+    const auto node = ntk.index_to_node( index );
+    cuts.cuts( index ).clear();
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      compute_cuts( index, workers[0] );
+    }
+  }
+
+private:
+  /* scratch data of a thread */
+  struct worker
+  {
+    std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+
+    /* cuts of the current node, which are copied into storage of their size */
+    cut_set_t scratch;
+
+    /* truth tables of the current level, which are added to the cache after the level */
+    std::vector<TT> pending;
+
+    /* gate operation of the current node for the word truth tables */
+    simd_op op{ simd_op::none };
+    std::array<uint64_t, 3> masks{};
+    std::vector<kitty::static_truth_table<6>> tts;
+
+    uint64_t total_tuples{ 0u };
+    std::size_t total_cuts{ 0u };
+    stopwatch<>::duration time_truth_table{ 0 };
+  };
+
+  static constexpr uint32_t pending_flag = UINT32_C( 1 ) << 31u;
+
+  /* nodes of one level are independent of each other and are processed
+     concurrently; truth tables are added to the cache in the order of the
+     nodes, such that the function ids do not depend on the number of
+     threads; they differ from the topological order, but the cuts and their
+     truth tables are the same */
+  void run_by_levels()
+  {
+    thread_pool pool( *ps.num_threads );
+    workers.resize( pool.num_threads() );
+    concurrent = true;
 
+    ntk.foreach_node( [this]( auto node ) {
       if ( ntk.is_constant( node ) )
       {
-        cuts.add_zero_cut( index );
+        cuts.add_zero_cut( ntk.node_to_index( node ) );
       }
       else if ( ntk.is_pi( node ) )
       {
-        cuts.add_unit_cut( index );
+        cuts.add_unit_cut( ntk.node_to_index( node ) );
       }
-      else
+    } );
+
+    std::vector<uint32_t> node_workers;
+    for ( auto const& level : cut_enumeration_levels( ntk ) )
+    {
+      node_workers.resize( level.size() );
+      pool.parallel_for( 0u, level.size(), 16u, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          node_workers[i] = thread;
+          compute_cuts( level[i], workers[thread] );
+        }
+      } );
+
+      if constexpr ( ComputeTruth )
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        for ( auto i = 0u; i < level.size(); ++i )
         {
-          merge_cuts2( index );
+          auto const& pending = workers[node_workers[i]].pending;
+          for ( auto& cut : cuts.cuts( level[i] ) )
+          {
+            if ( ( *cut )->func_id & pending_flag )
+            {
+              ( *cut )->func_id = cache_truth_table( pending[( *cut )->func_id & ~pending_flag] );
+            }
+          }
         }
-        else
+        for ( auto& w : workers )
         {
-          merge_cuts( index );
+          w.pending.clear();
         }
       }
+    }
+
+    concurrent = false;
+  }
+
+  void compute_cuts( uint32_t index, worker& w )
+  {
+    if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+    {
+      merge_cuts2( index, w );
+    }
+    else
+    {
+      merge_cuts( index, w );
+    }
+  }
+
+  uint32_t insert_truth_table( worker& w, TT const& tt )
+  {
+    if ( concurrent )
+    {
+      w.pending.push_back( tt );
+      return pending_flag | static_cast<uint32_t>( w.pending.size() - 1u );
+    }
+    return cache_truth_table( tt );
+  }
+
+  uint32_t cache_truth_table( TT const& tt )
+  {
+    const auto lit = cuts._truth_tables.insert( tt );
+    if ( word_truth_tables )
+    {
+      word_literals[tt.num_vars()].emplace( tt6_stretch( *cuts._truth_tables.normal( lit ).cbegin(), tt.num_vars() ), lit & ~1u );
+    }
+    return lit;
+  }
+
+  /* truth tables of cuts with up to 6 leaves are computed on single words,
+     which are looked up by their function before a truth table is created */
+  void init_word_literals()
+  {
+    word_truth_tables = true;
+    for ( auto i = 0u; i < cuts._truth_tables.size(); ++i )
+    {
+      auto const& tt = cuts._truth_tables.normal( 2u * i );
+      if ( tt.num_vars() <= 6u )
+      {
+        word_literals[tt.num_vars()].emplace( tt6_stretch( *tt.cbegin(), tt.num_vars() ), 2u * i );
+      }
+    }
+  }
+
+  void prepare_word_truth_tables( uint32_t index, worker& w )
+  {
+    const auto n = ntk.index_to_node( index );
+    w.op = simd_op_of( ntk, n );
+    w.masks = { 0u, 0u, 0u };
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      if ( static_cast<uint32_t>( i ) < 3u && ntk.is_complemented( f ) )
+      {
+        w.masks[i] = ~UINT64_C( 0 );
+      }
     } );
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t insert_word_truth_table( worker& w, uint64_t word, uint32_t num_vars )
   {
-    stopwatch t( st.time_truth_table );
+    const auto normal = ( word & 1u ) ? ~word : word;
+    auto const& literals = word_literals[num_vars];
+    if ( const auto it = literals.find( normal ); it != literals.end() )
+    {
+      return it->second | static_cast<uint32_t>( word & 1u );
+    }
+
+    TT tt( num_vars );
+    *tt.begin() = word;
+    tt.mask_bits();
+    return insert_truth_table( w, tt );
+  }
+
+  uint32_t compute_word_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker& w )
+  {
+    stopwatch t( w.time_truth_table );
+
+    std::array<uint64_t, 3> words;
+    if ( w.op == simd_op::none )
+    {
+      w.tts.resize( vcuts.size() );
+    }
+
+    auto i = 0u;
+    for ( auto const& cut : vcuts )
+    {
+      const auto lit = ( *cut )->func_id;
+      auto const& tt = cuts._truth_tables.normal( lit );
+      auto word = tt6_stretch( *tt.cbegin(), tt.num_vars() ) ^ ( ( lit & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+
+      /* positions of the leaves in `res`, both are sorted */
+      std::array<uint8_t, 6> pos;
+      auto it = res.begin();
+      auto k = 0u;
+      for ( auto leaf : *cut )
+      {
+        while ( *it != leaf )
+        {
+          ++it;
+        }
+        pos[k++] = static_cast<uint8_t>( it - res.begin() );
+      }
+      word = tt6_expand( word, pos.data(), k );
+
+      if ( w.op == simd_op::none )
+      {
+        *w.tts[i].begin() = word;
+      }
+      else
+      {
+        words[i] = word ^ w.masks[i];
+      }
+      ++i;
+    }
+
+    uint64_t word;
+    switch ( w.op )
+    {
+    case simd_op::and2:
+      word = words[0] & words[1];
+      break;
+    case simd_op::xor2:
+      word = words[0] ^ words[1];
+      break;
+    case simd_op::maj3:
+      word = ( words[0] & words[1] ) | ( words[2] & ( words[0] | words[1] ) );
+      break;
+    case simd_op::xor3:
+      word = words[0] ^ words[1] ^ words[2];
+      break;
+    case simd_op::ite3:
+      word = ( words[0] & words[1] ) | ( ~words[0] & words[2] );
+      break;
+    default:
+      word = *ntk.compute( ntk.index_to_node( index ), w.tts.begin(), w.tts.end() ).cbegin();
+      break;
+    }
+
+    if ( ps.minimize_truth_table )
+    {
+      std::array<uint8_t, 6> support;
+      const auto num_vars = tt6_min_base( word, res.size(), support.data() );
+      if ( num_vars != res.size() )
+      {
+        std::array<uint32_t, 6> leaves;
+        for ( auto k = 0u; k < num_vars; ++k )
+        {
+          leaves[k] = res.begin()[support[k]];
+        }
+        res.set_leaves( leaves.begin(), leaves.begin() + num_vars );
+        return insert_word_truth_table( w, word, num_vars );
+      }
+    }
+
+    return insert_word_truth_table( w, word, res.size() );
+  }
+
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, worker& w )
+  {
+    if ( word_truth_tables )
+    {
+      return compute_word_truth_table( index, vcuts, res, w );
+    }
+
+    stopwatch t( w.time_truth_table );
 
     std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
     auto i = 0;
@@ -386,34 +794,39 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return insert_truth_table( w, tt_res_shrink );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return insert_truth_table( w, tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker& w )
   {
     const auto fanin = 2;
 
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      pairs *= static_cast<uint32_t>( lcuts[i]->size() );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
+      w.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      pairs *= static_cast<uint32_t>( w.lcuts[i]->size() );
     } );
-    lcuts[2] = &cuts.cuts( index );
-    auto& rcuts = *lcuts[fanin];
+    w.lcuts[2] = &w.scratch;
+    auto& rcuts = *w.lcuts[fanin];
     rcuts.clear();
 
+    if ( word_truth_tables )
+    {
+      prepare_word_truth_tables( index, w );
+    }
+
     cut_t new_cut;
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
-    for ( auto const& c1 : *lcuts[0] )
+    w.total_tuples += pairs;
+    for ( auto const& c1 : *w.lcuts[0] )
     {
-      for ( auto const& c2 : *lcuts[1] )
+      for ( auto const& c2 : *w.lcuts[1] )
       {
         if ( !c1->merge( *c2, new_cut, ps.cut_size ) )
         {
@@ -429,7 +842,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -438,47 +851,55 @@ private:
       }
     }
 
+    add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    w.total_cuts += rcuts.size();
 
-    if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
+    if ( rcuts.size() != 1 || ( *rcuts.begin() )->size() > 1 )
     {
-      cuts.add_unit_cut( index );
+      cuts.add_unit_cut( rcuts, index );
     }
+
+    cuts.cuts( index ) = rcuts;
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker& w )
   {
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
+      w.lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      cut_sizes.push_back( static_cast<uint32_t>( w.lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
     } );
 
     const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
+    w.lcuts[fanin] = &w.scratch;
 
-    auto& rcuts = *lcuts[fanin];
+    auto& rcuts = *w.lcuts[fanin];
+    rcuts.clear();
 
-    if ( fanin > 1 && fanin <= ps.fanin_limit )
+    if ( word_truth_tables )
     {
-      rcuts.clear();
+      prepare_word_truth_tables( index, w );
+    }
 
+    if ( fanin > 1 && fanin <= ps.fanin_limit )
+    {
       cut_t new_cut, tmp_cut;
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      w.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
         while ( begin != end )
         {
-          *it++ = &( ( *lcuts[i++] )[*begin++] );
+          *it++ = &( ( *w.lcuts[i++] )[*begin++] );
         }
 
         if ( !vcuts[0]->merge( *vcuts[1], new_cut, ps.cut_size ) )
@@ -502,7 +923,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -512,20 +933,20 @@ private:
         return true;
       } );
 
+      add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
       /* limit the maximum number of cuts */
       rcuts.limit( ps.cut_limit - 1 );
     }
     else if ( fanin == 1 )
     {
-      rcuts.clear();
-
-      for ( auto const& cut : *lcuts[0] )
+      for ( auto const& cut : *w.lcuts[0] )
       {
         cut_t new_cut = *cut;
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -533,13 +954,16 @@ private:
         rcuts.insert( new_cut );
       }
 
+      add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
       /* limit the maximum number of cuts */
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    w.total_cuts += static_cast<uint32_t>( rcuts.size() );
 
-    cuts.add_unit_cut( index );
+    cuts.add_unit_cut( rcuts, index );
+    cuts.cuts( index ) = rcuts;
   }
 
 private:
@@ -548,7 +972,11 @@ private:
   cut_enumeration_stats& st;
   network_cuts<Ntk, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  std::vector<worker> workers;
+  bool concurrent{ false };
+
+  bool word_truth_tables{ false };
+  std::array<phmap::flat_hash_map<uint64_t, uint32_t>, 7> word_literals;
 };
 
 template<typename Ntk, bool ComputeTruth, typename CutData>
@@ -748,10 +1176,12 @@ private:
       unique.emplace( c->data.hash, kitty::get_bit( cuts.truth_table( c ), 0 ) ? !v : v );
     }
 
-    if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
+    if ( rcuts.size() != 1 || ( *rcuts.begin() )->size() > 1 )
     {
       cuts.add_unit_cut( index );
     }
+
+    rcuts.shrink_to_fit();
   }
 
   void merge_cuts( uint32_t index )
@@ -845,6 +1275,7 @@ private:
     cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
+    rcuts.shrink_to_fit();
   }
 
 private:
@@ -869,6 +1300,8 @@ private:
  * traverses all nodes in topological order and computes a node's cuts based
  * on its fanins' cuts.  Dominated cuts are filtered and are not added to the
  * cut set.  For each node a unit cut is added to the end of each cut set.
+ * In a choice network (see `choice_view`), the cuts of the alternatives of
+ * a node are added to the cuts of the node.
  *
  * The template parameter `ComputeTruth` controls whether truth tables should
  * be computed for each cut.  Computing truth tables slows down the execution
@@ -991,7 +1424,10 @@ class fast_cut_enumeration_impl;
  * node, or the function of a cut (if it was computed).
  *
  * Comparing to `network_cuts`, it uses static truth tables instead of
- * dynamic truth tables to speed-up the truth table computation.
+ * dynamic truth tables to speed-up the truth table computation.  The cuts
+ * of a node are stored contiguously with 16-bit or 32-bit leaves once they
+ * are final (see `compact_cut_set`), such that the cut sets can be read and
+ * the data of the cuts can be modified, but no cuts can be inserted.
  *
  * An instance of type `fast_network_cuts` can only be constructed from the
  * `fast_cut_enumeration` algorithm.
@@ -1001,12 +1437,16 @@ struct fast_network_cuts
 {
 public:
   static constexpr uint32_t max_cut_num = 50;
-  using cut_t = cut_type<ComputeTruth, CutData>;
-  using cut_set_t = cut_set<cut_t, max_cut_num>;
+  using cut_t = compact_cut<cut_data<ComputeTruth, CutData>>;
+  using cut_set_t = compact_cut_set<cut_t, max_cut_num>;
   static constexpr bool compute_truth = ComputeTruth;
 
 private:
-  explicit fast_network_cuts( uint32_t size ) : _cuts( size )
+  /* cuts of a node while they are computed */
+  using enumeration_cut_t = cut_type<ComputeTruth, CutData, NumVars>;
+  using enumeration_cut_set_t = cut_set<enumeration_cut_t, max_cut_num>;
+
+  explicit fast_network_cuts( uint32_t size ) : _cuts( size ), _arenas( 1u )
   {
     kitty::static_truth_table<NumVars> zero, proj;
     kitty::create_nth_var( proj, 0u );
@@ -1047,13 +1487,25 @@ public:
     return _cuts.size();
   }
 
+  /*! \brief Returns the number of bytes allocated for the cut sets */
+  std::size_t num_bytes() const
+  {
+    auto bytes = _cuts.size() * sizeof( cut_set_t );
+    for ( auto const& arena : _arenas )
+    {
+      bytes += arena.capacity();
+    }
+    return bytes;
+  }
+
   /* compute positions of leave indices in cut `sub` (subset) with respect to
    * leaves in cut `sup` (super set).
    *
    * Example:
    *   compute_truth_table_support( {1, 3, 6}, {0, 1, 2, 3, 6, 7} ) = {1, 3, 4}
    */
-  std::vector<uint8_t> compute_truth_table_support( cut_t const& sub, cut_t const& sup ) const
+  template<typename Cut>
+  std::vector<uint8_t> compute_truth_table_support( Cut const& sub, enumeration_cut_t const& sup ) const
   {
     std::vector<uint8_t> support;
     support.reserve( sub.size() );
@@ -1091,17 +1543,28 @@ private:
 private:
   void add_zero_cut( uint32_t index )
   {
-    auto& cut = _cuts[index].add_cut( &index, &index ); /* fake iterator for emptyness */
+    enumeration_cut_t cut;
+    cut.set_leaves( &index, &index ); /* fake iterator for emptyness */
 
     if constexpr ( ComputeTruth )
     {
       cut->func_id = 0;
     }
+
+    enumeration_cut_t const* pcut = &cut;
+    _cuts[index].assign( &pcut, &pcut + 1, _arenas.front() );
   }
 
   void add_unit_cut( uint32_t index )
   {
-    auto& cut = _cuts[index].add_cut( &index, &index + 1 );
+    enumeration_cut_set_t set;
+    add_unit_cut( set, index );
+    _cuts[index].assign( set.begin(), set.end(), _arenas.front() );
+  }
+
+  void add_unit_cut( enumeration_cut_set_t& set, uint32_t index )
+  {
+    auto& cut = set.add_cut( &index, &index + 1 );
 
     if constexpr ( ComputeTruth )
     {
@@ -1113,6 +1576,9 @@ private:
   /* compressed representation of cuts */
   std::vector<cut_set_t> _cuts;
 
+  /* memory of the cut sets, one arena for each thread */
+  std::vector<cut_arena> _arenas;
+
   /* cut truth tables */
   truth_table_cache<kitty::static_truth_table<NumVars>> _truth_tables;
 
@@ -1131,6 +1597,9 @@ class fast_cut_enumeration_impl
 public:
   using cut_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_set_t;
+  using enumeration_cut_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::enumeration_cut_t;
+  using enumeration_cut_set_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::enumeration_cut_set_t;
+  using TT = kitty::static_truth_table<NumVars>;
 
   explicit fast_cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -1146,40 +1615,169 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    if ( ps.num_threads && cut_enumeration_concurrent_update<CutData>::value )
+    {
+      run_by_levels();
+    }
+    else
+    {
+      workers.resize( 1u );
+      workers[0].arena = &cuts._arenas[0];
+      ntk.foreach_node( [this]( auto node ) {
+        const auto index = ntk.node_to_index( node );
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+        if ( ps.very_verbose )
+        {
+          std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+        }
+
+        if ( ntk.is_constant( node ) )
+        {
+          cuts.add_zero_cut( index );
+        }
+        else if ( ntk.is_pi( node ) )
+        {
+          cuts.add_unit_cut( index );
+        }
+        else
+        {
+          compute_cuts( index, workers[0] );
+        }
+      } );
+    }
+
+    for ( auto const& w : workers )
+    {
+      cuts._total_tuples += static_cast<uint32_t>( w.total_tuples );
+      cuts._total_cuts += w.total_cuts;
+      st.time_truth_table += w.time_truth_table;
+    }
+  }
+
+private:
+  /* scratch data of a thread */
+  struct worker
+  {
+    /* cut sets of the fanins, and the signatures of their cuts, which are
+       computed once for each node instead of once for each merge */
+    std::vector<cut_set_t const*> lcuts;
+    std::vector<std::vector<uint64_t>> signatures;
+
+    /* cuts of the current node, which are copied into the arena of the thread */
+    enumeration_cut_set_t scratch;
+    cut_arena* arena{ nullptr };
+
+    /* truth tables of the current level, which are added to the cache after the level */
+    std::vector<TT> pending;
+
+    uint64_t total_tuples{ 0u };
+    std::size_t total_cuts{ 0u };
+    stopwatch<>::duration time_truth_table{ 0 };
+  };
+
+  static constexpr uint32_t pending_flag = UINT32_C( 1 ) << 31u;
+
+  /* nodes of one level are independent of each other and are processed
+     concurrently; truth tables are added to the cache in the order of the
+     nodes, such that the function ids do not depend on the number of
+     threads; they differ from the topological order, but the cuts and their
+     truth tables are the same */
+  void run_by_levels()
+  {
+    thread_pool pool( *ps.num_threads );
+    workers.resize( pool.num_threads() );
+    cuts._arenas.resize( workers.size() );
+    for ( auto i = 0u; i < workers.size(); ++i )
+    {
+      workers[i].arena = &cuts._arenas[i];
+    }
+    concurrent = true;
 
+    ntk.foreach_node( [this]( auto node ) {
       if ( ntk.is_constant( node ) )
       {
-        cuts.add_zero_cut( index );
+        cuts.add_zero_cut( ntk.node_to_index( node ) );
       }
       else if ( ntk.is_pi( node ) )
       {
-        cuts.add_unit_cut( index );
+        cuts.add_unit_cut( ntk.node_to_index( node ) );
       }
-      else
+    } );
+
+    std::vector<uint32_t> node_workers;
+    for ( auto const& level : cut_enumeration_levels( ntk ) )
+    {
+      node_workers.resize( level.size() );
+      pool.parallel_for( 0u, level.size(), 16u, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          node_workers[i] = thread;
+          compute_cuts( level[i], workers[thread] );
+        }
+      } );
+
+      if constexpr ( ComputeTruth )
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        for ( auto i = 0u; i < level.size(); ++i )
         {
-          merge_cuts2( index );
+          auto const& pending = workers[node_workers[i]].pending;
+          for ( auto* cut : cuts.cuts( level[i] ) )
+          {
+            if ( ( *cut )->func_id & pending_flag )
+            {
+              ( *cut )->func_id = cuts._truth_tables.insert( pending[( *cut )->func_id & ~pending_flag] );
+            }
+          }
         }
-        else
+        for ( auto& w : workers )
         {
-          merge_cuts( index );
+          w.pending.clear();
         }
       }
-    } );
+    }
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  void compute_cuts( uint32_t index, worker& w )
   {
-    stopwatch t( st.time_truth_table );
+    if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+    {
+      merge_cuts2( index, w );
+    }
+    else
+    {
+      merge_cuts( index, w );
+    }
+  }
+
+  uint32_t insert_truth_table( worker& w, TT const& tt )
+  {
+    if ( concurrent )
+    {
+      w.pending.push_back( tt );
+      return pending_flag | static_cast<uint32_t>( w.pending.size() - 1u );
+    }
+    return cuts._truth_tables.insert( tt );
+  }
+
+  void load_cuts( worker& w, uint32_t i, uint32_t fanin_index )
+  {
+    if ( w.lcuts.size() <= i )
+    {
+      w.lcuts.resize( i + 1u );
+      w.signatures.resize( i + 1u );
+    }
+    w.lcuts[i] = &cuts.cuts( fanin_index );
+    auto& signatures = w.signatures[i];
+    signatures.clear();
+    for ( auto const* cut : *w.lcuts[i] )
+    {
+      signatures.push_back( cut->signature() );
+    }
+  }
+
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, enumeration_cut_t& res, worker& w )
+  {
+    stopwatch t( w.time_truth_table );
 
     std::vector<kitty::static_truth_table<NumVars>> tt( vcuts.size() );
     auto i = 0;
@@ -1211,32 +1809,36 @@ private:
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return insert_truth_table( w, tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, worker& w )
   {
     const auto fanin = 2;
 
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      pairs *= static_cast<uint32_t>( lcuts[i]->size() );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
+      load_cuts( w, i, ntk.node_to_index( ntk.get_node( child ) ) );
+      pairs *= static_cast<uint32_t>( w.lcuts[i]->size() );
     } );
-    lcuts[2] = &cuts.cuts( index );
-    auto& rcuts = *lcuts[fanin];
+    auto& rcuts = w.scratch;
     rcuts.clear();
 
-    cut_t new_cut;
+    enumeration_cut_t new_cut;
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
-    for ( auto const& c1 : *lcuts[0] )
+    w.total_tuples += pairs;
+    auto const& signatures1 = w.signatures[0];
+    auto const& signatures2 = w.signatures[1];
+    auto i1 = 0u;
+    for ( auto const* c1 : *w.lcuts[0] )
     {
-      for ( auto const& c2 : *lcuts[1] )
+      const auto signature1 = signatures1[i1++];
+      auto i2 = 0u;
+      for ( auto const* c2 : *w.lcuts[1] )
       {
-        if ( !c1->merge( *c2, new_cut, NumVars ) )
+        if ( !new_cut.set_union( *c1, signature1, *c2, signatures2[i2++], NumVars ) )
         {
           continue;
         }
@@ -1250,7 +1852,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -1259,50 +1861,53 @@ private:
       }
     }
 
+    add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    w.total_cuts += rcuts.size();
 
-    if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
+    if ( rcuts.size() != 1 || ( *rcuts.begin() )->size() > 1 )
     {
-      cuts.add_unit_cut( index );
+      cuts.add_unit_cut( rcuts, index );
     }
+
+    cuts.cuts( index ).assign( rcuts.begin(), rcuts.end(), *w.arena );
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, worker& w )
   {
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
+      load_cuts( w, i, ntk.node_to_index( ntk.get_node( child ) ) );
+      cut_sizes.push_back( static_cast<uint32_t>( w.lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
     } );
 
     const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
-
-    auto& rcuts = *lcuts[fanin];
+    auto& rcuts = w.scratch;
+    rcuts.clear();
 
     if ( fanin > 1 && fanin <= ps.fanin_limit )
     {
-      rcuts.clear();
-
-      cut_t new_cut, tmp_cut;
+      enumeration_cut_t new_cut, tmp_cut;
 
       std::vector<cut_t const*> vcuts( fanin );
+      std::vector<uint64_t> vsignatures( fanin );
 
-      cuts._total_tuples += pairs;
+      w.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
-        auto it = vcuts.begin();
         auto i = 0u;
         while ( begin != end )
         {
-          *it++ = &( ( *lcuts[i++] )[*begin++] );
+          vcuts[i] = &( *w.lcuts[i] )[*begin];
+          vsignatures[i] = w.signatures[i][*begin++];
+          ++i;
         }
 
-        if ( !vcuts[0]->merge( *vcuts[1], new_cut, NumVars ) )
+        if ( !new_cut.set_union( *vcuts[0], vsignatures[0], *vcuts[1], vsignatures[1], NumVars ) )
         {
           return true; /* continue */
         }
@@ -1310,7 +1915,7 @@ private:
         for ( i = 2; i < fanin; ++i )
         {
           tmp_cut = new_cut;
-          if ( !vcuts[i]->merge( tmp_cut, new_cut, NumVars ) )
+          if ( !new_cut.set_union( *vcuts[i], vsignatures[i], tmp_cut, tmp_cut.signature(), NumVars ) )
           {
             return true; /* continue */
           }
@@ -1323,7 +1928,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -1333,20 +1938,20 @@ private:
         return true;
       } );
 
+      add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
       /* limit the maximum number of cuts */
       rcuts.limit( ps.cut_limit - 1 );
     }
     else if ( fanin == 1 )
     {
-      rcuts.clear();
-
-      for ( auto const& cut : *lcuts[0] )
+      for ( auto const* cut : *w.lcuts[0] )
       {
-        cut_t new_cut = *cut;
+        enumeration_cut_t new_cut( *cut );
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut, w );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -1354,13 +1959,16 @@ private:
         rcuts.insert( new_cut );
       }
 
+      add_choice_cuts<ComputeTruth, CutData>( ntk, cuts, index, rcuts );
+
       /* limit the maximum number of cuts */
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    w.total_cuts += static_cast<uint32_t>( rcuts.size() );
 
-    cuts.add_unit_cut( index );
+    cuts.add_unit_cut( rcuts, index );
+    cuts.cuts( index ).assign( rcuts.begin(), rcuts.end(), *w.arena );
   }
 
 private:
@@ -1369,7 +1977,8 @@ private:
   cut_enumeration_stats& st;
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  std::vector<worker> workers;
+  bool concurrent{ false };
 };
 } /* namespace detail */
 /*! \endcond */
@@ -1380,6 +1989,8 @@ private:
  * traverses all nodes in topological order and computes a node's cuts based
  * on its fanins' cuts.  Dominated cuts are filtered and are not added to the
  * cut set.  For each node a unit cut is added to the end of each cut set.
+ * In a choice network (see `choice_view`), the cuts of the alternatives of
+ * a node are added to the cuts of the node.
  *
  * The template parameter `ComputeTruth` controls whether truth tables should
  * be computed for each cut.  Computing truth tables slows down the execution
@@ -58,8 +58,8 @@ struct cut_enumeration_cnf_cut
   float cost{ 0 };
 };
 
-template<bool ComputeTruth>
-bool operator<( cut_type<ComputeTruth, cut_enumeration_cnf_cut> const& c1, cut_type<ComputeTruth, cut_enumeration_cnf_cut> const& c2 )
+template<bool ComputeTruth, int MaxLeaves>
+bool operator<( cut_type<ComputeTruth, cut_enumeration_cnf_cut, MaxLeaves> const& c1, cut_type<ComputeTruth, cut_enumeration_cnf_cut, MaxLeaves> const& c2 )
 {
   constexpr auto eps{ 0.005f };
   if ( c1->data.flow < c2->data.flow - eps )
@@ -97,6 +97,12 @@ struct cut_enumeration_update_cut<cut_enumeration_cnf_cut>
   }
 };
 
+/* the update reads the truth table of the cut */
+template<>
+struct cut_enumeration_concurrent_update<cut_enumeration_cnf_cut> : std::false_type
+{
+};
+
 template<int MaxLeaves>
 std::ostream& operator<<( std::ostream& os, cut<MaxLeaves, cut_data<false, cut_enumeration_cnf_cut>> const& c )
 {
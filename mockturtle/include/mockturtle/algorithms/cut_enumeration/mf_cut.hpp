@@ -54,8 +54,8 @@ struct cut_enumeration_mf_cut
   float cost{ 0 };
 };
 
-template<bool ComputeTruth>
-bool operator<( cut_type<ComputeTruth, cut_enumeration_mf_cut> const& c1, cut_type<ComputeTruth, cut_enumeration_mf_cut> const& c2 )
+template<bool ComputeTruth, int MaxLeaves>
+bool operator<( cut_type<ComputeTruth, cut_enumeration_mf_cut, MaxLeaves> const& c1, cut_type<ComputeTruth, cut_enumeration_mf_cut, MaxLeaves> const& c2 )
 {
   constexpr auto eps{ 0.005f };
   if ( c1->data.flow < c2->data.flow - eps )
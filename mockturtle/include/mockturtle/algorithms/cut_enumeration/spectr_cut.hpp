@@ -64,8 +64,8 @@ struct cut_enumeration_spectr_cut
   float cost{ 0.0f };
 };
 
-template<bool ComputeTruth>
-bool operator<( cut_type<ComputeTruth, cut_enumeration_spectr_cut> const& c1, cut_type<ComputeTruth, cut_enumeration_spectr_cut> const& c2 )
+template<bool ComputeTruth, int MaxLeaves>
+bool operator<( cut_type<ComputeTruth, cut_enumeration_spectr_cut, MaxLeaves> const& c1, cut_type<ComputeTruth, cut_enumeration_spectr_cut, MaxLeaves> const& c2 )
 {
   constexpr auto eps{ 0.005f };
 
@@ -185,6 +185,12 @@ struct cut_enumeration_update_cut<cut_enumeration_spectr_cut>
   }
 };
 
+/* the update reads the truth table of the cut */
+template<>
+struct cut_enumeration_concurrent_update<cut_enumeration_spectr_cut> : std::false_type
+{
+};
+
 template<int MaxLeaves>
 std::ostream& operator<<( std::ostream& os, cut<MaxLeaves, cut_data<false, cut_enumeration_spectr_cut>> const& c )
 {
@@ -0,0 +1,279 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simd_kernels.hpp
+  \brief Vectorized kernels for bit-parallel simulation
+
+  The kernels compute AND, XOR, majority, and if-then-else of up to three
+  word arrays with complemented inputs in place.  They are compiled for
+  256-bit (AVX2) and 512-bit (AVX-512) vectors using GCC vector extensions
+  and the instruction set is selected at runtime.  Other compilers and
+  platforms use the portable 64-bit implementation.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define MOCKTURTLE_SIMD_X86 1
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Instruction set used by the simulation kernels. */
+enum class simd_level : uint8_t
+{
+  scalar,
+  avx2,
+  avx512
+};
+
+/*! \brief Widest instruction set supported by the CPU. */
+inline simd_level simd_supported_level()
+{
+#if defined( MOCKTURTLE_SIMD_X86 )
+  static const simd_level level = []() {
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx512f" ) )
+    {
+      return simd_level::avx512;
+    }
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+      return simd_level::avx2;
+    }
+    return simd_level::scalar;
+  }();
+  return level;
+#else
+  return simd_level::scalar;
+#endif
+}
+
+namespace detail
+{
+
+/*! \brief Gate operations of the simulation kernels. */
+enum class simd_op : uint8_t
+{
+  none,  /* not supported by the kernels */
+  and2,  /* a & b */
+  xor2,  /* a ^ b */
+  maj3,  /* <a, b, c> */
+  xor3,  /* a ^ b ^ c */
+  ite3   /* a ? b : c */
+};
+
+/* computes words [begin, end) of `op` over the fan-in words, which are
+   complemented according to `masks`; all pointers may alias */
+using simd_kernel = void ( * )( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end );
+
+#if defined( MOCKTURTLE_SIMD_X86 )
+#define MOCKTURTLE_SIMD_INLINE __attribute__( ( always_inline ) ) inline
+#else
+#define MOCKTURTLE_SIMD_INLINE inline
+#endif
+
+/* `V` is either `uint64_t` or a GCC vector of `uint64_t` */
+template<typename V, simd_op Op>
+MOCKTURTLE_SIMD_INLINE void simd_loop( uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  constexpr uint64_t lanes = sizeof( V ) / sizeof( uint64_t );
+
+  const V ma = V{} + masks[0];
+  const V mb = V{} + masks[1];
+  const V mc = V{} + masks[2];
+
+  auto const* a = fanins[0];
+  auto const* b = fanins[1];
+  auto const* c = fanins[2];
+
+  for ( auto i = begin; i < end; i += lanes )
+  {
+    V x, y, z, res;
+    std::memcpy( &x, a + i, sizeof( V ) );
+    std::memcpy( &y, b + i, sizeof( V ) );
+    x ^= ma;
+    y ^= mb;
+    if constexpr ( Op == simd_op::and2 )
+    {
+      res = x & y;
+    }
+    else if constexpr ( Op == simd_op::xor2 )
+    {
+      res = x ^ y;
+    }
+    else
+    {
+      std::memcpy( &z, c + i, sizeof( V ) );
+      z ^= mc;
+      if constexpr ( Op == simd_op::maj3 )
+      {
+        res = ( x & y ) | ( z & ( x | y ) );
+      }
+      else if constexpr ( Op == simd_op::xor3 )
+      {
+        res = x ^ y ^ z;
+      }
+      else
+      {
+        res = ( x & y ) | ( ~x & z );
+      }
+    }
+    std::memcpy( r + i, &res, sizeof( V ) );
+  }
+}
+
+template<typename V>
+MOCKTURTLE_SIMD_INLINE void simd_dispatch( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  switch ( op )
+  {
+  case simd_op::and2:
+    simd_loop<V, simd_op::and2>( r, fanins, masks, begin, end );
+    break;
+  case simd_op::xor2:
+    simd_loop<V, simd_op::xor2>( r, fanins, masks, begin, end );
+    break;
+  case simd_op::maj3:
+    simd_loop<V, simd_op::maj3>( r, fanins, masks, begin, end );
+    break;
+  case simd_op::xor3:
+    simd_loop<V, simd_op::xor3>( r, fanins, masks, begin, end );
+    break;
+  case simd_op::ite3:
+    simd_loop<V, simd_op::ite3>( r, fanins, masks, begin, end );
+    break;
+  default:
+    assert( false );
+    break;
+  }
+}
+
+inline void simd_compute_scalar( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  simd_dispatch<uint64_t>( op, r, fanins, masks, begin, end );
+}
+
+template<typename V>
+MOCKTURTLE_SIMD_INLINE void simd_compute( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  constexpr uint64_t lanes = sizeof( V ) / sizeof( uint64_t );
+  const auto vector_end = begin + ( end - begin ) / lanes * lanes;
+  simd_dispatch<V>( op, r, fanins, masks, begin, vector_end );
+  simd_dispatch<uint64_t>( op, r, fanins, masks, vector_end, end );
+}
+
+#if defined( MOCKTURTLE_SIMD_X86 )
+__attribute__( ( target( "avx2" ) ) ) inline void simd_compute_avx2( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  typedef uint64_t avx2_vector __attribute__( ( vector_size( 32 ) ) );
+  simd_compute<avx2_vector>( op, r, fanins, masks, begin, end );
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline void simd_compute_avx512( simd_op op, uint64_t* r, uint64_t const* const* fanins, uint64_t const* masks, uint64_t begin, uint64_t end )
+{
+  typedef uint64_t avx512_vector __attribute__( ( vector_size( 64 ) ) );
+  simd_compute<avx512_vector>( op, r, fanins, masks, begin, end );
+}
+#endif
+
+/*! \brief Kernel for an instruction set, which must be supported by the CPU. */
+inline simd_kernel simd_kernel_for( simd_level level )
+{
+  assert( level <= simd_supported_level() );
+#if defined( MOCKTURTLE_SIMD_X86 )
+  switch ( level )
+  {
+  case simd_level::avx512:
+    return &simd_compute_avx512;
+  case simd_level::avx2:
+    return &simd_compute_avx2;
+  default:
+    break;
+  }
+#endif
+  (void)level;
+  return &simd_compute_scalar;
+}
+
+/*! \brief Words of simulation values for all nodes in one aligned block.
+ *
+ * Each row holds `num_words` words and starts at a 64-byte boundary.
+ */
+class simd_arena
+{
+public:
+  static constexpr uint64_t alignment = 64u;
+
+  simd_arena( uint64_t num_rows, uint64_t num_words )
+      : _num_words( num_words ),
+        _stride( ( num_words + alignment / sizeof( uint64_t ) - 1u ) / ( alignment / sizeof( uint64_t ) ) * ( alignment / sizeof( uint64_t ) ) ),
+        _data( static_cast<uint64_t*>( ::operator new[]( std::max<uint64_t>( num_rows * _stride, 1u ) * sizeof( uint64_t ), std::align_val_t{ alignment } ) ) )
+  {
+  }
+
+  uint64_t* row( uint64_t index )
+  {
+    return _data.get() + index * _stride;
+  }
+
+  uint64_t const* row( uint64_t index ) const
+  {
+    return _data.get() + index * _stride;
+  }
+
+  uint64_t num_words() const
+  {
+    return _num_words;
+  }
+
+private:
+  struct aligned_delete
+  {
+    void operator()( uint64_t* p ) const
+    {
+      ::operator delete[]( p, std::align_val_t{ alignment } );
+    }
+  };
+
+  uint64_t _num_words;
+  uint64_t _stride;
+  std::unique_ptr<uint64_t[], aligned_delete> _data;
+};
+
+} // namespace detail
+
+} // namespace mockturtle
+
+#undef MOCKTURTLE_SIMD_INLINE
@@ -32,12 +32,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
-#include "../simulation.hpp"
-
-#include <kitty/bit_operations.hpp>
-#include <kitty/partial_truth_table.hpp>
+#include "../activity_estimation.hpp"
 
 namespace mockturtle::detail
 {
@@ -47,24 +45,25 @@ namespace mockturtle::detail
  * This function computes the switching activity for each node
  * in the network by performing random simulation.
  *
+ * For sequential networks with registers, the activity is the measured
+ * toggle rate over `simulation_size / 256` consecutive clock cycles of 256
+ * parallel traces (see `simulate_sequential`), which takes the temporal
+ * correlation through the registers into account.  Otherwise, it is the
+ * rate of toggles between `simulation_size` independent random patterns,
+ * which are counted in blocks without storing the values of all nodes (see
+ * `activity_estimator`).
+ *
  * \param ntk Network
  * \param simulation_size Number of simulation bits
+ * \param num_threads Number of simulation threads (0 uses the hardware concurrency)
  */
 template<typename Ntk>
-std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
+std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048, uint32_t num_threads = 1u )
 {
-  std::vector<float> sw_map( ntk.size() );
-  partial_simulator sim( ntk.num_pis(), simulation_size );
-
-  auto tts = simulate_nodes<kitty::partial_truth_table, Ntk, partial_simulator>( ntk, sim );
-
-  ntk.foreach_node( [&]( auto const& n ) {
-    float ones = static_cast<float>( kitty::count_ones( tts[n] ) );
-    float activity = 2.0 * ones / simulation_size * ( simulation_size - ones ) / simulation_size;
-    sw_map[ntk.node_to_index( n )] = activity;
-  } );
-
-  return sw_map;
+  activity_estimation_params ps;
+  ps.num_patterns = simulation_size;
+  ps.num_threads = num_threads;
+  return estimate_switching_activity( ntk, ps );
 }
 
-} // namespace mockturtle::detail
\ No newline at end of file
+} // namespace mockturtle::detail
@@ -0,0 +1,128 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file truth_table6.hpp
+  \brief Truth tables with up to six variables in one word
+
+  A function with `n <= 6` variables is kept *stretched* to six variables,
+  i.e., its \f$2^n\f$ bits are repeated to fill the 64-bit word.  Variables
+  the function does not depend on can then be swapped in and out without
+  masking, which makes expanding to and shrinking from the leaves of a cut a
+  sequence of word-level swaps.
+*/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace mockturtle::detail
+{
+
+/* words of the projection functions x_0, ..., x_5 */
+inline constexpr std::array<uint64_t, 6> tt6_projections = {
+    UINT64_C( 0xaaaaaaaaaaaaaaaa ), UINT64_C( 0xcccccccccccccccc ), UINT64_C( 0xf0f0f0f0f0f0f0f0 ),
+    UINT64_C( 0xff00ff00ff00ff00 ), UINT64_C( 0xffff0000ffff0000 ), UINT64_C( 0xffffffff00000000 ) };
+
+/* mask of the bits in which x_i = 1 and x_j = 0, for i < j */
+inline constexpr auto tt6_swap_masks = []() {
+  std::array<std::array<uint64_t, 6>, 6> masks{};
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    for ( auto j = i + 1u; j < 6u; ++j )
+    {
+      masks[i][j] = tt6_projections[i] & ~tt6_projections[j];
+    }
+  }
+  return masks;
+}();
+
+/* repeats the first 2^num_vars bits to fill the word */
+inline uint64_t tt6_stretch( uint64_t word, uint32_t num_vars )
+{
+  assert( num_vars <= 6u );
+  if ( num_vars < 6u )
+  {
+    word &= ( UINT64_C( 1 ) << ( 1u << num_vars ) ) - 1u;
+  }
+  for ( auto k = num_vars; k < 6u; ++k )
+  {
+    word |= word << ( 1u << k );
+  }
+  return word;
+}
+
+/* swaps variables i < j */
+inline uint64_t tt6_swap( uint64_t word, uint32_t i, uint32_t j )
+{
+  assert( i < j && j < 6u );
+  const auto mask = tt6_swap_masks[i][j];
+  const auto shift = ( 1u << j ) - ( 1u << i );
+  return ( word & ~( mask | ( mask << shift ) ) ) | ( ( word & mask ) << shift ) | ( ( word >> shift ) & mask );
+}
+
+/* moves variable i to position pos[i] for a sorted `pos` (see kitty::expand_inplace) */
+inline uint64_t tt6_expand( uint64_t word, uint8_t const* pos, uint32_t size )
+{
+  for ( auto i = size; i-- > 0u; )
+  {
+    if ( pos[i] != i )
+    {
+      word = tt6_swap( word, i, pos[i] );
+    }
+  }
+  return word;
+}
+
+/* checks whether the function depends on variable `var` */
+inline bool tt6_has_var( uint64_t word, uint32_t var )
+{
+  return ( ( ( word >> ( 1u << var ) ) ^ word ) & ~tt6_projections[var] ) != 0u;
+}
+
+/* moves the variables of the support of the first `num_vars` variables to
+   the front, writes their original positions to `support`, and returns
+   their number (see kitty::min_base_inplace) */
+inline uint32_t tt6_min_base( uint64_t& word, uint32_t num_vars, uint8_t* support )
+{
+  auto k = 0u;
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( !tt6_has_var( word, i ) )
+    {
+      continue;
+    }
+    if ( k < i )
+    {
+      word = tt6_swap( word, k, i );
+    }
+    support[k++] = static_cast<uint8_t>( i );
+  }
+  return k;
+}
+
+} // namespace mockturtle::detail
@@ -427,7 +427,7 @@ using window_resub_stats = boolean_optimization_stats<complete_tt_windowing_stat
 template<class Ntk>
 void window_xag_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, window_resub_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk::base_type is not xag_network" );
+  static_assert( is_xag_network_type_v<typename Ntk::base_type>, "Ntk::base_type is not xag_network" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
@@ -457,7 +457,7 @@ void window_xag_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, w
 template<class Ntk>
 void window_aig_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, window_resub_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network>, "Ntk::base_type is not aig_network" );
+  static_assert( is_aig_network_type_v<typename Ntk::base_type>, "Ntk::base_type is not aig_network" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
@@ -0,0 +1,467 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file incremental_cuts.hpp
+  \brief Keeps cuts up to date with network edits
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/fanout_index.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "cut_enumeration.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for incremental_network_cuts. */
+struct incremental_cuts_params
+{
+  /*! \brief Parameters of the cut enumeration. */
+  cut_enumeration_params cut_enumeration_ps{};
+
+  /*! \brief Maximum distance from a modified node up to which cuts are recomputed.
+   *
+   * Nodes in the transitive fanout that are further away keep their cuts.
+   * Since rewriting preserves the functions of all nodes, these cuts remain
+   * valid, but they may miss cuts through the new nodes.  Kept cuts with
+   * deleted leaves are removed when the cut set is accessed.
+   */
+  uint32_t max_depth{ std::numeric_limits<uint32_t>::max() };
+};
+
+/*! \brief Statistics for incremental_network_cuts. */
+struct incremental_cuts_stats
+{
+  /*! \brief Total time (initial enumeration and updates). */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of nodes whose cuts were recomputed after the initial enumeration. */
+  uint64_t num_computed{ 0u };
+
+  /*! \brief Number of nodes whose cuts were invalidated by network edits. */
+  uint64_t num_invalidated{ 0u };
+
+  /*! \brief Number of kept cuts that were removed due to deleted leaves. */
+  uint64_t num_removed{ 0u };
+
+  /*! \brief Statistics of the cut enumeration. */
+  cut_enumeration_stats cut_enumeration_st;
+
+  /*! \brief Prints report. */
+  void report() const
+  {
+    fmt::print( "[i] total time  = {:>5.2f} secs\n", to_seconds( time_total ) );
+    fmt::print( "[i] computed    = {}\n", num_computed );
+    fmt::print( "[i] invalidated = {}\n", num_invalidated );
+    fmt::print( "[i] removed     = {}\n", num_removed );
+    fmt::print( "[i] Cut enumeration stats\n" );
+    cut_enumeration_st.report();
+  }
+};
+
+/*! \brief Cut database that is kept up to date with network edits.
+ *
+ * The cuts of all nodes are enumerated on construction as with
+ * `cut_enumeration`.  Then, the database subscribes to the events of the
+ * network.  When the fan-ins of a node are modified (e.g., by
+ * `substitute_node`), the cuts of the node and of its transitive fanout up
+ * to `max_depth` levels are invalidated; nodes added to the network,
+ * including PIs, have no cuts yet. Invalidated cut sets are recomputed on
+ * demand, i.e., when they are requested with `cuts` or when `update` is
+ * called, from the cut sets of the fan-ins. Hence, a round of local
+ * rewrites only pays for the cuts in the transitive fanout of the rewritten
+ * nodes.
+ *
+ * With the default `max_depth`, the cut sets of all live nodes are the same
+ * as the ones of a new enumeration.  The database keeps its own fanouts,
+ * hence it does not require a `fanout_view`.  It cannot be copied, since it
+ * is registered with the network.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `index_to_node`
+ * - `node_to_index`
+ * - `is_constant`
+ * - `is_pi`
+ * - `is_dead`
+ * - `compute`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      incremental_cuts_params ps;
+      ps.cut_enumeration_ps.cut_size = 4;
+      incremental_network_cuts<aig_network, true> cuts( aig, ps );
+
+      aig.substitute_node( n, g );  // invalidates the cuts of the fanouts of `n`
+      for ( auto const& cut : cuts.cuts( aig.node_to_index( f ) ) )
+      {
+        const auto tt = cuts.truth_table( *cut );
+      }
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
+class incremental_network_cuts
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using network_cuts_t = network_cuts<Ntk, ComputeTruth, CutData>;
+  using cut_t = typename network_cuts_t::cut_t;
+  using cut_set_t = typename network_cuts_t::cut_set_t;
+
+  explicit incremental_network_cuts( Ntk const& ntk, incremental_cuts_params const& ps = {} )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _cuts( _ntk.size() ),
+        _impl( _ntk, _ps.cut_enumeration_ps, _st.cut_enumeration_st, _cuts ),
+        _dirty( _ntk, 0u ),
+        _checked( _ntk, 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+
+    stopwatch t( _st.time_total );
+    _impl.run();
+
+    _fanout.build( _ntk.size(), [&]( auto&& add ) {
+      _ntk.foreach_gate( [&]( auto const& n ) {
+        _ntk.foreach_fanin( n, [&]( auto const& f ) {
+          add( _ntk.node_to_index( _ntk.get_node( f ) ), n );
+        } );
+      } );
+    } );
+
+    _add_event = _ntk.events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    _modified_event = _ntk.events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    _delete_event = _ntk.events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+  incremental_network_cuts( incremental_network_cuts const& ) = delete;
+  incremental_network_cuts& operator=( incremental_network_cuts const& ) = delete;
+
+  ~incremental_network_cuts()
+  {
+    _ntk.events().release_add_event( _add_event );
+    _ntk.events().release_modified_event( _modified_event );
+    _ntk.events().release_delete_event( _delete_event );
+  }
+
+  /*! \brief Returns the cut set of a node, recomputes invalidated cut sets in its fan-in cone. */
+  cut_set_t const& cuts( uint32_t node_index )
+  {
+    stopwatch t( _st.time_total );
+    invalidate();
+    compute( _ntk.index_to_node( node_index ) );
+    return _cuts.cuts( node_index );
+  }
+
+  /*! \brief Returns the truth table of a cut. */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  auto truth_table( cut_t const& cut ) const
+  {
+    return _cuts.truth_table( cut );
+  }
+
+  /*! \brief Recomputes all invalidated cut sets. */
+  void update()
+  {
+    stopwatch t( _st.time_total );
+    invalidate();
+    while ( !_pending.empty() )
+    {
+      const auto n = _pending.back();
+      _pending.pop_back();
+      compute( n );
+    }
+  }
+
+  /*! \brief Whether the cut set of a node needs to be recomputed. */
+  bool is_dirty( uint32_t node_index )
+  {
+    invalidate();
+    return !is_up_to_date( _ntk.index_to_node( node_index ) );
+  }
+
+  /*! \brief Returns the cuts of all nodes after recomputing invalidated cut sets.
+   *
+   * The result can be passed to functions that expect the result of
+   * `cut_enumeration`.  Kept cut sets with deleted leaves are not cleaned up.
+   */
+  network_cuts_t const& database()
+  {
+    update();
+    return _cuts;
+  }
+
+  /*! \brief Statistics on recomputed and invalidated cut sets. */
+  incremental_cuts_stats const& stats() const
+  {
+    return _st;
+  }
+
+private:
+  bool is_up_to_date( node const& n ) const
+  {
+    return _ntk.node_to_index( n ) < _cuts.nodes_size() && _dirty[n] == 0u;
+  }
+
+  /* distance budget of a modified node, nodes with a budget are invalidated */
+  uint32_t max_budget() const
+  {
+    return std::min( _ps.max_depth, std::numeric_limits<uint32_t>::max() - 1u ) + 1u;
+  }
+
+  /* nodes created since the last call have no cuts yet, including PIs, which do not emit add events */
+  void resize()
+  {
+    const auto old_size = static_cast<uint32_t>( _cuts.nodes_size() );
+    if ( old_size == _ntk.size() )
+    {
+      return;
+    }
+
+    _dirty.resize( 0u );
+    _checked.resize( 0u );
+    _cuts._cuts.resize( _ntk.size() );
+    for ( auto i = old_size; i < _ntk.size(); ++i )
+    {
+      const auto n = _ntk.index_to_node( i );
+      _dirty[n] = max_budget();
+      _pending.push_back( n );
+    }
+  }
+
+  /* invalidates the transitive fanout of all modified nodes */
+  void invalidate()
+  {
+    resize();
+
+    while ( !_modified.empty() )
+    {
+      _stack.push_back( _modified.back() );
+      _modified.pop_back();
+
+      while ( !_stack.empty() )
+      {
+        const auto n = _stack.back();
+        _stack.pop_back();
+        if ( _ntk.is_dead( n ) || _dirty[n] <= 1u )
+        {
+          continue;
+        }
+
+        const auto budget = _dirty[n] - 1u;
+        std::for_each( _fanout.begin( _ntk.node_to_index( n ) ), _fanout.end( _ntk.node_to_index( n ) ), [&]( auto const& p ) {
+          if ( _dirty[p] < budget )
+          {
+            if ( _dirty[p] == 0u )
+            {
+              ++_st.num_invalidated;
+              _pending.push_back( p );
+            }
+            _dirty[p] = budget;
+            _stack.push_back( p );
+          }
+        } );
+      }
+    }
+  }
+
+  /* recomputes the invalidated cut sets in the fan-in cone of `root` */
+  void compute( node const& root )
+  {
+    if ( _ntk.is_dead( root ) )
+    {
+      return;
+    }
+
+    _stack.push_back( root );
+    while ( !_stack.empty() )
+    {
+      const auto n = _stack.back();
+      if ( is_up_to_date( n ) )
+      {
+        remove_dead_leaves( n );
+        _stack.pop_back();
+        continue;
+      }
+
+      bool ready = true;
+      if ( !_ntk.is_constant( n ) && !_ntk.is_pi( n ) )
+      {
+        _ntk.foreach_fanin( n, [&]( auto const& f ) {
+          if ( !is_up_to_date( _ntk.get_node( f ) ) )
+          {
+            _stack.push_back( _ntk.get_node( f ) );
+            ready = false;
+          }
+          else
+          {
+            remove_dead_leaves( _ntk.get_node( f ) );
+          }
+        } );
+      }
+
+      if ( ready )
+      {
+        _stack.pop_back();
+        _impl.compute_node( _ntk.node_to_index( n ) );
+        ++_st.num_computed;
+        _dirty[n] = 0u;
+        _checked[n] = _num_deleted;
+      }
+    }
+  }
+
+  /* only kept cut sets of nodes beyond `max_depth` may have deleted leaves */
+  void remove_dead_leaves( node const& n )
+  {
+    if ( _checked[n] == _num_deleted )
+    {
+      return;
+    }
+    _checked[n] = _num_deleted;
+
+    auto& set = _cuts.cuts( _ntk.node_to_index( n ) );
+    const auto is_live = [&]( auto const* cut ) {
+      return std::none_of( cut->begin(), cut->end(), [&]( auto leaf ) { return _ntk.is_dead( _ntk.index_to_node( leaf ) ); } );
+    };
+    if ( std::all_of( set.begin(), set.end(), is_live ) )
+    {
+      return;
+    }
+
+    cut_set_t live;
+    for ( auto const* cut : set )
+    {
+      if ( is_live( cut ) )
+      {
+        live.add_cut( cut->begin(), cut->end() ) = *cut;
+      }
+      else
+      {
+        ++_st.num_removed;
+      }
+    }
+    set = live;
+  }
+
+  void on_add( node const& n )
+  {
+    resize();
+    _fanout.resize( _ntk.size() );
+    _ntk.foreach_fanin( n, [&]( auto const& f ) {
+      _fanout.push_back( _ntk.node_to_index( _ntk.get_node( f ) ), n );
+    } );
+  }
+
+  void on_modified( node const& n, std::vector<signal> const& previous )
+  {
+    for ( auto const& f : previous )
+    {
+      _fanout.erase( _ntk.node_to_index( _ntk.get_node( f ) ), n );
+    }
+    _ntk.foreach_fanin( n, [&]( auto const& f ) {
+      _fanout.push_back( _ntk.node_to_index( _ntk.get_node( f ) ), n );
+    } );
+
+    resize();
+    if ( _dirty[n] == 0u )
+    {
+      ++_st.num_invalidated;
+      _pending.push_back( n );
+    }
+    _dirty[n] = max_budget();
+    _modified.push_back( n );
+  }
+
+  void on_delete( node const& n )
+  {
+    _fanout.clear( _ntk.node_to_index( n ) );
+    _ntk.foreach_fanin( n, [&]( auto const& f ) {
+      _fanout.erase( _ntk.node_to_index( _ntk.get_node( f ) ), n );
+    } );
+
+    resize();
+    _cuts.cuts( _ntk.node_to_index( n ) ).clear();
+    _dirty[n] = 0u;
+    if ( _ps.max_depth != std::numeric_limits<uint32_t>::max() )
+    {
+      ++_num_deleted;
+    }
+  }
+
+private:
+  Ntk _ntk;
+  incremental_cuts_params _ps;
+  incremental_cuts_stats _st;
+  network_cuts_t _cuts;
+  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> _impl;
+
+  /* distance budget of invalidated nodes, 0 for up-to-date nodes */
+  node_map<uint32_t, Ntk> _dirty;
+  /* number of deletions when the leaves of the cut set were checked */
+  node_map<uint32_t, Ntk> _checked;
+  uint32_t _num_deleted{ 0u };
+
+  fanout_index<node> _fanout;
+  std::vector<node> _modified;
+  std::vector<node> _pending;
+  std::vector<node> _stack;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+};
+
+} // namespace mockturtle
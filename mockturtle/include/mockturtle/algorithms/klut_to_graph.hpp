@@ -53,18 +53,18 @@ namespace detail
 template<class NtkDestBase>
 const auto set_npn_resynthesis_fn()
 {
-  using aig_npn_type = xag_npn_resynthesis<aig_network, xag_network, xag_npn_db_kind::aig_complete>;
-  using xag_npn_type = xag_npn_resynthesis<xag_network, xag_network, xag_npn_db_kind::xag_complete>;
+  using aig_npn_type = xag_npn_resynthesis<NtkDestBase, xag_network, xag_npn_db_kind::aig_complete>;
+  using xag_npn_type = xag_npn_resynthesis<NtkDestBase, xag_network, xag_npn_db_kind::xag_complete>;
   using mig_npn_type = mig_npn_resynthesis;
   using xmg_npn_type = xmg_npn_resynthesis;
 
-  if constexpr ( std::is_same_v<NtkDestBase, aig_network> )
+  if constexpr ( is_aig_network_type_v<NtkDestBase> )
     return aig_npn_type{};
-  else if constexpr ( std::is_same_v<NtkDestBase, xag_network> )
+  else if constexpr ( is_xag_network_type_v<NtkDestBase> )
     return xag_npn_type{};
-  else if constexpr ( std::is_same_v<NtkDestBase, mig_network> )
+  else if constexpr ( is_mig_network_type_v<NtkDestBase> )
     return mig_npn_type{};
-  else if constexpr ( std::is_same_v<NtkDestBase, xmg_network> )
+  else if constexpr ( is_xmg_network_type_v<NtkDestBase> )
     return xmg_npn_type{};
 }
 
@@ -92,8 +92,8 @@ NtkDest convert_klut_to_graph( NtkSrc const& ntk_src )
 {
   using NtkDestBase = typename NtkDest::base_type;
   static_assert( std::is_same_v<typename NtkSrc::base_type, klut_network>, "NtkSrc is not klut_network" );
-  static_assert( std::is_same_v<NtkDestBase, aig_network> || std::is_same_v<NtkDestBase, xag_network> ||
-                     std::is_same_v<NtkDestBase, mig_network> || std::is_same_v<NtkDestBase, xmg_network>,
+  static_assert( is_aig_network_type_v<NtkDestBase> || is_xag_network_type_v<NtkDestBase> ||
+                     is_mig_network_type_v<NtkDestBase> || is_xmg_network_type_v<NtkDestBase>,
                  "NtkDest is not an AIG, XAG, MIG, or XMG" );
 
   uint32_t threshold{ 4 };
@@ -117,8 +117,8 @@ void convert_klut_to_graph( NtkDest& ntk_dest, NtkSrc const& ntk_src )
 {
   using NtkDestBase = typename NtkDest::base_type;
   static_assert( std::is_same_v<typename NtkSrc::base_type, klut_network>, "NtkSrc is not klut_network" );
-  static_assert( std::is_same_v<NtkDestBase, aig_network> || std::is_same_v<NtkDestBase, xag_network> ||
-                     std::is_same_v<NtkDestBase, mig_network> || std::is_same_v<NtkDestBase, xmg_network>,
+  static_assert( is_aig_network_type_v<NtkDestBase> || is_xag_network_type_v<NtkDestBase> ||
+                     is_mig_network_type_v<NtkDestBase> || is_xmg_network_type_v<NtkDestBase>,
                  "NtkDest is not an AIG, XAG, MIG, or XMG" );
 
   uint32_t threshold{ 4 };
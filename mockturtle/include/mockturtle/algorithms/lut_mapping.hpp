@@ -491,6 +491,12 @@ private:
  * example of a CutData type that implements the cost function that is used in
  * the LUT mapper `&mf` in ABC.
  *
+ * If `Ntk` is a choice network (see `choice_view`), the cuts of each node
+ * include the cuts of its alternatives, such that the mapping may cover a
+ * node by the structure of one of its alternatives.  In that case, the LUT
+ * functions cannot be derived from the structure of the network and must
+ * be stored in the mapping, i.e., `StoreFunction` must be true.
+ *
  * **Required network functions:**
  * - `size`
  * - `is_pi`
@@ -529,6 +535,7 @@ void lut_mapping( Ntk& ntk, lut_mapping_params const& ps = {}, lut_mapping_stats
   static_assert( has_clear_mapping_v<Ntk>, "Ntk does not implement the clear_mapping method" );
   static_assert( has_add_to_mapping_v<Ntk>, "Ntk does not implement the add_to_mapping method" );
   static_assert( !StoreFunction || has_set_cell_function_v<Ntk>, "Ntk does not implement the set_cell_function method" );
+  static_assert( StoreFunction || !has_foreach_choice_v<Ntk>, "Mapping a choice network requires StoreFunction" );
 
   lut_mapping_stats st;
   detail::lut_mapping_impl<Ntk, StoreFunction, CutData> p( ntk, ps, st );
@@ -32,8 +32,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <memory>
 
 #include <fmt/format.h>
 
@@ -41,6 +43,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/topo_view.hpp"
@@ -98,6 +101,20 @@ struct map_params
   /*! \brief Maximum number of cuts evaluated for logic sharing. */
   uint32_t logic_sharing_cut_limit{ 8u };
 
+  /*! \brief Number of threads (0 uses the hardware concurrency).
+   *
+   * With more than one thread, cuts are enumerated and matched
+   * concurrently and the nodes of one level are mapped concurrently
+   * in the delay and area flow rounds, which does not change the
+   * result.  Exact area and switching power recovery map partitions
+   * of the network concurrently: references to nodes of other
+   * partitions are resolved once all partitions are mapped, such
+   * that the result does not depend on the number of threads, but
+   * may differ from the one of a single thread.  Only used by the
+   * technology mapper.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -118,6 +135,8 @@ struct map_stats
 
   /*! \brief Runtime for covering. */
   stopwatch<>::duration time_mapping{ 0 };
+  /*! \brief Runtime for switching activity estimation. */
+  stopwatch<>::duration time_switching_activity{ 0 };
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
@@ -142,6 +161,8 @@ struct map_stats
     else
       std::cout << "\n";
     std::cout << fmt::format( "[i] Mapping runtime = {:>5.2f} secs\n", to_seconds( time_mapping ) );
+    if ( time_switching_activity.count() != 0 )
+      std::cout << fmt::format( "[i] Activity time   = {:>5.2f} secs\n", to_seconds( time_switching_activity ) );
     std::cout << fmt::format( "[i] Total runtime   = {:>5.2f} secs\n", to_seconds( time_total ) );
   }
 };
@@ -191,9 +212,23 @@ class tech_map_impl
 public:
   using network_cuts_t = fast_network_cuts<Ntk, CutSize, true, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
-  using match_map = std::unordered_map<uint32_t, std::vector<cut_match_tech<NInputs>>>;
+  using match_map = std::vector<std::vector<cut_match_tech<NInputs>>>;
   using klut_map = std::unordered_map<uint32_t, std::array<signal<klut_network>, 2>>;
 
+private:
+  /* range of the topological order mapped by one thread in exact area recovery */
+  struct ela_partition
+  {
+    uint32_t id{ 0u };
+    uint32_t begin{ 0u };
+    uint32_t end{ 0u };
+    /* pending changes of the references to nodes of other partitions, by leaf and phase */
+    phmap::flat_hash_map<uint64_t, int32_t> boundary_refs;
+  };
+
+  static constexpr uint32_t min_partition_size = 4096u;
+  static constexpr uint32_t max_partitions = 64u;
+
 public:
   explicit tech_map_impl( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, map_params const& ps, map_stats& st )
       : ntk( ntk ),
@@ -201,9 +236,9 @@ public:
         ps( ps ),
         st( st ),
         node_match( ntk.size() ),
-        matches(),
-        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
-        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        matches( ntk.size() ),
+        switch_activity( ps.eswp_rounds ? call_with_stopwatch( st.time_switching_activity, [&]() { return switching_activity( ntk, ps.switching_activity_patterns ); } ) : std::vector<float>( 0 ) ),
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, cut_enumeration_params_of( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -215,9 +250,9 @@ public:
         ps( ps ),
         st( st ),
         node_match( ntk.size() ),
-        matches(),
+        matches( ntk.size() ),
         switch_activity( switch_activity ),
-        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, cut_enumeration_params_of( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -235,6 +270,13 @@ public:
       top_order.push_back( n );
     } );
 
+    if ( ps.num_threads != 1u )
+    {
+      pool = std::make_unique<thread_pool>( ps.num_threads );
+      compute_levels();
+      compute_partitions();
+    }
+
     /* match cuts with gates */
     compute_matches();
 
@@ -290,6 +332,14 @@ public:
   }
 
 private:
+  static cut_enumeration_params cut_enumeration_params_of( map_params const& ps )
+  {
+    auto cut_ps = ps.cut_enumeration_ps;
+    if ( !cut_ps.num_threads && ps.num_threads != 1u )
+      cut_ps.num_threads = ps.num_threads;
+    return cut_ps;
+  }
+
   void init_nodes()
   {
     ntk.foreach_node( [this]( auto const& n, auto ) {
@@ -316,16 +366,74 @@ private:
     } );
   }
 
+  /* groups the gates by level, in topological order within each level */
+  void compute_levels()
+  {
+    std::vector<uint32_t> node_level( ntk.size(), 0u );
+    for ( auto const& n : top_order )
+    {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      uint32_t level{ 0u };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, node_level[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+      if constexpr ( has_foreach_choice_v<Ntk> )
+      {
+        ntk.foreach_choice( n, [&]( auto const& a ) {
+          level = std::max( level, node_level[ntk.node_to_index( a )] );
+        } );
+      }
+
+      const auto index = ntk.node_to_index( n );
+      node_level[index] = level + 1u;
+      if ( levels.size() <= level )
+        levels.resize( level + 1u );
+      levels[level].push_back( index );
+    }
+  }
+
+  /* splits the topological order into partitions for exact area recovery,
+     their number depends only on the number of gates */
+  void compute_partitions()
+  {
+    const auto num_gates = static_cast<uint32_t>( ntk.num_gates() );
+    const auto partition_size = std::max( min_partition_size, ( num_gates + max_partitions - 1u ) / max_partitions );
+
+    partition_of.assign( ntk.size(), UINT32_MAX );
+    partitions.clear();
+
+    uint32_t gates_in_partition = 0u;
+    for ( auto i = 0u; i < top_order.size(); ++i )
+    {
+      auto const& n = top_order[i];
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      if ( partitions.empty() || gates_in_partition == partition_size )
+      {
+        partitions.emplace_back();
+        partitions.back().id = static_cast<uint32_t>( partitions.size() - 1u );
+        partitions.back().begin = i;
+        gates_in_partition = 0u;
+      }
+      partition_of[ntk.node_to_index( n )] = partitions.back().id;
+      partitions.back().end = i + 1u;
+      ++gates_in_partition;
+    }
+  }
+
   void compute_matches()
   {
-    /* match gates */
-    ntk.foreach_gate( [&]( auto const& n ) {
+    /* match the cuts of a gate */
+    auto const match_cuts = [&]( auto const& n ) {
       const auto index = ntk.node_to_index( n );
 
       std::vector<cut_match_tech<NInputs>> node_matches;
 
       auto i = 0u;
-      for ( auto& cut : cuts.cuts( index ) )
+      for ( auto* cut : cuts.cuts( index ) )
       {
         /* ignore unit cut */
         if ( cut->size() == 1 && *cut->begin() == index )
@@ -383,27 +491,52 @@ private:
       }
 
       matches[index] = node_matches;
-    } );
+    };
+
+    /* match gates */
+    if ( pool )
+    {
+      pool->parallel_for( 0u, top_order.size(), 256u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          if ( !ntk.is_constant( top_order[i] ) && !ntk.is_pi( top_order[i] ) )
+            match_cuts( top_order[i] );
+        }
+      } );
+    }
+    else
+    {
+      ntk.foreach_gate( match_cuts );
+    }
   }
 
   template<bool DO_AREA>
   bool compute_mapping()
   {
-    for ( auto const& n : top_order )
+    if ( pool )
     {
-      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      /* the matches of a node depend only on nodes of lower levels */
+      for ( auto const& level : levels )
       {
-        continue;
+        pool->parallel_for( 0u, level.size(), 64u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+          for ( auto i = begin; i < end; ++i )
+          {
+            match_node<DO_AREA>( ntk.index_to_node( level[i] ) );
+          }
+        } );
       }
+    }
+    else
+    {
+      for ( auto const& n : top_order )
+      {
+        if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        {
+          continue;
+        }
 
-      /* match positive phase */
-      match_phase<DO_AREA>( n, 0u );
-
-      /* match negative phase */
-      match_phase<DO_AREA>( n, 1u );
-
-      /* try to drop one phase */
-      match_drop_phase<DO_AREA, false>( n, 0 );
+        match_node<DO_AREA>( n );
+      }
     }
 
     double area_old = area;
@@ -432,35 +565,55 @@ private:
     return success;
   }
 
+  template<bool DO_AREA>
+  void match_node( node<Ntk> const& n )
+  {
+    /* match positive phase */
+    match_phase<DO_AREA>( n, 0u );
+
+    /* match negative phase */
+    match_phase<DO_AREA>( n, 1u );
+
+    /* try to drop one phase */
+    match_drop_phase<DO_AREA, false>( n, 0 );
+  }
+
   template<bool SwitchActivity>
   bool compute_mapping_exact()
   {
-    for ( auto const& n : top_order )
+    if ( partitions.size() > 1u )
     {
-      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
-        continue;
-
-      auto index = ntk.node_to_index( n );
-      auto& node_data = node_match[index];
+      /* partitions are mapped independently, using only the required
+       * times of the nodes of other partitions */
+      pool->parallel_for( 0u, partitions.size(), 1u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+        for ( auto p = begin; p < end; ++p )
+        {
+          auto& part = partitions[p];
+          for ( auto i = part.begin; i < part.end; ++i )
+          {
+            if ( ntk.is_constant( top_order[i] ) || ntk.is_pi( top_order[i] ) )
+              continue;
+            match_node_exact<SwitchActivity>( top_order[i], &part );
+          }
+        }
+      } );
 
-      /* recursively deselect the best cut shared between
-       * the two phases if in use in the cover */
-      if ( node_data.same_match && node_data.map_refs[2] != 0 )
+      /* resolve the references between partitions in a fixed order */
+      for ( auto& part : partitions )
       {
-        if ( node_data.best_supergate[0] != nullptr )
-          cut_deref<SwitchActivity>( cuts.cuts( index )[node_data.best_cut[0]], n, 0u );
-        else
-          cut_deref<SwitchActivity>( cuts.cuts( index )[node_data.best_cut[1]], n, 1u );
+        apply_boundary_refs( part );
       }
+      propagate_arrival_times();
+    }
+    else
+    {
+      for ( auto const& n : top_order )
+      {
+        if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+          continue;
 
-      /* match positive phase */
-      match_phase_exact<SwitchActivity>( n, 0u );
-
-      /* match negative phase */
-      match_phase_exact<SwitchActivity>( n, 1u );
-
-      /* try to drop one phase */
-      match_drop_phase<true, true>( n, 0 );
+        match_node_exact<SwitchActivity>( n, nullptr );
+      }
     }
 
     double area_old = area;
@@ -481,6 +634,90 @@ private:
     return success;
   }
 
+  template<bool SwitchActivity>
+  void match_node_exact( node<Ntk> const& n, ela_partition* part )
+  {
+    auto index = ntk.node_to_index( n );
+    auto& node_data = node_match[index];
+
+    /* recursively deselect the best cut shared between
+     * the two phases if in use in the cover */
+    if ( node_data.same_match && node_data.map_refs[2] != 0 )
+    {
+      if ( node_data.best_supergate[0] != nullptr )
+        cut_deref<SwitchActivity>( cuts.cuts( index )[node_data.best_cut[0]], n, 0u, part );
+      else
+        cut_deref<SwitchActivity>( cuts.cuts( index )[node_data.best_cut[1]], n, 1u, part );
+    }
+
+    /* match positive phase */
+    match_phase_exact<SwitchActivity>( n, 0u, part );
+
+    /* match negative phase */
+    match_phase_exact<SwitchActivity>( n, 1u, part );
+
+    /* try to drop one phase */
+    match_drop_phase<true, true>( n, 0, part );
+  }
+
+  /* applies the references of a partition to nodes of other partitions */
+  void apply_boundary_refs( ela_partition& part )
+  {
+    std::vector<std::pair<uint64_t, int32_t>> refs( part.boundary_refs.begin(), part.boundary_refs.end() );
+    std::sort( refs.begin(), refs.end() );
+    part.boundary_refs.clear();
+
+    for ( auto const& [key, diff] : refs )
+    {
+      const auto leaf = static_cast<uint32_t>( key >> 1u );
+      const auto leaf_phase = static_cast<uint8_t>( key & 1u );
+      float count{ 0.0f };
+      for ( auto i = 0; i < diff; ++i )
+      {
+        leaf_ref<false>( leaf, leaf_phase, count, nullptr );
+      }
+      for ( auto i = 0; i > diff; --i )
+      {
+        leaf_deref<false>( leaf, leaf_phase, count, nullptr );
+      }
+    }
+  }
+
+  /* recomputes the arrival times of the selected matches */
+  void propagate_arrival_times()
+  {
+    for ( auto const& n : top_order )
+    {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      const auto index = ntk.node_to_index( n );
+      auto& node_data = node_match[index];
+      for ( auto phase = 0u; phase < 2u; ++phase )
+      {
+        auto const* supergate = node_data.best_supergate[phase];
+        if ( supergate == nullptr )
+          continue;
+
+        double worst_arrival = 0.0f;
+        auto ctr = 0u;
+        for ( auto l : cuts.cuts( index )[node_data.best_cut[phase]] )
+        {
+          double arrival_pin = node_match[l].arrival[( node_data.phase[phase] >> ctr ) & 1] + supergate->tdelay[ctr];
+          worst_arrival = std::max( worst_arrival, arrival_pin );
+          ++ctr;
+        }
+        node_data.arrival[phase] = worst_arrival;
+      }
+
+      if ( node_data.same_match )
+      {
+        const auto use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+        node_data.arrival[use_phase ^ 1u] = node_data.arrival[use_phase] + lib_inv_delay;
+      }
+    }
+  }
+
   template<bool ELA>
   bool set_mapping_refs()
   {
@@ -682,7 +919,7 @@ private:
       if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
       {
         auto ctr = 0u;
-        auto best_cut = cuts.cuts( index )[node_data.best_cut[use_phase]];
+        auto const& best_cut = cuts.cuts( index )[node_data.best_cut[use_phase]];
         auto const& supergate = node_data.best_supergate[use_phase];
         for ( auto leaf : best_cut )
         {
@@ -695,7 +932,7 @@ private:
       if ( !node_data.same_match && node_data.map_refs[other_phase] > 0 )
       {
         auto ctr = 0u;
-        auto best_cut = cuts.cuts( index )[node_data.best_cut[other_phase]];
+        auto const& best_cut = cuts.cuts( index )[node_data.best_cut[other_phase]];
         auto const& supergate = node_data.best_supergate[other_phase];
         for ( auto leaf : best_cut )
         {
@@ -745,7 +982,7 @@ private:
     }
 
     /* foreach cut */
-    for ( auto& cut : cuts.cuts( index ) )
+    for ( auto* cut : cuts.cuts( index ) )
     {
       /* trivial cuts or not matched cuts */
       if ( ( *cut )->data.ignore )
@@ -809,7 +1046,7 @@ private:
   }
 
   template<bool SwitchActivity>
-  void match_phase_exact( node<Ntk> const& n, uint8_t phase )
+  void match_phase_exact( node<Ntk> const& n, uint8_t phase, ela_partition* part )
   {
     double best_arrival = std::numeric_limits<double>::max();
     float best_exact_area = std::numeric_limits<float>::max();
@@ -838,7 +1075,7 @@ private:
       auto ctr = 0u;
       for ( auto l : cut )
       {
-        double arrival_pin = node_match[l].arrival[( best_phase >> ctr ) & 1] + best_supergate->tdelay[ctr];
+        double arrival_pin = leaf_arrival( l, ( best_phase >> ctr ) & 1, part ) + best_supergate->tdelay[ctr];
         best_arrival = std::max( best_arrival, arrival_pin );
         ++ctr;
       }
@@ -846,17 +1083,17 @@ private:
       /* if cut is implemented, remove it from the cover */
       if ( !node_data.same_match && node_data.map_refs[phase] )
       {
-        best_exact_area = cut_deref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase );
+        best_exact_area = cut_deref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase, part );
       }
       else
       {
-        best_exact_area = cut_ref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase );
-        cut_deref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase );
+        best_exact_area = cut_ref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase, part );
+        cut_deref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase, part );
       }
     }
 
     /* foreach cut */
-    for ( auto& cut : cuts.cuts( index ) )
+    for ( auto* cut : cuts.cuts( index ) )
     {
       /* trivial cuts or not matched cuts */
       if ( ( *cut )->data.ignore )
@@ -880,14 +1117,14 @@ private:
         uint8_t gate_polarity = gate.polarity ^ negation;
         node_data.phase[phase] = gate_polarity;
         node_data.area[phase] = gate.area;
-        float area_exact = cut_ref<SwitchActivity>( *cut, n, phase );
-        cut_deref<SwitchActivity>( *cut, n, phase );
+        float area_exact = cut_ref<SwitchActivity>( *cut, n, phase, part );
+        cut_deref<SwitchActivity>( *cut, n, phase, part );
         double worst_arrival = 0.0f;
 
         auto ctr = 0u;
         for ( auto l : *cut )
         {
-          double arrival_pin = node_match[l].arrival[( gate_polarity >> ctr ) & 1] + gate.tdelay[ctr];
+          double arrival_pin = leaf_arrival( l, ( gate_polarity >> ctr ) & 1, part ) + gate.tdelay[ctr];
           worst_arrival = std::max( worst_arrival, arrival_pin );
           ++ctr;
         }
@@ -919,12 +1156,12 @@ private:
 
     if ( !node_data.same_match && node_data.map_refs[phase] )
     {
-      best_exact_area = cut_ref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase );
+      best_exact_area = cut_ref<SwitchActivity>( cuts.cuts( index )[best_cut], n, phase, part );
     }
   }
 
   template<bool DO_AREA, bool ELA>
-  void match_drop_phase( node<Ntk> const& n, float required_margin_factor )
+  void match_drop_phase( node<Ntk> const& n, float required_margin_factor, ela_partition* part = nullptr )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -942,7 +1179,7 @@ private:
       if constexpr ( ELA )
       {
         if ( node_data.map_refs[2] )
-          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1 );
+          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1, part );
       }
       return;
     }
@@ -952,7 +1189,7 @@ private:
       if constexpr ( ELA )
       {
         if ( node_data.map_refs[2] )
-          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0 );
+          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0, part );
       }
       return;
     }
@@ -1046,13 +1283,13 @@ private:
         {
           /* dereference the negative phase cut if in use */
           if ( node_data.map_refs[1] > 0 )
-            cut_deref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1 );
+            cut_deref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1, part );
           /* reference the positive cut if not in use before */
           if ( node_data.map_refs[0] == 0 && node_data.map_refs[2] )
-            cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0 );
+            cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0, part );
         }
         else if ( node_data.map_refs[2] )
-          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0 );
+          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0, part );
       }
       set_match_complemented_phase( index, 0, worst_arrival_nneg );
     }
@@ -1065,13 +1302,13 @@ private:
         {
           /* dereference the positive phase cut if in use */
           if ( node_data.map_refs[0] > 0 )
-            cut_deref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0 );
+            cut_deref<false>( cuts.cuts( index )[node_data.best_cut[0]], n, 0, part );
           /* reference the negative cut if not in use before */
           if ( node_data.map_refs[1] == 0 && node_data.map_refs[2] )
-            cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1 );
+            cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1, part );
         }
         else if ( node_data.map_refs[2] )
-          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1 );
+          cut_ref<false>( cuts.cuts( index )[node_data.best_cut[1]], n, 1, part );
       }
       set_match_complemented_phase( index, 1, worst_arrival_npos );
     }
@@ -1152,7 +1389,7 @@ private:
   }
 
   template<bool SwitchActivity>
-  float cut_ref( cut_t const& cut, node<Ntk> const& n, uint8_t phase )
+  float cut_ref( cut_t const& cut, node<Ntk> const& n, uint8_t phase, ela_partition* part )
   {
     auto const& node_data = node_match[ntk.node_to_index( n )];
     float count;
@@ -1167,61 +1404,80 @@ private:
     {
       /* compute leaf phase using the current gate */
       uint8_t leaf_phase = ( node_data.phase[phase] >> ctr++ ) & 1;
+      leaf_ref<SwitchActivity>( leaf, leaf_phase, count, part );
+    }
+    return count;
+  }
 
-      if ( ntk.is_constant( ntk.index_to_node( leaf ) ) )
-      {
-        continue;
-      }
-      else if ( ntk.is_pi( ntk.index_to_node( leaf ) ) )
+  template<bool SwitchActivity>
+  void leaf_ref( uint32_t leaf, uint8_t leaf_phase, float& count, ela_partition* part )
+  {
+    if ( ntk.is_constant( ntk.index_to_node( leaf ) ) )
+    {
+      return;
+    }
+    else if ( part != nullptr && partition_of[leaf] != part->id )
+    {
+      /* reference nodes of other partitions later, add inverter cost for negative PIs */
+      auto& diff = part->boundary_refs[( static_cast<uint64_t>( leaf ) << 1u ) | leaf_phase];
+      if ( leaf_phase == 1u && ntk.is_pi( ntk.index_to_node( leaf ) ) && node_match[leaf].map_refs[1] + diff == 0 )
       {
-        /* reference PIs, add inverter cost for negative phase */
-        if ( leaf_phase == 1u )
-        {
-          if ( node_match[leaf].map_refs[1]++ == 0u )
-          {
-            if constexpr ( SwitchActivity )
-              count += switch_activity[leaf];
-            else
-              count += lib_inv_area;
-          }
-        }
+        if constexpr ( SwitchActivity )
+          count += switch_activity[leaf];
         else
-        {
-          ++node_match[leaf].map_refs[0];
-        }
-        continue;
+          count += lib_inv_area;
       }
-
-      if ( node_match[leaf].same_match )
+      ++diff;
+      return;
+    }
+    else if ( ntk.is_pi( ntk.index_to_node( leaf ) ) )
+    {
+      /* reference PIs, add inverter cost for negative phase */
+      if ( leaf_phase == 1u )
       {
-        /* Add inverter area if not present yet and leaf node is implemented in the opposite phase */
-        if ( node_match[leaf].map_refs[leaf_phase]++ == 0u && node_match[leaf].best_supergate[leaf_phase] == nullptr )
+        if ( node_match[leaf].map_refs[1]++ == 0u )
         {
           if constexpr ( SwitchActivity )
             count += switch_activity[leaf];
           else
             count += lib_inv_area;
         }
-        /* Recursive referencing if leaf was not referenced */
-        if ( node_match[leaf].map_refs[2]++ == 0u )
-        {
-          count += cut_ref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase );
-        }
       }
       else
       {
-        ++node_match[leaf].map_refs[2];
-        if ( node_match[leaf].map_refs[leaf_phase]++ == 0u )
-        {
-          count += cut_ref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase );
-        }
+        ++node_match[leaf].map_refs[0];
+      }
+      return;
+    }
+
+    if ( node_match[leaf].same_match )
+    {
+      /* Add inverter area if not present yet and leaf node is implemented in the opposite phase */
+      if ( node_match[leaf].map_refs[leaf_phase]++ == 0u && node_match[leaf].best_supergate[leaf_phase] == nullptr )
+      {
+        if constexpr ( SwitchActivity )
+          count += switch_activity[leaf];
+        else
+          count += lib_inv_area;
+      }
+      /* Recursive referencing if leaf was not referenced */
+      if ( node_match[leaf].map_refs[2]++ == 0u )
+      {
+        count += cut_ref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase, part );
+      }
+    }
+    else
+    {
+      ++node_match[leaf].map_refs[2];
+      if ( node_match[leaf].map_refs[leaf_phase]++ == 0u )
+      {
+        count += cut_ref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase, part );
       }
     }
-    return count;
   }
 
   template<bool SwitchActivity>
-  float cut_deref( cut_t const& cut, node<Ntk> const& n, uint8_t phase )
+  float cut_deref( cut_t const& cut, node<Ntk> const& n, uint8_t phase, ela_partition* part )
   {
     auto const& node_data = node_match[ntk.node_to_index( n )];
     float count;
@@ -1236,57 +1492,85 @@ private:
     {
       /* compute leaf phase using the current gate */
       uint8_t leaf_phase = ( node_data.phase[phase] >> ctr++ ) & 1;
+      leaf_deref<SwitchActivity>( leaf, leaf_phase, count, part );
+    }
+    return count;
+  }
 
-      if ( ntk.is_constant( ntk.index_to_node( leaf ) ) )
-      {
-        continue;
-      }
-      else if ( ntk.is_pi( ntk.index_to_node( leaf ) ) )
+  template<bool SwitchActivity>
+  void leaf_deref( uint32_t leaf, uint8_t leaf_phase, float& count, ela_partition* part )
+  {
+    if ( ntk.is_constant( ntk.index_to_node( leaf ) ) )
+    {
+      return;
+    }
+    else if ( part != nullptr && partition_of[leaf] != part->id )
+    {
+      /* dereference nodes of other partitions later, add inverter cost for negative PIs */
+      auto& diff = part->boundary_refs[( static_cast<uint64_t>( leaf ) << 1u ) | leaf_phase];
+      --diff;
+      if ( leaf_phase == 1u && ntk.is_pi( ntk.index_to_node( leaf ) ) && node_match[leaf].map_refs[1] + diff == 0 )
       {
-        /* dereference PIs, add inverter cost for negative phase */
-        if ( leaf_phase == 1u )
-        {
-          if ( --node_match[leaf].map_refs[1] == 0u )
-          {
-            if constexpr ( SwitchActivity )
-              count += switch_activity[leaf];
-            else
-              count += lib_inv_area;
-          }
-        }
+        if constexpr ( SwitchActivity )
+          count += switch_activity[leaf];
         else
-        {
-          --node_match[leaf].map_refs[0];
-        }
-        continue;
+          count += lib_inv_area;
       }
-
-      if ( node_match[leaf].same_match )
+      return;
+    }
+    else if ( ntk.is_pi( ntk.index_to_node( leaf ) ) )
+    {
+      /* dereference PIs, add inverter cost for negative phase */
+      if ( leaf_phase == 1u )
       {
-        /* Add inverter area if it is used only by the current gate and leaf node is implemented in the opposite phase */
-        if ( --node_match[leaf].map_refs[leaf_phase] == 0u && node_match[leaf].best_supergate[leaf_phase] == nullptr )
+        if ( --node_match[leaf].map_refs[1] == 0u )
         {
           if constexpr ( SwitchActivity )
             count += switch_activity[leaf];
           else
             count += lib_inv_area;
         }
-        /* Recursive dereferencing */
-        if ( --node_match[leaf].map_refs[2] == 0u )
-        {
-          count += cut_deref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase );
-        }
       }
       else
       {
-        --node_match[leaf].map_refs[2];
-        if ( --node_match[leaf].map_refs[leaf_phase] == 0u )
-        {
-          count += cut_deref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase );
-        }
+        --node_match[leaf].map_refs[0];
+      }
+      return;
+    }
+
+    if ( node_match[leaf].same_match )
+    {
+      /* Add inverter area if it is used only by the current gate and leaf node is implemented in the opposite phase */
+      if ( --node_match[leaf].map_refs[leaf_phase] == 0u && node_match[leaf].best_supergate[leaf_phase] == nullptr )
+      {
+        if constexpr ( SwitchActivity )
+          count += switch_activity[leaf];
+        else
+          count += lib_inv_area;
+      }
+      /* Recursive dereferencing */
+      if ( --node_match[leaf].map_refs[2] == 0u )
+      {
+        count += cut_deref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase, part );
+      }
+    }
+    else
+    {
+      --node_match[leaf].map_refs[2];
+      if ( --node_match[leaf].map_refs[leaf_phase] == 0u )
+      {
+        count += cut_deref<SwitchActivity>( cuts.cuts( leaf )[node_match[leaf].best_cut[leaf_phase]], ntk.index_to_node( leaf ), leaf_phase, part );
       }
     }
-    return count;
+  }
+
+  /* arrival time of a leaf, which is bounded by its required time for
+     nodes of other partitions, as these may be mapped concurrently */
+  inline double leaf_arrival( uint32_t leaf, uint8_t leaf_phase, ela_partition const* part ) const
+  {
+    if ( part != nullptr && partition_of[leaf] != part->id && partition_of[leaf] != UINT32_MAX )
+      return node_match[leaf].required[leaf_phase];
+    return node_match[leaf].arrival[leaf_phase];
   }
 
   void insert_buffers()
@@ -1593,6 +1877,12 @@ private:
   match_map matches;
   std::vector<float> switch_activity;
   network_cuts_t cuts;
+
+  /* multi-threaded mapping */
+  std::unique_ptr<thread_pool> pool;
+  std::vector<std::vector<uint32_t>> levels;
+  std::vector<ela_partition> partitions;
+  std::vector<uint32_t> partition_of;
 };
 
 } /* namespace detail */
@@ -1620,6 +1910,10 @@ private:
  *
  * The function returns a k-LUT network. Each LUT abstacts a gate of the technology library.
  *
+ * If `Ntk` is a choice network (see `choice_view`), the cuts of each node include
+ * the cuts of its alternatives, such that the gates may be matched on any of the
+ * recorded structures in a single mapping pass.
+ *
  * **Required network functions:**
  * - `size`
  * - `is_pi`
@@ -1657,6 +1951,52 @@ binding_view<klut_network> map( Ntk const& ntk, tech_library<NInputs, Configurat
   detail::tech_map_impl<Ntk, CutSize, CutData, NInputs, Configuration> p( ntk, library, ps, st );
   auto res = p.run();
 
+  st.time_total = st.time_mapping + st.cut_enumeration_st.time_total + st.time_switching_activity;
+  if ( ps.verbose && !st.mapping_error )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return res;
+}
+
+/*! \brief Technology mapping with a given switching activity.
+ *
+ * Same as `map`, but the switching activity of the nodes (indexed by
+ * `node_to_index`) used in the switching power recovery rounds is given,
+ * e.g., to estimate it once with `estimate_switching_activity` and reuse it
+ * when mapping the same network several times.
+ *
+ * \param ntk Network
+ * \param library Technology library
+ * \param switching_activity Switching activity of each node
+ * \param ps Mapping params
+ * \param pst Mapping statistics
+ */
+template<class Ntk, unsigned CutSize = 5u, typename CutData = cut_enumeration_tech_map_cut, unsigned NInputs, classification_type Configuration>
+binding_view<klut_network> map( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, std::vector<float> const& switching_activity, map_params const& ps = {}, map_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+
+  assert( switching_activity.size() == ntk.size() );
+
+  map_stats st;
+  detail::tech_map_impl<Ntk, CutSize, CutData, NInputs, Configuration> p( ntk, library, switching_activity, ps, st );
+  auto res = p.run();
+
   st.time_total = st.time_mapping + st.cut_enumeration_st.time_total;
   if ( ps.verbose && !st.mapping_error )
   {
@@ -1833,7 +2173,7 @@ private:
       std::vector<cut_match_t<NtkDest, NInputs>> node_matches;
 
       auto i = 0u;
-      for ( auto& cut : cuts.cuts( index ) )
+      for ( auto* cut : cuts.cuts( index ) )
       {
         /* ignore unit cut */
         if ( cut->size() == 1 && *cut->begin() == index )
@@ -2218,7 +2558,7 @@ private:
       if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
       {
         auto ctr = 0u;
-        auto best_cut = cuts.cuts( i )[node_data.best_cut[use_phase]];
+        auto const& best_cut = cuts.cuts( i )[node_data.best_cut[use_phase]];
         auto const& match = matches[i][best_cut->data.match_index];
         auto const& supergate = node_data.best_supergate[use_phase];
         for ( auto leaf : best_cut )
@@ -2232,7 +2572,7 @@ private:
       if ( !node_data.same_match && node_data.map_refs[other_phase] > 0 )
       {
         auto ctr = 0u;
-        auto best_cut = cuts.cuts( i )[node_data.best_cut[other_phase]];
+        auto const& best_cut = cuts.cuts( i )[node_data.best_cut[other_phase]];
         auto const& match = matches[i][best_cut->data.match_index];
         auto const& supergate = node_data.best_supergate[other_phase];
         for ( auto leaf : best_cut )
@@ -2289,7 +2629,7 @@ private:
     }
 
     /* foreach cut */
-    for ( auto& cut : cuts.cuts( index ) )
+    for ( auto* cut : cuts.cuts( index ) )
     {
       /* trivial cuts or not matched cuts */
       if ( ( *cut )->data.ignore )
@@ -2409,7 +2749,7 @@ private:
     }
 
     /* foreach cut */
-    for ( auto& cut : cuts.cuts( index ) )
+    for ( auto* cut : cuts.cuts( index ) )
     {
       /* trivial cuts or not matched cuts */
       if ( ( *cut )->data.ignore )
@@ -2654,7 +2994,7 @@ private:
 
     /* foreach cut */
     unsigned int rewrite_count = 1u;
-    for ( auto& cut : cuts.cuts( index ) )
+    for ( auto* cut : cuts.cuts( index ) )
     {
       /* trivial cuts, not matched cuts, or rewriting limit reached */
       if ( ( *cut )->data.ignore || ( rewrite_count > ps.logic_sharing_cut_limit && cut_index != best_cut ) )
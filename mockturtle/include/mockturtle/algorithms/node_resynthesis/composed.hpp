@@ -72,7 +72,7 @@ auto cached_exact_xag_resynthesis( std::string const& cache_filename, uint32_t i
 {
   exact_resynthesis_params exact_ps;
   exact_ps.conflict_limit = conflict_limit;
-  exact_aig_resynthesis<Ntk> exact_resyn( std::is_same_v<typename Ntk::base_type, xag_network>, exact_ps );
+  exact_aig_resynthesis<Ntk> exact_resyn( is_xag_network_type_v<typename Ntk::base_type>, exact_ps );
   exact_blacklist_cache_info info;
   info.conflict_limit = conflict_limit;
   return cached_resynthesis<Ntk, decltype( exact_resyn ), exact_blacklist_cache_info>( exact_resyn, input_limit, cache_filename, info );
@@ -89,19 +89,21 @@ public:
     }
   }
 
-  template<typename LeavesIterator, typename Fn>
-  void operator()( mig_network& mig, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
+  template<class Ntk, typename LeavesIterator, typename Fn>
+  void operator()( Ntk& mig, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
+    static_assert( is_mig_network_type_v<typename Ntk::base_type>, "Ntk is not MIG-like" );
+
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
     const auto config = kitty::exact_npn_canonization( fe );
 
     const auto it = class2signal.find( static_cast<uint16_t>( std::get<0>( config )._bits[0] ) );
 
-    std::vector<mig_network::signal> pis( 4, mig.get_constant( false ) );
+    std::vector<typename Ntk::signal> pis( 4, mig.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
 
-    std::vector<mig_network::signal> pis_perm( 4 );
+    std::vector<typename Ntk::signal> pis_perm( 4 );
     auto perm = std::get<2>( config );
     for ( auto i = 0; i < 4; ++i )
     {
@@ -84,9 +84,11 @@ public:
     build_db();
   }
 
-  template<typename LeavesIterator, typename Fn>
-  void operator()( xmg_network& xmg, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
+  template<class Ntk, typename LeavesIterator, typename Fn>
+  void operator()( Ntk& xmg, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
+    static_assert( is_xmg_network_type_v<typename Ntk::base_type>, "Ntk is not XMG-like" );
+
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
     const auto config = kitty::exact_npn_canonization( fe );
@@ -97,10 +99,10 @@ public:
 
     // const auto it = class2signal.find( static_cast<uint16_t>( std::get<0>( config )._bits[0] ) );
 
-    std::vector<xmg_network::signal> pis( 4, xmg.get_constant( false ) );
+    std::vector<typename Ntk::signal> pis( 4, xmg.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
 
-    std::vector<xmg_network::signal> pis_perm( 4 );
+    std::vector<typename Ntk::signal> pis_perm( 4 );
     auto perm = std::get<2>( config );
     for ( auto i = 0; i < 4; ++i )
     {
@@ -0,0 +1,409 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file parallel_simulation.hpp
+  \brief Multi-threaded simulation of whole networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for parallel_simulate_nodes.
+ *
+ * The data structure `parallel_simulation_params` holds configurable
+ * parameters with default arguments for `parallel_simulate_nodes` and
+ * `parallel_simulate`.
+ */
+struct parallel_simulation_params
+{
+  /*! \brief Partitioning of the work among threads. */
+  enum class partition_t
+  {
+    /*! \brief Words if supported and there are enough patterns, otherwise levels. */
+    automatic,
+    /*! \brief Gates of the same level are simulated in parallel. */
+    levels,
+    /*! \brief Each thread simulates all gates for a slice of the words (`simd_simulator` only). */
+    words
+  };
+
+  /*! \brief Number of threads (0 uses the hardware concurrency). */
+  uint32_t num_threads{ 0u };
+
+  /*! \brief Partitioning of the work among threads. */
+  partition_t partition{ partition_t::automatic };
+
+  /*! \brief Number of gates per task when partitioning by levels. */
+  uint32_t gates_per_task{ 64u };
+
+  /*! \brief Number of words per task when partitioning by words (0 is automatic). */
+  uint32_t words_per_task{ 0u };
+};
+
+/*! \brief Statistics for parallel_simulate_nodes. */
+struct parallel_simulation_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of threads. */
+  uint32_t num_threads{ 0u };
+
+  /*! \brief Number of levels (0 if partitioned by words). */
+  uint32_t num_levels{ 0u };
+
+  /*! \brief Whether the work was partitioned by words. */
+  bool by_words{ false };
+
+  void report() const
+  {
+    fmt::print( "[i] threads    = {}\n", num_threads );
+    fmt::print( "[i] partition  = {}\n", by_words ? "words" : fmt::format( "{} levels", num_levels ) );
+    fmt::print( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class SimulationType, class Ntk, class Simulator>
+class parallel_simulation_impl
+{
+  using node = typename Ntk::node;
+
+public:
+  parallel_simulation_impl( Ntk const& ntk, Simulator const& sim, parallel_simulation_params const& ps, parallel_simulation_stats& st )
+      : ntk( ntk ), sim( sim ), ps( ps ), st( st ), pool( ps.num_threads ), node_to_value( ntk )
+  {
+  }
+
+  node_map<SimulationType, Ntk> run()
+  {
+    stopwatch t( st.time_total );
+    st.num_threads = pool.num_threads();
+
+    simulate_inputs();
+    sort_gates();
+
+    if ( use_words() )
+    {
+      st.by_words = true;
+      simulate_by_words();
+    }
+    else
+    {
+      simulate_by_levels();
+    }
+
+    return node_to_value;
+  }
+
+private:
+  void simulate_inputs()
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      node_to_value[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+    }
+
+    std::vector<node> pis;
+    pis.reserve( ntk.num_pis() );
+    ntk.foreach_pi( [&]( auto const& n ) {
+      pis.push_back( n );
+    } );
+    pool.parallel_for( 0u, pis.size(), 16u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+      for ( auto i = begin; i < end; ++i )
+      {
+        node_to_value[pis[i]] = sim.compute_pi( static_cast<uint32_t>( i ) );
+      }
+    } );
+  }
+
+  /* sorts the gates by level (stable, hence also in topological order) */
+  void sort_gates()
+  {
+    std::vector<uint32_t> levels( ntk.size(), 0u );
+    std::vector<uint32_t> counts( 1u, 0u );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      uint32_t level = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+      levels[ntk.node_to_index( n )] = ++level;
+      if ( level >= counts.size() )
+      {
+        counts.resize( level + 1u, 0u );
+      }
+      ++counts[level];
+    } );
+
+    level_begin.assign( counts.size() + 1u, 0u );
+    for ( auto l = 1u; l < counts.size(); ++l )
+    {
+      level_begin[l + 1u] = level_begin[l] + counts[l];
+    }
+    gates.resize( level_begin.back() );
+    auto next = level_begin;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      gates[next[levels[ntk.node_to_index( n )]]++] = n;
+    } );
+  }
+
+  bool use_words() const
+  {
+    if constexpr ( is_simd_simulator_v<Simulator> )
+    {
+      if ( ps.partition == parallel_simulation_params::partition_t::levels )
+      {
+        return false;
+      }
+      if ( !std::all_of( gates.begin(), gates.end(), [&]( auto const& n ) { return simd_op_of( ntk, n ) != simd_op::none; } ) )
+      {
+        return false;
+      }
+      /* every thread gets at least one 512-bit vector per task */
+      return ps.partition == parallel_simulation_params::partition_t::words ||
+             num_words() >= 8u * pool.num_threads();
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  uint64_t num_words() const
+  {
+    return static_cast<uint64_t>( node_to_value[ntk.get_node( ntk.get_constant( false ) )].num_blocks() );
+  }
+
+  void simulate_by_levels()
+  {
+    st.num_levels = static_cast<uint32_t>( level_begin.size() ) - 2u;
+
+    std::vector<std::vector<SimulationType>> fanin_values( pool.num_threads() );
+    for ( auto l = 1u; l + 1u < level_begin.size(); ++l )
+    {
+      pool.parallel_for( level_begin[l], level_begin[l + 1u], ps.gates_per_task, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          simulate_gate( gates[i], fanin_values[thread] );
+        }
+      } );
+    }
+  }
+
+  void simulate_gate( node const& n, std::vector<SimulationType>& fanin_values )
+  {
+    if constexpr ( is_simd_simulator_v<Simulator> )
+    {
+      if ( simd_op_of( ntk, n ) != simd_op::none )
+      {
+        simd_simulate_node( ntk, n, node_to_value, sim, false );
+        return;
+      }
+    }
+
+    fanin_values.resize( ntk.fanin_size( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      fanin_values[i] = node_to_value[ntk.get_node( f )];
+    } );
+    node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+  }
+
+  void simulate_by_words()
+  {
+    if constexpr ( is_simd_simulator_v<Simulator> )
+    {
+      const auto prototype = node_to_value[ntk.get_node( ntk.get_constant( false ) )];
+      pool.parallel_for( 0u, gates.size(), 1024u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          node_to_value[gates[i]] = prototype;
+        }
+      } );
+
+      const auto words = num_words();
+      auto slice = ps.words_per_task != 0u ? ps.words_per_task : std::max<uint64_t>( 8u, words / ( 4u * pool.num_threads() ) );
+      slice = ( slice + 7u ) & ~UINT64_C( 7 );
+
+      const auto words_of = [&]( auto const& n ) -> uint64_t const* {
+        return simd_words( node_to_value[n] );
+      };
+      pool.parallel_for( 0u, words, slice, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+        for ( auto const& n : gates )
+        {
+          simd_compute_gate( ntk, n, sim.kernel(), simd_words( node_to_value[n] ), words_of, begin, end );
+        }
+      } );
+
+      pool.parallel_for( 0u, gates.size(), 1024u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          node_to_value[gates[i]].mask_bits();
+        }
+      } );
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  Simulator const& sim;
+  parallel_simulation_params const& ps;
+  parallel_simulation_stats& st;
+
+  thread_pool pool;
+  node_map<SimulationType, Ntk> node_to_value;
+  std::vector<node> gates;
+  std::vector<uint64_t> level_begin;
+};
+
+} // namespace detail
+
+/*! \brief Simulates a network with several threads.
+ *
+ * This function computes the same values as `simulate_nodes`, but
+ * simulates gates on a work-stealing thread pool.  By default, gates are
+ * grouped by level and the gates of one level are simulated in parallel,
+ * which works with every simulator.  With a `simd_simulator` on networks
+ * in which all gates are supported by the vectorized kernels (AIGs, XAGs,
+ * MIGs, and XMGs), the words of the simulation patterns are partitioned
+ * instead, and each thread simulates all gates for its slice of words
+ * without synchronization between levels.
+ *
+ * Since every value only depends on the values of the fan-ins, the result
+ * does not depend on the number of threads or on the schedule.  The
+ * `compute` method of the network must be safe to call concurrently, and
+ * simulation values of type `bool` are simulated with one thread, since
+ * they do not have separate memory locations in a node map.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<SimulationType>`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      simd_simulator<> sim( aig.num_pis(), 100000u );
+      parallel_simulation_params ps;
+      ps.num_threads = 16u;
+      const auto tts = parallel_simulate_nodes<kitty::partial_truth_table>( aig, sim, ps );
+   \endverbatim
+ *
+ * \param ntk Network
+ * \param sim Simulator, which implements the simulator interface
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class SimulationType, class Ntk, class Simulator = default_simulator<SimulationType>>
+node_map<SimulationType, Ntk> parallel_simulate_nodes( Ntk const& ntk, Simulator const& sim = Simulator(), parallel_simulation_params const& ps = {}, parallel_simulation_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute method for SimulationType" );
+
+  parallel_simulation_stats st;
+  parallel_simulation_params ps_local = ps;
+  if constexpr ( std::is_same_v<SimulationType, bool> )
+  {
+    ps_local.num_threads = 1u;
+  }
+
+  detail::parallel_simulation_impl<SimulationType, Ntk, Simulator> p( ntk, sim, ps_local, st );
+  auto node_to_value = p.run();
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return node_to_value;
+}
+
+/*! \brief Simulates the outputs of a network with several threads.
+ *
+ * This function computes the same values as `simulate` using
+ * `parallel_simulate_nodes`.
+ *
+ * \param ntk Network
+ * \param sim Simulator, which implements the simulator interface
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class SimulationType, class Ntk, class Simulator = default_simulator<SimulationType>>
+std::vector<SimulationType> parallel_simulate( Ntk const& ntk, Simulator const& sim = Simulator(), parallel_simulation_params const& ps = {}, parallel_simulation_stats* pst = nullptr )
+{
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+
+  const auto node_to_value = parallel_simulate_nodes<SimulationType>( ntk, sim, ps, pst );
+
+  std::vector<SimulationType> po_values( ntk.num_pos() );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    if ( ntk.is_complemented( f ) )
+    {
+      po_values[i] = sim.compute_not( node_to_value[f] );
+    }
+    else
+    {
+      po_values[i] = node_to_value[f];
+    }
+  } );
+  return po_values;
+}
+
+} // namespace mockturtle
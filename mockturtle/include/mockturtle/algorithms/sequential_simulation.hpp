@@ -0,0 +1,397 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file sequential_simulation.hpp
+  \brief Bit-parallel multi-cycle simulation of sequential networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for simulate_sequential.
+ *
+ * The data structure `sequential_simulation_params` holds configurable
+ * parameters with default arguments for `simulate_sequential`.
+ */
+struct sequential_simulation_params
+{
+  /*! \brief Number of independent traces simulated in parallel (one bit each). */
+  uint32_t num_traces{ 256u };
+
+  /*! \brief Number of clock cycles. */
+  uint32_t num_cycles{ 64u };
+
+  /*! \brief Probability that a PI changes its value from one cycle to the next. */
+  double input_switching_probability{ 0.5 };
+
+  /*! \brief Initialize registers with unknown reset value randomly (instead of with 0). */
+  bool random_unknown_init{ false };
+
+  /*! \brief Keep the values of the POs of every cycle. */
+  bool record_pos{ true };
+
+  /*! \brief Seed for the random stimuli. */
+  uint64_t seed{ 0xcafeaffe };
+};
+
+/*! \brief Statistics for simulate_sequential. */
+struct sequential_simulation_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of simulated cycles. */
+  uint32_t num_cycles{ 0u };
+
+  /*! \brief Number of traces. */
+  uint32_t num_traces{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] cycles     = {} x {} traces\n", num_cycles, num_traces );
+    fmt::print( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+/*! \brief Simulates a sequential network cycle by cycle.
+ *
+ * Every node holds one bit per trace, such that `num_traces` independent
+ * stimulus traces are simulated in parallel.  The register state is carried
+ * from one cycle to the next: in each cycle, the register outputs take the
+ * values that the register inputs had in the previous cycle, starting from
+ * the reset values of the registers (see `register_t::init`).
+ *
+ * The number of value changes of each node between consecutive cycles is
+ * accumulated over all traces and cycles.  Gates are computed with the
+ * kernels of `simd_simulator` when possible.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      sequential<aig_network> aig = ...;
+      sequential_simulator sim( aig, 256u );
+      std::vector<kitty::partial_truth_table> inputs( aig.num_pis(), kitty::partial_truth_table( 256u ) );
+      for ( auto cycle = 0u; cycle < 100u; ++cycle )
+      {
+        // set inputs
+        sim.step( inputs );
+        // read sim.po_value( i )
+      }
+   \endverbatim
+ */
+template<class Ntk>
+class sequential_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  sequential_simulator( Ntk const& ntk, uint32_t num_traces, bool random_unknown_init = false, uint64_t seed = 0xcafeaffe )
+      : ntk( ntk ), num_traces( num_traces ), current( ntk ), previous( ntk ), counts( ntk.size(), 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_ro_v<Ntk>, "Ntk does not implement the foreach_ro method" );
+    static_assert( has_foreach_ri_v<Ntk>, "Ntk does not implement the foreach_ri method" );
+    static_assert( has_num_registers_v<Ntk>, "Ntk does not implement the num_registers method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+
+    reset( random_unknown_init, seed );
+  }
+
+  /*! \brief Sets the registers to their reset values and clears all counts. */
+  void reset( bool random_unknown_init = false, uint64_t seed = 0xcafeaffe )
+  {
+    std::default_random_engine rng( seed );
+    state.assign( ntk.num_registers(), kitty::partial_truth_table( num_traces ) );
+    for ( auto i = 0u; i < state.size(); ++i )
+    {
+      switch ( ntk.register_at( i ).init )
+      {
+      case 0u:
+        break;
+      case 1u:
+        state[i] = ~state[i];
+        break;
+      default:
+        if ( random_unknown_init )
+        {
+          kitty::create_random( state[i], rng() );
+        }
+        break;
+      }
+    }
+    std::fill( counts.begin(), counts.end(), 0u );
+    cycles = 0u;
+  }
+
+  /*! \brief Simulates one cycle with the given PI values (one truth table with `num_traces` bits per PI). */
+  void step( std::vector<kitty::partial_truth_table> const& pi_values )
+  {
+    assert( pi_values.size() == ntk.num_pis() );
+    std::swap( current, previous );
+
+    const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+    current[c0] = kitty::partial_truth_table( num_traces );
+    if ( ntk.constant_value( c0 ) )
+    {
+      current[c0] = ~current[c0];
+    }
+    if ( ntk.get_node( ntk.get_constant( true ) ) != c0 )
+    {
+      current[ntk.get_node( ntk.get_constant( true ) )] = ~current[c0];
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      assert( pi_values[i].num_bits() == num_traces );
+      current[n] = pi_values[i];
+    } );
+    ntk.foreach_ro( [&]( auto const& n, auto i ) {
+      current[n] = state[i];
+    } );
+
+    ntk.foreach_gate( [&]( auto const& n ) {
+      if ( detail::simd_op_of( ntk, n ) != detail::simd_op::none )
+      {
+        current[n].resize( num_traces );
+        detail::simd_simulate_node( ntk, n, current, kernels, false );
+      }
+      else
+      {
+        fanin_values.resize( ntk.fanin_size( n ) );
+        ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          fanin_values[i] = current[f];
+        } );
+        current[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+      }
+    } );
+
+    /* next state */
+    ntk.foreach_ri( [&]( auto const& f, auto i ) {
+      state[i] = ntk.is_complemented( f ) ? ~current[f] : current[f];
+    } );
+
+    if ( cycles > 0u )
+    {
+      ntk.foreach_node( [&]( auto const& n ) {
+        counts[ntk.node_to_index( n )] += count_toggles( current[n], previous[n] );
+      } );
+    }
+    ++cycles;
+  }
+
+  /*! \brief Values of node `n` in the last simulated cycle. */
+  kitty::partial_truth_table const& value( node const& n ) const
+  {
+    return current[n];
+  }
+
+  /*! \brief Values of the `index`-th PO in the last simulated cycle. */
+  kitty::partial_truth_table po_value( uint32_t index ) const
+  {
+    const auto f = ntk.po_at( index );
+    return ntk.is_complemented( f ) ? ~current[f] : current[f];
+  }
+
+  /*! \brief Values of the `index`-th register for the next cycle. */
+  kitty::partial_truth_table const& register_value( uint32_t index ) const
+  {
+    return state[index];
+  }
+
+  /*! \brief Number of value changes of node `n` between consecutive cycles (all traces). */
+  uint64_t toggles( node const& n ) const
+  {
+    return counts[ntk.node_to_index( n )];
+  }
+
+  /*! \brief Fraction of cycles and traces in which node `n` changed its value. */
+  double toggle_rate( node const& n ) const
+  {
+    return cycles > 1u ? static_cast<double>( toggles( n ) ) / ( static_cast<double>( cycles - 1u ) * num_traces ) : 0.0;
+  }
+
+  /*! \brief Number of simulated cycles since the last reset. */
+  uint32_t num_cycles() const
+  {
+    return cycles;
+  }
+
+  /*! \brief Restricts the instruction set of the simulation kernels. */
+  void set_simd_level( simd_level level )
+  {
+    kernels.set_level( level );
+  }
+
+private:
+  static uint64_t count_toggles( kitty::partial_truth_table const& a, kitty::partial_truth_table const& b )
+  {
+    uint64_t count = 0u;
+    for ( auto w = 0u; w < a._bits.size(); ++w )
+    {
+      const auto diff = a._bits[w] ^ b._bits[w];
+      count += std::bitset<64>( diff ).count();
+    }
+    return count;
+  }
+
+private:
+  Ntk const& ntk;
+  uint32_t num_traces;
+  detail::simd_kernel_selection kernels;
+
+  node_map<kitty::partial_truth_table, Ntk> current;
+  node_map<kitty::partial_truth_table, Ntk> previous;
+  std::vector<kitty::partial_truth_table> state;
+  std::vector<kitty::partial_truth_table> fanin_values;
+  std::vector<uint64_t> counts;
+  uint32_t cycles{ 0u };
+};
+
+/*! \brief Result of simulate_sequential. */
+struct sequential_simulation_result
+{
+  /*! \brief Values of the POs for each cycle (if `record_pos` is set). */
+  std::vector<std::vector<kitty::partial_truth_table>> po_values;
+
+  /*! \brief Number of value changes of each node (by node index). */
+  std::vector<uint64_t> toggles;
+
+  /*! \brief Fraction of cycles and traces in which each node (by node index) changed its value. */
+  std::vector<float> toggle_rates;
+};
+
+/*! \brief Simulates a sequential network with random stimuli over several cycles.
+ *
+ * All `num_traces` traces start in the reset state of the registers.  In
+ * the first cycle, the PIs are assigned random values; in each following
+ * cycle, every PI changes its value with probability
+ * `input_switching_probability`.  Unlike random simulation of the
+ * combinational core, values of consecutive cycles are correlated through
+ * the registers.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_ro`
+ * - `foreach_ri`
+ * - `register_at`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * \param ntk Sequential network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+sequential_simulation_result simulate_sequential( Ntk const& ntk, sequential_simulation_params const& ps = {}, sequential_simulation_stats* pst = nullptr )
+{
+  sequential_simulation_stats st;
+  sequential_simulation_result result;
+
+  {
+    stopwatch t( st.time_total );
+
+    sequential_simulator<Ntk> sim( ntk, ps.num_traces, ps.random_unknown_init, ps.seed );
+    std::default_random_engine rng( ps.seed + 1u );
+
+    /* after the first cycle, each bit of a PI flips with the switching probability */
+    std::vector<kitty::partial_truth_table> inputs( ntk.num_pis(), kitty::partial_truth_table( ps.num_traces ) );
+    std::bernoulli_distribution flip( ps.input_switching_probability );
+
+    for ( auto cycle = 0u; cycle < ps.num_cycles; ++cycle )
+    {
+      for ( auto& tt : inputs )
+      {
+        if ( cycle == 0u || ps.input_switching_probability == 0.5 )
+        {
+          kitty::create_random( tt, rng() );
+        }
+        else
+        {
+          for ( auto b = 0u; b < ps.num_traces; ++b )
+          {
+            if ( flip( rng ) )
+            {
+              kitty::flip_bit( tt, b );
+            }
+          }
+        }
+      }
+
+      sim.step( inputs );
+
+      if ( ps.record_pos )
+      {
+        auto& pos = result.po_values.emplace_back( ntk.num_pos() );
+        for ( auto i = 0u; i < ntk.num_pos(); ++i )
+        {
+          pos[i] = sim.po_value( i );
+        }
+      }
+    }
+
+    result.toggles.resize( ntk.size(), 0u );
+    result.toggle_rates.resize( ntk.size(), 0.0f );
+    ntk.foreach_node( [&]( auto const& n ) {
+      result.toggles[ntk.node_to_index( n )] = sim.toggles( n );
+      result.toggle_rates[ntk.node_to_index( n )] = static_cast<float>( sim.toggle_rate( n ) );
+    } );
+
+    st.num_cycles = sim.num_cycles();
+    st.num_traces = ps.num_traces;
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return result;
+}
+
+} // namespace mockturtle
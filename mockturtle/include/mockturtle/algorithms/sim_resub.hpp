@@ -355,13 +355,13 @@ void sim_resubstitution_run( Ntk& ntk, resubstitution_params const& ps, resubsti
 template<class Ntk>
 void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubstitution_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network> || std::is_same_v<typename Ntk::base_type, xag_network>, "Currently only supports AIG and XAG" );
+  static_assert( is_aig_network_type_v<typename Ntk::base_type> || is_xag_network_type_v<typename Ntk::base_type>, "Currently only supports AIG and XAG" );
 
   using resub_view_t = fanout_view<depth_view<Ntk>>;
   depth_view<Ntk> depth_view{ ntk };
   resub_view_t resub_view{ depth_view };
 
-  if constexpr ( std::is_same_v<typename Ntk::base_type, aig_network> )
+  if constexpr ( is_aig_network_type_v<typename Ntk::base_type> )
   {
     using resyn_engine_t = xag_resyn_decompose<kitty::partial_truth_table, aig_resyn_static_params_for_sim_resub<resub_view_t>>;
 
@@ -41,6 +41,7 @@
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "detail/simd_kernels.hpp"
 
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
@@ -480,6 +481,345 @@ private:
   uint32_t packed_patterns;
 };
 
+/*! \brief Simulates with vectorized kernels.
+ *
+ * This simulator computes the same values as `partial_simulator` (for
+ * `kitty::partial_truth_table`) or `default_simulator` (for
+ * `kitty::static_truth_table`), but `simulate_nodes`, `simulate`, and
+ * `simulate_node` compute AND, XOR, majority, and if-then-else gates in
+ * place with SIMD kernels instead of through the truth table operators.
+ * `simulate` keeps the values of all nodes in one aligned block of memory
+ * instead of one truth table per node.  Other gates (e.g., in k-LUT
+ * networks) are computed with the `compute` method of the network.
+ *
+ * The instruction set (AVX-512, AVX2, or 64-bit words) is selected at
+ * runtime and can be restricted with `set_level`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      simd_simulator<> sim( aig.num_pis(), 1024 );
+      const auto tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+   \endverbatim
+ */
+template<class SimulationType = kitty::partial_truth_table>
+class simd_simulator
+{
+public:
+  simd_simulator() = delete;
+};
+
+namespace detail
+{
+
+class simd_kernel_selection
+{
+public:
+  /*! \brief Restricts the kernels to an instruction set supported by the CPU. */
+  void set_level( simd_level level )
+  {
+    _level = std::min( level, simd_supported_level() );
+    _kernel = simd_kernel_for( _level );
+  }
+
+  /*! \brief Instruction set of the kernels. */
+  simd_level level() const
+  {
+    return _level;
+  }
+
+  simd_kernel kernel() const
+  {
+    return _kernel;
+  }
+
+private:
+  simd_level _level{ simd_supported_level() };
+  simd_kernel _kernel{ simd_kernel_for( _level ) };
+};
+
+} // namespace detail
+
+template<>
+class simd_simulator<kitty::partial_truth_table> : public partial_simulator, public detail::simd_kernel_selection
+{
+public:
+  using partial_simulator::partial_simulator;
+
+  simd_simulator( partial_simulator const& sim )
+      : partial_simulator( sim )
+  {}
+};
+
+template<uint32_t NumVars>
+class simd_simulator<kitty::static_truth_table<NumVars>> : public default_simulator<kitty::static_truth_table<NumVars>>, public detail::simd_kernel_selection
+{
+};
+
+template<class Simulator>
+struct is_simd_simulator : std::false_type
+{
+};
+
+template<class SimulationType>
+struct is_simd_simulator<simd_simulator<SimulationType>> : std::true_type
+{
+};
+
+template<class Simulator>
+inline constexpr bool is_simd_simulator_v = is_simd_simulator<Simulator>::value;
+
+namespace detail
+{
+
+inline uint64_t* simd_words( kitty::partial_truth_table& tt )
+{
+  return tt._bits.data();
+}
+
+inline uint64_t const* simd_words( kitty::partial_truth_table const& tt )
+{
+  return tt._bits.data();
+}
+
+template<uint32_t NumVars>
+uint64_t* simd_words( kitty::static_truth_table<NumVars>& tt )
+{
+  if constexpr ( NumVars <= 6 )
+  {
+    return &tt._bits;
+  }
+  else
+  {
+    return tt._bits.data();
+  }
+}
+
+template<uint32_t NumVars>
+uint64_t const* simd_words( kitty::static_truth_table<NumVars> const& tt )
+{
+  return simd_words( const_cast<kitty::static_truth_table<NumVars>&>( tt ) );
+}
+
+/* copies words into a truth table of the right size */
+template<class TT>
+void simd_load( TT& tt, uint64_t const* words )
+{
+  std::copy( words, words + tt.num_blocks(), simd_words( tt ) );
+  tt.mask_bits();
+}
+
+/* operation of a gate that is supported by the kernels */
+template<class Ntk>
+simd_op simd_op_of( Ntk const& ntk, typename Ntk::node const& n )
+{
+  const auto size = ntk.fanin_size( n );
+  if constexpr ( has_is_and_v<Ntk> )
+  {
+    if ( ntk.is_and( n ) )
+    {
+      return size == 2u ? simd_op::and2 : simd_op::none;
+    }
+  }
+  if constexpr ( has_is_xor_v<Ntk> )
+  {
+    if ( ntk.is_xor( n ) )
+    {
+      return size == 2u ? simd_op::xor2 : simd_op::none;
+    }
+  }
+  if constexpr ( has_is_maj_v<Ntk> )
+  {
+    if ( ntk.is_maj( n ) )
+    {
+      return size == 3u ? simd_op::maj3 : simd_op::none;
+    }
+  }
+  if constexpr ( has_is_xor3_v<Ntk> )
+  {
+    if ( ntk.is_xor3( n ) )
+    {
+      return size == 3u ? simd_op::xor3 : simd_op::none;
+    }
+  }
+  if constexpr ( has_is_ite_v<Ntk> )
+  {
+    if ( ntk.is_ite( n ) )
+    {
+      return size == 3u ? simd_op::ite3 : simd_op::none;
+    }
+  }
+  return simd_op::none;
+}
+
+/* computes words [begin, end) of gate `n` into `result`, `words_of` returns
+   the words of a fan-in node; returns false if the gate is not supported */
+template<class Ntk, class WordsFn>
+bool simd_compute_gate( Ntk const& ntk, typename Ntk::node const& n, simd_kernel kernel, uint64_t* result, WordsFn&& words_of, uint64_t begin, uint64_t end )
+{
+  const auto op = simd_op_of( ntk, n );
+  if ( op == simd_op::none )
+  {
+    return false;
+  }
+
+  uint64_t const* fanins[3];
+  uint64_t masks[3] = { 0u, 0u, 0u };
+  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+    fanins[i] = words_of( ntk.get_node( f ) );
+    masks[i] = ntk.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+  } );
+  if ( op == simd_op::and2 || op == simd_op::xor2 )
+  {
+    fanins[2] = fanins[0];
+  }
+
+  kernel( op, result, fanins, masks, begin, end );
+  return true;
+}
+
+/* simulates all constants, PIs, and gates into rows of an arena indexed by
+   `node_to_index`; `prototype` is a truth table of the right size */
+template<class SimulationType, class Ntk, class Simulator>
+simd_arena simd_simulate_arena( Ntk const& ntk, Simulator const& sim, SimulationType const& prototype )
+{
+  const auto num_words = static_cast<uint64_t>( prototype.num_blocks() );
+  simd_arena arena( ntk.size(), num_words );
+
+  const auto store = [&]( auto const& n, SimulationType const& value ) {
+    std::copy( simd_words( value ), simd_words( value ) + num_words, arena.row( ntk.node_to_index( n ) ) );
+  };
+
+  store( ntk.get_node( ntk.get_constant( false ) ), sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) ) );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    store( ntk.get_node( ntk.get_constant( true ) ), sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    store( n, sim.compute_pi( i ) );
+  } );
+
+  const auto words_of = [&]( auto const& n ) -> uint64_t const* {
+    return arena.row( ntk.node_to_index( n ) );
+  };
+
+  std::vector<SimulationType> fanin_values;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( !simd_compute_gate( ntk, n, sim.kernel(), arena.row( ntk.node_to_index( n ) ), words_of, 0u, num_words ) )
+    {
+      /* bits beyond the number of patterns are not masked in the arena */
+      fanin_values.assign( ntk.fanin_size( n ), prototype );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        simd_load( fanin_values[i], words_of( ntk.get_node( f ) ) );
+      } );
+      store( n, ntk.compute( n, fanin_values.begin(), fanin_values.end() ) );
+    }
+  } );
+
+  return arena;
+}
+
+/* simulates gate `n` in place, if `last_block` is true, only the last word is computed */
+template<class Ntk, class Container, class Simulator>
+void simd_simulate_node( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value, Simulator const& sim, bool last_block )
+{
+  auto& result = node_to_value[n];
+
+  typename Ntk::node first{};
+  ntk.foreach_fanin( n, [&]( auto const& f ) {
+    first = ntk.get_node( f );
+    return false;
+  } );
+  auto const& value = node_to_value[first];
+  if constexpr ( std::is_same_v<std::decay_t<decltype( result )>, kitty::partial_truth_table> )
+  {
+    assert( value.num_bits() >= result.num_bits() );
+    result.resize( value.num_bits() );
+  }
+
+  const auto num_words = static_cast<uint64_t>( value.num_blocks() );
+  const auto words_of = [&]( auto const& f ) -> uint64_t const* {
+    return simd_words( node_to_value[f] );
+  };
+  const bool okay = simd_compute_gate( ntk, n, sim.kernel(), simd_words( result ), words_of, last_block ? num_words - 1u : 0u, num_words );
+  (void)okay;
+  assert( okay && "gate is not supported by the kernels" );
+  result.mask_bits();
+}
+
+/* whether gate `n` is simulated in place with `Simulator` */
+template<class Simulator, class Ntk>
+bool is_simd_gate( Ntk const& ntk, typename Ntk::node const& n )
+{
+  if constexpr ( is_simd_simulator_v<Simulator> )
+  {
+    return simd_op_of( ntk, n ) != simd_op::none;
+  }
+  else
+  {
+    (void)ntk;
+    (void)n;
+    return false;
+  }
+}
+
+/* the values are computed in place in the node map, which avoids copying
+   them out of an arena */
+template<class SimulationType, class Ntk, class Simulator>
+node_map<SimulationType, Ntk> simd_simulate_nodes( Ntk const& ntk, Simulator const& sim )
+{
+  node_map<SimulationType, Ntk> node_to_value( ntk );
+
+  node_to_value[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    node_to_value[n] = sim.compute_pi( i );
+  } );
+
+  std::vector<SimulationType> fanin_values;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( simd_op_of( ntk, n ) != simd_op::none )
+    {
+      simd_simulate_node( ntk, n, node_to_value, sim, false );
+    }
+    else
+    {
+      fanin_values.resize( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = node_to_value[f];
+      } );
+      node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+  } );
+
+  return node_to_value;
+}
+
+template<class SimulationType, class Ntk, class Simulator>
+std::vector<SimulationType> simd_simulate( Ntk const& ntk, Simulator const& sim )
+{
+  const auto prototype = sim.compute_constant( false );
+  const auto arena = simd_simulate_arena<SimulationType>( ntk, sim, prototype );
+
+  std::vector<SimulationType> po_values( ntk.num_pos(), prototype );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    simd_load( po_values[i], arena.row( ntk.node_to_index( ntk.get_node( f ) ) ) );
+    if ( ntk.is_complemented( f ) )
+    {
+      po_values[i] = sim.compute_not( po_values[i] );
+    }
+  } );
+  return po_values;
+}
+
+} // namespace detail
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
@@ -525,6 +865,11 @@ node_map<SimulationType, Ntk> simulate_nodes( Ntk const& ntk, Simulator const& s
   static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
   static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute method for SimulationType" );
 
+  if constexpr ( is_simd_simulator_v<Simulator> )
+  {
+    return detail::simd_simulate_nodes<SimulationType>( ntk, sim );
+  }
+
   node_map<SimulationType, Ntk> node_to_value( ntk );
 
   node_to_value[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
@@ -589,6 +934,15 @@ void simulate_nodes_with_node_map( Ntk const& ntk, Container& node_to_value, Sim
   ntk.foreach_gate( [&]( auto const& n ) {
     if ( !node_to_value.has( n ) )
     {
+      if constexpr ( is_simd_simulator_v<Simulator> )
+      {
+        if ( detail::is_simd_gate<Simulator>( ntk, n ) )
+        {
+          detail::simd_simulate_node( ntk, n, node_to_value, sim, false );
+          return;
+        }
+      }
+
       std::vector<SimulationType> fanin_values( ntk.fanin_size( n ) );
       ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
         fanin_values[i] = node_to_value[ntk.get_node( f )];
@@ -654,7 +1008,8 @@ void re_simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Contai
 template<class Ntk, class Simulator, class Container>
 void simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value, Simulator const& sim )
 {
-  std::vector<kitty::partial_truth_table> fanin_values( ntk.fanin_size( n ) );
+  const bool simd = is_simd_gate<Simulator>( ntk, n );
+  std::vector<kitty::partial_truth_table> fanin_values( simd ? 0u : ntk.fanin_size( n ) );
   ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
     if ( !node_to_value.has( ntk.get_node( f ) ) )
     {
@@ -664,15 +1019,28 @@ void simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Container
     {
       re_simulate_fanin_cone( ntk, ntk.get_node( f ), node_to_value, sim );
     }
-    fanin_values[i] = node_to_value[ntk.get_node( f )];
+    if ( !simd )
+    {
+      fanin_values[i] = node_to_value[ntk.get_node( f )];
+    }
   } );
+
+  if constexpr ( is_simd_simulator_v<Simulator> )
+  {
+    if ( simd )
+    {
+      simd_simulate_node( ntk, n, node_to_value, sim, false );
+      return;
+    }
+  }
   node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
 }
 
 template<class Ntk, class Simulator, class Container>
 void re_simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value, Simulator const& sim )
 {
-  std::vector<kitty::partial_truth_table> fanin_values( ntk.fanin_size( n ) );
+  const bool simd = is_simd_gate<Simulator>( ntk, n );
+  std::vector<kitty::partial_truth_table> fanin_values( simd ? 0u : ntk.fanin_size( n ) );
   ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
     if ( !node_to_value.has( ntk.get_node( f ) ) )
     {
@@ -682,8 +1050,20 @@ void re_simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Contai
     {
       re_simulate_fanin_cone( ntk, ntk.get_node( f ), node_to_value, sim );
     }
-    fanin_values[i] = node_to_value[ntk.get_node( f )];
+    if ( !simd )
+    {
+      fanin_values[i] = node_to_value[ntk.get_node( f )];
+    }
   } );
+
+  if constexpr ( is_simd_simulator_v<Simulator> )
+  {
+    if ( simd )
+    {
+      simd_simulate_node( ntk, n, node_to_value, sim, true );
+      return;
+    }
+  }
   ntk.compute( n, node_to_value[n], fanin_values.begin(), fanin_values.end() );
 }
 
@@ -724,7 +1104,7 @@ void simulate_node( Ntk const& ntk, typename Ntk::node const& n, Container& node
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
   static_assert( has_compute_inplace_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the in-place compute specialization for kitty::partial_truth_table" );
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator> || std::is_same_v<Simulator, simd_simulator<kitty::partial_truth_table>>, "This function is specialized for partial_simulator, bit_packed_simulator, or simd_simulator" );
 
   if ( node_to_value[ntk.get_node( ntk.get_constant( false ) )].num_bits() != sim.num_bits() )
   {
@@ -741,7 +1121,7 @@ void simulate_node( Ntk const& ntk, typename Ntk::node const& n, Container& node
   }
 }
 
-/*! \brief Simulates a network with `partial_simulator` (or `bit_packed_simulator`).
+/*! \brief Simulates a network with `partial_simulator` (or `bit_packed_simulator`, or `simd_simulator`).
  *
  * This is the specialization for `partial_truth_table`.
  * This function simulates every node in the circuit.
@@ -762,7 +1142,7 @@ void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const&
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
   static_assert( has_compute_inplace_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the in-place compute specialization for kitty::partial_truth_table" );
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator> || std::is_same_v<Simulator, simd_simulator<kitty::partial_truth_table>>, "This function is specialized for partial_simulator, bit_packed_simulator, or simd_simulator" );
 
   detail::update_const_pi( ntk, node_to_value, sim );
 
@@ -822,6 +1202,11 @@ std::vector<SimulationType> simulate( Ntk const& ntk, Simulator const& sim = Sim
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented function" );
   static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute function for SimulationType" );
 
+  if constexpr ( is_simd_simulator_v<Simulator> )
+  {
+    return detail::simd_simulate<SimulationType>( ntk, sim );
+  }
+
   const auto node_to_value = simulate_nodes<SimulationType, Ntk, Simulator>( ntk, sim );
 
   std::vector<SimulationType> po_values( ntk.num_pos() );
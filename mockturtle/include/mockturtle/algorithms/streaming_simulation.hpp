@@ -0,0 +1,421 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file streaming_simulation.hpp
+  \brief Simulation of pattern streams with constant memory
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../io/read_patterns.hpp"
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for simulate_stream. */
+struct streaming_simulation_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Time to read the patterns. */
+  stopwatch<>::duration time_read{ 0 };
+
+  /*! \brief Time to simulate the blocks. */
+  stopwatch<>::duration time_simulate{ 0 };
+
+  /*! \brief Time spent in the reducers. */
+  stopwatch<>::duration time_reduce{ 0 };
+
+  /*! \brief Number of simulated patterns. */
+  uint64_t num_patterns{ 0u };
+
+  /*! \brief Number of simulated blocks. */
+  uint64_t num_blocks{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] patterns       = {} in {} blocks\n", num_patterns, num_blocks );
+    fmt::print( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+    fmt::print( "[i] read time      = {:>5.2f} secs\n", to_seconds( time_read ) );
+    fmt::print( "[i] simulate time  = {:>5.2f} secs\n", to_seconds( time_simulate ) );
+    fmt::print( "[i] reduce time    = {:>5.2f} secs\n", to_seconds( time_reduce ) );
+  }
+};
+
+/*! \brief Simulation values of one block of patterns.
+ *
+ * The values are only valid while the reducers are called for the block.
+ */
+template<class Ntk>
+class simulation_block
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  simulation_block( Ntk const& ntk )
+      : ntk( ntk ), values( ntk )
+  {
+  }
+
+  /*! \brief Network. */
+  Ntk const& network() const
+  {
+    return ntk;
+  }
+
+  /*! \brief Values of node `n` for the patterns of the block. */
+  kitty::partial_truth_table const& value( node const& n ) const
+  {
+    return values[n];
+  }
+
+  /*! \brief Values of the `index`-th PO for the patterns of the block. */
+  kitty::partial_truth_table po_value( uint32_t index ) const
+  {
+    const auto f = ntk.po_at( index );
+    return ntk.is_complemented( f ) ? ~values[f] : values[f];
+  }
+
+  /*! \brief Index of the first pattern of the block. */
+  uint64_t first_pattern() const
+  {
+    return offset;
+  }
+
+  /*! \brief Number of patterns of the block. */
+  uint32_t num_patterns() const
+  {
+    return num_bits;
+  }
+
+  /* simulates a block, the memory of the previous block is reused */
+  void simulate( std::vector<kitty::partial_truth_table> const& pi_values, uint64_t first_pattern, detail::simd_kernel_selection const& kernels )
+  {
+    offset = first_pattern;
+    num_bits = pi_values.empty() ? 0u : pi_values[0].num_bits();
+
+    const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+    values[c0].resize( num_bits );
+    std::fill( values[c0]._bits.begin(), values[c0]._bits.end(), ntk.constant_value( c0 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    values[c0].mask_bits();
+    if ( ntk.get_node( ntk.get_constant( true ) ) != c0 )
+    {
+      values[ntk.get_node( ntk.get_constant( true ) )] = ~values[c0];
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      values[n] = pi_values[i];
+    } );
+
+    std::vector<kitty::partial_truth_table> fanin_values;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      if ( detail::simd_op_of( ntk, n ) != detail::simd_op::none )
+      {
+        values[n].resize( num_bits );
+        detail::simd_simulate_node( ntk, n, values, kernels, false );
+      }
+      else
+      {
+        fanin_values.resize( ntk.fanin_size( n ) );
+        ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          fanin_values[i] = values[f];
+        } );
+        values[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+      }
+    } );
+  }
+
+private:
+  Ntk const& ntk;
+  node_map<kitty::partial_truth_table, Ntk> values;
+  uint64_t offset{ 0u };
+  uint32_t num_bits{ 0u };
+};
+
+/*! \brief Simulates a stream of pattern blocks with constant memory.
+ *
+ * The patterns are read block by block from `source` and each block is
+ * simulated with the vectorized kernels of `simd_simulator`, reusing the
+ * memory of the previous block.  After each block, every reducer is called
+ * with the `simulation_block`, such that memory only depends on the number
+ * of nodes and the block size, but not on the number of patterns.
+ *
+ * A source implements `bool next( std::vector<kitty::partial_truth_table>& )`
+ * and `uint64_t block_offset() const` (e.g., `pattern_block_reader`).  A
+ * reducer is a callable that takes a `simulation_block<Ntk> const&`.
+ * Predefined reducers are `popcount_reducer`, `toggle_reducer`, and
+ * `mismatch_reducer`.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `num_pis`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<kitty::partial_truth_table>`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      pattern_block_reader reader( "patterns.txt" );
+      popcount_reducer<aig_network> ones( aig );
+      toggle_reducer<aig_network> toggles( aig );
+      simulate_stream( aig, reader, ones, toggles );
+   \endverbatim
+ *
+ * Returns `std::nullopt` if a block of `source` does not have one value for
+ * each PI of `ntk` (e.g., if the pattern file has fewer lines than the
+ * network has PIs).  The blocks before are simulated and reduced.
+ *
+ * \param ntk Network
+ * \param source Source of pattern blocks
+ * \param reducers Reducers called for each block
+ */
+template<class Ntk, class Source, class... Reducers>
+std::optional<streaming_simulation_stats> simulate_stream( Ntk const& ntk, Source& source, Reducers&... reducers )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+
+  streaming_simulation_stats st;
+  stopwatch t( st.time_total );
+
+  simulation_block<Ntk> block( ntk );
+  std::vector<kitty::partial_truth_table> pi_values;
+  detail::simd_kernel_selection kernels;
+
+  while ( call_with_stopwatch( st.time_read, [&]() { return source.next( pi_values ); } ) )
+  {
+    if ( pi_values.size() != ntk.num_pis() )
+    {
+      return std::nullopt;
+    }
+    call_with_stopwatch( st.time_simulate, [&]() { block.simulate( pi_values, source.block_offset(), kernels ); } );
+    call_with_stopwatch( st.time_reduce, [&]() { ( reducers( block ), ... ); } );
+
+    st.num_patterns += block.num_patterns();
+    ++st.num_blocks;
+  }
+
+  return st;
+}
+
+/*! \brief Counts the patterns for which POs (and optionally all nodes) are 1. */
+template<class Ntk>
+class popcount_reducer
+{
+public:
+  explicit popcount_reducer( Ntk const& ntk, bool count_nodes = false )
+      : ones( ntk.num_pos(), 0u ), node_ones( count_nodes ? ntk.size() : 0u, 0u )
+  {
+  }
+
+  void operator()( simulation_block<Ntk> const& block )
+  {
+    auto const& ntk = block.network();
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      const auto count = kitty::count_ones( block.value( ntk.get_node( f ) ) );
+      ones[i] += ntk.is_complemented( f ) ? block.num_patterns() - count : count;
+    } );
+    if ( !node_ones.empty() )
+    {
+      ntk.foreach_node( [&]( auto const& n ) {
+        node_ones[ntk.node_to_index( n )] += kitty::count_ones( block.value( n ) );
+      } );
+    }
+  }
+
+  /*! \brief Number of patterns for which the `index`-th PO is 1. */
+  uint64_t po_ones( uint32_t index ) const
+  {
+    return ones[index];
+  }
+
+  /*! \brief Number of patterns for which node `n` is 1 (requires `count_nodes`). */
+  uint64_t node_ones_at( uint64_t index ) const
+  {
+    return node_ones[index];
+  }
+
+private:
+  std::vector<uint64_t> ones;
+  std::vector<uint64_t> node_ones;
+};
+
+/*! \brief Counts value changes between consecutive patterns for every node.
+ *
+ * The last value of each node is kept between blocks, such that the counts
+ * do not depend on the block size.
+ */
+template<class Ntk>
+class toggle_reducer
+{
+public:
+  explicit toggle_reducer( Ntk const& ntk )
+      : counts( ntk.size(), 0u ), last( ntk.size(), 0u )
+  {
+  }
+
+  void operator()( simulation_block<Ntk> const& block )
+  {
+    auto const& ntk = block.network();
+    const auto num_bits = block.num_patterns();
+    if ( num_bits == 0u )
+    {
+      return;
+    }
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const& words = block.value( n )._bits;
+      const auto index = ntk.node_to_index( n );
+
+      uint64_t toggles = 0u;
+      uint64_t carry = last[index];
+      for ( auto w = 0u; w < words.size(); ++w )
+      {
+        auto diff = words[w] ^ ( ( words[w] << 1 ) | carry );
+        if ( w == 0u && block.first_pattern() == 0u )
+        {
+          diff &= ~UINT64_C( 1 ); /* no previous pattern */
+        }
+        if ( w + 1u == words.size() && ( num_bits & 63u ) != 0u )
+        {
+          diff &= ( UINT64_C( 1 ) << ( num_bits & 63u ) ) - 1u;
+        }
+        toggles += std::bitset<64>( diff ).count();
+        carry = words[w] >> 63;
+      }
+      counts[index] += toggles;
+      last[index] = ( words[( num_bits - 1u ) / 64u] >> ( ( num_bits - 1u ) % 64u ) ) & 1u;
+    } );
+  }
+
+  /*! \brief Number of value changes of the node with index `index`. */
+  uint64_t toggles( uint64_t index ) const
+  {
+    return counts[index];
+  }
+
+private:
+  std::vector<uint64_t> counts;
+  std::vector<uint8_t> last;
+};
+
+/*! \brief Detects patterns for which the POs of two networks differ.
+ *
+ * The reducer simulates the reference network on the same patterns and
+ * compares its POs to the POs of the simulated network.  The first
+ * mismatching pattern of each PO and the number of mismatches are kept.
+ */
+template<class Ntk, class RefNtk = Ntk>
+class mismatch_reducer
+{
+public:
+  explicit mismatch_reducer( RefNtk const& reference )
+      : reference( reference ), block( reference ), first( reference.num_pos() ), counts( reference.num_pos(), 0u )
+  {
+  }
+
+  void operator()( simulation_block<Ntk> const& other )
+  {
+    auto const& ntk = other.network();
+    assert( ntk.num_pis() == reference.num_pis() && ntk.num_pos() == reference.num_pos() );
+
+    pi_values.resize( ntk.num_pis() );
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      pi_values[i] = other.value( n );
+    } );
+    block.simulate( pi_values, other.first_pattern(), kernels );
+
+    for ( auto i = 0u; i < ntk.num_pos(); ++i )
+    {
+      const auto diff = other.po_value( i ) ^ block.po_value( i );
+      const auto count = kitty::count_ones( diff );
+      if ( count > 0u && !first[i] )
+      {
+        first[i] = other.first_pattern() + kitty::find_first_one_bit( diff );
+      }
+      counts[i] += count;
+    }
+  }
+
+  /*! \brief Whether all POs agree on all patterns so far. */
+  bool equivalent() const
+  {
+    return std::all_of( counts.begin(), counts.end(), []( auto c ) { return c == 0u; } );
+  }
+
+  /*! \brief First pattern for which the `index`-th PO differs. */
+  std::optional<uint64_t> first_mismatch( uint32_t index ) const
+  {
+    return first[index];
+  }
+
+  /*! \brief Number of patterns for which the `index`-th PO differs. */
+  uint64_t num_mismatches( uint32_t index ) const
+  {
+    return counts[index];
+  }
+
+private:
+  RefNtk const& reference;
+  simulation_block<RefNtk> block;
+  detail::simd_kernel_selection kernels;
+  std::vector<kitty::partial_truth_table> pi_values;
+  std::vector<std::optional<uint64_t>> first;
+  std::vector<uint64_t> counts;
+};
+
+} // namespace mockturtle
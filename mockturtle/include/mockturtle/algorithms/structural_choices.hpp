@@ -0,0 +1,449 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file structural_choices.hpp
+  \brief Computes a choice network from several structures of a network
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/choice_view.hpp"
+#include "../views/topo_view.hpp"
+#include "circuit_validator.hpp"
+#include "simulation.hpp"
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace mockturtle
+{
+
+struct structural_choices_params
+{
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+
+  /*! \brief Number of random simulation patterns. */
+  uint32_t num_patterns{ 256 };
+
+  /*! \brief Maximum number of candidate representatives a node is compared to. */
+  uint32_t max_candidates{ 10 };
+
+  /*! \brief Conflict limit for the SAT solver. */
+  uint32_t conflict_limit{ 100 };
+
+  /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
+  uint32_t max_clauses{ 1000 };
+};
+
+struct structural_choices_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Time for simulation. */
+  stopwatch<>::duration time_sim{ 0 };
+
+  /*! \brief Time for SAT solving. */
+  stopwatch<>::duration time_sat{ 0 };
+
+  /*! \brief Number of proven equivalences. */
+  uint32_t num_equivalences{ 0 };
+
+  /*! \brief Number of recorded alternatives. */
+  uint32_t num_choices{ 0 };
+
+  /*! \brief Number of counter-examples (SAT calls). */
+  uint32_t num_cex{ 0 };
+
+  /*! \brief Number of SAT solver timeout. */
+  uint32_t num_timeout{ 0 };
+
+  void report() const
+  {
+    // clang-format off
+    std::cout <<              "[i] Structural choices\n";
+    std::cout <<              "[i] ========  Stats  ========\n";
+    std::cout << fmt::format( "[i] #FE pairs = {:8d}\n", num_equivalences );
+    std::cout << fmt::format( "[i] #choices  = {:8d}\n", num_choices );
+    std::cout << fmt::format( "[i] #SAT      = {:8d}\n", num_cex );
+    std::cout << fmt::format( "[i] #TIMEOUT  = {:8d}\n", num_timeout );
+    std::cout <<              "[i] ======== Runtime ========\n";
+    std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   SAT solving: {:>5.2f} secs\n", to_seconds( time_sat ) );
+    std::cout <<              "[i] =========================\n\n";
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk, typename validator_t = circuit_validator<choice_view<Ntk>, bill::solvers::bsat2>>
+class structural_choices_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using TT = unordered_node_map<kitty::partial_truth_table, choice_view<Ntk>>;
+
+  explicit structural_choices_impl( std::vector<Ntk> const& snapshots, structural_choices_params const& ps, validator_params const& vps, structural_choices_stats& st )
+      : snapshots( snapshots ), ps( ps ), st( st ), res( create_inputs( snapshots.front().num_pis() ) ), tts( res ), repr( res ),
+        sim( snapshots.front().num_pis(), ps.num_patterns ), validator( res, vps )
+  {
+    static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
+  }
+
+  choice_view<Ntk> run()
+  {
+    stopwatch t( st.time_total );
+
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<choice_view<Ntk>>( res, tts, sim, true );
+    } );
+
+    const auto c0 = res.get_node( res.get_constant( false ) );
+    candidates[signature( c0 )].push_back( c0 );
+    res.foreach_pi( [&]( auto const& n ) {
+      candidates[signature( n )].push_back( n );
+    } );
+
+    for ( auto i = 0u; i < snapshots.size(); ++i )
+    {
+      add_snapshot( snapshots[i], i == 0u );
+    }
+
+    return res;
+  }
+
+private:
+  /* the validator expects the PIs to exist when it is constructed */
+  static choice_view<Ntk> create_inputs( uint32_t num_pis )
+  {
+    choice_view<Ntk> ntk;
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      ntk.create_pi();
+    }
+    return ntk;
+  }
+
+  /* copies the gates of a snapshot in topological order, with their fanins
+     replaced by representatives; a new gate is compared to the earlier
+     representatives with the same signature and becomes an alternative of
+     the first one it is proven to be equivalent to, or a representative */
+  void add_snapshot( Ntk const& ntk, bool keep_outputs )
+  {
+    assert( ntk.num_pis() == res.num_pis() );
+
+    node_map<signal, Ntk> old2new( ntk );
+    old2new[ntk.get_constant( false )] = res.get_constant( false );
+    if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
+    {
+      old2new[ntk.get_constant( true )] = res.get_constant( true );
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      old2new[n] = res.make_signal( res.pi_at( i ) );
+    } );
+
+    topo_view<Ntk>{ ntk }.foreach_gate( [&]( auto const& n ) {
+      std::vector<signal> children;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( old2new[f] ^ ntk.is_complemented( f ) );
+      } );
+
+      const auto size = res.size();
+      const auto f = res.clone_node( ntk, n, children );
+      const auto fn = res.get_node( f );
+
+      /* structurally equal to an existing node */
+      if ( res.size() == size )
+      {
+        old2new[n] = repr.has( fn ) ? repr[fn] ^ res.is_complemented( f ) : f;
+        return;
+      }
+
+      auto& nodes = candidates[signature( fn )];
+      for ( auto j = 0u; j < nodes.size() && j < ps.max_candidates; ++j )
+      {
+        if ( const auto g = prove( fn, nodes[j] ); g )
+        {
+          ++st.num_equivalences;
+          repr[fn] = *g;
+          old2new[n] = *g ^ res.is_complemented( f );
+          add_choice( nodes[j], res.make_signal( fn ) ^ res.is_complemented( *g ) );
+          return;
+        }
+      }
+
+      nodes.push_back( fn );
+      old2new[n] = f;
+    } );
+
+    if ( keep_outputs )
+    {
+      ntk.foreach_po( [&]( auto const& f ) {
+        res.create_po( old2new[f] ^ ntk.is_complemented( f ) );
+      } );
+    }
+  }
+
+  /* the first bits of the simulation signatures, which do not change when
+     counter-examples are added, up to complementation */
+  uint64_t signature( node const& n )
+  {
+    check_tts( n );
+
+    auto const& tt = tts[n];
+    const auto num_blocks = ( ps.num_patterns + 63u ) / 64u;
+    const auto mask = ( *tt.cbegin() & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+
+    uint64_t key{ 0u };
+    for ( auto i = 0u; i < num_blocks; ++i )
+    {
+      auto block = *( tt.cbegin() + i ) ^ mask;
+      if ( i + 1u == num_blocks && ps.num_patterns % 64u != 0u )
+      {
+        block &= ( UINT64_C( 1 ) << ( ps.num_patterns % 64u ) ) - 1u;
+      }
+      key ^= block + UINT64_C( 0x9e3779b97f4a7c15 ) + ( key << 6 ) + ( key >> 2 );
+    }
+    return key;
+  }
+
+  /* returns the signal of `candidate` which is equivalent to `n`, if any */
+  std::optional<signal> prove( node const& n, node const& candidate )
+  {
+    check_tts( n );
+    check_tts( candidate );
+
+    signal g;
+    if ( tts[n] == tts[candidate] )
+    {
+      g = res.make_signal( candidate );
+    }
+    else if ( tts[n] == ~tts[candidate] )
+    {
+      g = !res.make_signal( candidate );
+    }
+    else
+    {
+      return std::nullopt;
+    }
+
+    const auto result = call_with_stopwatch( st.time_sat, [&]() {
+      return validator.validate( n, g );
+    } );
+    if ( !result ) /* timeout */
+    {
+      ++st.num_timeout;
+      return std::nullopt;
+    }
+    else if ( !( *result ) ) /* SAT, cex found */
+    {
+      found_cex();
+      return std::nullopt;
+    }
+    return g;
+  }
+
+  /* records an alternative unless it contains the representative in its
+     transitive fanin, including the alternatives of representatives */
+  void add_choice( node const& r, signal const& alternative )
+  {
+    if ( res.is_constant( r ) || res.is_ci( r ) )
+    {
+      return;
+    }
+
+    res.incr_trav_id();
+    std::vector<node> stack{ res.get_node( alternative ) };
+    while ( !stack.empty() )
+    {
+      const auto n = stack.back();
+      stack.pop_back();
+      if ( n == r )
+      {
+        return;
+      }
+
+      const auto visit = [&]( node const& m ) {
+        if ( res.visited( m ) != res.trav_id() && !res.is_constant( m ) && !res.is_ci( m ) )
+        {
+          res.set_visited( m, res.trav_id() );
+          stack.push_back( m );
+        }
+      };
+      res.foreach_fanin( n, [&]( auto const& f ) {
+        visit( res.get_node( f ) );
+      } );
+      res.foreach_choice( n, visit );
+    }
+
+    res.add_choice( r, alternative );
+    ++st.num_choices;
+  }
+
+  void found_cex()
+  {
+    ++st.num_cex;
+    sim.add_pattern( validator.cex );
+
+    /* re-simulate the whole circuit (for the last block) when a block is full */
+    if ( sim.num_bits() % 64 == 0 )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_nodes<choice_view<Ntk>>( res, tts, sim, false );
+      } );
+    }
+  }
+
+  void check_tts( node const& n )
+  {
+    if ( !tts.has( n ) || tts[n].num_bits() != sim.num_bits() )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_node<choice_view<Ntk>>( res, n, tts, sim );
+      } );
+    }
+  }
+
+private:
+  std::vector<Ntk> const& snapshots;
+  structural_choices_params const& ps;
+  structural_choices_stats& st;
+
+  choice_view<Ntk> res;
+  TT tts;
+
+  /* the representative signal of each node that was proven equivalent */
+  unordered_node_map<signal, choice_view<Ntk>> repr;
+
+  /* the representatives by their signatures */
+  std::unordered_map<uint64_t, std::vector<node>> candidates;
+
+  partial_simulator sim;
+  validator_t validator;
+}; /* structural_choices_impl */
+
+} /* namespace detail */
+
+/*! \brief Structural choices.
+ *
+ * Combines several structures of the same network, e.g., the results of
+ * different optimization scripts, into one choice network with shared
+ * PIs.  The structures are added one after the other, in topological
+ * order and with their fanins replaced by representatives.  Each new node
+ * is compared to the earlier representatives with the same simulation
+ * signature, and equivalences are proven by SAT, in the same way as in
+ * `functional_reduction`.  A node that is proven to be equivalent to a
+ * representative is recorded as its alternative (see `choice_view`),
+ * unless the representative is in its transitive fanin; all other nodes
+ * become representatives.  Since the fanins are merged before a node is
+ * compared, the SAT problems remain small.  The returned network has the
+ * POs of the first structure.
+ *
+ * Choice-aware algorithms, such as `lut_mapping` and `map`, can then
+ * select the best structure for each class in a single mapping run.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `clone_node`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `get_constant`
+ * - `get_node`
+ * - `is_complemented`
+ * - `make_signal`
+ * - `incr_trav_id`
+ * - `set_visited`
+ * - `visited`
+ * - `trav_id`
+ *
+ * \param snapshots Structures of the same network, with the same PIs and POs
+ */
+template<class Ntk>
+choice_view<Ntk> structural_choices( std::vector<Ntk> const& snapshots, structural_choices_params const& ps = {}, structural_choices_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi method" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po method" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
+  static_assert( has_incr_trav_id_v<Ntk>, "Ntk does not implement the incr_trav_id method" );
+  static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+  static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+  static_assert( has_trav_id_v<Ntk>, "Ntk does not implement the trav_id method" );
+
+  if ( snapshots.empty() )
+  {
+    return choice_view<Ntk>{};
+  }
+
+  validator_params vps;
+  vps.max_clauses = ps.max_clauses;
+  vps.conflict_limit = ps.conflict_limit;
+
+  structural_choices_stats st;
+  detail::structural_choices_impl<Ntk> p( snapshots, ps, vps, st );
+  const auto res = p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return res;
+}
+
+} /* namespace mockturtle */
@@ -371,6 +371,43 @@ public:
    * \return Whether ``n`` is dead
    */
   bool is_dead( node const& n ) const;
+
+  /*! \brief Removes all dead nodes.
+   *
+   * Dead nodes are removed from the network and the remaining nodes are
+   * renumbered: the constant comes first, followed by the CIs in their
+   * order and all live gates in topological order.  The hash table is
+   * rebuilt.  This changes the indexes of nodes, containers that store
+   * node indexes can be updated with the returned map (e.g., using
+   * ``node_map::remap``).
+   *
+   * \return Maps each old node index to its new index, dead nodes are
+   *         mapped to ``std::numeric_limits<uint64_t>::max()``
+   */
+  std::vector<uint64_t> compact();
+#pragma endregion
+
+#pragma region Snapshots
+  /*! \brief Takes a snapshot of the network.
+   *
+   * Snapshots are kept on a stack.  The most recent snapshot is removed
+   * either by ``commit``, which keeps all changes since the snapshot was
+   * taken, or by ``rollback``, which reverts them.  Networks with
+   * copy-on-write storage share all nodes with the snapshot, hence the
+   * cost of a snapshot is proportional to the amount of modified data.
+   */
+  void fork();
+
+  /*! \brief Keeps all changes since the most recent ``fork``. */
+  void commit();
+
+  /*! \brief Reverts all changes since the most recent ``fork``.
+   *
+   * No events are emitted, hence no views that register events may be
+   * attached to the network.  Static listeners and containers that keep
+   * information about nodes must be updated by the caller.
+   */
+  void rollback();
 #pragma endregion
 
 #pragma region Structural properties
@@ -759,7 +796,10 @@ public:
   /*! \brief Returns network events object.
    *
    * Clients can register callbacks for network events to this object.  Events
-   * include adding nodes, modifying nodes, and deleting nodes.
+   * include adding nodes, modifying nodes, and deleting nodes.  Networks
+   * that are instantiated with a static listener (e.g.,
+   * ``basic_aig_network<aig_storage, Listener>``) keep it in the ``listener``
+   * member of this object.
    */
   network_events<base_type>& events() const;
 #pragma endregion
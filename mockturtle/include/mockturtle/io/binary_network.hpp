@@ -0,0 +1,703 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file binary_network.hpp
+  \brief Versioned binary network format that can be memory-mapped
+
+  This file implements a binary format for AIGs, XAGs, MIGs, XMGs, and
+  k-LUT networks, which stores the storage arrays of a network (nodes,
+  fan-in pool, primary inputs and outputs, structural hash table, truth
+  tables, and register information) in page-aligned sections.  Reading a
+  file maps it into memory and copies each section in bulk.  Networks with
+  copy-on-write storage (see `cow_storage`) use the mapped pages directly
+  and rebuild their structural hash table on first access, such that
+  opening a trusted file without validation takes constant time and the
+  mapped pages are shared between all processes that read the same file.
+  k-LUT networks with copy-on-write storage (`klut_cow_storage`) cannot be
+  written or read.
+
+  Like `serialize_network`, the format keeps the exact state of the network
+  (including dangling and dead nodes), but is not platform-independent.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../networks/aig.hpp"
+#include "../networks/klut.hpp"
+#include "../networks/mig.hpp"
+#include "../networks/sequential.hpp"
+#include "../networks/storage.hpp"
+#include "../networks/xag.hpp"
+#include "../networks/xmg.hpp"
+#include "../traits.hpp"
+#include "../utils/mapped_file.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* "mcktrtl" followed by a zero byte, also detects a different byte order */
+static constexpr uint64_t binary_network_magic = UINT64_C( 0x006c7472746b636d );
+static constexpr uint32_t binary_network_version = 1u;
+static constexpr uint64_t binary_network_alignment = 4096u;
+
+enum class binary_network_kind : uint32_t
+{
+  aig = 1u,
+  xag = 2u,
+  mig = 3u,
+  xmg = 4u,
+  klut = 5u
+};
+
+enum class binary_network_section : uint32_t
+{
+  nodes = 0u,
+  fanins = 1u,
+  inputs = 2u,
+  outputs = 3u,
+  strash = 4u,
+  truth_tables = 5u,
+  registers = 6u,
+  num_sections = 7u
+};
+
+struct binary_network_section_entry
+{
+  uint64_t offset{ 0u };
+  uint64_t size{ 0u };  /* in bytes */
+  uint64_t count{ 0u }; /* number of elements */
+};
+
+struct binary_network_header
+{
+  uint64_t magic{ binary_network_magic };
+  uint32_t version{ binary_network_version };
+  uint32_t kind{ 0u };
+  uint32_t node_size{ 0u };
+  uint32_t trav_id{ 0u };
+  uint32_t num_pis{ 0u };
+  uint32_t num_pos{ 0u };
+  binary_network_section_entry sections[static_cast<uint32_t>( binary_network_section::num_sections )];
+};
+
+template<class Ntk>
+constexpr binary_network_kind binary_network_kind_of()
+{
+  using base_type = typename Ntk::base_type;
+  if constexpr ( is_aig_network_type_v<base_type> )
+  {
+    return binary_network_kind::aig;
+  }
+  else if constexpr ( is_xag_network_type_v<base_type> )
+  {
+    return binary_network_kind::xag;
+  }
+  else if constexpr ( is_mig_network_type_v<base_type> )
+  {
+    return binary_network_kind::mig;
+  }
+  else if constexpr ( is_xmg_network_type_v<base_type> )
+  {
+    return binary_network_kind::xmg;
+  }
+  else
+  {
+    static_assert( std::is_same_v<base_type, klut_network>, "Ntk is not an AIG, XAG, MIG, XMG, or k-LUT network" );
+    return binary_network_kind::klut;
+  }
+}
+
+template<class Storage>
+struct is_pooled_storage : std::false_type
+{
+};
+
+template<typename Node, typename T>
+struct is_pooled_storage<pooled_storage<Node, T>> : std::true_type
+{
+};
+
+class binary_network_writer
+{
+public:
+  explicit binary_network_writer( std::ostream& os )
+      : os( os )
+  {
+    /* space for the header, which is written last */
+    static_assert( sizeof( binary_network_header ) <= binary_network_alignment );
+    zeros( binary_network_alignment );
+  }
+
+  template<typename T>
+  void write_section( binary_network_section id, T const* data, uint64_t count, uint64_t padded_count )
+  {
+    static_assert( std::is_trivially_copyable_v<T>, "section elements must be trivially copyable" );
+    begin_section( id, count );
+    write( data, count * sizeof( T ) );
+    zeros( ( padded_count - count ) * sizeof( T ) );
+    end_section( id );
+  }
+
+  template<typename T>
+  void write_section( binary_network_section id, std::vector<T> const& data )
+  {
+    write_section( id, data.data(), data.size(), data.size() );
+  }
+
+  /* nodes are padded to whole pages of a `cow_vector`, such that each page can be used in place */
+  template<typename T>
+  void write_nodes( std::vector<T> const& nodes )
+  {
+    write_section( binary_network_section::nodes, nodes.data(), nodes.size(), padded_to_pages<T>( nodes.size() ) );
+  }
+
+  template<typename T, uint32_t PageBits>
+  void write_nodes( cow_vector<T, PageBits> const& nodes )
+  {
+    static_assert( std::is_trivially_copyable_v<T>, "section elements must be trivially copyable" );
+    static_assert( cow_vector<T, PageBits>::page_size == cow_vector<T>::page_size, "nodes must use the default page size" );
+    constexpr auto page_size = cow_vector<T, PageBits>::page_size;
+    begin_section( binary_network_section::nodes, nodes.size() );
+    for ( uint64_t i = 0u; i < nodes.size(); i += page_size )
+    {
+      write( &nodes[i], std::min<uint64_t>( page_size, nodes.size() - i ) * sizeof( T ) );
+    }
+    zeros( ( padded_to_pages<T>( nodes.size() ) - nodes.size() ) * sizeof( T ) );
+    end_section( binary_network_section::nodes );
+  }
+
+  template<typename T>
+  static uint64_t padded_to_pages( uint64_t count )
+  {
+    constexpr auto page_size = cow_vector<T>::page_size;
+    return ( count + page_size - 1u ) / page_size * page_size;
+  }
+
+  void begin_section( binary_network_section id, uint64_t count )
+  {
+    auto& entry = header.sections[static_cast<uint32_t>( id )];
+    entry.offset = static_cast<uint64_t>( os.tellp() );
+    entry.count = count;
+  }
+
+  void write( void const* data, uint64_t size )
+  {
+    os.write( reinterpret_cast<char const*>( data ), size );
+  }
+
+  void end_section( binary_network_section id )
+  {
+    auto& entry = header.sections[static_cast<uint32_t>( id )];
+    entry.size = static_cast<uint64_t>( os.tellp() ) - entry.offset;
+    zeros( ( binary_network_alignment - entry.size % binary_network_alignment ) % binary_network_alignment );
+  }
+
+  void finish()
+  {
+    os.seekp( 0 );
+    write( &header, sizeof( header ) );
+    os.seekp( 0, std::ios::end );
+  }
+
+private:
+  void zeros( uint64_t size )
+  {
+    static char const zero[binary_network_alignment] = {};
+    while ( size > 0u )
+    {
+      const auto chunk = std::min( size, binary_network_alignment );
+      os.write( zero, chunk );
+      size -= chunk;
+    }
+  }
+
+public:
+  binary_network_header header;
+
+private:
+  std::ostream& os;
+};
+
+inline std::shared_ptr<char> map_binary_file( std::string const& filename, uint64_t& size )
+{
+  return map_file( filename, size, sizeof( binary_network_header ) );
+}
+
+template<class Ntk>
+class binary_network_reader
+{
+public:
+  using storage_type = typename Ntk::storage::element_type;
+  using node_type = typename storage_type::node_type;
+  using pointer_type = typename node_type::pointer_type;
+
+  binary_network_reader( std::shared_ptr<char> const& file, uint64_t file_size )
+      : file( file ), file_size( file_size )
+  {
+    std::memcpy( &header, file.get(), sizeof( header ) );
+  }
+
+  bool check() const
+  {
+    if ( header.magic != binary_network_magic || header.version != binary_network_version ||
+         header.kind != static_cast<uint32_t>( binary_network_kind_of<Ntk>() ) || header.node_size != sizeof( node_type ) )
+    {
+      return false;
+    }
+
+    for ( auto const& entry : header.sections )
+    {
+      if ( entry.offset % binary_network_alignment != 0u || entry.offset > file_size || entry.size > file_size - entry.offset )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  binary_network_section_entry const& section( binary_network_section id ) const
+  {
+    return header.sections[static_cast<uint32_t>( id )];
+  }
+
+  template<typename T>
+  T* data( binary_network_section id ) const
+  {
+    return reinterpret_cast<T*>( file.get() + section( id ).offset );
+  }
+
+  template<typename T>
+  bool check_section( binary_network_section id, uint64_t padded_count ) const
+  {
+    return section( id ).count <= padded_count && padded_count * sizeof( T ) <= section( id ).size;
+  }
+
+  template<typename T>
+  bool read_section( binary_network_section id, std::vector<T>& v ) const
+  {
+    if ( !check_section<T>( id, section( id ).count ) )
+    {
+      return false;
+    }
+    auto const* begin = data<T const>( id );
+    v.assign( begin, begin + section( id ).count );
+    return true;
+  }
+
+  std::shared_ptr<storage_type> read( bool validate ) const
+  {
+    auto storage = std::make_shared<storage_type>();
+    storage->trav_id = header.trav_id;
+    if ( !read_section( binary_network_section::inputs, storage->inputs ) ||
+         !read_section( binary_network_section::outputs, storage->outputs ) )
+    {
+      return nullptr;
+    }
+
+    if constexpr ( is_pooled_storage<storage_type>::value )
+    {
+      if ( !read_section( binary_network_section::nodes, storage->nodes ) ||
+           !read_section( binary_network_section::fanins, storage->fanins ) ||
+           !check_section<uint64_t>( binary_network_section::strash, 2u * section( binary_network_section::strash ).count ) )
+      {
+        return nullptr;
+      }
+
+      /* signature and node pairs */
+      auto const* entries = data<uint64_t const>( binary_network_section::strash );
+      storage->hash.reserve( section( binary_network_section::strash ).count );
+      for ( uint64_t i = 0u; i < section( binary_network_section::strash ).count; ++i )
+      {
+        if ( entries[2u * i + 1u] >= storage->nodes.size() )
+        {
+          return nullptr;
+        }
+        storage->hash[entries[2u * i]] = entries[2u * i + 1u];
+      }
+
+      /* number of variables followed by the words of each normal truth table */
+      auto const* words = data<uint64_t const>( binary_network_section::truth_tables );
+      auto const* const words_end = words + section( binary_network_section::truth_tables ).size / sizeof( uint64_t );
+      for ( uint64_t i = 0u; i < section( binary_network_section::truth_tables ).count; ++i )
+      {
+        if ( words == words_end || *words > 32u )
+        {
+          return nullptr;
+        }
+
+        /* check the number of words before allocating the truth table */
+        const auto num_vars = static_cast<uint32_t>( *words++ );
+        const uint64_t num_blocks = num_vars <= 6u ? 1u : ( UINT64_C( 1 ) << ( num_vars - 6u ) );
+        if ( static_cast<uint64_t>( words_end - words ) < num_blocks )
+        {
+          return nullptr;
+        }
+        kitty::dynamic_truth_table tt( num_vars );
+        kitty::create_from_words( tt, words, words + tt.num_blocks() );
+        words += tt.num_blocks();
+        storage->data.cache.insert( tt );
+      }
+
+      if ( validate && !check_pooled_nodes( *storage ) )
+      {
+        return nullptr;
+      }
+    }
+    else
+    {
+      if ( !check_section<uint64_t>( binary_network_section::strash, section( binary_network_section::strash ).count ) )
+      {
+        return nullptr;
+      }
+      auto const* strash = data<uint64_t const>( binary_network_section::strash );
+      const auto num_strash = section( binary_network_section::strash ).count;
+      const auto num_nodes = section( binary_network_section::nodes ).count;
+      if ( validate && !std::all_of( strash, strash + num_strash, [&]( auto index ) { return index < num_nodes; } ) )
+      {
+        return nullptr;
+      }
+
+      if constexpr ( is_cow_storage_v<storage_type> )
+      {
+        /* use the mapped pages in place */
+        if ( !check_section<node_type>( binary_network_section::nodes, binary_network_writer::padded_to_pages<node_type>( num_nodes ) ) ||
+             ( validate && !check_fanins( data<node_type const>( binary_network_section::nodes ), num_nodes ) ) )
+        {
+          return nullptr;
+        }
+        storage->nodes.adopt( file, data<node_type>( binary_network_section::nodes ), num_nodes );
+
+        /* structural hashing is rebuilt on first access from the nodes as they are now */
+        storage->hash.defer( [nodes = storage->nodes, strash, num_strash, file = file]( auto& hash ) {
+          hash.reserve( num_strash );
+          for ( uint64_t i = 0u; i < num_strash; ++i )
+          {
+            hash.emplace( nodes[strash[i]], strash[i] );
+          }
+        } );
+      }
+      else
+      {
+        if ( !read_section( binary_network_section::nodes, storage->nodes ) ||
+             ( validate && !check_fanins( storage->nodes.data(), num_nodes ) ) )
+        {
+          return nullptr;
+        }
+
+        storage->hash.reserve( num_strash );
+        for ( uint64_t i = 0u; i < num_strash; ++i )
+        {
+          storage->hash.emplace( storage->nodes[strash[i]], strash[i] );
+        }
+      }
+    }
+
+    if ( !check_terminals( *storage ) )
+    {
+      return nullptr;
+    }
+
+    return storage;
+  }
+
+  bool read_registers( std::vector<register_t>& registers ) const
+  {
+    auto const* p = data<char const>( binary_network_section::registers );
+    auto const* const end = p + section( binary_network_section::registers ).size;
+
+    const auto read_string = [&]( std::string& str ) {
+      uint32_t length;
+      if ( end - p < static_cast<std::ptrdiff_t>( sizeof( length ) ) )
+      {
+        return false;
+      }
+      std::memcpy( &length, p, sizeof( length ) );
+      p += sizeof( length );
+      if ( static_cast<uint64_t>( end - p ) < length )
+      {
+        return false;
+      }
+      str.assign( p, length );
+      p += length;
+      return true;
+    };
+
+    /* each register takes at least its init byte and two string lengths */
+    const auto count = section( binary_network_section::registers ).count;
+    if ( static_cast<uint64_t>( end - p ) / ( 1u + 2u * sizeof( uint32_t ) ) < count )
+    {
+      return false;
+    }
+    registers.resize( count );
+    for ( auto& r : registers )
+    {
+      if ( p == end )
+      {
+        return false;
+      }
+      r.init = static_cast<uint8_t>( *p++ );
+      if ( !read_string( r.control ) || !read_string( r.type ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  /* all fan-ins refer to stored nodes (the fan-ins of a PI hold its input index) */
+  static bool check_fanins( node_type const* nodes, uint64_t num_nodes )
+  {
+    return std::all_of( nodes, nodes + num_nodes, [&]( auto const& n ) {
+      return std::all_of( std::begin( n.children ), std::end( n.children ), [&]( auto const& c ) { return c.index < num_nodes; } );
+    } );
+  }
+
+  /* all fan-in ranges lie in the fan-in pool, refer to stored nodes, and all functions are cached */
+  static bool check_pooled_nodes( storage_type const& storage )
+  {
+    const auto num_nodes = storage.nodes.size();
+    const auto num_literals = 2u * static_cast<uint64_t>( storage.data.cache.size() );
+    return std::all_of( storage.fanins.begin(), storage.fanins.end(), [&]( auto const& f ) { return f.index < num_nodes; } ) &&
+           std::all_of( storage.nodes.begin(), storage.nodes.end(), [&]( auto const& n ) {
+             return static_cast<uint64_t>( n.fanin_offset ) + n.fanin_size <= storage.fanins.size() && n.data[1].h1 < num_literals;
+           } );
+  }
+
+  /* all inputs and outputs refer to stored nodes */
+  static bool check_terminals( storage_type const& storage )
+  {
+    const auto num_nodes = storage.nodes.size();
+    return std::all_of( storage.inputs.begin(), storage.inputs.end(), [&]( auto index ) { return index < num_nodes; } ) &&
+           std::all_of( storage.outputs.begin(), storage.outputs.end(), [&]( auto const& f ) { return f.index < num_nodes; } );
+  }
+
+public:
+  binary_network_header header;
+
+private:
+  std::shared_ptr<char> file;
+  uint64_t file_size;
+};
+
+} /* namespace detail */
+
+/*! \brief Writes a network in binary format into an output stream
+ *
+ * Writes all storage arrays of the network in page-aligned sections after
+ * a header with the version of the format, the network type, and the size
+ * of a node.  Instead of the structural hash table, the indexes of the
+ * hashed nodes are stored.  If `Ntk` is a sequential network, the register
+ * information is written as well.
+ *
+ * The stream must be seekable, since the header is written last.
+ *
+ * **Required network functions:**
+ * - `_storage` of type `storage`, `pooled_storage`, or `cow_storage`
+ *   (`cow_pooled_storage` is not supported)
+ *
+ * \param ntk Network
+ * \param os Output stream
+ */
+template<class Ntk>
+void write_binary_network( Ntk const& ntk, std::ostream& os )
+{
+  using storage_type = typename Ntk::storage::element_type;
+  static_assert( !is_soa_storage_v<storage_type>, "structure-of-arrays storages are not supported" );
+
+  auto const& storage = *ntk._storage;
+  detail::binary_network_writer writer( os );
+
+  writer.header.kind = static_cast<uint32_t>( detail::binary_network_kind_of<Ntk>() );
+  writer.header.node_size = sizeof( typename storage_type::node_type );
+  writer.header.trav_id = storage.trav_id;
+  writer.header.num_pis = static_cast<uint32_t>( storage.inputs.size() );
+  writer.header.num_pos = static_cast<uint32_t>( storage.outputs.size() );
+
+  writer.write_nodes( storage.nodes );
+  writer.write_section( detail::binary_network_section::inputs, storage.inputs );
+  writer.write_section( detail::binary_network_section::outputs, storage.outputs );
+
+  if constexpr ( detail::is_pooled_storage<storage_type>::value )
+  {
+    writer.write_section( detail::binary_network_section::fanins, storage.fanins );
+
+    std::vector<uint64_t> entries;
+    entries.reserve( 2u * storage.hash.size() );
+    for ( auto const& [key, index] : storage.hash )
+    {
+      entries.push_back( key );
+      entries.push_back( index );
+    }
+    writer.begin_section( detail::binary_network_section::strash, storage.hash.size() );
+    writer.write( entries.data(), entries.size() * sizeof( uint64_t ) );
+    writer.end_section( detail::binary_network_section::strash );
+
+    auto const& cache = storage.data.cache;
+    writer.begin_section( detail::binary_network_section::truth_tables, cache.size() );
+    for ( uint32_t i = 0u; i < cache.size(); ++i )
+    {
+      const auto tt = cache[2u * i];
+      const uint64_t num_vars = tt.num_vars();
+      writer.write( &num_vars, sizeof( num_vars ) );
+      writer.write( &*tt.cbegin(), tt.num_blocks() * sizeof( uint64_t ) );
+    }
+    writer.end_section( detail::binary_network_section::truth_tables );
+  }
+  else
+  {
+    /* gates that are found in the hash table under their own index */
+    std::vector<uint64_t> strash;
+    for ( uint64_t i = 1u; i < storage.nodes.size(); ++i )
+    {
+      const auto it = storage.hash.find( storage.nodes[i] );
+      if ( it != storage.hash.end() && it->second == i )
+      {
+        strash.push_back( i );
+      }
+    }
+    writer.write_section( detail::binary_network_section::strash, strash );
+  }
+
+  if constexpr ( has_num_registers_v<Ntk> )
+  {
+    writer.header.num_pis = ntk.num_pis();
+    writer.header.num_pos = ntk.num_pos();
+
+    writer.begin_section( detail::binary_network_section::registers, ntk.num_registers() );
+    for ( uint32_t i = 0u; i < ntk.num_registers(); ++i )
+    {
+      const auto r = ntk.register_at( i );
+      const auto write_string = [&]( std::string const& str ) {
+        const auto length = static_cast<uint32_t>( str.size() );
+        writer.write( &length, sizeof( length ) );
+        writer.write( str.data(), length );
+      };
+      writer.write( &r.init, sizeof( r.init ) );
+      write_string( r.control );
+      write_string( r.type );
+    }
+    writer.end_section( detail::binary_network_section::registers );
+  }
+
+  writer.finish();
+}
+
+/*! \brief Writes a network in binary format into a file
+ *
+ * \param ntk Network
+ * \param filename Filename
+ */
+template<class Ntk>
+void write_binary_network( Ntk const& ntk, std::string const& filename )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc );
+  write_binary_network( ntk, os );
+  os.close();
+}
+
+/*! \brief Reads a network in binary format from a file
+ *
+ * The file is mapped into memory.  For `storage` and `pooled_storage`, each
+ * section is copied into the storage in bulk and the structural hash table
+ * is rebuilt from the stored node indexes.  For `cow_storage`, the nodes
+ * stay in the mapped pages, which are only copied when they are modified,
+ * and the structural hash table is rebuilt when it is accessed for the
+ * first time.  The mapping is private, modifications of the network are
+ * never written back into the file.
+ *
+ * Returns `std::nullopt` if the file cannot be read, or if it has been
+ * written with a different version of the format, for a different network
+ * type, or with a different node layout, or if a node index, fan-in range,
+ * or function literal in the file is out of range.  If `Ntk` is a
+ * sequential network, the register information is read as well.
+ *
+ * By default, all nodes and hashed node indexes are checked when reading,
+ * also for `cow_storage`, which then reads (but does not copy) every mapped
+ * page.  For trusted files, e.g., files written by `write_binary_network`
+ * and not modified since, `validate = false` skips these checks, such that
+ * opening a file with `cow_storage` takes constant time in the number of
+ * nodes.  The header, the section bounds, and the primary inputs and
+ * outputs are always checked.  A corrupted file read without validation
+ * leads to undefined behavior.
+ *
+ * \param filename Filename
+ * \param validate Check the nodes and the hashed node indexes
+ * \return Network or `std::nullopt`
+ */
+template<class Ntk>
+std::optional<Ntk> read_binary_network( std::string const& filename, bool validate = true )
+{
+  using storage_type = typename Ntk::storage::element_type;
+  static_assert( !is_soa_storage_v<storage_type>, "structure-of-arrays storages are not supported" );
+
+  uint64_t size{ 0u };
+  const auto file = detail::map_binary_file( filename, size );
+  if ( !file )
+  {
+    return std::nullopt;
+  }
+
+  detail::binary_network_reader<Ntk> reader( file, size );
+  if ( !reader.check() )
+  {
+    return std::nullopt;
+  }
+
+  const auto storage = reader.read( validate );
+  if ( !storage )
+  {
+    return std::nullopt;
+  }
+
+  Ntk ntk( storage );
+  if constexpr ( has_num_registers_v<Ntk> )
+  {
+    auto& info = *ntk._sequential_storage;
+    info.num_pis = reader.header.num_pis;
+    info.num_pos = reader.header.num_pos;
+    if ( !reader.read_registers( info.registers ) )
+    {
+      return std::nullopt;
+    }
+  }
+  return ntk;
+}
+
+} /* namespace mockturtle */
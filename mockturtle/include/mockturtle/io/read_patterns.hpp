@@ -0,0 +1,254 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file read_patterns.hpp
+  \brief Read simulation patterns in blocks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Reads simulation patterns from a file in blocks of words.
+ *
+ * The file has the format written by `write_patterns`: one line per
+ * primary input, and each line contains the simulation values of the
+ * input in hexadecimal, where the last character holds the first four
+ * patterns.  All lines must have the same length.
+ *
+ * Instead of reading all patterns into memory (as the file constructor of
+ * `partial_simulator`), the reader only keeps the position of each line
+ * and reads the patterns of one block of `words_per_block` 64-bit words at
+ * a time.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      pattern_block_reader reader( "patterns.txt", 1024u );
+      std::vector<kitty::partial_truth_table> block;
+      while ( reader.next( block ) )
+      {
+        // block[i] holds patterns [reader.block_offset(), reader.block_offset() + block[i].num_bits()) of PI i
+      }
+   \endverbatim
+ */
+class pattern_block_reader
+{
+public:
+  /*! \brief Opens a pattern file.
+   *
+   * \param filename Name of the pattern file
+   * \param words_per_block Number of 64-bit words per block
+   * \param length Number of patterns to read (0 reads all patterns)
+   */
+  explicit pattern_block_reader( std::string const& filename, uint32_t words_per_block = 1024u, uint64_t length = 0u )
+      : in( filename, std::ifstream::in | std::ifstream::binary ),
+        words_per_block( std::max( words_per_block, 1u ) )
+  {
+    if ( !in.is_open() )
+    {
+      return;
+    }
+
+    /* find the lines */
+    std::vector<char> buffer( 1u << 16 );
+    uint64_t position = 0u, line_begin = 0u, line_length = 0u;
+    bool in_line = false;
+    const auto end_line = [&]() {
+      if ( in_line )
+      {
+        if ( line_offsets.empty() )
+        {
+          num_chars = line_length;
+        }
+        else if ( line_length != num_chars )
+        {
+          _valid = false;
+        }
+        line_offsets.push_back( line_begin );
+      }
+      in_line = false;
+      line_length = 0u;
+    };
+
+    _valid = true;
+    while ( in.read( buffer.data(), buffer.size() ) || in.gcount() > 0 )
+    {
+      const auto count = static_cast<uint64_t>( in.gcount() );
+      for ( auto i = 0u; i < count; ++i, ++position )
+      {
+        const auto c = buffer[i];
+        if ( c == '\n' || c == '\r' )
+        {
+          end_line();
+        }
+        else
+        {
+          if ( !in_line )
+          {
+            in_line = true;
+            line_begin = position;
+          }
+          if ( hex_value( c ) == invalid_hex )
+          {
+            _valid = false;
+          }
+          ++line_length;
+        }
+      }
+    }
+    end_line();
+    in.clear();
+
+    _num_patterns = length == 0u ? 4u * num_chars : std::min<uint64_t>( length, 4u * num_chars );
+    _valid = _valid && !line_offsets.empty();
+  }
+
+  /*! \brief Whether the file could be opened, all lines have the same length, and contain only hexadecimal digits. */
+  bool is_valid() const
+  {
+    return _valid;
+  }
+
+  /*! \brief Number of primary inputs (lines). */
+  uint32_t num_pis() const
+  {
+    return static_cast<uint32_t>( line_offsets.size() );
+  }
+
+  /*! \brief Number of patterns in the file. */
+  uint64_t num_patterns() const
+  {
+    return _num_patterns;
+  }
+
+  /*! \brief Index of the first pattern in the last block read by `next`. */
+  uint64_t block_offset() const
+  {
+    return _block_offset;
+  }
+
+  /*! \brief Reads the next block into `block` (one truth table per PI).
+   *
+   * Returns false if all patterns have been read or if the file is not
+   * valid.  The last block may have fewer patterns.
+   */
+  bool next( std::vector<kitty::partial_truth_table>& block )
+  {
+    if ( !_valid || _next_pattern >= _num_patterns )
+    {
+      return false;
+    }
+
+    const auto begin = _next_pattern;
+    const auto num_bits = std::min<uint64_t>( 64u * words_per_block, _num_patterns - begin );
+
+    /* characters [first, last) hold the patterns, the last character holds the first patterns */
+    const auto first = num_chars - ( begin + num_bits + 3u ) / 4u;
+    const auto last = num_chars - begin / 4u;
+    chars.resize( last - first );
+
+    block.resize( num_pis() );
+    for ( auto i = 0u; i < num_pis(); ++i )
+    {
+      auto& tt = block[i];
+      tt.resize( static_cast<int>( num_bits ) );
+      std::fill( tt._bits.begin(), tt._bits.end(), 0u );
+
+      in.seekg( line_offsets[i] + first );
+      in.read( chars.data(), chars.size() );
+
+      for ( auto c = 0u; c < chars.size(); ++c )
+      {
+        const auto value = hex_value( chars[c] );
+        if ( value == invalid_hex )
+        {
+          /* the file has been modified since it was opened */
+          _valid = false;
+          return false;
+        }
+        const auto bit = 4u * ( last - 1u - first - c );
+        tt._bits[bit / 64u] |= static_cast<uint64_t>( value ) << ( bit % 64u );
+      }
+      tt.mask_bits();
+    }
+
+    _block_offset = begin;
+    _next_pattern = begin + num_bits;
+    return true;
+  }
+
+  /*! \brief Starts reading from the first pattern again. */
+  void rewind()
+  {
+    _next_pattern = 0u;
+    _block_offset = 0u;
+  }
+
+private:
+  static constexpr uint8_t invalid_hex = 0xff;
+
+  static uint8_t hex_value( char c )
+  {
+    if ( c >= '0' && c <= '9' )
+    {
+      return c - '0';
+    }
+    if ( c >= 'a' && c <= 'f' )
+    {
+      return c - 'a' + 10;
+    }
+    if ( c >= 'A' && c <= 'F' )
+    {
+      return c - 'A' + 10;
+    }
+    return invalid_hex;
+  }
+
+private:
+  std::ifstream in;
+  uint32_t words_per_block;
+  std::vector<uint64_t> line_offsets;
+  std::vector<char> chars;
+  uint64_t num_chars{ 0u };
+  uint64_t _num_patterns{ 0u };
+  uint64_t _next_pattern{ 0u };
+  uint64_t _block_offset{ 0u };
+  bool _valid{ false };
+};
+
+} // namespace mockturtle
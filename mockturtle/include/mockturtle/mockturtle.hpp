@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "mockturtle/algorithms/activity_estimation.hpp"
 #include "mockturtle/algorithms/aig_resub.hpp"
 #include "mockturtle/algorithms/akers_synthesis.hpp"
 #include "mockturtle/algorithms/aqfp/aqfp_assumptions.hpp"
@@ -59,6 +60,7 @@
 #include "mockturtle/algorithms/cleanup.hpp"
 #include "mockturtle/algorithms/cnf.hpp"
 #include "mockturtle/algorithms/collapse_mapped.hpp"
+#include "mockturtle/algorithms/compiled_simulation.hpp"
 #include "mockturtle/algorithms/cover_to_graph.hpp"
 #include "mockturtle/algorithms/cut_enumeration.hpp"
 #include "mockturtle/algorithms/cut_enumeration/cnf_cut.hpp"
@@ -74,6 +76,7 @@
 #include "mockturtle/algorithms/detail/minmc_xags.hpp"
 #include "mockturtle/algorithms/detail/resub_utils.hpp"
 #include "mockturtle/algorithms/detail/switching_activity.hpp"
+#include "mockturtle/algorithms/detail/truth_table6.hpp"
 #include "mockturtle/algorithms/dont_cares.hpp"
 #include "mockturtle/algorithms/dsd_decomposition.hpp"
 #include "mockturtle/algorithms/equivalence_checking.hpp"
@@ -88,6 +91,7 @@
 #include "mockturtle/algorithms/extract_linear.hpp"
 #include "mockturtle/algorithms/functional_reduction.hpp"
 #include "mockturtle/algorithms/gates_to_nodes.hpp"
+#include "mockturtle/algorithms/incremental_cuts.hpp"
 #include "mockturtle/algorithms/klut_to_graph.hpp"
 #include "mockturtle/algorithms/linear_resynthesis.hpp"
 #include "mockturtle/algorithms/lut_mapping.hpp"
@@ -114,6 +118,7 @@
 #include "mockturtle/algorithms/node_resynthesis/xag_npn.hpp"
 #include "mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp"
 #include "mockturtle/algorithms/node_resynthesis/xmg_npn.hpp"
+#include "mockturtle/algorithms/parallel_simulation.hpp"
 #include "mockturtle/algorithms/pattern_generation.hpp"
 #include "mockturtle/algorithms/reconv_cut.hpp"
 #include "mockturtle/algorithms/refactoring.hpp"
@@ -123,8 +128,11 @@
 #include "mockturtle/algorithms/resyn_engines/mig_resyn.hpp"
 #include "mockturtle/algorithms/resyn_engines/xag_resyn.hpp"
 #include "mockturtle/algorithms/satlut_mapping.hpp"
+#include "mockturtle/algorithms/sequential_simulation.hpp"
 #include "mockturtle/algorithms/sim_resub.hpp"
 #include "mockturtle/algorithms/simulation.hpp"
+#include "mockturtle/algorithms/streaming_simulation.hpp"
+#include "mockturtle/algorithms/structural_choices.hpp"
 #include "mockturtle/algorithms/testcase_minimizer.hpp"
 #include "mockturtle/algorithms/window_rewriting.hpp"
 #include "mockturtle/algorithms/xag_optimization.hpp"
@@ -143,11 +151,13 @@
 #include "mockturtle/generators/sorting.hpp"
 #include "mockturtle/io/aiger_reader.hpp"
 #include "mockturtle/io/bench_reader.hpp"
+#include "mockturtle/io/binary_network.hpp"
 #include "mockturtle/io/blif_reader.hpp"
 #include "mockturtle/io/bristol_reader.hpp"
 #include "mockturtle/io/dimacs_reader.hpp"
 #include "mockturtle/io/genlib_reader.hpp"
 #include "mockturtle/io/pla_reader.hpp"
+#include "mockturtle/io/read_patterns.hpp"
 #include "mockturtle/io/serialize.hpp"
 #include "mockturtle/io/super_reader.hpp"
 #include "mockturtle/io/verilog_reader.hpp"
@@ -179,13 +189,18 @@
 #include "mockturtle/properties/xmgcost.hpp"
 #include "mockturtle/traits.hpp"
 #include "mockturtle/utils/algorithm.hpp"
+#include "mockturtle/utils/bucket_queue.hpp"
+#include "mockturtle/utils/concurrent_vector.hpp"
 #include "mockturtle/utils/cost_functions.hpp"
+#include "mockturtle/utils/cow_containers.hpp"
 #include "mockturtle/utils/cuts.hpp"
 #include "mockturtle/utils/debugging_utils.hpp"
+#include "mockturtle/utils/fanout_index.hpp"
 #include "mockturtle/utils/hash_functions.hpp"
 #include "mockturtle/utils/include/percy.hpp"
 #include "mockturtle/utils/index_list.hpp"
 #include "mockturtle/utils/json_utils.hpp"
+#include "mockturtle/utils/mapped_file.hpp"
 #include "mockturtle/utils/mixed_radix.hpp"
 #include "mockturtle/utils/name_utils.hpp"
 #include "mockturtle/utils/network_cache.hpp"
@@ -197,10 +212,12 @@
 #include "mockturtle/utils/string_utils.hpp"
 #include "mockturtle/utils/super_utils.hpp"
 #include "mockturtle/utils/tech_library.hpp"
+#include "mockturtle/utils/thread_pool.hpp"
 #include "mockturtle/utils/truth_table_cache.hpp"
 #include "mockturtle/utils/truth_table_utils.hpp"
 #include "mockturtle/utils/window_utils.hpp"
 #include "mockturtle/views/binding_view.hpp"
+#include "mockturtle/views/choice_view.hpp"
 #include "mockturtle/views/cnf_view.hpp"
 #include "mockturtle/views/color_view.hpp"
 #include "mockturtle/views/cost_view.hpp"
@@ -209,8 +226,10 @@
 #include "mockturtle/views/fanout_limit_view.hpp"
 #include "mockturtle/views/fanout_view.hpp"
 #include "mockturtle/views/immutable_view.hpp"
+#include "mockturtle/views/incremental_simulation_view.hpp"
 #include "mockturtle/views/mapping_view.hpp"
 #include "mockturtle/views/mffc_view.hpp"
 #include "mockturtle/views/names_view.hpp"
+#include "mockturtle/views/timing_view.hpp"
 #include "mockturtle/views/topo_view.hpp"
 #include "mockturtle/views/window_view.hpp"
@@ -45,6 +45,8 @@
 #include <kitty/print.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <utility>
 
 namespace mockturtle
 {
@@ -76,19 +78,16 @@ struct cover_storage_data
 
 /*! \brief cover node
  *
- * The cover node is a mixed fanin node with the following attributes:
- * `children`  : vector of pointers to children
+ * The cover node is a pooled fanin node with the following attributes:
+ * `fanin_offset`: Position of the first child in the fan-in pool
+ * `fanin_size`  : Number of children
  * `data[0].h1`: Fan-out size
  * `data[0].h2`: Application-specific value
  * `data[1].h1`: Index of the cover of the node in the covers container
  * `data[1].h2`: Visited flags
  */
-struct cover_storage_node : mixed_fanin_node<2>
+struct cover_storage_node : pooled_fanin_node<2>
 {
-  bool operator==( cover_storage_node const& other ) const
-  {
-    return data[1].h1 == other.data[1].h1 && children == other.children;
-  }
 };
 
 /*! \brief cover storage container
@@ -96,12 +95,20 @@ struct cover_storage_node : mixed_fanin_node<2>
  * The network as a storage entity is defined by combining the node structure with the cover_storage structure.
  * The attributes of this storage unit are listed in the following:
  * `nodes`            : Vector of cover storage nodes
+ * `fanins`           : Fan-in pool with the children of all nodes
  * `inputs`           : Vector of indeces to inputs nodes
  * `outputs`          : Vector of pointers to node types
- * `hash`             : maps a node to its index in the nodes vector
+ * `hash`             : maps a node signature to its index in the nodes vector
  * `data`             : cover storage data
  */
-using cover_storage = storage<cover_storage_node, cover_storage_data>;
+using cover_storage = pooled_storage<cover_storage_node, cover_storage_data>;
+
+/*! \brief cover storage container with copy-on-write snapshots
+ *
+ * Same information as in `cover_storage`, but copies share nodes, fan-ins,
+ * and hash table entries until they are modified (see `cow_pooled_storage`).
+ */
+using cover_cow_storage = cow_pooled_storage<cover_storage_node, cover_storage_data>;
 
 /*! \brief cover_network
  *
@@ -111,6 +118,8 @@ using cover_storage = storage<cover_storage_node, cover_storage_data>;
  * ON set (OFF set) is considered.
  *
  * This data structure is primarily meant to be used for reading .blif files in which the number of variables would make it unfeasible the reading via a k-LUT network.
+ *
+ * The template parameter selects the storage layout, which is either `cover_storage` (the default, see `cover_network`) or `cover_cow_storage`.
  *
   \verbatim embed:rst
 
@@ -134,30 +143,30 @@ using cover_storage = storage<cover_storage_node, cover_storage_data>;
 
   \endverbatim
  */
-
-class cover_network
+template<typename Storage = cover_storage>
+class basic_cover_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
 
-  using base_type = cover_network;
+  using base_type = basic_cover_network;
   using cover_type = std::pair<std::vector<kitty::cube>, bool>;
-  using storage = std::shared_ptr<cover_storage>;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
   using signal = uint64_t;
 
-  cover_network()
-      : _storage( std::make_shared<cover_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_cover_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
-  cover_network( std::shared_ptr<cover_storage> storage )
+  basic_cover_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
@@ -173,14 +182,12 @@ protected:
     index = _storage->data.insert( std::make_pair( cube_dc, false ) );
     cover_storage_node& node_0 = _storage->nodes[0];
     node_0.data[1].h1 = index;
-    _storage->hash[node_0] = 0;
 
     /* reserve the second node for constant 1 */
     _storage->nodes.emplace_back();
     index = _storage->data.insert( std::make_pair( cube_dc, true ) );
     cover_storage_node& node_1 = _storage->nodes[1];
     node_1.data[1].h1 = index;
-    _storage->hash[node_1] = 1;
 
     /* reserve the third node for the identity (inputs)*/
   }
@@ -202,7 +209,6 @@ public:
     _storage->nodes.emplace_back();
     cover_storage_node& node_in = _storage->nodes[index_node];
     node_in.data[1].h1 = index_node;
-    _storage->hash[node_in] = index_node;
     _storage->inputs.emplace_back( index_node );
 
     return index_node;
@@ -370,19 +376,29 @@ public:
   {
 
     uint64_t literal = _storage->data.insert( new_cover );
-    storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
-    node.data[1].h1 = literal;
 
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    /* probe signatures until the node is found or a free slot is reached */
+    auto key = pooled_signature( literal, children.begin(), children.end() );
+    for ( auto it = _storage->hash.find( key ); it != _storage->hash.end(); it = _storage->hash.find( ++key ) )
     {
-      return it->second;
+      if ( _has_cover_and_fanins( it->second, literal, children ) )
+      {
+        return it->second;
+      }
     }
 
+    assert( _storage->fanins.size() + children.size() <= std::numeric_limits<uint32_t>::max() );
+
     const auto index = _storage->nodes.size();
-    _storage->nodes.emplace_back( node );
-    _storage->hash[node] = index;
+    auto& node = _storage->nodes.emplace_back();
+    node.fanin_offset = static_cast<uint32_t>( _storage->fanins.size() );
+    node.fanin_size = static_cast<uint32_t>( children.size() );
+    node.data[1].h1 = literal;
+    for ( auto c : children )
+    {
+      _storage->fanins.emplace_back( c );
+    }
+    _storage->hash[key] = index;
 
     /* increase ref-count to children */
     for ( auto c : children )
@@ -444,10 +460,10 @@ public:
     return _create_cover_node( children, new_cover );
   }
 
-  signal clone_node( cover_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_cover_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
-    cover_type cb = other._storage->data.covers[other._storage->nodes[source].data[1].h1];
+    cover_type cb = other._storage->data.covers[std::as_const( *other._storage ).nodes[source].data[1].h1];
     return create_cover_node( children, cb );
   }
 #pragma endregion
@@ -455,17 +471,19 @@ public:
 #pragma region Restructuring
   void substitute_node( node const& old_node, signal const& new_signal )
   {
-    /* find all parents from old_node */
+    /* find all parents from old_node, only modified fan-ins are accessed for writing */
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
-      auto& n = _storage->nodes[i];
-      for ( auto& child : n.children )
+      auto const& n = std::as_const( *_storage ).nodes[i];
+      const auto begin = std::as_const( *_storage ).fanins.begin() + n.fanin_offset;
+      const auto end = begin + n.fanin_size;
+      for ( auto it = begin; it != end; ++it )
       {
-        if ( child == old_node )
+        if ( *it == old_node )
         {
-          std::vector<signal> old_children( n.children.size() );
-          std::transform( n.children.begin(), n.children.end(), old_children.begin(), []( auto c ) { return c.index; } );
-          child = new_signal;
+          std::vector<signal> old_children( n.fanin_size );
+          std::transform( begin, end, old_children.begin(), []( auto c ) { return c.index; } );
+          _storage->fanins[n.fanin_offset + ( it - begin )] = new_signal;
 
           // increment fan-out of new node
           _storage->nodes[new_signal].data[0].h1++;
@@ -498,6 +516,38 @@ public:
   {
     return false;
   }
+
+  /*! \brief Takes a snapshot of the network.
+   *
+   * Only available for copy-on-write storage (see `cow_pooled_storage`),
+   * where the snapshot shares all nodes and fan-ins with the network.
+   * Snapshots are kept on a stack and are removed by `commit` or
+   * `rollback`.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void fork()
+  {
+    _storage->fork();
+  }
+
+  /*! \brief Keeps all changes since the most recent `fork`. */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void commit()
+  {
+    _storage->commit();
+  }
+
+  /*! \brief Reverts all changes since the most recent `fork`.
+   *
+   * No events are emitted, hence no views that register events may be
+   * attached to the network.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void rollback()
+  {
+    assert( _events->on_add.empty() && _events->on_modified.empty() && _events->on_delete.empty() && "rollback does not emit events" );
+    _storage->rollback();
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -533,12 +583,12 @@ public:
 
   uint32_t fanin_size( node const& n ) const
   {
-    return static_cast<uint32_t>( _storage->nodes[n].children.size() );
+    return std::as_const( *_storage ).nodes[n].fanin_size;
   }
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1;
+    return std::as_const( *_storage ).nodes[n].data[0].h1;
   }
 
   bool is_function( node const& n ) const
@@ -550,7 +600,7 @@ public:
 #pragma region Functional properties
   cover_type node_cover( const node& n ) const
   {
-    return _storage->data.covers[_storage->nodes[n].data[1].h1];
+    return _storage->data.covers[std::as_const( *_storage ).nodes[n].data[1].h1];
   }
 #pragma endregion
 
@@ -660,9 +710,11 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    auto const& storage = std::as_const( *_storage );
+    using IteratorType = decltype( storage.fanins.begin() );
+    const auto begin = storage.fanins.begin() + storage.nodes[n].fanin_offset;
     detail::foreach_element_transform<IteratorType, uint32_t>(
-        _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; },
+        begin, begin + storage.nodes[n].fanin_size, []( auto f ) { return f.index; },
         fn );
   }
 
@@ -682,7 +734,7 @@ public:
       index ^= *begin++ ? 1 : 0;
     }
     auto cb_input = kitty::cube( index, mask );
-    cover_type& cubes_cover = _storage->data.covers[_storage->nodes[n].data[1].h1];
+    cover_type& cubes_cover = _storage->data.covers[std::as_const( *_storage ).nodes[n].data[1].h1];
     for ( auto cb : cubes_cover.first )
     {
       if ( ( cb._bits & cb._mask ) == ( cb_input._bits & cb._mask ) )
@@ -696,7 +748,7 @@ public:
   iterates_over_truth_table_t<Iterator>
   compute( node const& n, Iterator begin, Iterator end ) const
   {
-    const auto nfanin = _storage->nodes[n].children.size();
+    const auto nfanin = std::as_const( *_storage ).nodes[n].fanin_size;
 
     std::vector<typename Iterator::value_type> tts( begin, end );
 
@@ -705,7 +757,7 @@ public:
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    cover_type& cubes_cover = _storage->data.covers[_storage->nodes[n].data[1].h1];
+    cover_type& cubes_cover = _storage->data.covers[std::as_const( *_storage ).nodes[n].data[1].h1];
     bool is_found = false;
     for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
     {
@@ -747,7 +799,7 @@ public:
 
   uint32_t value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return std::as_const( *_storage ).nodes[n].data[0].h2;
   }
 
   void set_value( node const& n, uint32_t v ) const
@@ -774,7 +826,7 @@ public:
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2;
+    return std::as_const( *_storage ).nodes[n].data[1].h2;
   }
 
   void set_visited( node const& n, uint32_t v ) const
@@ -800,9 +852,23 @@ public:
   }
 #pragma endregion
 
+protected:
+  bool _has_cover_and_fanins( node const& n, uint64_t literal, std::vector<signal> const& children ) const
+  {
+    auto const& nobj = std::as_const( *_storage ).nodes[n];
+    if ( nobj.data[1].h1 != literal || nobj.fanin_size != children.size() )
+    {
+      return false;
+    }
+    const auto begin = std::as_const( *_storage ).fanins.begin() + nobj.fanin_offset;
+    return std::equal( children.begin(), children.end(), begin, []( auto c, auto f ) { return c == f.index; } );
+  }
+
 public:
-  std::shared_ptr<cover_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using cover_network = basic_cover_network<>;
+
 } // namespace mockturtle
\ No newline at end of file
@@ -0,0 +1,188 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact.hpp
+  \brief Removes dead nodes from a network storage
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../storage.hpp"
+
+namespace mockturtle::detail
+{
+
+/*! \brief Removes dead nodes and renumbers the remaining nodes.
+ *
+ * The constant comes first, followed by the CIs in their current order and
+ * all live gates in topological order.  Fan-ins are renumbered and sorted
+ * in the same direction as before, since some networks encode the gate
+ * type in the fan-in order (e.g., AND and XOR in XAGs).  The structural
+ * hash table is rebuilt from the live gates.
+ *
+ * Works for `storage` and `cow_storage` with `regular_node` and for
+ * `soa_storage` with `fanin_node`, where the MSB of the fan-out size
+ * marks a dead node.  Not for `concurrent_storage`, whose nodes are not
+ * moved while they may be accessed.
+ *
+ * Returns a vector that maps each old node index to its new index, dead
+ * nodes are mapped to `std::numeric_limits<uint64_t>::max()`.
+ */
+template<class Storage>
+std::vector<uint64_t> compact_storage( Storage& storage )
+{
+  constexpr auto removed = std::numeric_limits<uint64_t>::max();
+
+  const auto is_dead = [&]( uint64_t n ) {
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return ( ( storage.fanout[n] >> 31 ) & 1 ) != 0;
+    }
+    else
+    {
+      return ( ( storage.nodes[n].data[0].h1 >> 31 ) & 1 ) != 0;
+    }
+  };
+
+  const auto num_nodes = storage.nodes.size();
+  std::vector<uint64_t> old_to_new( num_nodes, removed );
+  std::vector<uint64_t> new_to_old;
+  new_to_old.reserve( num_nodes );
+
+  const auto add = [&]( uint64_t n ) {
+    old_to_new[n] = new_to_old.size();
+    new_to_old.push_back( n );
+  };
+
+  /* constant and CIs keep their relative order */
+  add( 0 );
+  for ( auto const& ci : storage.inputs )
+  {
+    add( ci );
+  }
+
+  /* live gates in topological order, fan-ins are visited first */
+  std::vector<uint64_t> stack;
+  for ( auto n = 1u; n < num_nodes; ++n )
+  {
+    if ( old_to_new[n] != removed || is_dead( n ) )
+    {
+      continue;
+    }
+
+    stack.push_back( n );
+    while ( !stack.empty() )
+    {
+      const auto top = stack.back();
+      if ( old_to_new[top] != removed )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      bool ready = true;
+      for ( auto const& child : storage.nodes[top].children )
+      {
+        if ( old_to_new[child.index] == removed )
+        {
+          assert( !is_dead( child.index ) );
+          stack.push_back( child.index );
+          ready = false;
+        }
+      }
+
+      if ( ready )
+      {
+        stack.pop_back();
+        add( top );
+      }
+    }
+  }
+
+  /* move nodes and update fan-ins */
+  const auto num_cis = storage.inputs.size();
+  decltype( storage.nodes ) nodes;
+  nodes.reserve( new_to_old.size() );
+  for ( auto i = 0u; i < new_to_old.size(); ++i )
+  {
+    auto& node = nodes.emplace_back( storage.nodes[new_to_old[i]] );
+    if ( i <= num_cis )
+    {
+      /* constant and CIs store data instead of fan-ins */
+      continue;
+    }
+
+    const auto descending = node.children[0].index > node.children[1].index;
+    for ( auto& child : node.children )
+    {
+      child.index = old_to_new[child.index];
+    }
+    std::sort( node.children.begin(), node.children.end(), [&]( auto const& a, auto const& b ) {
+      return descending ? a.index > b.index : a.index < b.index;
+    } );
+  }
+  storage.nodes = std::move( nodes );
+
+  if constexpr ( is_soa_storage_v<Storage> )
+  {
+    const auto permute = [&]( std::vector<uint32_t>& values ) {
+      std::vector<uint32_t> permuted( new_to_old.size() );
+      std::transform( new_to_old.begin(), new_to_old.end(), permuted.begin(), [&]( auto n ) { return values[n]; } );
+      values = std::move( permuted );
+    };
+    permute( storage.fanout );
+    permute( storage.values );
+    permute( storage.visited );
+  }
+
+  for ( auto& ci : storage.inputs )
+  {
+    ci = old_to_new[ci];
+  }
+
+  for ( auto& output : storage.outputs )
+  {
+    assert( old_to_new[output.index] != removed );
+    output.index = old_to_new[output.index];
+  }
+
+  /* rebuild structural hash table */
+  storage.hash.clear();
+  for ( auto i = num_cis + 1; i < storage.nodes.size(); ++i )
+  {
+    storage.hash.emplace( storage.nodes[i], i );
+  }
+
+  return old_to_new;
+}
+
+} // namespace mockturtle::detail
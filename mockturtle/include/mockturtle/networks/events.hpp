@@ -36,21 +36,147 @@
 
 #include "../traits.hpp"
 
+#include <array>
 #include <functional>
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 
 namespace mockturtle
 {
 
+/*! \brief Static listener without any callbacks.
+ *
+ * Default listener of networks, which then only call the events that are
+ * registered at run-time.
+ */
+struct no_listener
+{
+};
+
+namespace detail
+{
+
+template<class Listener, class Ntk, class = void>
+struct has_listener_on_add : std::false_type
+{
+};
+
+template<class Listener, class Ntk>
+struct has_listener_on_add<Listener, Ntk, std::void_t<decltype( std::declval<Listener&>().on_add( std::declval<Ntk const&>(), std::declval<node<Ntk> const&>() ) )>> : std::true_type
+{
+};
+
+template<class Listener, class Ntk, class Children, class = void>
+struct has_listener_on_modified : std::false_type
+{
+};
+
+template<class Listener, class Ntk, class Children>
+struct has_listener_on_modified<Listener, Ntk, Children, std::void_t<decltype( std::declval<Listener&>().on_modified( std::declval<Ntk const&>(), std::declval<node<Ntk> const&>(), std::declval<Children const&>() ) )>> : std::true_type
+{
+};
+
+template<class Listener, class Ntk, class = void>
+struct has_listener_on_delete : std::false_type
+{
+};
+
+template<class Listener, class Ntk>
+struct has_listener_on_delete<Listener, Ntk, std::void_t<decltype( std::declval<Listener&>().on_delete( std::declval<Ntk const&>(), std::declval<node<Ntk> const&>() ) )>> : std::true_type
+{
+};
+
+} // namespace detail
+
+/*! \brief Combines several static listeners.
+ *
+ * The callbacks of all listeners are called in the order of the template
+ * arguments.  Each listener can be accessed with `std::get`-like casts,
+ * e.g., `static_cast<A&>( ntk.events().listener )`.
+ */
+template<class... Listeners>
+struct listeners : Listeners...
+{
+  template<class Ntk>
+  void on_add( Ntk const& ntk, node<Ntk> const& n )
+  {
+    ( call_on_add<Listeners>( ntk, n ), ... );
+  }
+
+  template<class Ntk, class Children>
+  void on_modified( Ntk const& ntk, node<Ntk> const& n, Children const& previous_children )
+  {
+    ( call_on_modified<Listeners>( ntk, n, previous_children ), ... );
+  }
+
+  template<class Ntk>
+  void on_delete( Ntk const& ntk, node<Ntk> const& n )
+  {
+    ( call_on_delete<Listeners>( ntk, n ), ... );
+  }
+
+private:
+  template<class Listener, class Ntk>
+  void call_on_add( Ntk const& ntk, node<Ntk> const& n )
+  {
+    if constexpr ( detail::has_listener_on_add<Listener, Ntk>::value )
+    {
+      static_cast<Listener&>( *this ).on_add( ntk, n );
+    }
+  }
+
+  template<class Listener, class Ntk, class Children>
+  void call_on_modified( Ntk const& ntk, node<Ntk> const& n, Children const& previous_children )
+  {
+    if constexpr ( detail::has_listener_on_modified<Listener, Ntk, Children>::value )
+    {
+      static_cast<Listener&>( *this ).on_modified( ntk, n, previous_children );
+    }
+  }
+
+  template<class Listener, class Ntk>
+  void call_on_delete( Ntk const& ntk, node<Ntk> const& n )
+  {
+    if constexpr ( detail::has_listener_on_delete<Listener, Ntk>::value )
+    {
+      static_cast<Listener&>( *this ).on_delete( ntk, n );
+    }
+  }
+};
+
 /*! \brief Network events.
  *
  * This data structure can be returned by a network.  Clients can add functions
  * to network events to call code whenever an event occurs.  Events are adding
  * a node, modifying a node, and deleting a node.
+ *
+ * Besides the events registered at run-time, a network can be instantiated
+ * with a static listener (`Listener`), which is called before the run-time
+ * events.  A static listener implements any subset of the methods
+ *
+ * - `on_add( ntk, n )`
+ * - `on_modified( ntk, n, previous_children )`
+ * - `on_delete( ntk, n )`
+ *
+ * where `previous_children` is a `std::array` of signals.  Since these
+ * calls are resolved at compile-time, they can be inlined, and networks
+ * with `no_listener` (the default) and without run-time events do not pay
+ * for events.  Static listeners are owned by the events object and can be
+ * accessed via `listener`.
+ *
+ * Views register run-time events and do not benefit from static listeners,
+ * except for `fanout_view`, which uses the fanouts of a `fanout_listener`
+ * if the network has one.
+ *
+ * Networks with concurrent storage (see `concurrent_storage`) create nodes
+ * from several threads, and then `on_add` events (static and run-time) may
+ * be called concurrently, each from the thread that created the node.
+ * Their callbacks must be thread-safe.  Registering or releasing events
+ * while nodes are created is not supported.
  */
-template<class Ntk>
+template<class Ntk, class Listener = no_listener>
 class network_events
 {
 public:
@@ -116,7 +242,54 @@ public:
                      std::end( on_delete ) );
   }
 
+  /*! \brief Notifies all listeners that node `n` has been added. */
+  void notify_add( Ntk const& ntk, node<Ntk> const& n )
+  {
+    if constexpr ( detail::has_listener_on_add<Listener, Ntk>::value )
+    {
+      listener.on_add( ntk, n );
+    }
+    for ( auto const& fn : on_add )
+    {
+      ( *fn )( n );
+    }
+  }
+
+  /*! \brief Notifies all listeners that node `n` has been modified. */
+  template<std::size_t NumChildren>
+  void notify_modified( Ntk const& ntk, node<Ntk> const& n, std::array<signal<Ntk>, NumChildren> const& previous_children )
+  {
+    if constexpr ( detail::has_listener_on_modified<Listener, Ntk, std::array<signal<Ntk>, NumChildren>>::value )
+    {
+      listener.on_modified( ntk, n, previous_children );
+    }
+    if ( !on_modified.empty() )
+    {
+      const std::vector<signal<Ntk>> children( previous_children.begin(), previous_children.end() );
+      for ( auto const& fn : on_modified )
+      {
+        ( *fn )( n, children );
+      }
+    }
+  }
+
+  /*! \brief Notifies all listeners that node `n` has been deleted. */
+  void notify_delete( Ntk const& ntk, node<Ntk> const& n )
+  {
+    if constexpr ( detail::has_listener_on_delete<Listener, Ntk>::value )
+    {
+      listener.on_delete( ntk, n );
+    }
+    for ( auto const& fn : on_delete )
+    {
+      ( *fn )( n );
+    }
+  }
+
 public:
+  /*! \brief Static listener. */
+  Listener listener;
+
   /*! \brief Event when node `n` is added. */
   std::vector<std::shared_ptr<add_event_type>> on_add;
 
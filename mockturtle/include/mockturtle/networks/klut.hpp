@@ -48,7 +48,9 @@
 #include <kitty/dynamic_truth_table.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <utility>
 
 namespace mockturtle
 {
@@ -59,48 +61,60 @@ struct klut_storage_data
 };
 
 /*! \brief k-LUT node
+ *
+ * The fan-ins are stored in the fan-in pool of `klut_storage`.
  *
  * `data[0].h1`: Fan-out size
  * `data[0].h2`: Application-specific value
  * `data[1].h1`: Function literal in truth table cache
  * `data[2].h2`: Visited flags
  */
-struct klut_storage_node : mixed_fanin_node<2>
+struct klut_storage_node : pooled_fanin_node<2>
 {
-  bool operator==( klut_storage_node const& other ) const
-  {
-    return data[1].h1 == other.data[1].h1 && children == other.children;
-  }
 };
 
 /*! \brief k-LUT storage container
 
   ...
 */
-using klut_storage = storage<klut_storage_node, klut_storage_data>;
+using klut_storage = pooled_storage<klut_storage_node, klut_storage_data>;
+
+/*! \brief k-LUT storage container with copy-on-write snapshots
+
+  Same information as in `klut_storage`, but copies share nodes, fan-ins,
+  and hash table entries until they are modified, which makes `fork`,
+  `commit`, and `rollback` cheap (see `cow_pooled_storage`).
+*/
+using klut_cow_storage = cow_pooled_storage<klut_storage_node, klut_storage_data>;
+
+/*! \brief k-LUT logic network
 
-class klut_network
+  The template parameter selects the storage layout, which is either
+  `klut_storage` (the default, see `klut_network`) or `klut_cow_storage`.
+*/
+template<typename Storage = klut_storage>
+class basic_klut_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
 
-  using base_type = klut_network;
-  using storage = std::shared_ptr<klut_storage>;
+  using base_type = basic_klut_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
   using signal = uint64_t;
 
-  klut_network()
-      : _storage( std::make_shared<klut_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_klut_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
-  klut_network( std::shared_ptr<klut_storage> storage )
+  basic_klut_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
@@ -108,6 +122,12 @@ public:
 protected:
   inline void _init()
   {
+    /* the storage is already initialized, e.g., when it is read from a file */
+    if ( _storage->nodes.size() > 1u )
+    {
+      return;
+    }
+
     /* reserve the second node for constant 1 */
     _storage->nodes.emplace_back();
 
@@ -298,19 +318,28 @@ public:
 #pragma region Create arbitrary functions
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
-    storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
-    node.data[1].h1 = literal;
-
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    /* probe signatures until the node is found or a free slot is reached */
+    auto key = pooled_signature( literal, children.begin(), children.end() );
+    for ( auto it = _storage->hash.find( key ); it != _storage->hash.end(); it = _storage->hash.find( ++key ) )
     {
-      return it->second;
+      if ( _has_function_and_fanins( it->second, literal, children ) )
+      {
+        return it->second;
+      }
     }
 
+    assert( _storage->fanins.size() + children.size() <= std::numeric_limits<uint32_t>::max() );
+
     const auto index = _storage->nodes.size();
-    _storage->nodes.push_back( node );
-    _storage->hash[node] = index;
+    auto& node = _storage->nodes.emplace_back();
+    node.fanin_offset = static_cast<uint32_t>( _storage->fanins.size() );
+    node.fanin_size = static_cast<uint32_t>( children.size() );
+    node.data[1].h1 = literal;
+    for ( auto c : children )
+    {
+      _storage->fanins.emplace_back( c );
+    }
+    _storage->hash[key] = index;
 
     /* increase ref-count to children */
     for ( auto c : children )
@@ -338,10 +367,10 @@ public:
     return _create_node( children, _storage->data.cache.insert( function ) );
   }
 
-  signal clone_node( klut_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_klut_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
-    const auto tt = other._storage->data.cache[other._storage->nodes[source].data[1].h1];
+    const auto tt = other._storage->data.cache[std::as_const( *other._storage ).nodes[source].data[1].h1];
     return create_node( children, tt );
   }
 #pragma endregion
@@ -349,17 +378,19 @@ public:
 #pragma region Restructuring
   void substitute_node( node const& old_node, signal const& new_signal )
   {
-    /* find all parents from old_node */
+    /* find all parents from old_node, only modified fan-ins are accessed for writing */
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
-      auto& n = _storage->nodes[i];
-      for ( auto& child : n.children )
+      auto const& n = std::as_const( *_storage ).nodes[i];
+      const auto begin = std::as_const( *_storage ).fanins.begin() + n.fanin_offset;
+      const auto end = begin + n.fanin_size;
+      for ( auto it = begin; it != end; ++it )
       {
-        if ( child == old_node )
+        if ( *it == old_node )
         {
-          std::vector<signal> old_children( n.children.size() );
-          std::transform( n.children.begin(), n.children.end(), old_children.begin(), []( auto c ) { return c.index; } );
-          child = new_signal;
+          std::vector<signal> old_children( n.fanin_size );
+          std::transform( begin, end, old_children.begin(), []( auto c ) { return c.index; } );
+          _storage->fanins[n.fanin_offset + ( it - begin )] = new_signal;
 
           // increment fan-out of new node
           _storage->nodes[new_signal].data[0].h1++;
@@ -392,6 +423,38 @@ public:
   {
     return false;
   }
+
+  /*! \brief Takes a snapshot of the network.
+   *
+   * Only available for copy-on-write storage (see `cow_pooled_storage`),
+   * where the snapshot shares all nodes and fan-ins with the network.
+   * Snapshots are kept on a stack and are removed by `commit` or
+   * `rollback`.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void fork()
+  {
+    _storage->fork();
+  }
+
+  /*! \brief Keeps all changes since the most recent `fork`. */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void commit()
+  {
+    _storage->commit();
+  }
+
+  /*! \brief Reverts all changes since the most recent `fork`.
+   *
+   * No events are emitted, hence no views that register events may be
+   * attached to the network.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void rollback()
+  {
+    assert( _events->on_add.empty() && _events->on_modified.empty() && _events->on_delete.empty() && "rollback does not emit events" );
+    _storage->rollback();
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -427,12 +490,12 @@ public:
 
   uint32_t fanin_size( node const& n ) const
   {
-    return static_cast<uint32_t>( _storage->nodes[n].children.size() );
+    return std::as_const( *_storage ).nodes[n].fanin_size;
   }
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1;
+    return std::as_const( *_storage ).nodes[n].data[0].h1;
   }
 
   bool is_function( node const& n ) const
@@ -444,7 +507,7 @@ public:
 #pragma region Functional properties
   kitty::dynamic_truth_table node_function( const node& n ) const
   {
-    return _storage->data.cache[_storage->nodes[n].data[1].h1];
+    return _storage->data.cache[std::as_const( *_storage ).nodes[n].data[1].h1];
   }
 #pragma endregion
 
@@ -552,9 +615,11 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    auto const& storage = std::as_const( *_storage );
+    using IteratorType = decltype( storage.fanins.begin() );
+    const auto begin = storage.fanins.begin() + storage.nodes[n].fanin_offset;
     detail::foreach_element_transform<IteratorType, uint32_t>(
-        _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
+        begin, begin + storage.nodes[n].fanin_size, []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
 
@@ -569,14 +634,14 @@ public:
       index <<= 1;
       index ^= *begin++ ? 1 : 0;
     }
-    return kitty::get_bit( _storage->data.cache[_storage->nodes[n].data[1].h1], index );
+    return kitty::get_bit( _storage->data.cache[std::as_const( *_storage ).nodes[n].data[1].h1], index );
   }
 
   template<typename Iterator>
   iterates_over_truth_table_t<Iterator>
   compute( node const& n, Iterator begin, Iterator end ) const
   {
-    const auto nfanin = _storage->nodes[n].children.size();
+    const auto nfanin = std::as_const( *_storage ).nodes[n].fanin_size;
 
     std::vector<typename Iterator::value_type> tts( begin, end );
 
@@ -585,7 +650,7 @@ public:
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    const auto gate_tt = _storage->data.cache[std::as_const( *_storage ).nodes[n].data[1].h1];
 
     for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
     {
@@ -612,7 +677,7 @@ public:
 
   uint32_t value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return std::as_const( *_storage ).nodes[n].data[0].h2;
   }
 
   void set_value( node const& n, uint32_t v ) const
@@ -639,7 +704,7 @@ public:
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2;
+    return std::as_const( *_storage ).nodes[n].data[1].h2;
   }
 
   void set_visited( node const& n, uint32_t v ) const
@@ -665,9 +730,23 @@ public:
   }
 #pragma endregion
 
+protected:
+  bool _has_function_and_fanins( node const& n, uint32_t literal, std::vector<signal> const& children ) const
+  {
+    auto const& nobj = std::as_const( *_storage ).nodes[n];
+    if ( nobj.data[1].h1 != literal || nobj.fanin_size != children.size() )
+    {
+      return false;
+    }
+    const auto begin = std::as_const( *_storage ).fanins.begin() + nobj.fanin_offset;
+    return std::equal( children.begin(), children.end(), begin, []( auto c, auto f ) { return c == f.index; } );
+  }
+
 public:
-  std::shared_ptr<klut_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using klut_network = basic_klut_network<>;
+
 } // namespace mockturtle
\ No newline at end of file
@@ -44,12 +44,14 @@
 #include <optional>
 #include <stack>
 #include <string>
+#include <utility>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -69,109 +71,142 @@ namespace mockturtle
 */
 using mig_storage = storage<regular_node<3, 2, 1>>;
 
-class mig_network
-{
-public:
-#pragma region Types and constructors
-  static constexpr auto min_fanin_size = 3u;
-  static constexpr auto max_fanin_size = 3u;
+/*! \brief MIG storage container with compact literals
 
-  using base_type = mig_network;
-  using storage = std::shared_ptr<mig_storage>;
-  using node = uint64_t;
+  Same as `mig_storage`, but fan-ins are stored as 32-bit literals (31-bit
+  index and complemented attribute).  Can be used for MIGs with less than
+  2^31 nodes.
+*/
+using mig_compact_storage = storage<regular_node<3, 2, 1, uint32_t>>;
 
-  struct signal
-  {
-    signal() = default;
+/*! \brief MIG storage container with copy-on-write snapshots
 
-    signal( uint64_t index, uint64_t complement )
-        : complement( complement ), index( index )
-    {
-    }
+  Same information as in `mig_storage`, but copies share nodes and hash
+  table entries until they are modified, which makes `fork`, `commit`, and
+  `rollback` cheap (see `cow_storage`).
+*/
+using mig_cow_storage = cow_storage<regular_node<3, 2, 1>>;
 
-    explicit signal( uint64_t data )
-        : data( data )
-    {
-    }
+/*! \brief Signal in an MIG (shared by all storage layouts) */
+struct mig_signal
+{
+  mig_signal() = default;
 
-    signal( mig_storage::node_type::pointer_type const& p )
-        : complement( p.weight ), index( p.index )
-    {
-    }
+  mig_signal( uint64_t index, uint64_t complement )
+      : complement( complement ), index( index )
+  {
+  }
 
-    union
+  explicit mig_signal( uint64_t data )
+      : data( data )
+  {
+  }
+
+  template<typename Word>
+  mig_signal( node_pointer<1, Word> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
+
+  union
+  {
+    struct
     {
-      struct
-      {
-        uint64_t complement : 1;
-        uint64_t index : 63;
-      };
-      uint64_t data;
+      uint64_t complement : 1;
+      uint64_t index : 63;
     };
+    uint64_t data;
+  };
 
-    signal operator!() const
-    {
-      return signal( data ^ 1 );
-    }
+  mig_signal operator!() const
+  {
+    return mig_signal( data ^ 1 );
+  }
 
-    signal operator+() const
-    {
-      return { index, 0 };
-    }
+  mig_signal operator+() const
+  {
+    return { index, 0 };
+  }
 
-    signal operator-() const
-    {
-      return { index, 1 };
-    }
+  mig_signal operator-() const
+  {
+    return { index, 1 };
+  }
 
-    signal operator^( bool complement ) const
-    {
-      return signal( data ^ ( complement ? 1 : 0 ) );
-    }
+  mig_signal operator^( bool complement ) const
+  {
+    return mig_signal( data ^ ( complement ? 1 : 0 ) );
+  }
 
-    bool operator==( signal const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( mig_signal const& other ) const
+  {
+    return data == other.data;
+  }
 
-    bool operator!=( signal const& other ) const
-    {
-      return data != other.data;
-    }
+  bool operator!=( mig_signal const& other ) const
+  {
+    return data != other.data;
+  }
 
-    bool operator<( signal const& other ) const
-    {
-      return data < other.data;
-    }
+  bool operator<( mig_signal const& other ) const
+  {
+    return data < other.data;
+  }
 
-    operator mig_storage::node_type::pointer_type() const
-    {
-      return { index, complement };
-    }
+  template<typename Word>
+  operator node_pointer<1, Word>() const
+  {
+    return { index, complement };
+  }
 
 #if __cplusplus > 201703L
-    bool operator==( mig_storage::node_type::pointer_type const& other ) const
-    {
-      return data == other.data;
-    }
+  template<typename Word>
+  bool operator==( node_pointer<1, Word> const& other ) const
+  {
+    return data == other.data;
+  }
 #endif
-  };
+};
+
+/*! \brief MIG logic network
+
+  The template parameter selects the storage, which is one of `mig_storage`
+  (the default, see `mig_network`), `mig_compact_storage`, or
+  `mig_cow_storage`.
+
+  The second template parameter is a static listener for network events
+  (see `network_events`), which is called without indirection.  The
+  default `no_listener` does not add any cost.
+*/
+template<typename Storage = mig_storage, typename Listener = no_listener>
+class basic_mig_network
+{
+public:
+#pragma region Types and constructors
+  static constexpr auto min_fanin_size = 3u;
+  static constexpr auto max_fanin_size = 3u;
+
+  using base_type = basic_mig_network;
+  using storage = std::shared_ptr<Storage>;
+  using node = uint64_t;
+  using signal = mig_signal;
+
 
-  mig_network()
-      : _storage( std::make_shared<mig_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_mig_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<network_events<base_type, Listener>>() )
   {
   }
 
-  mig_network( std::shared_ptr<mig_storage> storage )
+  basic_mig_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<network_events<base_type, Listener>>() )
   {
   }
 
-  mig_network clone() const
+  basic_mig_network clone() const
   {
-    return { std::make_shared<mig_storage>( *_storage ) };
+    return { std::make_shared<Storage>( *_storage ) };
   }
 #pragma endregion
 
@@ -184,6 +219,7 @@ public:
   signal create_pi()
   {
     const auto index = _storage->nodes.size();
+    assert( index <= Storage::node_type::pointer_type::max_index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = node.children[2].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
@@ -211,12 +247,12 @@ public:
 
   bool is_ci( node const& n ) const
   {
-    return _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data && _storage->nodes[n].children[0].data == _storage->nodes[n].children[2].data;
+    return std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data && std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[2].data;
   }
 
   bool is_pi( node const& n ) const
   {
-    return _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data && _storage->nodes[n].children[0].data == _storage->nodes[n].children[2].data && !is_constant( n );
+    return std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data && std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[2].data && !is_constant( n );
   }
 
   bool constant_value( node const& n ) const
@@ -280,7 +316,7 @@ public:
       c.complement = !c.complement;
     }
 
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
     node.children[2] = c;
@@ -293,6 +329,7 @@ public:
     }
 
     const auto index = _storage->nodes.size();
+    assert( index <= Storage::node_type::pointer_type::max_index );
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
@@ -309,10 +346,7 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( *this, index );
 
     return { index, node_complement };
   }
@@ -399,7 +433,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( mig_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_mig_network const& other, node const& source, std::vector<signal> const& children )
   {
     (void)other;
     (void)source;
@@ -411,7 +445,8 @@ public:
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
-    auto& node = _storage->nodes[n];
+    // read the fanins through const access, the node is only written if one of them matches
+    auto const& cnode = std::as_const( *_storage ).nodes[n];
 
     uint32_t fanin = 0u;
     for ( auto i = 0u; i < 4u; ++i )
@@ -421,14 +456,16 @@ public:
         return std::nullopt;
       }
 
-      if ( node.children[i].index == old_node )
+      if ( cnode.children[i].index == old_node )
       {
         fanin = i;
-        new_signal.complement ^= node.children[i].weight;
+        new_signal.complement ^= cnode.children[i].weight;
         break;
       }
     }
 
+    auto& node = _storage->nodes[n];
+
     // determine potential new children of node n
     signal child2 = new_signal;
     signal child1 = node.children[( fanin + 1 ) % 3];
@@ -463,7 +500,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     _hash_obj.children[2] = child2;
@@ -489,10 +526,7 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _events->notify_modified( *this, n, std::array<signal, 3u>{ old_child0, old_child1, old_child2 } );
 
     return std::nullopt;
   }
@@ -528,10 +562,7 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( *this, n );
 
     for ( auto i = 0u; i < 3u; ++i )
     {
@@ -548,7 +579,7 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    return ( std::as_const( *_storage ).nodes[n].data[0].h1 >> 31 ) & 1;
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -592,6 +623,54 @@ public:
       }
     }
   }
+
+  /*! \brief Removes dead nodes in place.
+   *
+   * Renumbers the remaining nodes such that the constant comes first,
+   * followed by the CIs and all live gates in topological order, and
+   * rebuilds the structural hash table.  Node indices kept outside the
+   * network, e.g., in views, become invalid.
+   *
+   * \return Maps each old node index to its new index (dead nodes are
+   *         mapped to `std::numeric_limits<uint64_t>::max()`), can be
+   *         passed to `node_map::remap`
+   */
+  std::vector<uint64_t> compact()
+  {
+    return detail::compact_storage( *_storage );
+  }
+
+  /*! \brief Takes a snapshot of the network.
+   *
+   * Only available for copy-on-write storage (see `cow_storage`), where the
+   * snapshot shares all nodes with the network.  Snapshots are kept on a
+   * stack and are removed by `commit` or `rollback`.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void fork()
+  {
+    _storage->fork();
+  }
+
+  /*! \brief Keeps all changes since the most recent `fork`. */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void commit()
+  {
+    _storage->commit();
+  }
+
+  /*! \brief Reverts all changes since the most recent `fork`.
+   *
+   * No events are emitted, hence no views that register events may be
+   * attached to the network, and a static listener must be updated by the
+   * caller.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void rollback()
+  {
+    assert( _events->on_add.empty() && _events->on_modified.empty() && _events->on_delete.empty() && "rollback does not emit events" );
+    _storage->rollback();
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -634,7 +713,7 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return std::as_const( *_storage ).nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t incr_fanout_size( node const& n ) const
@@ -763,9 +842,9 @@ public:
 
   uint32_t ci_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data &&
-            _storage->nodes[n].children[0].data == _storage->nodes[n].children[2].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data &&
+            std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[2].data );
+    return static_cast<uint32_t>( std::as_const( *_storage ).nodes[n].children[0].data );
   }
 
   uint32_t co_index( signal const& s ) const
@@ -784,9 +863,9 @@ public:
 
   uint32_t pi_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data &&
-            _storage->nodes[n].children[0].data == _storage->nodes[n].children[2].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data &&
+            std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[2].data );
+    return static_cast<uint32_t>( std::as_const( *_storage ).nodes[n].children[0].data );
   }
 
   uint32_t po_index( signal const& s ) const
@@ -863,31 +942,31 @@ public:
     // we don't use foreach_element here to have better performance
     if constexpr ( detail::is_callable_without_index_v<Fn, signal, bool> )
     {
-      if ( !fn( signal{ _storage->nodes[n].children[0] } ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[0] } ) )
         return;
-      if ( !fn( signal{ _storage->nodes[n].children[1] } ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[1] } ) )
         return;
-      fn( signal{ _storage->nodes[n].children[2] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[2] } );
     }
     else if constexpr ( detail::is_callable_with_index_v<Fn, signal, bool> )
     {
-      if ( !fn( signal{ _storage->nodes[n].children[0] }, 0 ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[0] }, 0 ) )
         return;
-      if ( !fn( signal{ _storage->nodes[n].children[1] }, 1 ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[1] }, 1 ) )
         return;
-      fn( signal{ _storage->nodes[n].children[2] }, 2 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[2] }, 2 );
     }
     else if constexpr ( detail::is_callable_without_index_v<Fn, signal, void> )
     {
-      fn( signal{ _storage->nodes[n].children[0] } );
-      fn( signal{ _storage->nodes[n].children[1] } );
-      fn( signal{ _storage->nodes[n].children[2] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[0] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[2] } );
     }
     else if constexpr ( detail::is_callable_with_index_v<Fn, signal, void> )
     {
-      fn( signal{ _storage->nodes[n].children[0] }, 0 );
-      fn( signal{ _storage->nodes[n].children[1] }, 1 );
-      fn( signal{ _storage->nodes[n].children[2] }, 2 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[0] }, 0 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] }, 1 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[2] }, 2 );
     }
   }
 #pragma endregion
@@ -901,9 +980,9 @@ public:
 
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
-    auto const& c3 = _storage->nodes[n].children[2];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
+    auto const& c3 = std::as_const( *_storage ).nodes[n].children[2];
 
     auto v1 = *begin++;
     auto v2 = *begin++;
@@ -920,9 +999,9 @@ public:
 
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
-    auto const& c3 = _storage->nodes[n].children[2];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
+    auto const& c3 = std::as_const( *_storage ).nodes[n].children[2];
 
     auto tt1 = *begin++;
     auto tt2 = *begin++;
@@ -940,9 +1019,9 @@ public:
     (void)end;
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
-    auto const& c3 = _storage->nodes[n].children[2];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
+    auto const& c3 = std::as_const( *_storage ).nodes[n].children[2];
 
     auto tt1 = *begin++;
     auto tt2 = *begin++;
@@ -971,7 +1050,7 @@ public:
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return std::as_const( *_storage ).nodes[n].data[0].h2;
   }
 
   void set_value( node const& n, uint32_t v ) const
@@ -998,7 +1077,7 @@ public:
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h1;
+    return std::as_const( *_storage ).nodes[n].data[1].h1;
   }
 
   void set_visited( node const& n, uint32_t v ) const
@@ -1025,8 +1104,15 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<mig_storage> _storage;
-  std::shared_ptr<network_events<base_type>> _events;
+  std::shared_ptr<Storage> _storage;
+  std::shared_ptr<network_events<base_type, Listener>> _events;
+};
+
+using mig_network = basic_mig_network<mig_storage>;
+
+template<class Storage, class Listener>
+struct is_mig_network_type<basic_mig_network<Storage, Listener>> : std::true_type
+{
 };
 
 } // namespace mockturtle
@@ -1035,9 +1121,9 @@ namespace std
 {
 
 template<>
-struct hash<mockturtle::mig_network::signal>
+struct hash<mockturtle::mig_signal>
 {
-  uint64_t operator()( mockturtle::mig_network::signal const& s ) const noexcept
+  uint64_t operator()( mockturtle::mig_signal const& s ) const noexcept
   {
     uint64_t k = s.data;
     k ^= k >> 33;
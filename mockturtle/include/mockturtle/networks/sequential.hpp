@@ -53,20 +53,20 @@ struct is_aig_like : std::false_type
 {
 };
 
-template<>
-struct is_aig_like<aig_network> : std::true_type
+template<class Storage, class Listener>
+struct is_aig_like<basic_aig_network<Storage, Listener>> : std::true_type
 {
 };
-template<>
-struct is_aig_like<xag_network> : std::true_type
+template<class Storage, class Listener>
+struct is_aig_like<basic_xag_network<Storage, Listener>> : std::true_type
 {
 };
-template<>
-struct is_aig_like<mig_network> : std::true_type
+template<class Storage, class Listener>
+struct is_aig_like<basic_mig_network<Storage, Listener>> : std::true_type
 {
 };
-template<>
-struct is_aig_like<xmg_network> : std::true_type
+template<class Storage, class Listener>
+struct is_aig_like<basic_xmg_network<Storage, Listener>> : std::true_type
 {
 };
 template<>
@@ -358,8 +358,8 @@ public:
   sequential()
       : _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
+    static_assert( is_aig_network_type_v<base_type> || is_xag_network_type_v<base_type> ||
+                       is_mig_network_type_v<base_type> || is_xmg_network_type_v<base_type> ||
                        std::is_same_v<base_type, aqfp_network>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
@@ -367,8 +367,8 @@ public:
   sequential( storage base_storage )
       : Ntk( base_storage ), _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
+    static_assert( is_aig_network_type_v<base_type> || is_xag_network_type_v<base_type> ||
+                       is_mig_network_type_v<base_type> || is_xmg_network_type_v<base_type> ||
                        std::is_same_v<base_type, aqfp_network>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
@@ -739,7 +739,7 @@ public:
   signal po_at( uint32_t index ) const
   {
     assert( index < _sequential_storage->num_pos );
-    return *( this->_storage->outputs.begin() + index );
+    return ( this->_storage->outputs.begin() + index )->index;
   }
 
   node ci_at( uint32_t index ) const
@@ -751,7 +751,7 @@ public:
   signal co_at( uint32_t index ) const
   {
     assert( index < this->_storage->outputs.size() );
-    return *( this->_storage->outputs.begin() + index );
+    return ( this->_storage->outputs.begin() + index )->index;
   }
 
   node ro_at( uint32_t index ) const
@@ -763,7 +763,7 @@ public:
   signal ri_at( uint32_t index ) const
   {
     assert( index < this->_storage->outputs.size() - _sequential_storage->num_pos );
-    return *( this->_storage->outputs.begin() + _sequential_storage->num_pos + index );
+    return ( this->_storage->outputs.begin() + _sequential_storage->num_pos + index )->index;
   }
 
   void set_register( uint32_t index, register_t reg )
@@ -39,22 +39,42 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
 
+#include "../utils/concurrent_vector.hpp"
+#include "../utils/cow_containers.hpp"
+
 namespace mockturtle
 {
 
-template<int PointerFieldSize = 0>
+/*! \brief Pointer to a node
+
+  The pointer is stored in a word of type `Word`, which is either `uint64_t`
+  (default) or `uint32_t`.  The latter results in compact literals, which
+  can be used as long as the network has less than
+  2^(32 - `PointerFieldSize`) nodes.
+*/
+template<int PointerFieldSize = 0, typename Word = uint64_t>
 struct node_pointer
 {
 private:
-  static constexpr auto _len = sizeof( uint64_t ) * 8;
+  static constexpr auto _len = sizeof( Word ) * 8;
 
 public:
+  using word_type = Word;
+
+  /*! \brief Largest index that can be represented */
+  static constexpr uint64_t max_index = ( UINT64_C( 1 ) << ( _len - PointerFieldSize ) ) - 1u;
+
   node_pointer() = default;
   node_pointer( uint64_t index, uint64_t weight ) : weight( weight ), index( index ) {}
 
@@ -62,32 +82,37 @@ public:
   {
     struct
     {
-      uint64_t weight : PointerFieldSize;
-      uint64_t index : _len - PointerFieldSize;
+      Word weight : PointerFieldSize;
+      Word index : _len - PointerFieldSize;
     };
-    uint64_t data;
+    Word data;
   };
 
-  bool operator==( node_pointer<PointerFieldSize> const& other ) const
+  bool operator==( node_pointer<PointerFieldSize, Word> const& other ) const
   {
     return data == other.data;
   }
 };
 
-template<>
-struct node_pointer<0>
+template<typename Word>
+struct node_pointer<0, Word>
 {
 public:
+  using word_type = Word;
+
+  /*! \brief Largest index that can be represented */
+  static constexpr uint64_t max_index = static_cast<Word>( ~Word( 0 ) );
+
   node_pointer() = default;
   node_pointer( uint64_t index ) : index( index ) {}
 
   union
   {
-    uint64_t index;
-    uint64_t data;
+    Word index;
+    Word data;
   };
 
-  bool operator==( node_pointer<0> const& other ) const
+  bool operator==( node_pointer<0, Word> const& other ) const
   {
     return data == other.data;
   }
@@ -110,15 +135,33 @@ union cauint64_t
   };
 };
 
-template<int Fanin, int Size = 0, int PointerFieldSize = 0>
+template<int Fanin, int Size = 0, int PointerFieldSize = 0, typename Word = uint64_t>
 struct regular_node
 {
-  using pointer_type = node_pointer<PointerFieldSize>;
+  using pointer_type = node_pointer<PointerFieldSize, Word>;
 
   std::array<pointer_type, Fanin> children;
   std::array<cauint64_t, Size> data;
 
-  bool operator==( regular_node<Fanin, Size, PointerFieldSize> const& other ) const
+  bool operator==( regular_node<Fanin, Size, PointerFieldSize, Word> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
+/*! \brief Node that only stores its fan-ins
+
+  Used together with `soa_storage`, which keeps the additional node data in
+  separate arrays.
+*/
+template<int Fanin, int PointerFieldSize = 0, typename Word = uint64_t>
+struct fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize, Word>;
+
+  std::array<pointer_type, Fanin> children;
+
+  bool operator==( fanin_node<Fanin, PointerFieldSize, Word> const& other ) const
   {
     return children == other.children;
   }
@@ -138,6 +181,22 @@ struct mixed_fanin_node
   }
 };
 
+/*! \brief Node whose fan-ins are kept in a shared fan-in pool
+
+  Used together with `pooled_storage`.  The fan-ins of a node are the
+  `fanin_size` consecutive entries starting at `fanin_offset` in the
+  `fanins` array of the storage.
+*/
+template<int Size = 0, int PointerFieldSize = 0>
+struct pooled_fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize>;
+
+  uint32_t fanin_offset{ 0 };
+  uint32_t fanin_size{ 0 };
+  std::array<cauint64_t, Size> data;
+};
+
 /*! \brief Hash function for 64-bit word */
 inline uint64_t hash_block( uint64_t word )
 {
@@ -162,6 +221,21 @@ inline void hash_combine( uint64_t& seed, uint64_t other )
   seed += 0xe6546b64;
 }
 
+/*! \brief Structural signature of a node in a `pooled_storage`
+
+  Combines the function literal of a node with the indices of its fan-ins.
+*/
+template<typename Iterator>
+uint64_t pooled_signature( uint64_t function, Iterator begin, Iterator end )
+{
+  auto seed = hash_block( function );
+  while ( begin != end )
+  {
+    hash_combine( seed, hash_block( *begin++ ) );
+  }
+  return seed;
+}
+
 template<typename Node>
 struct node_hash
 {
@@ -208,9 +282,344 @@ struct storage
   std::vector<uint64_t> inputs;
   std::vector<typename node_type::pointer_type> outputs;
 
-  phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
+  phmap::flat_hash_map<node_type, typename node_type::pointer_type::word_type, NodeHasher> hash;
 
   T data;
 };
 
+/*! \brief Structure-of-arrays storage container
+
+  Instead of keeping each node as one struct, this container keeps the
+  fan-ins of all nodes in one contiguous array (`nodes`) and stores the
+  additional node data in separate arrays:
+
+  `fanout`: Fan-out size (we use MSB to indicate whether a node is dead)
+  `values`: Application-specific value
+  `visited`: Visited flag
+
+  Traversals that only access fan-ins, such as topological sorting, cut
+  enumeration, or simulation, therefore do not load the remaining data into
+  the cache.  The `Node` type is expected to be a `fanin_node`.
+*/
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
+struct soa_storage
+{
+  soa_storage()
+  {
+    nodes.reserve( 10000u );
+    fanout.reserve( 10000u );
+    values.reserve( 10000u );
+    visited.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+    fanout.emplace_back( 0u );
+    values.emplace_back( 0u );
+    visited.emplace_back( 0u );
+  }
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  std::vector<node_type> nodes;
+  std::vector<uint32_t> fanout;
+  std::vector<uint32_t> values;
+  std::vector<uint32_t> visited;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  phmap::flat_hash_map<node_type, typename node_type::pointer_type::word_type, NodeHasher> hash;
+
+  T data;
+};
+
+/*! \brief Storage container with a shared fan-in pool
+
+  Used for networks with a variable number of fan-ins per node.  Instead of
+  one heap-allocated fan-in vector per node, the fan-ins of all nodes are
+  appended to one contiguous array (`fanins`) and each node refers to its
+  range by offset and size.  Fan-in lists are only appended and are
+  rewritten in place by substitution, hence the pool never contains gaps.
+
+  Since a node alone does not contain its fan-ins, `hash` maps a structural
+  signature of a node (function and fan-ins) to the node index.  Lookups
+  must compare the fan-ins of the found node and probe the next signature
+  in case of a mismatch.  The `Node` type is expected to be a
+  `pooled_fanin_node`.
+*/
+template<typename Node, typename T = empty_storage_data>
+struct pooled_storage
+{
+  pooled_storage()
+  {
+    nodes.reserve( 10000u );
+    fanins.reserve( 20000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  std::vector<node_type> nodes;
+  std::vector<typename node_type::pointer_type> fanins;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  phmap::flat_hash_map<uint64_t, uint64_t> hash;
+
+  T data;
+};
+
+/*! \brief Storage container for concurrent node creation
+
+  Structure-of-arrays layout (see `soa_storage`) in which all node arrays are
+  `concurrent_vector`s and the fan-out sizes are atomic.  The structural
+  hash table is a `phmap::parallel_flat_hash_map` with `2^6` submaps, each
+  protected by its own mutex.
+
+  Networks use the lock of the submap to serialize the creation of
+  structurally equal nodes and allocate node indexes atomically.  Hence,
+  several threads can create gates in the same network at the same time and
+  structural hashing stays canonical.  Creating PIs and POs and all other
+  modifications are not thread-safe.  The `Node` type is expected to be a
+  `fanin_node`.
+*/
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
+struct concurrent_storage
+{
+  concurrent_storage()
+  {
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+    fanout.emplace_back( 0u );
+    values.emplace_back( 0u );
+    visited.emplace_back( 0u );
+  }
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  concurrent_vector<node_type> nodes;
+  concurrent_vector<std::atomic<uint32_t>> fanout;
+  concurrent_vector<uint32_t> values;
+  concurrent_vector<uint32_t> visited;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  phmap::parallel_flat_hash_map<node_type, typename node_type::pointer_type::word_type, NodeHasher,
+                                phmap::priv::hash_default_eq<node_type>,
+                                phmap::priv::Allocator<phmap::priv::Pair<const node_type, typename node_type::pointer_type::word_type>>,
+                                6, std::mutex>
+      hash;
+
+  T data;
+};
+
+/*! \brief Storage container with copy-on-write snapshots
+
+  Same information as in `storage`, but nodes are kept in a `cow_vector`
+  and the structural hash table is a `cow_hash_map`.  Copying the storage
+  therefore only copies page tables, and pages and hash table shards are
+  copied when they are accessed for modification.  Networks read their
+  nodes through const access, hence only the pages of nodes that are
+  modified after a copy are copied.
+
+  `fork` pushes a snapshot of the current state on a stack, `rollback`
+  restores the most recent snapshot, and `commit` discards it.  Snapshots
+  are immutable and can be shared between copies of the storage.
+*/
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
+struct cow_storage
+{
+  cow_storage()
+  {
+    nodes.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  struct snapshot
+  {
+    uint32_t trav_id;
+    cow_vector<node_type> nodes;
+    std::vector<uint64_t> inputs;
+    std::vector<typename node_type::pointer_type> outputs;
+    cow_hash_map<node_type, typename node_type::pointer_type::word_type, NodeHasher> hash;
+    T data;
+  };
+
+  /*! \brief Takes a snapshot of the current state. */
+  void fork()
+  {
+    snapshots.push_back( std::make_shared<const snapshot>( snapshot{ trav_id, nodes, inputs, outputs, hash, data } ) );
+  }
+
+  /*! \brief Discards the most recent snapshot and keeps the current state. */
+  void commit()
+  {
+    assert( !snapshots.empty() );
+    snapshots.pop_back();
+  }
+
+  /*! \brief Restores the most recent snapshot and discards it. */
+  void rollback()
+  {
+    assert( !snapshots.empty() );
+    auto const& s = *snapshots.back();
+    trav_id = s.trav_id;
+    nodes = s.nodes;
+    inputs = s.inputs;
+    outputs = s.outputs;
+    hash = s.hash;
+    data = s.data;
+    snapshots.pop_back();
+  }
+
+  uint32_t trav_id = 0u;
+
+  cow_vector<node_type> nodes;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  cow_hash_map<node_type, typename node_type::pointer_type::word_type, NodeHasher> hash;
+
+  T data;
+
+  std::vector<std::shared_ptr<const snapshot>> snapshots;
+};
+
+/*! \brief Pooled storage container with copy-on-write snapshots
+
+  Same information as in `pooled_storage`, but nodes and the fan-in pool
+  are kept in `cow_vector`s and the structural hash table is a
+  `cow_hash_map`.  Snapshots work as in `cow_storage`.
+*/
+template<typename Node, typename T = empty_storage_data>
+struct cow_pooled_storage
+{
+  cow_pooled_storage()
+  {
+    nodes.reserve( 10000u );
+    fanins.reserve( 20000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  struct snapshot
+  {
+    uint32_t trav_id;
+    cow_vector<node_type> nodes;
+    cow_vector<typename node_type::pointer_type> fanins;
+    std::vector<uint64_t> inputs;
+    std::vector<typename node_type::pointer_type> outputs;
+    cow_hash_map<uint64_t, uint64_t> hash;
+    T data;
+  };
+
+  /*! \brief Takes a snapshot of the current state. */
+  void fork()
+  {
+    snapshots.push_back( std::make_shared<const snapshot>( snapshot{ trav_id, nodes, fanins, inputs, outputs, hash, data } ) );
+  }
+
+  /*! \brief Discards the most recent snapshot and keeps the current state. */
+  void commit()
+  {
+    assert( !snapshots.empty() );
+    snapshots.pop_back();
+  }
+
+  /*! \brief Restores the most recent snapshot and discards it. */
+  void rollback()
+  {
+    assert( !snapshots.empty() );
+    auto const& s = *snapshots.back();
+    trav_id = s.trav_id;
+    nodes = s.nodes;
+    fanins = s.fanins;
+    inputs = s.inputs;
+    outputs = s.outputs;
+    hash = s.hash;
+    data = s.data;
+    snapshots.pop_back();
+  }
+
+  uint32_t trav_id = 0u;
+
+  cow_vector<node_type> nodes;
+  cow_vector<typename node_type::pointer_type> fanins;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  cow_hash_map<uint64_t, uint64_t> hash;
+
+  T data;
+
+  std::vector<std::shared_ptr<const snapshot>> snapshots;
+};
+
+template<typename Storage>
+struct is_soa_storage : std::false_type
+{
+};
+
+template<typename Node, typename T, typename NodeHasher>
+struct is_soa_storage<soa_storage<Node, T, NodeHasher>> : std::true_type
+{
+};
+
+template<typename Node, typename T, typename NodeHasher>
+struct is_soa_storage<concurrent_storage<Node, T, NodeHasher>> : std::true_type
+{
+};
+
+template<typename Storage>
+inline constexpr bool is_soa_storage_v = is_soa_storage<Storage>::value;
+
+template<typename Storage>
+struct is_concurrent_storage : std::false_type
+{
+};
+
+template<typename Node, typename T, typename NodeHasher>
+struct is_concurrent_storage<concurrent_storage<Node, T, NodeHasher>> : std::true_type
+{
+};
+
+template<typename Storage>
+inline constexpr bool is_concurrent_storage_v = is_concurrent_storage<Storage>::value;
+
+template<typename Storage>
+struct is_cow_storage : std::false_type
+{
+};
+
+template<typename Node, typename T, typename NodeHasher>
+struct is_cow_storage<cow_storage<Node, T, NodeHasher>> : std::true_type
+{
+};
+
+template<typename Node, typename T>
+struct is_cow_storage<cow_pooled_storage<Node, T>> : std::true_type
+{
+};
+
+template<typename Storage>
+inline constexpr bool is_cow_storage_v = is_cow_storage<Storage>::value;
+
 } /* namespace mockturtle */
\ No newline at end of file
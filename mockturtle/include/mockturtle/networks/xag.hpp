@@ -44,12 +44,14 @@
 #include <optional>
 #include <stack>
 #include <string>
+#include <utility>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -86,109 +88,165 @@ using xag_storage = storage<regular_node<2, 2, 1>,
                             empty_storage_data,
                             xag_hash<regular_node<2, 2, 1>>>;
 
-class xag_network
-{
-public:
-#pragma region Types and constructors
-  static constexpr auto min_fanin_size = 2u;
-  static constexpr auto max_fanin_size = 2u;
+/*! \brief XAG storage container with structure-of-arrays layout
 
-  using base_type = xag_network;
-  using storage = std::shared_ptr<xag_storage>;
-  using node = uint64_t;
+  Same information as in `xag_storage`, but the fan-ins of all nodes are kept
+  in one contiguous array, and fan-out sizes, application-specific values,
+  and visited flags are kept in three separate arrays.
+*/
+using xag_soa_storage = soa_storage<fanin_node<2, 1>,
+                                    empty_storage_data,
+                                    xag_hash<fanin_node<2, 1>>>;
 
-  struct signal
-  {
-    signal() = default;
+/*! \brief XAG storage container with compact literals
 
-    signal( uint64_t index, uint64_t complement )
-        : complement( complement ), index( index )
-    {
-    }
+  Same as `xag_storage`, but fan-ins are stored as 32-bit literals (31-bit
+  index and complemented attribute).  Can be used for XAGs with less than
+  2^31 nodes.
+*/
+using xag_compact_storage = storage<regular_node<2, 2, 1, uint32_t>,
+                                    empty_storage_data,
+                                    xag_hash<regular_node<2, 2, 1, uint32_t>>>;
 
-    explicit signal( uint64_t data )
-        : data( data )
-    {
-    }
+/*! \brief XAG storage container for concurrent node creation
 
-    signal( xag_storage::node_type::pointer_type const& p )
-        : complement( p.weight ), index( p.index )
-    {
-    }
+  Same layout as `xag_soa_storage`, but gates can be created from several
+  threads at the same time (see `concurrent_storage`).
+*/
+using xag_concurrent_storage = concurrent_storage<fanin_node<2, 1>,
+                                                  empty_storage_data,
+                                                  xag_hash<fanin_node<2, 1>>>;
+
+/*! \brief XAG storage container with copy-on-write snapshots
+
+  Same information as in `xag_storage`, but copies share nodes and hash
+  table entries until they are modified, which makes `fork`, `commit`, and
+  `rollback` cheap (see `cow_storage`).
+*/
+using xag_cow_storage = cow_storage<regular_node<2, 2, 1>,
+                                    empty_storage_data,
+                                    xag_hash<regular_node<2, 2, 1>>>;
+
+/*! \brief Signal in an XAG (shared by all storage layouts) */
+struct xag_signal
+{
+  xag_signal() = default;
+
+  xag_signal( uint64_t index, uint64_t complement )
+      : complement( complement ), index( index )
+  {
+  }
 
-    union
+  explicit xag_signal( uint64_t data )
+      : data( data )
+  {
+  }
+
+  template<typename Word>
+  xag_signal( node_pointer<1, Word> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
+
+  union
+  {
+    struct
     {
-      struct
-      {
-        uint64_t complement : 1;
-        uint64_t index : 63;
-      };
-      uint64_t data;
+      uint64_t complement : 1;
+      uint64_t index : 63;
     };
+    uint64_t data;
+  };
 
-    signal operator!() const
-    {
-      return signal( data ^ 1 );
-    }
+  xag_signal operator!() const
+  {
+    return xag_signal( data ^ 1 );
+  }
 
-    signal operator+() const
-    {
-      return { index, 0 };
-    }
+  xag_signal operator+() const
+  {
+    return { index, 0 };
+  }
 
-    signal operator-() const
-    {
-      return { index, 1 };
-    }
+  xag_signal operator-() const
+  {
+    return { index, 1 };
+  }
 
-    signal operator^( bool complement ) const
-    {
-      return signal( data ^ ( complement ? 1 : 0 ) );
-    }
+  xag_signal operator^( bool complement ) const
+  {
+    return xag_signal( data ^ ( complement ? 1 : 0 ) );
+  }
 
-    bool operator==( signal const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( xag_signal const& other ) const
+  {
+    return data == other.data;
+  }
 
-    bool operator!=( signal const& other ) const
-    {
-      return data != other.data;
-    }
+  bool operator!=( xag_signal const& other ) const
+  {
+    return data != other.data;
+  }
 
-    bool operator<( signal const& other ) const
-    {
-      return data < other.data;
-    }
+  bool operator<( xag_signal const& other ) const
+  {
+    return data < other.data;
+  }
 
-    operator xag_storage::node_type::pointer_type() const
-    {
-      return { index, complement };
-    }
+  template<typename Word>
+  operator node_pointer<1, Word>() const
+  {
+    return { index, complement };
+  }
 
 #if __cplusplus > 201703L
-    bool operator==( xag_storage::node_type::pointer_type const& other ) const
-    {
-      return data == other.data;
-    }
+  template<typename Word>
+  bool operator==( node_pointer<1, Word> const& other ) const
+  {
+    return data == other.data;
+  }
 #endif
-  };
+};
+
+/*! \brief XAG logic network
+
+  The template parameter selects the storage layout, which is one of
+  `xag_storage` (the default, see `xag_network`), `xag_soa_storage`,
+  `xag_compact_storage`, `xag_concurrent_storage`, or `xag_cow_storage`.
+
+  The second template parameter is a static listener for network events
+  (see `network_events`), which is called without indirection.  The
+  default `no_listener` does not add any cost.
+*/
+template<typename Storage = xag_storage, typename Listener = no_listener>
+class basic_xag_network
+{
+public:
+#pragma region Types and constructors
+  static constexpr auto min_fanin_size = 2u;
+  static constexpr auto max_fanin_size = 2u;
+
+  using base_type = basic_xag_network;
+  using storage = std::shared_ptr<Storage>;
+  using node = uint64_t;
+  using signal = xag_signal;
 
-  xag_network()
-      : _storage( std::make_shared<xag_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+
+  basic_xag_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<network_events<base_type, Listener>>() )
   {
   }
 
-  xag_network( std::shared_ptr<xag_storage> storage )
+  basic_xag_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<network_events<base_type, Listener>>() )
   {
   }
 
-  xag_network clone() const
+  basic_xag_network clone() const
   {
-    return { std::make_shared<xag_storage>( *_storage ) };
+    return { std::make_shared<Storage>( *_storage ) };
   }
 #pragma endregion
 
@@ -201,8 +259,15 @@ public:
   signal create_pi()
   {
     const auto index = _storage->nodes.size();
+    assert( index <= Storage::node_type::pointer_type::max_index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      _storage->fanout.emplace_back( 0u );
+      _storage->values.emplace_back( 0u );
+      _storage->visited.emplace_back( 0u );
+    }
     _storage->inputs.emplace_back( index );
     return { index, 0 };
   }
@@ -210,7 +275,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    incr_fanout_size( f.index );
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
     return po_index;
@@ -228,12 +293,12 @@ public:
 
   bool is_ci( node const& n ) const
   {
-    return _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data;
+    return std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data;
   }
 
   bool is_pi( node const& n ) const
   {
-    return _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data && !is_constant( n );
+    return std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data && !is_constant( n );
   }
 
   bool constant_value( node const& n ) const
@@ -258,11 +323,43 @@ public:
 #pragma region Create binary functions
   signal _create_node( signal a, signal b )
   {
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
     /* structural hashing */
+    if constexpr ( is_concurrent_storage_v<Storage> )
+    {
+      /* the lock of the submap serializes the creation of equal nodes */
+      uint64_t index{};
+      const auto inserted = _storage->hash.lazy_emplace_l(
+          node,
+          [&]( auto const& existing ) { index = existing; },
+          [&]( auto const& ctor ) {
+            index = _storage->nodes.append( node );
+            assert( index <= Storage::node_type::pointer_type::max_index );
+            _storage->fanout.emplace_at( index, 0u );
+            _storage->values.emplace_at( index, 0u );
+            _storage->visited.emplace_at( index, 0u );
+            ctor( node, index );
+          } );
+
+      if ( inserted )
+      {
+        /* increase ref-count to children */
+        incr_fanout_size( a.index );
+        incr_fanout_size( b.index );
+
+        _events->notify_add( *this, index );
+      }
+      else
+      {
+        assert( !is_dead( index ) );
+      }
+
+      return { index, 0 };
+    }
+
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
     {
@@ -270,25 +367,35 @@ public:
     }
 
     const auto index = _storage->nodes.size();
+    assert( index <= Storage::node_type::pointer_type::max_index );
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
       _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
       _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+      if constexpr ( is_soa_storage_v<Storage> )
+      {
+        _storage->fanout.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+        _storage->values.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+        _storage->visited.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+      }
     }
 
     _storage->nodes.push_back( node );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      _storage->fanout.emplace_back( 0u );
+      _storage->values.emplace_back( 0u );
+      _storage->visited.emplace_back( 0u );
+    }
 
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    incr_fanout_size( a.index );
+    incr_fanout_size( b.index );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( *this, index );
 
     return { index, 0 };
   }
@@ -416,7 +523,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( xag_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_xag_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( children.size() == 2u );
     if ( other.is_and( source ) )
@@ -433,24 +540,27 @@ public:
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
-    auto& node = _storage->nodes[n];
+    // read the fanins through const access, the node is only written if one of them matches
+    auto const& cnode = std::as_const( *_storage ).nodes[n];
 
     uint32_t fanin = 0u;
-    if ( node.children[0].index == old_node )
+    if ( cnode.children[0].index == old_node )
     {
       fanin = 0u;
-      new_signal.complement ^= node.children[0].weight;
+      new_signal.complement ^= cnode.children[0].weight;
     }
-    else if ( node.children[1].index == old_node )
+    else if ( cnode.children[1].index == old_node )
     {
       fanin = 1u;
-      new_signal.complement ^= node.children[1].weight;
+      new_signal.complement ^= cnode.children[1].weight;
     }
     else
     {
       return std::nullopt;
     }
 
+    auto& node = _storage->nodes[n];
+
     // determine gate type of n
     auto _is_and = node.children[0].index < node.children[1].index;
 
@@ -486,7 +596,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -507,12 +617,9 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    incr_fanout_size( new_signal.index );
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1 } );
-    }
+    _events->notify_modified( *this, n, std::array<signal, 2u>{ old_child0, old_child1 } );
 
     return std::nullopt;
   }
@@ -532,7 +639,7 @@ public:
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
-          _storage->nodes[new_signal.index].data[0].h1++;
+          incr_fanout_size( new_signal.index );
         }
       }
     }
@@ -545,13 +652,17 @@ public:
       return;
 
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
-    _storage->hash.erase( nobj );
-
-    for ( auto const& fn : _events->on_delete )
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      _storage->fanout[n] = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
+    }
+    else
     {
-      ( *fn )( n );
+      nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     }
+    _storage->hash.erase( nobj );
+
+    _events->notify_delete( *this, n );
 
     for ( auto i = 0u; i < 2u; ++i )
     {
@@ -568,7 +679,14 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return ( _storage->fanout[n] >> 31 ) & 1;
+    }
+    else
+    {
+      return ( std::as_const( *_storage ).nodes[n].data[0].h1 >> 31 ) & 1;
+    }
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -612,6 +730,57 @@ public:
       }
     }
   }
+
+  /*! \brief Removes dead nodes in place.
+   *
+   * Renumbers the remaining nodes such that the constant comes first,
+   * followed by the CIs and all live gates in topological order, and
+   * rebuilds the structural hash table.  Node indices kept outside the
+   * network, e.g., in views, become invalid.
+   *
+   * \return Maps each old node index to its new index (dead nodes are
+   *         mapped to `std::numeric_limits<uint64_t>::max()`), can be
+   *         passed to `node_map::remap`
+   *
+   * Not available for concurrent storage (see `concurrent_storage`).
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<!is_concurrent_storage_v<_Storage>>>
+  std::vector<uint64_t> compact()
+  {
+    return detail::compact_storage( *_storage );
+  }
+
+  /*! \brief Takes a snapshot of the network.
+   *
+   * Only available for copy-on-write storage (see `cow_storage`), where the
+   * snapshot shares all nodes with the network.  Snapshots are kept on a
+   * stack and are removed by `commit` or `rollback`.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void fork()
+  {
+    _storage->fork();
+  }
+
+  /*! \brief Keeps all changes since the most recent `fork`. */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void commit()
+  {
+    _storage->commit();
+  }
+
+  /*! \brief Reverts all changes since the most recent `fork`.
+   *
+   * No events are emitted, hence no views that register events may be
+   * attached to the network, and a static listener must be updated by the
+   * caller.
+   */
+  template<typename _Storage = Storage, typename = std::enable_if_t<is_cow_storage_v<_Storage>>>
+  void rollback()
+  {
+    assert( _events->on_add.empty() && _events->on_modified.empty() && _events->on_delete.empty() && "rollback does not emit events" );
+    _storage->rollback();
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -654,22 +823,43 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return _storage->fanout[n] & UINT32_C( 0x7FFFFFFF );
+    }
+    else
+    {
+      return std::as_const( *_storage ).nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    }
   }
 
   uint32_t incr_fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return _storage->fanout[n]++ & UINT32_C( 0x7FFFFFFF );
+    }
+    else
+    {
+      return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    }
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return --_storage->fanout[n] & UINT32_C( 0x7FFFFFFF );
+    }
+    else
+    {
+      return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    }
   }
 
   bool is_and( node const& n ) const
   {
-    return n > 0 && !is_ci( n ) && ( _storage->nodes[n].children[0].index < _storage->nodes[n].children[1].index );
+    return n > 0 && !is_ci( n ) && ( std::as_const( *_storage ).nodes[n].children[0].index < std::as_const( *_storage ).nodes[n].children[1].index );
   }
 
   bool is_or( node const& n ) const
@@ -680,7 +870,7 @@ public:
 
   bool is_xor( node const& n ) const
   {
-    return n > 0 && !is_ci( n ) && ( _storage->nodes[n].children[0].index > _storage->nodes[n].children[1].index );
+    return n > 0 && !is_ci( n ) && ( std::as_const( *_storage ).nodes[n].children[0].index > std::as_const( *_storage ).nodes[n].children[1].index );
   }
 
   bool is_maj( node const& n ) const
@@ -724,7 +914,7 @@ public:
   kitty::dynamic_truth_table node_function( const node& n ) const
   {
     kitty::dynamic_truth_table _func( 2 );
-    if ( _storage->nodes[n].children[0u].index < _storage->nodes[n].children[1u].index )
+    if ( std::as_const( *_storage ).nodes[n].children[0u].index < std::as_const( *_storage ).nodes[n].children[1u].index )
     {
       _func._bits[0] = 0x8;
       return _func;
@@ -789,8 +979,8 @@ public:
 
   uint32_t ci_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data );
+    return static_cast<uint32_t>( std::as_const( *_storage ).nodes[n].children[0].data );
   }
 
   uint32_t co_index( signal const& s ) const
@@ -809,8 +999,8 @@ public:
 
   uint32_t pi_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( std::as_const( *_storage ).nodes[n].children[0].data == std::as_const( *_storage ).nodes[n].children[1].data );
+    return static_cast<uint32_t>( std::as_const( *_storage ).nodes[n].children[0].data );
   }
 
   uint32_t po_index( signal const& s ) const
@@ -887,25 +1077,25 @@ public:
     /* we don't use foreach_element here to have better performance */
     if constexpr ( detail::is_callable_without_index_v<Fn, signal, bool> )
     {
-      if ( !fn( signal{ _storage->nodes[n].children[0] } ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[0] } ) )
         return;
-      fn( signal{ _storage->nodes[n].children[1] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] } );
     }
     else if constexpr ( detail::is_callable_with_index_v<Fn, signal, bool> )
     {
-      if ( !fn( signal{ _storage->nodes[n].children[0] }, 0 ) )
+      if ( !fn( signal{ std::as_const( *_storage ).nodes[n].children[0] }, 0 ) )
         return;
-      fn( signal{ _storage->nodes[n].children[1] }, 1 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] }, 1 );
     }
     else if constexpr ( detail::is_callable_without_index_v<Fn, signal, void> )
     {
-      fn( signal{ _storage->nodes[n].children[0] } );
-      fn( signal{ _storage->nodes[n].children[1] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[0] } );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] } );
     }
     else if constexpr ( detail::is_callable_with_index_v<Fn, signal, void> )
     {
-      fn( signal{ _storage->nodes[n].children[0] }, 0 );
-      fn( signal{ _storage->nodes[n].children[1] }, 1 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[0] }, 0 );
+      fn( signal{ std::as_const( *_storage ).nodes[n].children[1] }, 1 );
     }
   }
 #pragma endregion
@@ -919,8 +1109,8 @@ public:
 
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
 
     auto v1 = *begin++;
     auto v2 = *begin++;
@@ -943,8 +1133,8 @@ public:
 
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
 
     auto tt1 = *begin++;
     auto tt2 = *begin++;
@@ -968,8 +1158,8 @@ public:
     (void)end;
     assert( n != 0 && !is_ci( n ) );
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
+    auto const& c1 = std::as_const( *_storage ).nodes[n].children[0];
+    auto const& c2 = std::as_const( *_storage ).nodes[n].children[1];
 
     auto tt1 = *begin++;
     auto tt2 = *begin++;
@@ -995,44 +1185,100 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      std::fill( _storage->values.begin(), _storage->values.end(), 0u );
+    }
+    else
+    {
+      std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    }
   }
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return _storage->values[n];
+    }
+    else
+    {
+      return std::as_const( *_storage ).nodes[n].data[0].h2;
+    }
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      _storage->values[n] = v;
+    }
+    else
+    {
+      _storage->nodes[n].data[0].h2 = v;
+    }
   }
 
   auto incr_value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2++;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return _storage->values[n]++;
+    }
+    else
+    {
+      return _storage->nodes[n].data[0].h2++;
+    }
   }
 
   auto decr_value( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h2;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return --_storage->values[n];
+    }
+    else
+    {
+      return --_storage->nodes[n].data[0].h2;
+    }
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      std::fill( _storage->visited.begin(), _storage->visited.end(), 0u );
+    }
+    else
+    {
+      std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    }
   }
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h1;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      return _storage->visited[n];
+    }
+    else
+    {
+      return std::as_const( *_storage ).nodes[n].data[1].h1;
+    }
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[1].h1 = v;
+    if constexpr ( is_soa_storage_v<Storage> )
+    {
+      _storage->visited[n] = v;
+    }
+    else
+    {
+      _storage->nodes[n].data[1].h1 = v;
+    }
   }
 
   uint32_t trav_id() const
@@ -1054,8 +1300,15 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<xag_storage> _storage;
-  std::shared_ptr<network_events<base_type>> _events;
+  std::shared_ptr<Storage> _storage;
+  std::shared_ptr<network_events<base_type, Listener>> _events;
+};
+
+using xag_network = basic_xag_network<xag_storage>;
+
+template<class Storage, class Listener>
+struct is_xag_network_type<basic_xag_network<Storage, Listener>> : std::true_type
+{
 };
 
 } // namespace mockturtle
@@ -1064,9 +1317,9 @@ namespace std
 {
 
 template<>
-struct hash<mockturtle::xag_network::signal>
+struct hash<mockturtle::xag_signal>
 {
-  uint64_t operator()( mockturtle::xag_network::signal const& s ) const noexcept
+  uint64_t operator()( mockturtle::xag_signal const& s ) const noexcept
   {
     uint64_t k = s.data;
     k ^= k >> 33;
@@ -85,6 +85,42 @@ struct is_buffered_network_type : std::false_type
 template<class Ntk>
 inline constexpr bool is_buffered_network_type_v = is_buffered_network_type<Ntk>::value;
 
+/*! \brief Checks whether `Ntk` is an AIG (with any storage) */
+template<class Ntk>
+struct is_aig_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_aig_network_type_v = is_aig_network_type<Ntk>::value;
+
+/*! \brief Checks whether `Ntk` is an XAG (with any storage) */
+template<class Ntk>
+struct is_xag_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_xag_network_type_v = is_xag_network_type<Ntk>::value;
+
+/*! \brief Checks whether `Ntk` is an MIG (with any storage) */
+template<class Ntk>
+struct is_mig_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_mig_network_type_v = is_mig_network_type<Ntk>::value;
+
+/*! \brief Checks whether `Ntk` is an XMG (with any storage) */
+template<class Ntk>
+struct is_xmg_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_xmg_network_type_v = is_xmg_network_type<Ntk>::value;
+
 #pragma region has_clone
 template<class Ntk, class = void>
 struct has_clone : std::false_type
@@ -685,6 +721,66 @@ template<class Ntk>
 inline constexpr bool has_is_dead_v = has_is_dead<Ntk>::value;
 #pragma endregion
 
+#pragma region has_compact
+template<class Ntk, class = void>
+struct has_compact : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_compact<Ntk, std::void_t<decltype( std::declval<Ntk>().compact() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_compact_v = has_compact<Ntk>::value;
+#pragma endregion
+
+#pragma region has_fork
+template<class Ntk, class = void>
+struct has_fork : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_fork<Ntk, std::void_t<decltype( std::declval<Ntk>().fork() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_fork_v = has_fork<Ntk>::value;
+#pragma endregion
+
+#pragma region has_commit
+template<class Ntk, class = void>
+struct has_commit : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_commit<Ntk, std::void_t<decltype( std::declval<Ntk>().commit() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_commit_v = has_commit<Ntk>::value;
+#pragma endregion
+
+#pragma region has_rollback
+template<class Ntk, class = void>
+struct has_rollback : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_rollback<Ntk, std::void_t<decltype( std::declval<Ntk>().rollback() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_rollback_v = has_rollback<Ntk>::value;
+#pragma endregion
+
 #pragma region has_size
 template<class Ntk, class = void>
 struct has_size : std::false_type
@@ -2170,6 +2266,21 @@ template<class Ntk>
 inline constexpr bool has_eval_fanins_color_v = has_eval_fanins_color<Ntk>::value;
 #pragma endregion
 
+#pragma region has_foreach_choice
+template<class Ntk, class = void>
+struct has_foreach_choice : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_foreach_choice<Ntk, std::void_t<decltype( std::declval<Ntk>().foreach_choice( std::declval<node<Ntk>>(), std::declval<void( node<Ntk> )>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_foreach_choice_v = has_foreach_choice<Ntk>::value;
+#pragma endregion
+
 /*! \brief SFINAE based on iterator type (for compute functions).
  */
 template<typename Iterator, typename T>
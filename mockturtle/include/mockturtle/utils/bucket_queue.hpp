@@ -0,0 +1,130 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file bucket_queue.hpp
+  \brief Priority queue with small integer keys
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Priority queue with small integer keys.
+ *
+ * Elements are kept in one bucket per key, such that `push`, `pop_min`,
+ * and `pop_max` run in amortized constant time when keys are levels in a
+ * network.  Elements with the same key are returned in reverse order of
+ * insertion.  A queue should be consumed either by `pop_min` or by
+ * `pop_max`, but elements may be pushed in between.
+ */
+template<typename T>
+class bucket_queue
+{
+public:
+  /*! \brief Adds `value` with priority `key`. */
+  void push( uint32_t key, T const& value )
+  {
+    if ( key >= buckets.size() )
+    {
+      buckets.resize( key + 1u );
+    }
+    buckets[key].push_back( value );
+
+    if ( num_elements++ == 0u )
+    {
+      min_key = max_key = key;
+    }
+    else
+    {
+      min_key = std::min( min_key, key );
+      max_key = std::max( max_key, key );
+    }
+  }
+
+  /*! \brief Removes and returns an element with the smallest key. */
+  T pop_min()
+  {
+    assert( !empty() );
+    while ( buckets[min_key].empty() )
+    {
+      ++min_key;
+    }
+    return pop( min_key );
+  }
+
+  /*! \brief Removes and returns an element with the largest key. */
+  T pop_max()
+  {
+    assert( !empty() );
+    while ( buckets[max_key].empty() )
+    {
+      --max_key;
+    }
+    return pop( max_key );
+  }
+
+  bool empty() const
+  {
+    return num_elements == 0u;
+  }
+
+  uint64_t size() const
+  {
+    return num_elements;
+  }
+
+  void clear()
+  {
+    for ( auto& bucket : buckets )
+    {
+      bucket.clear();
+    }
+    num_elements = 0u;
+  }
+
+private:
+  T pop( uint32_t key )
+  {
+    const auto value = buckets[key].back();
+    buckets[key].pop_back();
+    --num_elements;
+    return value;
+  }
+
+private:
+  std::vector<std::vector<T>> buckets;
+  uint64_t num_elements{ 0u };
+  uint32_t min_key{ 0u };
+  uint32_t max_key{ 0u };
+};
+
+} /* namespace mockturtle */
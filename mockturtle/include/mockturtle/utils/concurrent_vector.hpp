@@ -0,0 +1,386 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file concurrent_vector.hpp
+  \brief Vector with concurrent growth
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Vector with concurrent growth.
+ *
+ * Elements are stored in segments of increasing size (the first segment has
+ * 1024 elements, each following segment has twice the size of the previous
+ * one).  Segments are never reallocated, hence references to elements stay
+ * valid while the vector grows, and several threads can append elements at
+ * the same time.  Access by index is safe for all elements whose insertion
+ * happened before the access (e.g., because the index was communicated
+ * through a synchronized data structure).
+ *
+ * All other operations (copy, `clear`, iteration) must not run concurrently
+ * with insertions.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      concurrent_vector<uint32_t> v;
+
+      auto i = v.append( 42u ); // i is 0, can be called from several threads
+      v.emplace_at( 5u, 7u );   // constructs element at index 5, size is 6
+   \endverbatim
+ */
+template<typename T>
+class concurrent_vector
+{
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = T const&;
+  using size_type = uint64_t;
+
+private:
+  static constexpr uint32_t first_segment_bits = 10u;
+  static constexpr uint32_t num_segments = 64u - first_segment_bits;
+
+  template<typename Vector, typename Reference>
+  class basic_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::remove_reference_t<Reference>*;
+    using reference = Reference;
+
+    basic_iterator( Vector* vec, uint64_t index )
+        : vec( vec ), index( index )
+    {
+    }
+
+    reference operator*() const
+    {
+      return ( *vec )[index];
+    }
+
+    pointer operator->() const
+    {
+      return &( *vec )[index];
+    }
+
+    basic_iterator& operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    basic_iterator operator++( int )
+    {
+      auto copy = *this;
+      ++index;
+      return copy;
+    }
+
+    bool operator==( basic_iterator const& other ) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=( basic_iterator const& other ) const
+    {
+      return index != other.index;
+    }
+
+  private:
+    Vector* vec;
+    uint64_t index;
+  };
+
+public:
+  using iterator = basic_iterator<concurrent_vector, T&>;
+  using const_iterator = basic_iterator<concurrent_vector const, T const&>;
+
+  concurrent_vector()
+  {
+    for ( auto& s : segments )
+    {
+      s.store( nullptr, std::memory_order_relaxed );
+    }
+  }
+
+  concurrent_vector( concurrent_vector const& other )
+      : concurrent_vector()
+  {
+    *this = other;
+  }
+
+  concurrent_vector( concurrent_vector&& other ) noexcept
+      : concurrent_vector()
+  {
+    *this = std::move( other );
+  }
+
+  ~concurrent_vector()
+  {
+    clear();
+    for ( auto i = 0u; i < num_segments; ++i )
+    {
+      ::operator delete( segments[i].load( std::memory_order_relaxed ) );
+    }
+  }
+
+  concurrent_vector& operator=( concurrent_vector const& other )
+  {
+    if ( this != &other )
+    {
+      clear();
+      for ( auto i = 0u; i < other.size(); ++i )
+      {
+        if constexpr ( std::is_copy_constructible_v<T> )
+        {
+          emplace_at( i, other[i] );
+        }
+        else
+        {
+          /* for atomic elements */
+          emplace_at( i, other[i].load() );
+        }
+      }
+    }
+    return *this;
+  }
+
+  concurrent_vector& operator=( concurrent_vector&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      clear();
+      for ( auto i = 0u; i < num_segments; ++i )
+      {
+        ::operator delete( segments[i].exchange( other.segments[i].exchange( nullptr ) ) );
+      }
+      _size.store( other._size.exchange( 0u ) );
+    }
+    return *this;
+  }
+
+  /*! \brief Number of elements. */
+  size_type size() const
+  {
+    return _size.load( std::memory_order_acquire );
+  }
+
+  /*! \brief Checks whether the vector is empty. */
+  bool empty() const
+  {
+    return size() == 0u;
+  }
+
+  /*! \brief Number of elements that fit into the allocated segments. */
+  size_type capacity() const
+  {
+    size_type cap{ 0 };
+    for ( auto i = 0u; i < num_segments && segments[i].load( std::memory_order_acquire ) != nullptr; ++i )
+    {
+      cap += segment_size( i );
+    }
+    return cap;
+  }
+
+  /*! \brief Allocates segments for at least `n` elements. */
+  void reserve( size_type n )
+  {
+    if ( n > 0u )
+    {
+      const auto last = segment_of( n - 1 ).first;
+      for ( auto i = 0u; i <= last; ++i )
+      {
+        allocate_segment( i );
+      }
+    }
+  }
+
+  /*! \brief Access element by index. */
+  reference operator[]( size_type index )
+  {
+    const auto [s, offset] = segment_of( index );
+    return segments[s].load( std::memory_order_acquire )[offset];
+  }
+
+  /*! \brief Access element by index. */
+  const_reference operator[]( size_type index ) const
+  {
+    const auto [s, offset] = segment_of( index );
+    return segments[s].load( std::memory_order_acquire )[offset];
+  }
+
+  /*! \brief Appends an element and returns its index.
+   *
+   * Can be called concurrently from several threads.
+   */
+  template<typename... Args>
+  size_type append( Args&&... args )
+  {
+    const auto index = _size.fetch_add( 1u, std::memory_order_acq_rel );
+    construct( index, std::forward<Args>( args )... );
+    return index;
+  }
+
+  /*! \brief Constructs an element at a given index.
+   *
+   * The size becomes at least `index + 1`.  Can be called concurrently from
+   * several threads for different indexes.  Elements between the previous
+   * size and `index` must be constructed separately.
+   */
+  template<typename... Args>
+  reference emplace_at( size_type index, Args&&... args )
+  {
+    auto& element = construct( index, std::forward<Args>( args )... );
+    auto current = _size.load( std::memory_order_relaxed );
+    while ( current <= index && !_size.compare_exchange_weak( current, index + 1, std::memory_order_acq_rel ) )
+    {
+    }
+    return element;
+  }
+
+  /*! \brief Appends an element and returns a reference to it. */
+  template<typename... Args>
+  reference emplace_back( Args&&... args )
+  {
+    return ( *this )[append( std::forward<Args>( args )... )];
+  }
+
+  /*! \brief Appends an element. */
+  void push_back( T const& value )
+  {
+    append( value );
+  }
+
+  /*! \brief Removes all elements but keeps the allocated segments. */
+  void clear()
+  {
+    if constexpr ( !std::is_trivially_destructible_v<T> )
+    {
+      for ( auto i = 0u; i < size(); ++i )
+      {
+        ( *this )[i].~T();
+      }
+    }
+    _size.store( 0u );
+  }
+
+  iterator begin()
+  {
+    return { this, 0u };
+  }
+
+  iterator end()
+  {
+    return { this, size() };
+  }
+
+  const_iterator begin() const
+  {
+    return { this, 0u };
+  }
+
+  const_iterator end() const
+  {
+    return { this, size() };
+  }
+
+private:
+  static constexpr size_type segment_size( uint32_t s )
+  {
+    return size_type( 1u ) << ( first_segment_bits + s );
+  }
+
+  static std::pair<uint32_t, size_type> segment_of( size_type index )
+  {
+    /* segment s starts at index 2^(first_segment_bits + s) - 2^first_segment_bits */
+    const auto shifted = index + ( size_type( 1u ) << first_segment_bits );
+#if defined( _MSC_VER )
+    unsigned long msb;
+    _BitScanReverse64( &msb, shifted );
+#else
+    const auto msb = 63u - static_cast<uint32_t>( __builtin_clzll( shifted ) );
+#endif
+    const auto s = static_cast<uint32_t>( msb ) - first_segment_bits;
+    return { s, shifted - segment_size( s ) };
+  }
+
+  T* allocate_segment( uint32_t s )
+  {
+    assert( s < num_segments );
+    auto* segment = segments[s].load( std::memory_order_acquire );
+    if ( segment != nullptr )
+    {
+      return segment;
+    }
+
+    auto* fresh = static_cast<T*>( ::operator new( segment_size( s ) * sizeof( T ) ) );
+    if ( segments[s].compare_exchange_strong( segment, fresh, std::memory_order_acq_rel ) )
+    {
+      return fresh;
+    }
+
+    /* another thread was faster */
+    ::operator delete( fresh );
+    return segment;
+  }
+
+  template<typename... Args>
+  reference construct( size_type index, Args&&... args )
+  {
+    const auto [s, offset] = segment_of( index );
+    auto* segment = allocate_segment( s );
+    return *new ( segment + offset ) T( std::forward<Args>( args )... );
+  }
+
+private:
+  std::array<std::atomic<T*>, num_segments> segments;
+  std::atomic<size_type> _size{ 0u };
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,644 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cow_containers.hpp
+  \brief Copy-on-write containers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
+namespace mockturtle
+{
+
+/*! \brief Vector with copy-on-write pages.
+ *
+ * Elements are stored in pages of `2^PageBits` elements, which are shared
+ * between copies of the vector.  Copying the vector only copies the page
+ * table, and a page is copied the first time it is accessed through a
+ * non-const reference in one of the copies.  Hence, the cost of a copy is
+ * proportional to the number of pages that are accessed afterwards.
+ *
+ * Each entry of the page table keeps a pointer to the elements that is only
+ * set while the page is owned by the vector, such that non-const accesses
+ * to owned pages do not need to check the reference count of the page.
+ * Copies reset these pointers in both vectors.
+ *
+ * The container is not thread-safe.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      cow_vector<uint32_t> v;
+      v.push_back( 42u );
+
+      auto w = v;  // shares all pages with v
+      w[0] = 7u;   // copies the first page, v[0] is still 42
+   \endverbatim
+ */
+template<typename T, uint32_t PageBits = 12u>
+class cow_vector
+{
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = T const&;
+  using size_type = uint64_t;
+
+  static constexpr size_type page_size = size_type( 1u ) << PageBits;
+
+private:
+  static constexpr size_type page_mask = page_size - 1u;
+
+  struct page
+  {
+    T* owned;
+    std::shared_ptr<T[]> elements;
+  };
+
+  template<typename Vector, typename Reference>
+  class basic_iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::remove_reference_t<Reference>*;
+    using reference = Reference;
+
+    basic_iterator( Vector* vec, uint64_t index )
+        : vec( vec ), index( index )
+    {
+    }
+
+    reference operator*() const
+    {
+      return ( *vec )[index];
+    }
+
+    pointer operator->() const
+    {
+      return &( *vec )[index];
+    }
+
+    reference operator[]( difference_type n ) const
+    {
+      return ( *vec )[index + n];
+    }
+
+    basic_iterator& operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    basic_iterator operator++( int )
+    {
+      auto copy = *this;
+      ++index;
+      return copy;
+    }
+
+    basic_iterator& operator--()
+    {
+      --index;
+      return *this;
+    }
+
+    basic_iterator operator--( int )
+    {
+      auto copy = *this;
+      --index;
+      return copy;
+    }
+
+    basic_iterator& operator+=( difference_type n )
+    {
+      index += n;
+      return *this;
+    }
+
+    basic_iterator& operator-=( difference_type n )
+    {
+      index -= n;
+      return *this;
+    }
+
+    basic_iterator operator+( difference_type n ) const
+    {
+      return { vec, index + n };
+    }
+
+    basic_iterator operator-( difference_type n ) const
+    {
+      return { vec, index - n };
+    }
+
+    difference_type operator-( basic_iterator const& other ) const
+    {
+      return static_cast<difference_type>( index - other.index );
+    }
+
+    bool operator==( basic_iterator const& other ) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=( basic_iterator const& other ) const
+    {
+      return index != other.index;
+    }
+
+    bool operator<( basic_iterator const& other ) const
+    {
+      return index < other.index;
+    }
+
+    bool operator>( basic_iterator const& other ) const
+    {
+      return index > other.index;
+    }
+
+    bool operator<=( basic_iterator const& other ) const
+    {
+      return index <= other.index;
+    }
+
+    bool operator>=( basic_iterator const& other ) const
+    {
+      return index >= other.index;
+    }
+
+  private:
+    Vector* vec;
+    uint64_t index;
+  };
+
+public:
+  using iterator = basic_iterator<cow_vector, T&>;
+  using const_iterator = basic_iterator<cow_vector const, T const&>;
+
+  cow_vector() = default;
+
+  cow_vector( cow_vector const& other )
+      : _pages( other.share() ),
+        _size( other._size ),
+        _capacity( other._capacity )
+  {
+  }
+
+  cow_vector( cow_vector&& other ) noexcept
+      : _pages( std::move( other._pages ) ),
+        _size( std::exchange( other._size, 0u ) ),
+        _capacity( std::exchange( other._capacity, 0u ) )
+  {
+    other._pages.clear();
+  }
+
+  cow_vector& operator=( cow_vector const& other )
+  {
+    if ( this != &other )
+    {
+      _pages = other.share();
+      _size = other._size;
+      _capacity = other._capacity;
+    }
+    return *this;
+  }
+
+  cow_vector& operator=( cow_vector&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      _pages = std::move( other._pages );
+      other._pages.clear();
+      _size = std::exchange( other._size, 0u );
+      _capacity = std::exchange( other._capacity, 0u );
+    }
+    return *this;
+  }
+
+  /*! \brief Number of elements. */
+  size_type size() const
+  {
+    return _size;
+  }
+
+  /*! \brief Checks whether the vector is empty. */
+  bool empty() const
+  {
+    return _size == 0u;
+  }
+
+  /*! \brief Number of elements for which space has been reserved. */
+  size_type capacity() const
+  {
+    return std::max<size_type>( _capacity, _pages.size() * page_size );
+  }
+
+  /*! \brief Reserves space in the page table for `n` elements.
+   *
+   * Pages are only allocated when elements are inserted.
+   */
+  void reserve( size_type n )
+  {
+    _pages.reserve( ( n + page_mask ) >> PageBits );
+    _capacity = std::max( _capacity, n );
+  }
+
+  /*! \brief Access element by index, copies its page if shared. */
+  reference operator[]( size_type index )
+  {
+    assert( index < _size );
+    auto& p = _pages[index >> PageBits];
+    auto* elements = p.owned != nullptr ? p.owned : own( p );
+    return elements[index & page_mask];
+  }
+
+  /*! \brief Access element by index. */
+  const_reference operator[]( size_type index ) const
+  {
+    assert( index < _size );
+    return _pages[index >> PageBits].elements[index & page_mask];
+  }
+
+  /*! \brief Access the last element, copies its page if shared. */
+  reference back()
+  {
+    return ( *this )[_size - 1u];
+  }
+
+  /*! \brief Access the last element. */
+  const_reference back() const
+  {
+    return ( *this )[_size - 1u];
+  }
+
+  /*! \brief Appends an element and returns a reference to it. */
+  template<typename... Args>
+  reference emplace_back( Args&&... args )
+  {
+    if ( ( _size >> PageBits ) == _pages.size() )
+    {
+      std::shared_ptr<T[]> elements( new T[page_size]() );
+      _pages.push_back( { elements.get(), std::move( elements ) } );
+    }
+    auto& element = ( *this )[_size++];
+    element = T( std::forward<Args>( args )... );
+    return element;
+  }
+
+  /*! \brief Appends an element. */
+  void push_back( T const& value )
+  {
+    emplace_back( value );
+  }
+
+  /*! \brief Removes all elements and releases all pages. */
+  void clear()
+  {
+    _pages.clear();
+    _size = 0u;
+  }
+
+  /*! \brief Replaces the elements by `count` elements in external memory.
+   *
+   * The elements are not copied.  Each page refers to `page_size`
+   * consecutive elements starting at `data` and keeps `owner` alive, hence
+   * `data` must provide space for `count` elements rounded up to whole
+   * pages.  The adopted pages are not owned by the vector, and since all
+   * of them share the ownership of `owner`, the first non-const access to
+   * a page copies it as long as another reference to `owner` exists.  Only
+   * a page that holds the last reference is modified in place, hence the
+   * memory must still be writable, e.g., a private memory mapping of a
+   * file.
+   */
+  void adopt( std::shared_ptr<void> const& owner, T* data, size_type count )
+  {
+    _pages.clear();
+    _pages.reserve( ( count + page_mask ) >> PageBits );
+    for ( size_type i = 0u; i < count; i += page_size )
+    {
+      _pages.push_back( { nullptr, std::shared_ptr<T[]>( owner, data + i ) } );
+    }
+    _size = count;
+  }
+
+  /*! \brief Number of pages that are shared with other vectors. */
+  size_type num_shared_pages() const
+  {
+    return std::count_if( _pages.begin(), _pages.end(), []( auto const& p ) { return p.elements.use_count() > 1; } );
+  }
+
+  iterator begin()
+  {
+    return { this, 0u };
+  }
+
+  iterator end()
+  {
+    return { this, _size };
+  }
+
+  const_iterator begin() const
+  {
+    return { this, 0u };
+  }
+
+  const_iterator end() const
+  {
+    return { this, _size };
+  }
+
+private:
+  std::vector<page> share() const
+  {
+    /* pages are shared now */
+    for ( auto& p : _pages )
+    {
+      p.owned = nullptr;
+    }
+    return _pages;
+  }
+
+  T* own( page& p )
+  {
+    if ( p.elements.use_count() > 1 )
+    {
+      std::shared_ptr<T[]> copy( new T[page_size] );
+      std::copy( p.elements.get(), p.elements.get() + page_size, copy.get() );
+      p.elements = std::move( copy );
+    }
+    return p.owned = p.elements.get();
+  }
+
+private:
+  mutable std::vector<page> _pages;
+  size_type _size{ 0u };
+  size_type _capacity{ 0u };
+};
+
+/*! \brief Hash map with copy-on-write shards.
+ *
+ * Entries are distributed over `2^ShardBits` hash maps (shards), which are
+ * shared between copies of the map in the same way as the pages of
+ * `cow_vector`.  Lookups never copy a shard, modifications copy the shard
+ * of the modified key if it is still shared.
+ *
+ * `find` returns a pointer to the entry, or `end()` (a null pointer) if the
+ * key is not contained.  The container is not thread-safe.
+ *
+ * Filling the map can be deferred with `defer`, then the entries are
+ * inserted the first time the map is accessed.
+ */
+template<typename Key, typename T, typename Hash = phmap::Hash<Key>, uint32_t ShardBits = 8u>
+class cow_hash_map
+{
+public:
+  using map_type = phmap::flat_hash_map<Key, T, Hash>;
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = typename map_type::value_type;
+  using size_type = uint64_t;
+  using const_iterator = value_type const*;
+
+  static constexpr uint32_t num_shards = 1u << ShardBits;
+
+private:
+  struct shard
+  {
+    map_type* owned;
+    std::shared_ptr<map_type> map;
+  };
+
+public:
+  cow_hash_map()
+  {
+    _shards.reserve( num_shards );
+    for ( auto i = 0u; i < num_shards; ++i )
+    {
+      auto map = std::make_shared<map_type>();
+      _shards.push_back( { map.get(), std::move( map ) } );
+    }
+  }
+
+  cow_hash_map( cow_hash_map const& other )
+      : _shards( other.share() ),
+        _size( other._size )
+  {
+  }
+
+  cow_hash_map( cow_hash_map&& other ) noexcept = default;
+
+  cow_hash_map& operator=( cow_hash_map const& other )
+  {
+    if ( this != &other )
+    {
+      _shards = other.share();
+      _size = other._size;
+      _deferred = nullptr;
+    }
+    return *this;
+  }
+
+  cow_hash_map& operator=( cow_hash_map&& other ) noexcept = default;
+
+  /*! \brief Number of entries. */
+  size_type size() const
+  {
+    materialize();
+    return _size;
+  }
+
+  /*! \brief Checks whether the map is empty. */
+  bool empty() const
+  {
+    return size() == 0u;
+  }
+
+  /*! \brief Returns the entry of `key` or `end()`. */
+  const_iterator find( Key const& key ) const
+  {
+    materialize();
+    auto const& map = *_shards[shard_of( key )].map;
+    const auto it = map.find( key );
+    return it == map.end() ? end() : &*it;
+  }
+
+  const_iterator end() const
+  {
+    return nullptr;
+  }
+
+  /*! \brief Access the value of `key`, inserts a default value if missing. */
+  T& operator[]( Key const& key )
+  {
+    materialize();
+    auto& map = writable( shard_of( key ) );
+    const auto before = map.size();
+    auto& value = map[key];
+    _size += map.size() - before;
+    return value;
+  }
+
+  /*! \brief Inserts an entry, if `key` is not contained yet. */
+  bool emplace( Key const& key, T const& value )
+  {
+    materialize();
+    const auto inserted = writable( shard_of( key ) ).emplace( key, value ).second;
+    _size += inserted ? 1u : 0u;
+    return inserted;
+  }
+
+  /*! \brief Removes the entry of `key` and returns the number of removed entries. */
+  size_type erase( Key const& key )
+  {
+    materialize();
+    const auto s = shard_of( key );
+    if ( _shards[s].map->find( key ) == _shards[s].map->end() )
+    {
+      return 0u;
+    }
+    writable( s ).erase( key );
+    --_size;
+    return 1u;
+  }
+
+  /*! \brief Reserves space for `n` entries in all shards that are not shared. */
+  void reserve( size_type n )
+  {
+    materialize();
+    for ( auto& s : _shards )
+    {
+      if ( s.owned != nullptr || s.map.use_count() == 1 )
+      {
+        s.owned = s.map.get();
+        s.owned->reserve( n >> ShardBits );
+      }
+    }
+  }
+
+  /*! \brief Removes all entries. */
+  void clear()
+  {
+    for ( auto& s : _shards )
+    {
+      s.map = std::make_shared<map_type>();
+      s.owned = s.map.get();
+    }
+    _size = 0u;
+    _deferred = nullptr;
+  }
+
+  /*! \brief Defers filling the map until its first access.
+   *
+   * Removes all entries.  `fill` is called with the map the first time it
+   * is accessed (or copied) and is expected to insert the entries.
+   */
+  void defer( std::function<void( cow_hash_map& )> fill )
+  {
+    clear();
+    _deferred = std::move( fill );
+  }
+
+  /*! \brief Checks whether filling the map is still deferred. */
+  bool is_deferred() const
+  {
+    return static_cast<bool>( _deferred );
+  }
+
+  /*! \brief Number of shards that are shared with other maps. */
+  size_type num_shared_shards() const
+  {
+    materialize();
+    return std::count_if( _shards.begin(), _shards.end(), []( auto const& s ) { return s.map.use_count() > 1; } );
+  }
+
+private:
+  static uint32_t shard_of( Key const& key )
+  {
+    /* Fibonacci hashing, the high bits select the shard */
+    return static_cast<uint32_t>( ( static_cast<uint64_t>( Hash{}( key ) ) * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> ( 64u - ShardBits ) );
+  }
+
+  void materialize() const
+  {
+    if ( _deferred )
+    {
+      /* filling the map does not change its logical state */
+      auto fill = std::move( _deferred );
+      _deferred = nullptr;
+      fill( const_cast<cow_hash_map&>( *this ) );
+    }
+  }
+
+  std::vector<shard> share() const
+  {
+    materialize();
+
+    /* shards are shared now */
+    for ( auto& s : _shards )
+    {
+      s.owned = nullptr;
+    }
+    return _shards;
+  }
+
+  map_type& writable( uint32_t index )
+  {
+    auto& s = _shards[index];
+    if ( s.owned == nullptr )
+    {
+      if ( s.map.use_count() > 1 )
+      {
+        s.map = std::make_shared<map_type>( *s.map );
+      }
+      s.owned = s.map.get();
+    }
+    return *s.owned;
+  }
+
+private:
+  mutable std::vector<shard> _shards;
+  size_type _size{ 0u };
+  mutable std::function<void( cow_hash_map& )> _deferred;
+};
+
+} /* namespace mockturtle */
@@ -33,10 +33,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <kitty/detail/mscfix.hpp>
 
@@ -47,13 +56,14 @@ struct empty_cut_data
 {
 };
 
+template<typename T>
+class compact_cut;
+
 /*! \brief A data-structure to hold a cut.
  *
  * The cut class is specialized via two template arguments, `MaxLeaves` and `T`.
- * `MaxLeaves` controls the maximum number of leaves a cut can hold.  To
- * guarantee an efficient implementation, this value should be \f$k \cdot l\f$,
- * where \f$k\f$ is the maximum cut size and \f$l\f$ is the maximum fanin size
- * of a gate in the logic network.  The second template argument `T` can be a
+ * `MaxLeaves` controls the maximum number of leaves a cut can hold, which must
+ * be at least the maximum cut size used in `merge`.  The second template argument `T` can be a
  * type for which a data entry is created in the cut to store additional data,
  * e.g., to compute the cost of a cut.  It defaults to `empty_cut_data`, which
  * is an empty struct that does not consume memory.
@@ -95,12 +105,22 @@ public:
    */
   cut( cut const& other )
   {
-    _cend = _end = std::copy( other.begin(), other.end(), _leaves.begin() );
+    std::copy( other.begin(), other.end(), _leaves.begin() );
     _length = other._length;
     _signature = other._signature;
     _data = other._data;
   }
 
+  /*! \brief Copies leaves and data of a compact cut.
+   *
+   * \param other Compact cut
+   */
+  explicit cut( compact_cut<T> const& other )
+  {
+    set_leaves( other.begin(), other.end() );
+    _data = other.data();
+  }
+
   /*! \brief Assignment operator.
    *
    * Copies leaves, length, signature, and data.
@@ -135,13 +155,20 @@ public:
   auto begin() const { return _leaves.begin(); }
 
   /*! \brief End iterator (constant). */
-  auto end() const { return _cend; }
+  auto end() const { return _leaves.begin() + _length; }
+
+  /*! \brief Calls `fn( begin(), end() )` as `compact_cut::visit_leaves`. */
+  template<typename Fn>
+  decltype( auto ) visit_leaves( Fn&& fn ) const
+  {
+    return fn( begin(), end() );
+  }
 
   /*! \brief Begin iterator (mutable). */
   auto begin() { return _leaves.begin(); }
 
   /*! \brief End iterator (mutable). */
-  auto end() { return _end; }
+  auto end() { return _leaves.begin() + _length; }
 
   /*! \brief Access to data (mutable). */
   T* operator->() { return &_data; }
@@ -159,11 +186,12 @@ public:
    *
    * If \f$L_1\f$ are the leaves of the current cut and \f$L_2\f$ are the leaves
    * of `that`, then this method returns true if and only if
-   * \f$L_1 \subseteq L_2\f$.
+   * \f$L_1 \subseteq L_2\f$.  The other cut can also be a `compact_cut`.
    *
    * \param that Other cut
    */
-  bool dominates( cut const& that ) const;
+  template<typename Cut>
+  bool dominates( Cut const& that ) const;
 
   /*! \brief Merges two cuts.
    *
@@ -171,21 +199,46 @@ public:
    * two cuts is the union \f$L_1 \cup L_2\f$ of the two leaf sets \f$L_1\f$ of
    * the cut and \f$L_2\f$ of `that`.  The merge is only successful if the
    * union has not more than `cut_size` elements.  In that case, the function
-   * returns `false`, otherwise `true`.
+   * returns `false`, otherwise `true`.  The result `res` must not be one of
+   * the merged cuts.  The other cut can also be a `compact_cut`.
    *
    * \param that Other cut
    * \param res Resulting cut
    * \param cut_size Maximum cut size
    * \return True, if resulting cut is small enough
    */
-  bool merge( cut const& that, cut& res, uint32_t cut_size ) const;
+  template<typename Cut>
+  bool merge( Cut const& that, cut& res, uint32_t cut_size ) const;
+
+  /*! \brief Sets the leaves to the union of the leaves of two cuts.
+   *
+   * This is the same as `c1.merge( c2, *this, cut_size )`, but both cuts can
+   * be of any cut type, e.g., `compact_cut`, and their signatures are passed,
+   * such that they are not recomputed for each merge.  The data of the cut
+   * is not changed.  The cut must not be one of the merged cuts.
+   *
+   * \param c1 First cut
+   * \param signature1 Signature of the first cut
+   * \param c2 Second cut
+   * \param signature2 Signature of the second cut
+   * \param cut_size Maximum cut size
+   * \return True, if resulting cut is small enough
+   */
+  template<typename Cut1, typename Cut2>
+  bool set_union( Cut1 const& c1, uint64_t signature1, Cut2 const& c2, uint64_t signature2, uint32_t cut_size );
+
+private:
+  /* writes the union of two sorted leaf ranges into the leaves and returns
+     its size, or a size larger than `cut_size` if the union is too large */
+  template<typename Iterator1, typename Iterator2>
+  uint32_t merge_leaves( Iterator1 it1, Iterator1 end1, Iterator2 it2, Iterator2 end2, uint32_t cut_size );
 
 private:
+  /* the end of the leaves is derived from the length, such that a cut does
+     not store iterators into itself */
+  uint64_t _signature;
   std::array<uint32_t, MaxLeaves> _leaves;
   uint32_t _length;
-  uint64_t _signature;
-  typename std::array<uint32_t, MaxLeaves>::const_iterator _cend;
-  typename std::array<uint32_t, MaxLeaves>::iterator _end;
 
   T _data;
 };
@@ -220,7 +273,7 @@ cut<MaxLeaves, T>& cut<MaxLeaves, T>::operator=( cut<MaxLeaves, T> const& other
 {
   if ( &other != this )
   {
-    _cend = _end = std::copy( other.begin(), other.end(), _leaves.begin() );
+    std::copy( other.begin(), other.end(), _leaves.begin() );
     _length = other._length;
     _signature = other._signature;
     _data = other._data;
@@ -232,7 +285,7 @@ template<int MaxLeaves, typename T>
 template<typename Iterator>
 void cut<MaxLeaves, T>::set_leaves( Iterator begin, Iterator end )
 {
-  _cend = _end = std::copy( begin, end, _leaves.begin() );
+  std::copy( begin, end, _leaves.begin() );
   _length = static_cast<uint32_t>( std::distance( begin, end ) );
   _signature = 0;
 
@@ -250,15 +303,16 @@ void cut<MaxLeaves, T>::set_leaves( Container const& c )
 }
 
 template<int MaxLeaves, typename T>
-bool cut<MaxLeaves, T>::dominates( cut const& that ) const
+template<typename Cut>
+bool cut<MaxLeaves, T>::dominates( Cut const& that ) const
 {
   /* quick check for counter example */
-  if ( _length > that._length || ( _signature & that._signature ) != _signature )
+  if ( _length > that.size() || ( _signature & that.signature() ) != _signature )
   {
     return false;
   }
 
-  if ( _length == that._length )
+  if ( _length == that.size() )
   {
     return std::equal( begin(), end(), that.begin() );
   }
@@ -288,26 +342,79 @@ bool cut<MaxLeaves, T>::dominates( cut const& that ) const
 }
 
 template<int MaxLeaves, typename T>
-bool cut<MaxLeaves, T>::merge( cut const& that, cut& res, uint32_t cut_size ) const
+template<typename Cut>
+bool cut<MaxLeaves, T>::merge( Cut const& that, cut& res, uint32_t cut_size ) const
+{
+  return res.set_union( *this, _signature, that, that.signature(), cut_size );
+}
+
+template<int MaxLeaves, typename T>
+template<typename Cut1, typename Cut2>
+bool cut<MaxLeaves, T>::set_union( Cut1 const& c1, uint64_t signature1, Cut2 const& c2, uint64_t signature2, uint32_t cut_size )
 {
-  if ( _length + that._length > cut_size )
+  if ( c1.size() + c2.size() > cut_size )
   {
-    const auto sign = _signature + that._signature;
+    const auto sign = signature1 + signature2;
     if ( uint32_t( __builtin_popcount( static_cast<uint32_t>( sign & 0xffffffff ) ) ) + uint32_t( __builtin_popcount( static_cast<uint32_t>( sign >> 32 ) ) ) > cut_size )
     {
       return false;
     }
   }
 
-  auto it = std::set_union( begin(), end(), that.begin(), that.end(), res.begin() );
-  if ( auto length = std::distance( res.begin(), it ); length <= cut_size )
+  assert( cut_size <= MaxLeaves );
+
+  /* union of the sorted leaves, which stops as soon as it exceeds the cut size */
+  const auto length = c1.visit_leaves( [&]( auto begin1, auto end1 ) {
+    return c2.visit_leaves( [&]( auto begin2, auto end2 ) {
+      return merge_leaves( begin1, end1, begin2, end2, cut_size );
+    } );
+  } );
+  if ( length > cut_size )
   {
-    res._cend = res._end = it;
-    res._length = static_cast<uint32_t>( length );
-    res._signature = _signature | that._signature;
-    return true;
+    return false;
   }
-  return false;
+
+  _length = length;
+  _signature = signature1 | signature2;
+  return true;
+}
+
+template<int MaxLeaves, typename T>
+template<typename Iterator1, typename Iterator2>
+uint32_t cut<MaxLeaves, T>::merge_leaves( Iterator1 it1, Iterator1 end1, Iterator2 it2, Iterator2 end2, uint32_t cut_size )
+{
+  auto it = _leaves.begin();
+  uint32_t length{ 0 };
+  while ( it1 != end1 && it2 != end2 )
+  {
+    if ( length++ == cut_size )
+    {
+      return cut_size + 1u;
+    }
+
+    if ( *it1 < *it2 )
+    {
+      *it++ = *it1++;
+    }
+    else if ( *it2 < *it1 )
+    {
+      *it++ = *it2++;
+    }
+    else
+    {
+      *it++ = *it1++;
+      ++it2;
+    }
+  }
+
+  const auto remaining = static_cast<uint32_t>( std::distance( it1, end1 ) + std::distance( it2, end2 ) );
+  if ( length + remaining > cut_size )
+  {
+    return cut_size + 1u;
+  }
+  it = std::copy( it1, end1, it );
+  std::copy( it2, end2, it );
+  return length + remaining;
 }
 
 /*! \brief A data-structure to hold a set of cuts.
@@ -319,6 +426,8 @@ bool cut<MaxLeaves, T>::merge( cut const& that, cut& res, uint32_t cut_size ) co
  * The cut set is defined using the `CutType` of cuts it should hold and a
  * maximum number of cuts it can hold.  No check is performed whether a cut set
  * is full, and therefore the caller must not insert cuts into a full set.
+ * Memory for the cuts is allocated when they are added, and `shrink_to_fit`
+ * releases the memory of cuts that were removed.
  *
    \verbatim embed:rst
 
@@ -354,9 +463,30 @@ template<typename CutType, int MaxCuts>
 class cut_set
 {
 public:
+  /*! \brief Type of the cuts in the set. */
+  using cut_t = CutType;
+
   /*! \brief Standard constructor.
    */
-  cut_set();
+  cut_set() = default;
+
+  /*! \brief Copy constructor.
+   *
+   * Allocates only the cuts in the set.
+   */
+  cut_set( cut_set const& other );
+
+  /*! \brief Move constructor. */
+  cut_set( cut_set&& other ) noexcept;
+
+  /*! \brief Assignment operator.
+   *
+   * Allocates only the cuts in the set.
+   */
+  cut_set& operator=( cut_set const& other );
+
+  /*! \brief Move assignment operator. */
+  cut_set& operator=( cut_set&& other ) noexcept;
 
   /*! \brief Clears a cut set.
    */
@@ -377,9 +507,10 @@ public:
 
   /*! \brief Checks whether cut is dominates by any cut in the set.
    *
-   * \param cut Cut outside of the set
+   * \param cut Cut outside of the set (can also be a `compact_cut`)
    */
-  bool is_dominated( CutType const& cut ) const;
+  template<typename Cut>
+  bool is_dominated( Cut const& cut ) const;
 
   /*! \brief Inserts a cut into a set.
    *
@@ -399,22 +530,25 @@ public:
    *
    * The iterator will point to a cut pointer.
    */
-  auto begin() const { return _pcuts.begin(); }
+  CutType* const* begin() const { return _pcuts.get(); }
 
   /*! \brief End iterator (constant). */
-  auto end() const { return _pcend; }
+  CutType* const* end() const { return _pcuts.get() + _size; }
 
   /*! \brief Begin iterator (mutable).
    *
    * The iterator will point to a cut pointer.
    */
-  auto begin() { return _pcuts.begin(); }
+  CutType** begin() { return _pcuts.get(); }
 
   /*! \brief End iterator (mutable). */
-  auto end() { return _pend; }
+  CutType** end() { return _pcuts.get() + _size; }
 
   /*! \brief Number of cuts in the set. */
-  auto size() const { return _pcend - _pcuts.begin(); }
+  std::ptrdiff_t size() const { return _size; }
+
+  /*! \brief Number of cuts for which memory is allocated. */
+  uint32_t capacity() const { return _capacity; }
 
   /*! \brief Returns reference to cut at index.
    *
@@ -446,6 +580,13 @@ public:
    */
   void limit( uint32_t size );
 
+  /*! \brief Releases the memory of cuts that are not in the set.
+   *
+   * Cut enumeration calls this method once the cuts of a node are final.  It
+   * invalidates pointers to the cuts.
+   */
+  void shrink_to_fit();
+
   /*! \brief Prints a cut set. */
   friend std::ostream& operator<<( std::ostream& os, cut_set const& set )
   {
@@ -457,91 +598,147 @@ public:
   }
 
 private:
-  std::array<CutType, MaxCuts> _cuts;
-  std::array<CutType*, MaxCuts> _pcuts;
-  typename std::array<CutType*, MaxCuts>::const_iterator _pcend{ _pcuts.begin() };
-  typename std::array<CutType*, MaxCuts>::iterator _pend{ _pcuts.begin() };
+  /* moves the cuts into storage for `capacity` cuts, keeping their order */
+  void reallocate( uint32_t capacity );
+
+private:
+  /* `_pcuts` is a permutation of the `_capacity` cuts in `_cuts`, of which
+     the first `_size` ones are in the set */
+  std::unique_ptr<CutType[]> _cuts;
+  std::unique_ptr<CutType*[]> _pcuts;
+  uint32_t _size{ 0u };
+  uint32_t _capacity{ 0u };
 };
 
 template<typename CutType, int MaxCuts>
-cut_set<CutType, MaxCuts>::cut_set()
+cut_set<CutType, MaxCuts>::cut_set( cut_set const& other )
+{
+  *this = other;
+}
+
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>::cut_set( cut_set&& other ) noexcept
 {
-  clear();
+  *this = std::move( other );
+}
+
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>& cut_set<CutType, MaxCuts>::operator=( cut_set const& other )
+{
+  if ( &other != this )
+  {
+    _size = 0u;
+    reallocate( other._size );
+    for ( auto const* cut : other )
+    {
+      *_pcuts[_size++] = *cut;
+    }
+  }
+  return *this;
+}
+
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>& cut_set<CutType, MaxCuts>::operator=( cut_set&& other ) noexcept
+{
+  if ( &other != this )
+  {
+    _cuts = std::move( other._cuts );
+    _pcuts = std::move( other._pcuts );
+    _size = std::exchange( other._size, 0u );
+    _capacity = std::exchange( other._capacity, 0u );
+  }
+  return *this;
 }
 
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::clear()
 {
-  _pcend = _pend = _pcuts.begin();
-  auto pit = _pcuts.begin();
-  for ( auto& c : _cuts )
+  _size = 0u;
+  for ( auto i = 0u; i < _capacity; ++i )
   {
-    *pit++ = &c;
+    _pcuts[i] = &_cuts[i];
   }
 }
 
+template<typename CutType, int MaxCuts>
+void cut_set<CutType, MaxCuts>::reallocate( uint32_t capacity )
+{
+  assert( capacity >= _size && capacity <= MaxCuts );
+
+  std::unique_ptr<CutType[]> cuts( capacity == 0u ? nullptr : new CutType[capacity] );
+  std::unique_ptr<CutType*[]> pcuts( capacity == 0u ? nullptr : new CutType*[capacity] );
+  for ( auto i = 0u; i < capacity; ++i )
+  {
+    if ( i < _size )
+    {
+      cuts[i] = *_pcuts[i];
+    }
+    pcuts[i] = &cuts[i];
+  }
+
+  _cuts = std::move( cuts );
+  _pcuts = std::move( pcuts );
+  _capacity = capacity;
+}
+
 template<typename CutType, int MaxCuts>
 template<typename Iterator>
 CutType& cut_set<CutType, MaxCuts>::add_cut( Iterator begin, Iterator end )
 {
-  assert( _pend != _pcuts.end() );
+  assert( _size < MaxCuts );
 
-  auto& cut = **_pend++;
-  cut.set_leaves( begin, end );
+  if ( _size == _capacity )
+  {
+    reallocate( std::min<uint32_t>( std::max( 2u * _capacity, 1u ), MaxCuts ) );
+  }
 
-  ++_pcend;
+  auto& cut = *_pcuts[_size++];
+  cut.set_leaves( begin, end );
   return cut;
 }
 
 template<typename CutType, int MaxCuts>
-bool cut_set<CutType, MaxCuts>::is_dominated( CutType const& cut ) const
+template<typename Cut>
+bool cut_set<CutType, MaxCuts>::is_dominated( Cut const& cut ) const
 {
-  return std::find_if( _pcuts.begin(), _pcend, [&cut]( auto const* other ) { return other->dominates( cut ); } ) != _pcend;
+  return std::find_if( begin(), end(), [&cut]( auto const* other ) { return other->dominates( cut ); } ) != end();
 }
 
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::insert( CutType const& cut )
 {
   /* remove elements that are dominated by new cut */
-  _pcend = _pend = std::stable_partition( _pcuts.begin(), _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
+  _size = static_cast<uint32_t>( std::stable_partition( begin(), end(), [&cut]( auto const* other ) { return !cut.dominates( *other ); } ) - begin() );
 
   /* insert cut in a sorted way */
-  auto ipos = std::lower_bound( _pcuts.begin(), _pend, &cut, []( auto a, auto b ) { return *a < *b; } );
+  auto ipos = static_cast<uint32_t>( std::lower_bound( begin(), end(), &cut, []( auto a, auto b ) { return *a < *b; } ) - begin() );
 
   /* too many cuts, we need to remove one */
-  if ( _pend == _pcuts.end() )
+  if ( _size == MaxCuts )
   {
     /* cut to be inserted is worse than all the others, return */
-    if ( ipos == _pend )
+    if ( ipos == _size )
     {
       return;
     }
     else
     {
       /* remove last cut */
-      --_pend;
-      --_pcend;
+      --_size;
     }
   }
+  else if ( _size == _capacity )
+  {
+    reallocate( std::min<uint32_t>( std::max( 2u * _capacity, 1u ), MaxCuts ) );
+  }
 
   /* copy cut */
-  auto& icut = *_pend;
+  auto& icut = _pcuts[_size];
   icut->set_leaves( cut.begin(), cut.end() );
   icut->data() = cut.data();
 
-  if ( ipos != _pend )
-  {
-    auto it = _pend;
-    while ( it > ipos )
-    {
-      std::swap( *it, *( it - 1 ) );
-      --it;
-    }
-  }
-
-  /* update iterators */
-  _pcend++;
-  _pend++;
+  std::rotate( begin() + ipos, begin() + _size, begin() + _size + 1 );
+  ++_size;
 }
 
 template<typename CutType, int MaxCuts>
@@ -558,10 +755,472 @@ void cut_set<CutType, MaxCuts>::update_best( uint32_t index )
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::limit( uint32_t size )
 {
-  if ( std::distance( _pcuts.begin(), _pend ) > static_cast<long>( size ) )
+  if ( _size > size )
+  {
+    _size = size;
+  }
+}
+
+template<typename CutType, int MaxCuts>
+void cut_set<CutType, MaxCuts>::shrink_to_fit()
+{
+  if ( _capacity != _size )
+  {
+    reallocate( _size );
+  }
+}
+
+/*! \brief Memory for compact cut sets.
+ *
+ * The arena allocates memory in chunks of growing size, which is only
+ * released when the arena is destroyed.  An arena is not thread-safe,
+ * concurrent cut enumeration uses one arena for each thread.
+ */
+class cut_arena
+{
+public:
+  /*! \brief Allocates `size` bytes aligned to `alignment`. */
+  void* allocate( std::size_t size, std::size_t alignment );
+
+  /*! \brief Number of bytes of all chunks, including their unused memory. */
+  std::size_t capacity() const { return _capacity; }
+
+private:
+  static constexpr std::size_t min_chunk_size = std::size_t( 1u ) << 12u;
+  static constexpr std::size_t max_chunk_size = std::size_t( 1u ) << 20u;
+
+  std::vector<std::unique_ptr<unsigned char[]>> _chunks;
+  unsigned char* _next{ nullptr };
+  std::size_t _remaining{ 0u };
+  std::size_t _capacity{ 0u };
+};
+
+inline void* cut_arena::allocate( std::size_t size, std::size_t alignment )
+{
+  const auto padding = [&]() {
+    return ( alignment - reinterpret_cast<std::uintptr_t>( _next ) % alignment ) % alignment;
+  };
+
+  if ( _next == nullptr || padding() + size > _remaining )
+  {
+    /* chunks double in size up to the maximum chunk size */
+    const auto chunk_size = std::max( size + alignment, std::clamp( _capacity, min_chunk_size, max_chunk_size ) );
+    _chunks.emplace_back( new unsigned char[chunk_size] );
+    _next = _chunks.back().get();
+    _remaining = chunk_size;
+    _capacity += chunk_size;
+  }
+
+  auto* p = _next + padding();
+  _remaining -= static_cast<std::size_t>( p - _next ) + size;
+  _next = p + size;
+  return p;
+}
+
+/*! \brief A cut in a compact cut set.
+ *
+ * A compact cut stores its data and the number of its leaves, which follow
+ * the cut in memory with 16 bits for each leaf, or with 32 bits if a leaf
+ * index does not fit into 16 bits.  The signature is computed from the
+ * leaves when it is needed.  Compact cuts are created by `compact_cut_set`
+ * and cannot be copied, but they can be read like a `cut`, and a `cut` can be
+ * constructed from them, e.g., to merge them.
+ */
+template<typename T = empty_cut_data>
+class alignas( uint32_t ) compact_cut
+{
+public:
+  /*! \brief Iterator that decodes the leaves to 32-bit indexes. */
+  class leaf_iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = uint32_t;
+
+    leaf_iterator() = default;
+
+    leaf_iterator( unsigned char const* leaf, uint32_t width )
+        : _leaf( leaf ), _width( width )
+    {
+    }
+
+    uint32_t operator*() const
+    {
+      if ( _width == sizeof( uint16_t ) )
+      {
+        uint16_t leaf;
+        std::memcpy( &leaf, _leaf, sizeof( leaf ) );
+        return leaf;
+      }
+      uint32_t leaf;
+      std::memcpy( &leaf, _leaf, sizeof( leaf ) );
+      return leaf;
+    }
+
+    uint32_t operator[]( difference_type n ) const { return *( *this + n ); }
+
+    leaf_iterator& operator++()
+    {
+      _leaf += _width;
+      return *this;
+    }
+
+    leaf_iterator operator++( int )
+    {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    leaf_iterator& operator--()
+    {
+      _leaf -= _width;
+      return *this;
+    }
+
+    leaf_iterator operator--( int )
+    {
+      auto it = *this;
+      --*this;
+      return it;
+    }
+
+    leaf_iterator& operator+=( difference_type n )
+    {
+      _leaf += n * static_cast<difference_type>( _width );
+      return *this;
+    }
+
+    leaf_iterator& operator-=( difference_type n ) { return *this += -n; }
+
+    leaf_iterator operator+( difference_type n ) const { return leaf_iterator( *this ) += n; }
+
+    leaf_iterator operator-( difference_type n ) const { return leaf_iterator( *this ) -= n; }
+
+    difference_type operator-( leaf_iterator const& other ) const { return ( _leaf - other._leaf ) / static_cast<difference_type>( _width ); }
+
+    bool operator==( leaf_iterator const& other ) const { return _leaf == other._leaf; }
+
+    bool operator!=( leaf_iterator const& other ) const { return _leaf != other._leaf; }
+
+    bool operator<( leaf_iterator const& other ) const { return _leaf < other._leaf; }
+
+    bool operator>( leaf_iterator const& other ) const { return _leaf > other._leaf; }
+
+    bool operator<=( leaf_iterator const& other ) const { return _leaf <= other._leaf; }
+
+    bool operator>=( leaf_iterator const& other ) const { return _leaf >= other._leaf; }
+
+  private:
+    unsigned char const* _leaf{ nullptr };
+    uint32_t _width{ sizeof( uint32_t ) };
+  };
+
+  compact_cut( compact_cut const& ) = delete;
+  compact_cut& operator=( compact_cut const& ) = delete;
+
+  /*! \brief Signature of the cut. */
+  uint64_t signature() const
+  {
+    return visit_leaves( []( auto begin, auto end ) {
+      uint64_t signature{ 0u };
+      while ( begin != end )
+      {
+        signature |= UINT64_C( 1 ) << ( *begin++ & 0x3f );
+      }
+      return signature;
+    } );
+  }
+
+  /*! \brief Returns the size of the cut (number of leaves). */
+  uint32_t size() const { return _length; }
+
+  /*! \brief Begin iterator. */
+  leaf_iterator begin() const { return { reinterpret_cast<unsigned char const*>( this ) + sizeof( compact_cut ), _width }; }
+
+  /*! \brief End iterator. */
+  leaf_iterator end() const { return begin() + _length; }
+
+  /*! \brief Calls `fn( begin, end )` with pointers to the leaves.
+   *
+   * The pointers are of type `uint16_t const*` or `uint32_t const*`,
+   * depending on the width of the leaves, such that algorithms over the
+   * leaves, e.g., `cut::set_union`, do not decode each leaf on access.
+   */
+  template<typename Fn>
+  decltype( auto ) visit_leaves( Fn&& fn ) const
+  {
+    auto const* leaves = reinterpret_cast<unsigned char const*>( this ) + sizeof( compact_cut );
+    if ( _width == sizeof( uint16_t ) )
+    {
+      auto const* begin = reinterpret_cast<uint16_t const*>( leaves );
+      return fn( begin, begin + _length );
+    }
+    auto const* begin = reinterpret_cast<uint32_t const*>( leaves );
+    return fn( begin, begin + _length );
+  }
+
+  /*! \brief Access to data (mutable). */
+  T* operator->() { return &_data; }
+
+  /*! \brief Access to data (constant). */
+  T const* operator->() const { return &_data; }
+
+  /*! \brief Access to data (mutable). */
+  T& data() { return _data; }
+
+  /*! \brief Access to data (constant). */
+  T const& data() const { return _data; }
+
+private:
+  /* copies the cut into memory of `num_bytes( other )` bytes */
+  template<typename Cut>
+  explicit compact_cut( Cut const& other )
+      : _data( other.data() ),
+        _length( static_cast<uint16_t>( other.size() ) ),
+        _width( static_cast<uint16_t>( leaf_width( other ) ) )
+  {
+    auto* leaves = reinterpret_cast<unsigned char*>( this ) + sizeof( compact_cut );
+    if ( _width == sizeof( uint16_t ) )
+    {
+      std::transform( other.begin(), other.end(), reinterpret_cast<uint16_t*>( leaves ), []( uint32_t l ) { return static_cast<uint16_t>( l ); } );
+    }
+    else
+    {
+      std::copy( other.begin(), other.end(), reinterpret_cast<uint32_t*>( leaves ) );
+    }
+  }
+
+  template<typename Cut>
+  static uint32_t leaf_width( Cut const& c )
+  {
+    return std::all_of( c.begin(), c.end(), []( uint32_t l ) { return l <= UINT16_MAX; } ) ? sizeof( uint16_t ) : sizeof( uint32_t );
+  }
+
+  template<typename Cut>
+  static std::size_t num_bytes( Cut const& c )
+  {
+    const auto bytes = sizeof( compact_cut ) + c.size() * leaf_width( c );
+    return ( bytes + alignof( compact_cut ) - 1u ) / alignof( compact_cut ) * alignof( compact_cut );
+  }
+
+  template<typename, int>
+  friend class compact_cut_set;
+
+private:
+  T _data;
+  uint16_t _length;
+  uint16_t _width;
+};
+
+/*! \brief Prints a compact cut.
+ */
+template<typename T>
+std::ostream& operator<<( std::ostream& os, compact_cut<T> const& c )
+{
+  os << "{ ";
+  std::copy( c.begin(), c.end(), std::ostream_iterator<uint32_t>( os, " " ) );
+  os << "}";
+  return os;
+}
+
+/*! \brief A set of cuts stored contiguously in a `cut_arena`.
+ *
+ * A compact cut set holds the cuts of a `cut_set` once they are final.  The
+ * cuts are stored in one block of the arena, which starts with the offsets of
+ * the cuts, followed by the cuts of type `compact_cut`, such that each cut
+ * only takes the memory its leaves need.  The cuts are accessed as in a
+ * `cut_set`, their data can be modified, and their order can be changed with
+ * `update_best` and `limit`, but no cuts can be inserted.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      cut_set<cut<10>, 30> cuts;
+      // ... insert cuts
+
+      cut_arena arena;
+      compact_cut_set<compact_cut<>, 30> compact_cuts;
+      compact_cuts.assign( cuts.begin(), cuts.end(), arena );
+
+      for ( auto const& cut : compact_cuts )
+      {
+        std::cout << *cut << std::endl;
+      }
+   \endverbatim
+ */
+template<typename CutType, int MaxCuts>
+class compact_cut_set
+{
+  static_assert( std::is_trivially_destructible_v<CutType>, "the memory of the cuts is released without destructing them" );
+
+public:
+  /*! \brief Type of the cuts in the set. */
+  using cut_t = CutType;
+
+  /*! \brief Iterator to the cuts, which are dereferenced to cut pointers as in `cut_set`.
+   *
+   * The cut pointers are computed from the offsets and returned by value,
+   * such that equal iterators dereference to the same pointer.
+   */
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CutType*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = CutType*;
+
+    iterator( unsigned char* block, uint32_t const* offset )
+        : _block( block ), _offset( offset )
+    {
+    }
+
+    reference operator*() const { return reinterpret_cast<CutType*>( _block + *_offset ); }
+
+    iterator& operator++()
+    {
+      ++_offset;
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      auto it = *this;
+      ++_offset;
+      return it;
+    }
+
+    bool operator==( iterator const& other ) const { return _offset == other._offset; }
+
+    bool operator!=( iterator const& other ) const { return _offset != other._offset; }
+
+  private:
+    unsigned char* _block;
+    uint32_t const* _offset;
+  };
+
+  /*! \brief Copies cuts into memory of an arena.
+   *
+   * The iterators point to cut pointers, e.g., the iterators of a `cut_set`.
+   * The memory of the previous cuts is not released before the arena is
+   * destroyed.
+   *
+   * \param begin Begin iterator to cut pointers
+   * \param end End iterator (exclusive) to cut pointers
+   * \param arena Arena for the memory of the cuts
+   */
+  template<typename Iterator>
+  void assign( Iterator begin, Iterator end, cut_arena& arena );
+
+  /*! \brief Begin iterator. */
+  iterator begin() const { return { _block, offsets() }; }
+
+  /*! \brief End iterator. */
+  iterator end() const { return { _block, offsets() + _size }; }
+
+  /*! \brief Number of cuts in the set. */
+  std::ptrdiff_t size() const { return _size; }
+
+  /*! \brief Returns reference to cut at index.
+   *
+   * The function does not check whether index is in the valid range.
+   *
+   * \param index Index
+   */
+  CutType const& operator[]( uint32_t index ) const { return *reinterpret_cast<CutType const*>( _block + offsets()[index] ); }
+
+  /*! \brief Returns the best cut, i.e., the first cut.
+   */
+  CutType const& best() const { return ( *this )[0]; }
+
+  /*! \brief Updates the best cut.
+   *
+   * This method will set the cut at index `index` to be the best cut.  All
+   * cuts before `index` will be moved one position higher.
+   *
+   * \param index Index of new best cut
+   */
+  void update_best( uint32_t index );
+
+  /*! \brief Resize the cut set, if it is too large.
+   *
+   * This method will resize the cut set to `size` only if the cut set has more
+   * than `size` elements.  Otherwise, the size will remain the same.
+   */
+  void limit( uint32_t size );
+
+  /*! \brief Prints a cut set. */
+  friend std::ostream& operator<<( std::ostream& os, compact_cut_set const& set )
+  {
+    for ( auto const& c : set )
+    {
+      os << *c << "\n";
+    }
+    return os;
+  }
+
+private:
+  uint32_t* offsets() const { return reinterpret_cast<uint32_t*>( _block ); }
+
+private:
+  /* block with the offsets of the `_size` cuts, followed by the cuts */
+  unsigned char* _block{ nullptr };
+  uint32_t _size{ 0u };
+};
+
+template<typename CutType, int MaxCuts>
+template<typename Iterator>
+void compact_cut_set<CutType, MaxCuts>::assign( Iterator begin, Iterator end, cut_arena& arena )
+{
+  const auto size = static_cast<uint32_t>( std::distance( begin, end ) );
+  assert( size <= MaxCuts );
+
+  constexpr auto alignment = std::max( alignof( CutType ), alignof( uint32_t ) );
+  const auto header = ( size * sizeof( uint32_t ) + alignment - 1u ) / alignment * alignment;
+  auto bytes = header;
+  for ( auto it = begin; it != end; ++it )
+  {
+    bytes += CutType::num_bytes( **it );
+  }
+
+  _block = static_cast<unsigned char*>( arena.allocate( bytes, alignment ) );
+  _size = size;
+
+  auto offset = header;
+  for ( auto i = 0u; begin != end; ++begin, ++i )
+  {
+    offsets()[i] = static_cast<uint32_t>( offset );
+    new ( _block + offset ) CutType( **begin );
+    offset += CutType::num_bytes( **begin );
+  }
+}
+
+template<typename CutType, int MaxCuts>
+void compact_cut_set<CutType, MaxCuts>::update_best( uint32_t index )
+{
+  const auto best = offsets()[index];
+  for ( auto i = index; i > 0; --i )
+  {
+    offsets()[i] = offsets()[i - 1];
+  }
+  offsets()[0] = best;
+}
+
+template<typename CutType, int MaxCuts>
+void compact_cut_set<CutType, MaxCuts>::limit( uint32_t size )
+{
+  if ( _size > size )
   {
-    _pcend = _pend = _pcuts.begin() + size;
+    _size = size;
   }
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
@@ -0,0 +1,298 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fanout_index.hpp
+  \brief Fanout lists in compressed sparse row format
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Fanout lists in compressed sparse row format.
+ *
+ * The lists of all nodes are stored in one array (`slots`), each node
+ * refers to its range by offset, size, and capacity.  When the lists are
+ * built, each list gets some slack slots for incremental updates.  A list
+ * that runs out of slots is moved to the end of the array with twice its
+ * capacity.  Its previous slots are garbage until the array is repacked,
+ * which happens automatically once the garbage exceeds the number of used
+ * slots.
+ *
+ * Lists keep the insertion order of their elements and removing elements
+ * preserves the order of the remaining ones.  Elements are accessed by
+ * index, such that iterating over one list remains valid while other lists
+ * are modified.
+ *
+ * Nodes are addressed by their index (see `node_to_index`).
+ */
+template<typename Node = uint64_t>
+class fanout_index
+{
+public:
+  using node_type = Node;
+
+  /*! \brief Iterator over the list of one node. */
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Node;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Node const*;
+    using reference = Node const&;
+
+    iterator( fanout_index const* index, uint64_t n, uint32_t pos )
+        : index( index ), n( n ), pos( pos )
+    {
+    }
+
+    reference operator*() const
+    {
+      return index->slots[index->offsets[n] + pos];
+    }
+
+    iterator& operator++()
+    {
+      ++pos;
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      auto copy = *this;
+      ++pos;
+      return copy;
+    }
+
+    bool operator==( iterator const& other ) const
+    {
+      return pos == other.pos;
+    }
+
+    bool operator!=( iterator const& other ) const
+    {
+      return pos != other.pos;
+    }
+
+  private:
+    fanout_index const* index;
+    uint64_t n;
+    uint32_t pos;
+  };
+
+public:
+  /*! \brief Removes all lists and creates `num_nodes` empty lists. */
+  void reset( uint64_t num_nodes )
+  {
+    offsets.assign( num_nodes, 0u );
+    sizes.assign( num_nodes, 0u );
+    capacities.assign( num_nodes, 0u );
+    slots.clear();
+    garbage = 0u;
+  }
+
+  /*! \brief Adds empty lists for new nodes up to `num_nodes`. */
+  void resize( uint64_t num_nodes )
+  {
+    if ( num_nodes > offsets.size() )
+    {
+      offsets.resize( num_nodes, slots.size() );
+      sizes.resize( num_nodes, 0u );
+      capacities.resize( num_nodes, 0u );
+    }
+  }
+
+  /*! \brief Builds all lists from scratch.
+   *
+   * `foreach_edge` is called twice with a function `add( n, fanout )`,
+   * which must be called for all fanouts `fanout` of all nodes `n` in the
+   * same order in both calls.  The first call counts the fanouts, the
+   * second one fills the lists.  Duplicate fanouts are ignored.
+   */
+  template<typename Fn>
+  void build( uint64_t num_nodes, Fn&& foreach_edge )
+  {
+    reset( num_nodes );
+    foreach_edge( [&]( uint64_t n, Node const& ) { ++capacities[n]; } );
+    allocate_with_slack();
+    foreach_edge( [&]( uint64_t n, Node const& fanout ) {
+      if ( !contains( n, fanout ) )
+      {
+        slots[offsets[n] + sizes[n]++] = fanout;
+      }
+    } );
+  }
+
+  /*! \brief Number of nodes. */
+  uint64_t num_nodes() const
+  {
+    return offsets.size();
+  }
+
+  /*! \brief Number of fanouts of node `n`. */
+  uint32_t size( uint64_t n ) const
+  {
+    return sizes[n];
+  }
+
+  iterator begin( uint64_t n ) const
+  {
+    return { this, n, 0u };
+  }
+
+  iterator end( uint64_t n ) const
+  {
+    return { this, n, sizes[n] };
+  }
+
+  /*! \brief Returns the fanouts of node `n` as a vector. */
+  std::vector<Node> to_vector( uint64_t n ) const
+  {
+    return { slots.begin() + offsets[n], slots.begin() + offsets[n] + sizes[n] };
+  }
+
+  /*! \brief Checks whether `fanout` is a fanout of node `n`. */
+  bool contains( uint64_t n, Node const& fanout ) const
+  {
+    const auto first = slots.begin() + offsets[n];
+    return std::find( first, first + sizes[n], fanout ) != first + sizes[n];
+  }
+
+  /*! \brief Appends `fanout` to the list of node `n`. */
+  void push_back( uint64_t n, Node const& fanout )
+  {
+    if ( sizes[n] == capacities[n] )
+    {
+      grow( n );
+    }
+    slots[offsets[n] + sizes[n]++] = fanout;
+  }
+
+  /*! \brief Removes all occurrences of `fanout` from the list of node `n`. */
+  void erase( uint64_t n, Node const& fanout )
+  {
+    const auto first = slots.begin() + offsets[n];
+    const auto last = std::remove( first, first + sizes[n], fanout );
+    sizes[n] = static_cast<uint32_t>( last - first );
+  }
+
+  /*! \brief Removes all fanouts of node `n`. */
+  void clear( uint64_t n )
+  {
+    sizes[n] = 0u;
+  }
+
+  /*! \brief Moves all lists next to each other and resets their slack. */
+  void repack()
+  {
+    std::vector<Node> packed;
+    std::vector<uint64_t> old_offsets( offsets );
+    std::copy( sizes.begin(), sizes.end(), capacities.begin() );
+    std::swap( packed, slots );
+    allocate_with_slack();
+    for ( uint64_t n = 0u; n < offsets.size(); ++n )
+    {
+      std::copy( packed.begin() + old_offsets[n], packed.begin() + old_offsets[n] + sizes[n], slots.begin() + offsets[n] );
+    }
+  }
+
+  /*! \brief Number of allocated slots (used, slack, and garbage). */
+  uint64_t num_slots() const
+  {
+    return slots.size();
+  }
+
+  /*! \brief Number of slots that are not reachable from any list. */
+  uint64_t num_garbage_slots() const
+  {
+    return garbage;
+  }
+
+private:
+  /* assigns offsets from capacities (which hold the number of fanouts) */
+  void allocate_with_slack()
+  {
+    uint64_t offset{ 0u };
+    for ( uint64_t n = 0u; n < offsets.size(); ++n )
+    {
+      capacities[n] += slack( capacities[n] );
+      offsets[n] = offset;
+      offset += capacities[n];
+    }
+    slots.resize( offset );
+    garbage = 0u;
+  }
+
+  static uint32_t slack( uint32_t size )
+  {
+    return ( size >> 2u ) + 1u;
+  }
+
+  void grow( uint64_t n )
+  {
+    if ( garbage + capacities[n] > slots.size() - garbage )
+    {
+      repack();
+      if ( sizes[n] < capacities[n] )
+      {
+        return;
+      }
+    }
+
+    /* the last list can grow in place */
+    const auto new_capacity = std::max<uint32_t>( 2u * capacities[n], 4u );
+    if ( offsets[n] + capacities[n] == slots.size() )
+    {
+      slots.resize( offsets[n] + new_capacity );
+    }
+    else
+    {
+      const auto new_offset = slots.size();
+      slots.resize( new_offset + new_capacity );
+      std::copy( slots.begin() + offsets[n], slots.begin() + offsets[n] + sizes[n], slots.begin() + new_offset );
+      garbage += capacities[n];
+      offsets[n] = new_offset;
+    }
+    capacities[n] = new_capacity;
+  }
+
+private:
+  std::vector<uint64_t> offsets;
+  std::vector<uint32_t> sizes;
+  std::vector<uint32_t> capacities;
+  std::vector<Node> slots;
+  uint64_t garbage{ 0u };
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,99 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_file.hpp
+  \brief Memory mapping of binary files
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* maps a file privately (modifications are not written back), or reads it
+   into memory if memory mapping is not available; returns nullptr if the
+   file cannot be opened or is smaller than `min_size` bytes */
+inline std::shared_ptr<char> map_file( std::string const& filename, uint64_t& size, uint64_t min_size = 0u )
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+  const int fd = ::open( filename.c_str(), O_RDONLY );
+  if ( fd < 0 )
+  {
+    return nullptr;
+  }
+
+  struct stat st;
+  if ( ::fstat( fd, &st ) != 0 || st.st_size == 0 || static_cast<uint64_t>( st.st_size ) < min_size )
+  {
+    ::close( fd );
+    return nullptr;
+  }
+  size = static_cast<uint64_t>( st.st_size );
+
+  void* addr = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+  ::close( fd );
+  if ( addr == MAP_FAILED )
+  {
+    return nullptr;
+  }
+  return std::shared_ptr<char>( static_cast<char*>( addr ), [size]( char* p ) { ::munmap( p, size ); } );
+#else
+  std::ifstream in( filename, std::ifstream::binary | std::ifstream::ate );
+  if ( !in.is_open() )
+  {
+    return nullptr;
+  }
+  size = static_cast<uint64_t>( in.tellg() );
+  if ( size == 0u || size < min_size )
+  {
+    return nullptr;
+  }
+
+  std::shared_ptr<char> data( new char[size], std::default_delete<char[]>() );
+  in.seekg( 0 );
+  in.read( data.get(), size );
+  return in ? data : nullptr;
+#endif
+}
+
+} // namespace detail
+
+} // namespace mockturtle
@@ -34,7 +34,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <variant>
@@ -186,6 +189,28 @@ public:
     }
   }
 
+  /*! \brief Moves the values to new node indices.
+   *
+   * This function should be called after the network has been compacted
+   * in place (e.g., with `compact`).  Values of removed nodes are dropped,
+   * and the map is resized to the current network's size.
+   *
+   * \param old_to_new Maps each old node index to its new index
+   */
+  void remap( std::vector<uint64_t> const& old_to_new )
+  {
+    container_type remapped( ntk->size() );
+    const auto num_old = std::min<uint64_t>( old_to_new.size(), data->size() );
+    for ( auto i = 0u; i < num_old; ++i )
+    {
+      if ( old_to_new[i] < remapped.size() )
+      {
+        remapped[old_to_new[i]] = std::move( ( *data )[i] );
+      }
+    }
+    *data = std::move( remapped );
+  }
+
 private:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -322,6 +347,26 @@ public:
   {
   }
 
+  /*! \brief Moves the values to new node indices.
+   *
+   * This function should be called after the network has been compacted
+   * in place (e.g., with `compact`).  Values of removed nodes are dropped.
+   *
+   * \param old_to_new Maps each old node index to its new index
+   */
+  void remap( std::vector<uint64_t> const& old_to_new )
+  {
+    container_type remapped;
+    for ( auto& [index, value] : *data )
+    {
+      if ( index < old_to_new.size() && old_to_new[index] != std::numeric_limits<uint64_t>::max() )
+      {
+        remapped.emplace( old_to_new[index], std::move( value ) );
+      }
+    }
+    *data = std::move( remapped );
+  }
+
 protected:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -35,6 +35,12 @@
 #pragma once
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -48,6 +54,7 @@
 
 #include "../io/genlib_reader.hpp"
 #include "../io/super_reader.hpp"
+#include "mapped_file.hpp"
 #include "super_utils.hpp"
 
 namespace mockturtle
@@ -94,6 +101,14 @@ struct tech_library_params
 
   /*! \brief reports all the entries in the library */
   bool very_verbose{ false };
+
+  /*! \brief binary file caching the library (empty for no cache)
+   *
+   * If the file has been written for the same gates, supergates, and
+   * template parameters, the library is read from it instead of being
+   * generated. Otherwise, the library is generated and written to it.
+   */
+  std::string cache_file{};
 };
 
 template<unsigned NInputs>
@@ -115,6 +130,82 @@ struct supergate
   uint8_t polarity{ 0 };
 };
 
+namespace detail
+{
+
+/* "mcktlib" followed by a zero byte */
+static constexpr uint64_t tech_library_cache_magic = UINT64_C( 0x0062696c746b636d );
+static constexpr uint32_t tech_library_cache_version = 1u;
+
+struct tech_library_cache_header
+{
+  uint64_t magic{ tech_library_cache_magic };
+  uint32_t version{ tech_library_cache_version };
+  uint32_t num_inputs{ 0u };
+  uint32_t configuration{ 0u };
+  uint32_t max_size{ 0u };
+  uint64_t key{ 0u }; /* hash of the gates and supergates specification */
+  float inv_area{ 0.0f };
+  float inv_delay{ 0.0f };
+  uint32_t inv_id{ 0u };
+  float buf_area{ 0.0f };
+  float buf_delay{ 0.0f };
+  uint32_t buf_id{ 0u };
+  uint64_t num_composed_gates{ 0u };
+  uint64_t num_entries{ 0u };
+  uint64_t num_supergates{ 0u };
+};
+
+/* the file contains the header, the entries (truth table words followed
+   by the number of supergates), and the supergates of all entries */
+template<unsigned NInputs>
+struct tech_library_cache_supergate
+{
+  uint32_t root; /* index in the composed gates of `super_utils` */
+  float area;
+  float tdelay[NInputs];
+  uint8_t polarity;
+  uint8_t num_pins;
+  uint8_t permutation[NInputs];
+};
+
+/* FNV-1a hash of the inputs of a library */
+class tech_library_hasher
+{
+public:
+  void add_bytes( void const* data, std::size_t size )
+  {
+    auto const* bytes = static_cast<unsigned char const*>( data );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      _hash = ( _hash ^ bytes[i] ) * UINT64_C( 0x100000001b3 );
+    }
+  }
+
+  template<typename T>
+  void add( T const& value )
+  {
+    static_assert( std::is_arithmetic_v<T> || std::is_enum_v<T> );
+    add_bytes( &value, sizeof( T ) );
+  }
+
+  void add( std::string const& value )
+  {
+    add( static_cast<uint64_t>( value.size() ) );
+    add_bytes( value.data(), value.size() );
+  }
+
+  uint64_t value() const
+  {
+    return _hash;
+  }
+
+private:
+  uint64_t _hash{ UINT64_C( 0xcbf29ce484222325 ) };
+};
+
+} // namespace detail
+
 /*! \brief Library of gates for Boolean matching
  *
  * This class creates a technology library from a set
@@ -144,6 +235,11 @@ struct supergate
       lorina::read_super( "file.super", super_reader( supergates_spec ) );
       // library with supergates
       mockturtle::tech_library lib_super( gates, supergates_spec );
+
+      // library cached in a binary file
+      tech_library_params ps;
+      ps.cache_file = "file.tlib";
+      mockturtle::tech_library lib_cached( gates, ps );
    \endverbatim
  */
 template<unsigned NInputs = 4u, classification_type Configuration = classification_type::np_configurations>
@@ -162,7 +258,7 @@ public:
         _use_supergates( false ),
         _super_lib()
   {
-    generate_library();
+    initialize();
   }
 
   explicit tech_library( std::vector<gate> const& gates, super_lib const& supergates_spec, tech_library_params const ps = {} )
@@ -173,7 +269,7 @@ public:
         _use_supergates( true ),
         _super_lib()
   {
-    generate_library();
+    initialize();
   }
 
   /*! \brief Get the gates matching the function.
@@ -219,7 +315,240 @@ public:
     return _gates;
   }
 
+  /*! \brief Writes the library to a binary file.
+   *
+   * The file can be read by `read_cache` of libraries constructed from
+   * the same gates and supergates specification. The file is written
+   * under a temporary name and then renamed, such that processes reading
+   * the file concurrently never see it partially written.
+   * Returns false if the file cannot be written.
+   */
+  bool write_cache( std::string const& filename ) const
+  {
+    using record_t = detail::tech_library_cache_supergate<NInputs>;
+
+    auto const& gates = _super.get_super_library();
+    std::unordered_map<composed_gate<NInputs> const*, uint32_t> gate_index;
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      gate_index.emplace( &gates[i], i );
+    }
+
+    detail::tech_library_cache_header header;
+    header.num_inputs = NInputs;
+    header.configuration = static_cast<uint32_t>( Configuration );
+    header.max_size = _max_size;
+    header.key = _cache_key;
+    header.inv_area = _inv_area;
+    header.inv_delay = _inv_delay;
+    header.inv_id = _inv_id;
+    header.buf_area = _buf_area;
+    header.buf_delay = _buf_delay;
+    header.buf_id = _buf_id;
+    header.num_composed_gates = gates.size();
+    header.num_entries = _super_lib.size();
+    for ( auto const& entry : _super_lib )
+    {
+      header.num_supergates += entry.second.size();
+    }
+
+    std::string const tmp_filename = filename + ".tmp" + std::to_string( std::random_device{}() );
+    std::ofstream os( tmp_filename, std::ofstream::binary );
+    if ( !os.is_open() )
+    {
+      return false;
+    }
+
+    os.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+    for ( auto const& entry : _super_lib )
+    {
+      uint64_t const count = entry.second.size();
+      os.write( reinterpret_cast<char const*>( &( *entry.first.cbegin() ) ), entry.first.num_blocks() * sizeof( uint64_t ) );
+      os.write( reinterpret_cast<char const*>( &count ), sizeof( count ) );
+    }
+    for ( auto const& entry : _super_lib )
+    {
+      for ( auto const& sg : entry.second )
+      {
+        record_t record;
+        std::memset( &record, 0, sizeof( record ) );
+        record.root = gate_index.at( sg.root );
+        record.area = sg.area;
+        std::copy( sg.tdelay.begin(), sg.tdelay.end(), record.tdelay );
+        record.polarity = sg.polarity;
+        record.num_pins = static_cast<uint8_t>( sg.permutation.size() );
+        std::copy( sg.permutation.begin(), sg.permutation.end(), record.permutation );
+        os.write( reinterpret_cast<char const*>( &record ), sizeof( record ) );
+      }
+    }
+
+    os.close();
+    if ( !os || std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+    {
+      std::remove( tmp_filename.c_str() );
+      return false;
+    }
+    return true;
+  }
+
+  /*! \brief Reads the library from a binary file.
+   *
+   * The file is memory-mapped and the library is rebuilt from the
+   * entries in a single pass, without enumerating configurations.
+   * Returns false, and leaves the library unchanged, if the file does
+   * not exist, is corrupted, or has been written for different gates,
+   * supergates, or template parameters.
+   */
+  bool read_cache( std::string const& filename )
+  {
+    using header_t = detail::tech_library_cache_header;
+    using record_t = detail::tech_library_cache_supergate<NInputs>;
+
+    uint64_t size = 0u;
+    auto const file = detail::map_file( filename, size, sizeof( header_t ) );
+    if ( !file )
+    {
+      return false;
+    }
+
+    header_t header;
+    std::memcpy( &header, file.get(), sizeof( header ) );
+
+    auto const& gates = _super.get_super_library();
+    uint64_t const num_blocks = kitty::static_truth_table<NInputs>{}.num_blocks();
+    uint64_t const entry_size = ( num_blocks + 1u ) * sizeof( uint64_t );
+    if ( header.magic != detail::tech_library_cache_magic || header.version != detail::tech_library_cache_version ||
+         header.num_inputs != NInputs || header.configuration != static_cast<uint32_t>( Configuration ) ||
+         header.key != _cache_key || header.num_composed_gates != gates.size() ||
+         header.num_entries > size / entry_size || header.num_supergates > size / sizeof( record_t ) ||
+         size != sizeof( header ) + header.num_entries * entry_size + header.num_supergates * sizeof( record_t ) )
+    {
+      return false;
+    }
+
+    lib_t lib;
+    lib.reserve( header.num_entries );
+
+    char const* entry = file.get() + sizeof( header );
+    char const* record_data = entry + header.num_entries * entry_size;
+    uint64_t remaining = header.num_supergates;
+    for ( auto i = 0u; i < header.num_entries; ++i, entry += entry_size )
+    {
+      kitty::static_truth_table<NInputs> tt;
+      uint64_t count;
+      std::memcpy( &( *tt.begin() ), entry, num_blocks * sizeof( uint64_t ) );
+      std::memcpy( &count, entry + num_blocks * sizeof( uint64_t ), sizeof( count ) );
+      if ( count > remaining )
+      {
+        return false;
+      }
+      remaining -= count;
+
+      auto& list = lib[tt];
+      list.reserve( count );
+      for ( auto j = 0u; j < count; ++j, record_data += sizeof( record_t ) )
+      {
+        record_t record;
+        std::memcpy( &record, record_data, sizeof( record ) );
+        if ( record.root >= gates.size() || gates[record.root].root == nullptr || record.num_pins > NInputs )
+        {
+          return false;
+        }
+
+        supergate<NInputs> sg = { &gates[record.root],
+                                  record.area,
+                                  {},
+                                  std::vector<uint8_t>( record.permutation, record.permutation + record.num_pins ),
+                                  record.polarity };
+        std::copy( record.tdelay, record.tdelay + NInputs, sg.tdelay.begin() );
+        list.push_back( std::move( sg ) );
+      }
+    }
+
+    if ( remaining != 0u )
+    {
+      return false;
+    }
+
+    _inv_area = header.inv_area;
+    _inv_delay = header.inv_delay;
+    _inv_id = header.inv_id;
+    _buf_area = header.buf_area;
+    _buf_delay = header.buf_delay;
+    _buf_id = header.buf_id;
+    _max_size = header.max_size;
+    _super_lib = std::move( lib );
+    return true;
+  }
+
 private:
+  void initialize()
+  {
+    _cache_key = compute_cache_key();
+
+    if ( !_ps.cache_file.empty() && read_cache( _ps.cache_file ) )
+    {
+      if ( _ps.verbose )
+      {
+        std::cout << "[i] Read library from " << _ps.cache_file << std::endl;
+      }
+      return;
+    }
+
+    generate_library();
+
+    if ( !_ps.cache_file.empty() && !write_cache( _ps.cache_file ) )
+    {
+      std::cerr << "[i] WARNING: library cache " << _ps.cache_file << " could not be written" << std::endl;
+    }
+  }
+
+  uint64_t compute_cache_key() const
+  {
+    detail::tech_library_hasher hasher;
+
+    hasher.add( _use_supergates );
+    hasher.add( static_cast<uint64_t>( _gates.size() ) );
+    for ( auto const& g : _gates )
+    {
+      hasher.add( g.id );
+      hasher.add( g.name );
+      hasher.add( g.num_vars );
+      hasher.add( g.function.num_vars() );
+      hasher.add_bytes( &( *g.function.cbegin() ), g.function.num_blocks() * sizeof( uint64_t ) );
+      hasher.add( g.area );
+      hasher.add( static_cast<uint64_t>( g.pins.size() ) );
+      for ( auto const& pin : g.pins )
+      {
+        hasher.add( pin.name );
+        hasher.add( pin.phase );
+        hasher.add( pin.input_load );
+        hasher.add( pin.max_load );
+        hasher.add( pin.rise_block_delay );
+        hasher.add( pin.rise_fanout_delay );
+        hasher.add( pin.fall_block_delay );
+        hasher.add( pin.fall_fanout_delay );
+      }
+      hasher.add( g.output_name );
+    }
+
+    hasher.add( _supergates_spec.max_num_vars );
+    hasher.add( static_cast<uint64_t>( _supergates_spec.supergates.size() ) );
+    for ( auto const& sg : _supergates_spec.supergates )
+    {
+      hasher.add( sg.id );
+      hasher.add( sg.name );
+      hasher.add( sg.is_super );
+      hasher.add( static_cast<uint64_t>( sg.fanin_id.size() ) );
+      for ( auto f : sg.fanin_id )
+      {
+        hasher.add( f );
+      }
+    }
+
+    return hasher.value();
+  }
+
   void generate_library()
   {
     bool inv = false;
@@ -616,6 +945,7 @@ private:
   tech_library_params const _ps;
   super_utils<NInputs> _super; /* supergates generation */
   lib_t _super_lib;            /* library of enumerated gates */
+  uint64_t _cache_key{ 0 };    /* hash of the inputs of the library */
 };                             /* class tech_library */
 
 template<typename Ntk, unsigned NInputs>
@@ -0,0 +1,302 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file thread_pool.hpp
+  \brief Work-stealing thread pool for parallel loops
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Work-stealing thread pool for parallel loops.
+ *
+ * The pool starts `num_threads - 1` worker threads, which sleep until the
+ * next call to `parallel_for`; the calling thread takes part in every loop.
+ * The iteration range of a loop is split into one contiguous part per
+ * thread.  Each thread processes its part in chunks of `grain` iterations
+ * from the front and, once its part is empty, steals the back half of the
+ * largest remaining part of another thread.
+ *
+ * Loops must not be nested, i.e., the loop body must not call
+ * `parallel_for` of the same pool.  Exceptions thrown by the loop body are
+ * rethrown in the calling thread after all threads have finished.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      thread_pool pool( 8u );
+      std::vector<uint64_t> v( 1000000u );
+      pool.parallel_for( 0u, v.size(), 1024u, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          v[i] = i * i;
+        }
+      } );
+   \endverbatim
+ */
+class thread_pool
+{
+public:
+  /*! \brief Creates a pool with `num_threads` threads (0 uses the hardware concurrency). */
+  explicit thread_pool( uint32_t num_threads = 0u )
+      : _num_threads( num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads ),
+        _ranges( std::make_unique<range[]>( _num_threads ) )
+  {
+    _workers.reserve( _num_threads - 1u );
+    for ( auto i = 1u; i < _num_threads; ++i )
+    {
+      _workers.emplace_back( [this, i]() { work( i ); } );
+    }
+  }
+
+  thread_pool( thread_pool const& ) = delete;
+  thread_pool& operator=( thread_pool const& ) = delete;
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _wake.notify_all();
+    for ( auto& t : _workers )
+    {
+      t.join();
+    }
+  }
+
+  /*! \brief Number of threads including the calling thread. */
+  uint32_t num_threads() const
+  {
+    return _num_threads;
+  }
+
+  /*! \brief Calls `fn( b, e, thread )` for chunks `[b, e)` of `[begin, end)`.
+   *
+   * Chunks have at most `grain` iterations and `thread` is the index of the
+   * thread (0 is the calling thread) that runs the chunk, e.g., to access
+   * per-thread buffers.  Ranges with at most `grain` iterations are run on
+   * the calling thread without waking up the workers.
+   */
+  template<typename Fn>
+  void parallel_for( uint64_t begin, uint64_t end, uint64_t grain, Fn&& fn )
+  {
+    if ( begin >= end )
+    {
+      return;
+    }
+    grain = std::max<uint64_t>( grain, 1u );
+    if ( _num_threads == 1u || end - begin <= grain )
+    {
+      for ( auto b = begin; b < end; b += grain )
+      {
+        fn( b, std::min( b + grain, end ), 0u );
+      }
+      return;
+    }
+
+    const auto size = end - begin;
+    for ( auto i = 0u; i < _num_threads; ++i )
+    {
+      _ranges[i].begin = begin + size * i / _num_threads;
+      _ranges[i].end = begin + size * ( i + 1u ) / _num_threads;
+    }
+
+    std::function<void( uint32_t )> job = [&]( uint32_t thread ) {
+      uint64_t b, e;
+      while ( pop( thread, grain, b, e ) || steal( thread, grain, b, e ) )
+      {
+        fn( b, e, thread );
+      }
+    };
+
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _job = &job;
+      _pending = _num_threads - 1u;
+      ++_generation;
+    }
+    _wake.notify_all();
+
+    run( job, 0u );
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _done.wait( lock, [this]() { return _pending == 0u; } );
+    _job = nullptr;
+    if ( _exception )
+    {
+      std::rethrow_exception( std::exchange( _exception, nullptr ) );
+    }
+  }
+
+private:
+  struct alignas( 64 ) range
+  {
+    std::mutex mutex;
+    uint64_t begin{ 0u };
+    uint64_t end{ 0u };
+  };
+
+  void work( uint32_t thread )
+  {
+    uint64_t generation = 0u;
+    while ( true )
+    {
+      std::function<void( uint32_t )>* job;
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _wake.wait( lock, [&]() { return _stop || _generation != generation; } );
+        if ( _stop )
+        {
+          return;
+        }
+        generation = _generation;
+        job = _job;
+      }
+
+      run( *job, thread );
+
+      std::lock_guard<std::mutex> lock( _mutex );
+      if ( --_pending == 0u )
+      {
+        _done.notify_one();
+      }
+    }
+  }
+
+  void run( std::function<void( uint32_t )> const& job, uint32_t thread )
+  {
+    try
+    {
+      job( thread );
+    }
+    catch ( ... )
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      if ( !_exception )
+      {
+        _exception = std::current_exception();
+      }
+      /* let the other threads run out of work */
+      for ( auto i = 0u; i < _num_threads; ++i )
+      {
+        std::lock_guard<std::mutex> range_lock( _ranges[i].mutex );
+        _ranges[i].begin = _ranges[i].end;
+      }
+    }
+  }
+
+  /* takes a chunk from the front of the own range */
+  bool pop( uint32_t thread, uint64_t grain, uint64_t& b, uint64_t& e )
+  {
+    auto& r = _ranges[thread];
+    std::lock_guard<std::mutex> lock( r.mutex );
+    if ( r.begin >= r.end )
+    {
+      return false;
+    }
+    b = r.begin;
+    e = std::min( r.begin + grain, r.end );
+    r.begin = e;
+    return true;
+  }
+
+  /* takes the back half of the largest range of another thread */
+  bool steal( uint32_t thread, uint64_t grain, uint64_t& b, uint64_t& e )
+  {
+    while ( true )
+    {
+      auto victim = thread;
+      uint64_t largest = 0u;
+      for ( auto i = 1u; i < _num_threads; ++i )
+      {
+        const auto j = ( thread + i ) % _num_threads;
+        std::lock_guard<std::mutex> lock( _ranges[j].mutex );
+        if ( _ranges[j].end - _ranges[j].begin > largest )
+        {
+          largest = _ranges[j].end - _ranges[j].begin;
+          victim = j;
+        }
+      }
+      if ( largest == 0u )
+      {
+        return false;
+      }
+
+      uint64_t stolen_begin, stolen_end;
+      {
+        auto& r = _ranges[victim];
+        std::lock_guard<std::mutex> lock( r.mutex );
+        if ( r.begin >= r.end )
+        {
+          continue; /* the range was emptied in the meantime */
+        }
+        stolen_end = r.end;
+        stolen_begin = r.end - ( r.end - r.begin + 1u ) / 2u;
+        r.end = stolen_begin;
+      }
+
+      b = stolen_begin;
+      e = std::min( stolen_begin + grain, stolen_end );
+      auto& own = _ranges[thread];
+      std::lock_guard<std::mutex> lock( own.mutex );
+      own.begin = e;
+      own.end = stolen_end;
+      return true;
+    }
+  }
+
+private:
+  uint32_t _num_threads;
+  std::unique_ptr<range[]> _ranges;
+  std::vector<std::thread> _workers;
+
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  std::function<void( uint32_t )>* _job{ nullptr };
+  uint64_t _generation{ 0u };
+  uint32_t _pending{ 0u };
+  bool _stop{ false };
+  std::exception_ptr _exception;
+};
+
+} // namespace mockturtle
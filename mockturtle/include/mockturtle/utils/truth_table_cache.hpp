@@ -106,6 +106,13 @@ public:
    */
   TT operator[]( uint32_t lit ) const;
 
+  /*! \brief Returns the normal truth table for a given literal.
+   *
+   * Unlike `operator[]`, the complement bit of `lit` is ignored and no copy
+   * is made.
+   */
+  TT const& normal( uint32_t lit ) const;
+
   /*! \brief Returns number of normalized truth tables in the cache. */
   auto size() const { return _data.size(); }
 
@@ -154,4 +161,10 @@ TT truth_table_cache<TT>::operator[]( uint32_t index ) const
   return ( index & 1 ) ? ~entry : entry;
 }
 
+template<typename TT>
+TT const& truth_table_cache<TT>::normal( uint32_t lit ) const
+{
+  return _data[lit >> 1];
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
@@ -141,7 +141,7 @@ public:
     return false;
   }
 
-  void remove_binding( node const& n ) const
+  void remove_binding( node const& n )
   {
     _bindings.erase( n );
   }
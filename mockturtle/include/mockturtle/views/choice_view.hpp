@@ -0,0 +1,344 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file choice_view.hpp
+  \brief Records functionally equivalent alternatives of nodes
+*/
+
+#pragma once
+
+#include "../networks/detail/foreach.hpp"
+#include "../traits.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Implements structural choices on a network.
+ *
+ * A choice network contains, next to the nodes driving its outputs,
+ * alternative structures of some nodes.  An alternative of a node is
+ * another node of the network that implements the same function, or its
+ * complement.  A node and its alternatives form a choice class, whose
+ * first node, the *representative*, is the one used by the fanouts.  The
+ * alternatives themselves are usually dangling, and their fanins point
+ * to representatives of other classes.  Algorithms that are aware of
+ * choices, such as cut enumeration and the mappers, can pick the best
+ * structure for each class in a single pass.  Other algorithms ignore the
+ * alternatives; e.g., `cleanup_dangling` removes them.
+ *
+ * This view reimplements `foreach_node` and `foreach_gate` such that each
+ * node is visited after its fanins and a representative is visited after
+ * its alternatives.  The order is recomputed on the next traversal after
+ * nodes have been added to the network or choices have been recorded.
+ * Recording a choice must not create a cycle, i.e., the representative
+ * must not be in the transitive fanin of the alternative, where the
+ * transitive fanin includes the alternatives of the representatives it
+ * contains.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `is_complemented`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `is_constant`
+ * - `is_ci`
+ * - `fanout_size`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      // network with two structures of the same function
+      choice_view<aig_network> aig;
+      const auto a = aig.create_pi();
+      const auto b = aig.create_pi();
+      const auto c = aig.create_pi();
+      const auto f = aig.create_and( aig.create_and( a, b ), c );
+      const auto g = aig.create_and( a, aig.create_and( b, c ) );
+      aig.create_po( f );
+
+      // g is an alternative of f
+      aig.add_choice( aig.get_node( f ), g );
+
+      // cuts of g are also cuts of f
+      const auto cuts = cut_enumeration( aig );
+   \endverbatim
+ */
+template<class Ntk>
+class choice_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr bool is_topologically_sorted = true;
+
+  /*! \brief Default constructor.
+   *
+   * \param ntk Network without choices
+   */
+  explicit choice_view( Ntk const& ntk = Ntk() )
+      : Ntk( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  }
+
+  /*! \brief Records an alternative of a node.
+   *
+   * The function of `alternative` must be equal to the function of
+   * `repr`.  The node of `alternative` must neither be a representative
+   * nor an alternative, and `repr` must be a gate which is not an
+   * alternative itself.
+   *
+   * \param repr Representative of the choice class
+   * \param alternative Signal equivalent to the representative
+   */
+  void add_choice( node const& repr, signal const& alternative )
+  {
+    const auto r = this->node_to_index( repr );
+    const auto a = this->node_to_index( this->get_node( alternative ) );
+    assert( r != a );
+    assert( !this->is_constant( repr ) && !this->is_ci( repr ) );
+    assert( !is_choice( repr ) && "representative is an alternative" );
+    assert( !is_choice( this->get_node( alternative ) ) && !has_choices( this->get_node( alternative ) ) );
+
+    if ( _repr.size() <= std::max( r, a ) )
+    {
+      _repr.resize( this->size(), 0u );
+      _next.resize( this->size(), 0u );
+      _phase.resize( this->size(), false );
+    }
+
+    /* append to the end of the class to keep the order of the alternatives */
+    auto last = r;
+    while ( _next[last] != 0u )
+    {
+      last = _next[last];
+    }
+    _next[last] = a;
+    _repr[a] = r;
+    _phase[a] = this->is_complemented( alternative );
+
+    ++_num_choices;
+    _order.clear();
+  }
+
+  /*! \brief Whether a node is the representative of alternatives. */
+  bool has_choices( node const& n ) const
+  {
+    const auto index = this->node_to_index( n );
+    return index < _next.size() && _repr[index] == 0u && _next[index] != 0u;
+  }
+
+  /*! \brief Whether a node is an alternative of another node. */
+  bool is_choice( node const& n ) const
+  {
+    const auto index = this->node_to_index( n );
+    return index < _repr.size() && _repr[index] != 0u;
+  }
+
+  /*! \brief Returns the representative of the choice class of a node. */
+  node get_choice_representative( node const& n ) const
+  {
+    return is_choice( n ) ? this->index_to_node( _repr[this->node_to_index( n )] ) : n;
+  }
+
+  /*! \brief Whether a node implements the complement of its representative. */
+  bool get_choice_phase( node const& n ) const
+  {
+    return is_choice( n ) && _phase[this->node_to_index( n )];
+  }
+
+  /*! \brief Returns the number of recorded alternatives. */
+  uint32_t num_choices() const
+  {
+    return _num_choices;
+  }
+
+  /*! \brief Iterates over the alternatives of a representative.
+   *
+   * The alternatives are visited in the order in which they were added.
+   */
+  template<typename Fn>
+  void foreach_choice( node const& n, Fn&& fn ) const
+  {
+    if ( !has_choices( n ) )
+    {
+      return;
+    }
+
+    for ( auto a = _next[this->node_to_index( n )]; a != 0u; a = _next[a] )
+    {
+      if constexpr ( std::is_invocable_r_v<bool, Fn, node> )
+      {
+        if ( !fn( this->index_to_node( a ) ) )
+        {
+          return;
+        }
+      }
+      else
+      {
+        fn( this->index_to_node( a ) );
+      }
+    }
+  }
+
+  /*! \brief Reimplementation of `fanout_size`.
+   *
+   * An alternative has the fanout size of its representative, whose
+   * fanouts it may drive in a mapping, such that the cost estimations of
+   * the mappers do not consider the alternatives as dangling.
+   */
+  uint32_t fanout_size( node const& n ) const
+  {
+    return Ntk::fanout_size( get_choice_representative( n ) );
+  }
+
+  /*! \brief Reimplementation of `foreach_node`. */
+  template<typename Fn>
+  void foreach_node( Fn&& fn ) const
+  {
+    update_order();
+    detail::foreach_element( _order.begin(), _order.end(), fn );
+  }
+
+  /*! \brief Reimplementation of `foreach_gate`. */
+  template<typename Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    update_order();
+    detail::foreach_element_if(
+        _order.begin(), _order.end(),
+        [this]( auto const& n ) { return !this->is_constant( n ) && !this->is_ci( n ); },
+        fn );
+  }
+
+private:
+  /* depth-first search in which the fanins and the alternatives of a
+     node are placed before the node */
+  void update_order() const
+  {
+    if ( !_order.empty() && _order_size == this->size() )
+    {
+      return;
+    }
+
+    _order.clear();
+    _order.reserve( this->size() );
+    _order_size = this->size();
+
+    /* 0: not visited, 1: on the stack, 2: placed */
+    std::vector<uint8_t> marks( this->size(), 0u );
+    std::vector<std::pair<node, bool>> stack;
+
+    Ntk::foreach_node( [&]( auto const& root ) {
+      if ( marks[this->node_to_index( root )] == 2u )
+      {
+        return;
+      }
+
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        const auto [n, expanded] = stack.back();
+        stack.pop_back();
+
+        auto& mark = marks[this->node_to_index( n )];
+        if ( expanded )
+        {
+          if ( mark != 2u )
+          {
+            mark = 2u;
+            _order.push_back( n );
+          }
+          continue;
+        }
+        if ( mark == 2u )
+        {
+          continue;
+        }
+        assert( mark == 0u && "cycle through the choices" );
+        mark = 1u;
+
+        stack.emplace_back( n, true );
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          if ( marks[this->node_to_index( this->get_node( f ) )] != 2u )
+          {
+            stack.emplace_back( this->get_node( f ), false );
+          }
+        } );
+        this->foreach_choice( n, [&]( auto const& a ) {
+          if ( marks[this->node_to_index( a )] != 2u )
+          {
+            stack.emplace_back( a, false );
+          }
+        } );
+      }
+    } );
+  }
+
+private:
+  /* representative of each alternative (0 for other nodes) */
+  std::vector<uint32_t> _repr;
+
+  /* next alternative in the class of a representative (0 at the end) */
+  std::vector<uint32_t> _next;
+
+  /* whether an alternative is complemented w.r.t. its representative */
+  std::vector<bool> _phase;
+
+  uint32_t _num_choices{ 0u };
+
+  mutable std::vector<node> _order;
+  mutable uint64_t _order_size{ 0u };
+};
+
+template<class T>
+choice_view( T const& ) -> choice_view<T>;
+
+} // namespace mockturtle
@@ -36,11 +36,16 @@
 
 #include "../networks/events.hpp"
 #include "../traits.hpp"
+#include "../utils/bucket_queue.hpp"
 #include "../utils/cost_functions.hpp"
+#include "../utils/fanout_index.hpp"
 #include "../utils/node_map.hpp"
 #include "immutable_view.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace mockturtle
@@ -53,8 +58,330 @@ struct depth_view_params
 
   /*! \brief Whether PIs have costs. */
   bool pi_cost{ false };
+
+  /*! \brief Maintain levels and required levels incrementally.
+   *
+   * If true, the view tracks the fanouts of all nodes and records which
+   * nodes are affected by network events.  A call to `update_levels` then
+   * only revisits the affected nodes instead of the whole network.
+   */
+  bool incremental{ false };
 };
 
+namespace detail
+{
+
+/* Levels and heights (distance to the POs) that are updated incrementally.
+ * The state is shared by all copies of a depth_view and registers its own
+ * events, such that each network event is recorded once. */
+template<class Ntk, class NodeCostFn>
+class depth_view_timing
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  depth_view_timing( Ntk const& ntk, node_map<uint32_t, Ntk> const& levels, NodeCostFn const& cost_fn, depth_view_params const& ps )
+      : ntk( ntk ), ps( ps ), cost_fn( cost_fn ), levels( levels ), heights( this->ntk ), queued( this->ntk ), po_refs( this->ntk ), po_compl_refs( this->ntk )
+  {
+    add_event = this->ntk.events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    modified_event = this->ntk.events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    delete_event = this->ntk.events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+  depth_view_timing( depth_view_timing const& ) = delete;
+  depth_view_timing& operator=( depth_view_timing const& ) = delete;
+
+  ~depth_view_timing()
+  {
+    ntk.events().release_add_event( add_event );
+    ntk.events().release_modified_event( modified_event );
+    ntk.events().release_delete_event( delete_event );
+  }
+
+  /*! \brief Computes fanouts and heights of all nodes, levels must be up to date. */
+  uint32_t compute()
+  {
+    fanout.build( ntk.size(), [&]( auto&& add ) {
+      ntk.foreach_gate( [&]( auto const& n ) {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          add( ntk.node_to_index( ntk.get_node( f ) ), n );
+        } );
+      } );
+    } );
+
+    heights.reset( 0 );
+    queued.reset( 0 );
+    po_refs.reset( 0 );
+    po_compl_refs.reset( 0 );
+    arrival_queue.clear();
+    required_queue.clear();
+
+    po_signals.clear();
+    ntk.foreach_po( [&]( auto const& f ) {
+      po_signals.push_back( f );
+      add_po_ref( f, 1 );
+    } );
+    ntk.foreach_node( [&]( auto const& n ) {
+      push_required( n );
+    } );
+    propagate_required();
+
+    return compute_depth();
+  }
+
+  /*! \brief Propagates all recorded changes and returns the depth. */
+  uint32_t update()
+  {
+    resize();
+
+    /* POs are replaced without events */
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      if ( i == po_signals.size() )
+      {
+        po_signals.push_back( f );
+        add_po_ref( f, 1 );
+      }
+      else if ( po_signals[i] != f )
+      {
+        add_po_ref( po_signals[i], -1 );
+        add_po_ref( f, 1 );
+        po_signals[i] = f;
+      }
+    } );
+
+    propagate_arrival();
+    propagate_required();
+    return compute_depth();
+  }
+
+  uint32_t height( node const& n ) const
+  {
+    return heights[n];
+  }
+
+  /*! \brief Whether the node has fanouts or drives a PO. */
+  bool is_used( node const& n ) const
+  {
+    return po_refs[n] > 0u || fanout.size( ntk.node_to_index( n ) ) > 0u;
+  }
+
+private:
+  /* node maps are resized lazily for nodes created since the last update */
+  void resize()
+  {
+    levels.resize();
+    heights.resize();
+    queued.resize();
+    po_refs.resize();
+    po_compl_refs.resize();
+    fanout.resize( ntk.size() );
+  }
+
+  bool is_alive( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return !ntk.is_dead( n );
+    }
+    else
+    {
+      (void)n;
+      return true;
+    }
+  }
+
+  uint32_t gate_level( node const& n ) const
+  {
+    uint32_t level{ 0 };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto clevel = levels[f];
+      if ( ps.count_complements && ntk.is_complemented( f ) )
+      {
+        clevel++;
+      }
+      level = std::max( level, clevel );
+    } );
+
+    return level + cost_fn( ntk, n );
+  }
+
+  uint32_t gate_height( node const& n ) const
+  {
+    uint32_t height{ 0 };
+    if ( ps.count_complements && po_compl_refs[n] > 0u )
+    {
+      height = 1u;
+    }
+
+    const auto index = ntk.node_to_index( n );
+    std::for_each( fanout.begin( index ), fanout.end( index ), [&]( node const& fo ) {
+      const auto cost = cost_fn( ntk, fo );
+      ntk.foreach_fanin( fo, [&]( auto const& f ) {
+        if ( ntk.get_node( f ) == n )
+        {
+          height = std::max( height, heights[fo] + cost + ( ps.count_complements && ntk.is_complemented( f ) ? 1u : 0u ) );
+        }
+      } );
+    } );
+    return height;
+  }
+
+  void push_arrival( node const& n, uint32_t key )
+  {
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) || ( queued[n] & 1u ) )
+    {
+      return;
+    }
+    queued[n] |= 1u;
+    arrival_queue.push( key, n );
+  }
+
+  void push_required( node const& n )
+  {
+    if ( queued[n] & 2u )
+    {
+      return;
+    }
+    queued[n] |= 2u;
+    required_queue.push( levels[n], n );
+  }
+
+  void add_po_ref( signal const& f, int32_t delta )
+  {
+    const auto n = ntk.get_node( f );
+    po_refs[n] += delta;
+    if ( ntk.is_complemented( f ) )
+    {
+      po_compl_refs[n] += delta;
+    }
+    push_required( n );
+  }
+
+  /* levels change in the transitive fanout of recorded nodes */
+  void propagate_arrival()
+  {
+    while ( !arrival_queue.empty() )
+    {
+      const auto n = arrival_queue.pop_min();
+      queued[n] &= ~1u;
+      if ( !is_alive( n ) )
+      {
+        continue;
+      }
+
+      const auto level = gate_level( n );
+      if ( level == levels[n] )
+      {
+        continue;
+      }
+      levels[n] = level;
+
+      /* fanouts are updated again if they are visited too early */
+      const auto index = ntk.node_to_index( n );
+      std::for_each( fanout.begin( index ), fanout.end( index ), [&]( node const& fo ) {
+        push_arrival( fo, std::max( levels[fo], level ) );
+      } );
+    }
+  }
+
+  /* heights change in the transitive fanin of recorded nodes */
+  void propagate_required()
+  {
+    while ( !required_queue.empty() )
+    {
+      const auto n = required_queue.pop_max();
+      queued[n] &= ~2u;
+      if ( !is_alive( n ) )
+      {
+        continue;
+      }
+
+      const auto height = gate_height( n );
+      if ( height == heights[n] )
+      {
+        continue;
+      }
+      heights[n] = height;
+
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        push_required( ntk.get_node( f ) );
+      } );
+    }
+  }
+
+  uint32_t compute_depth() const
+  {
+    uint32_t depth{ 0 };
+    ntk.foreach_po( [&]( auto const& f ) {
+      depth = std::max( depth, levels[f] + ( ps.count_complements && ntk.is_complemented( f ) ? 1u : 0u ) );
+    } );
+    return depth;
+  }
+
+  void on_add( node const& n )
+  {
+    resize();
+    levels[n] = gate_level( n );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+      push_required( ntk.get_node( f ) );
+    } );
+
+    /* fanins may be waiting for an update */
+    if ( !arrival_queue.empty() )
+    {
+      push_arrival( n, levels[n] );
+    }
+  }
+
+  void on_modified( node const& n, std::vector<signal> const& previous )
+  {
+    resize();
+    for ( auto const& f : previous )
+    {
+      fanout.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+      push_required( ntk.get_node( f ) );
+    }
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+      push_required( ntk.get_node( f ) );
+    } );
+    push_arrival( n, levels[n] );
+  }
+
+  void on_delete( node const& n )
+  {
+    resize();
+    fanout.clear( ntk.node_to_index( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+      push_required( ntk.get_node( f ) );
+    } );
+  }
+
+private:
+  Ntk ntk;
+  depth_view_params ps;
+  NodeCostFn cost_fn;
+
+  node_map<uint32_t, Ntk> levels;
+  node_map<uint32_t, Ntk> heights;
+  node_map<uint8_t, Ntk> queued;
+  node_map<uint32_t, Ntk> po_refs;
+  node_map<uint32_t, Ntk> po_compl_refs;
+  std::vector<signal> po_signals;
+  fanout_index<node> fanout;
+  bucket_queue<node> arrival_queue;
+  bucket_queue<node> required_queue;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+} // namespace detail
+
 /*! \brief Implements `depth` and `level` methods for networks.
  *
  * This view computes the level of each node and also the depth of
@@ -68,6 +395,19 @@ struct depth_view_params
  * recalculated (due to efficiency reasons).  In order to recalculate levels,
  * depth, and critical paths, one can call `update_levels` instead.
  *
+ * If `incremental` is set in the parameters, the view also computes the
+ * required level of each node, i.e., the latest level at which the node
+ * can be computed without increasing the depth, and the slack between
+ * required level and level.  Modified and deleted nodes, as well as
+ * replaced POs, are recorded when they happen.  On `update_levels`, level
+ * changes are propagated to the transitive fanout and required level
+ * changes to the transitive fanin of the recorded nodes, in order of their
+ * levels, using bucket queues.  Unaffected nodes are not visited.  In
+ * this mode, a node is on a critical path if its slack is zero, and
+ * levels are also computed for dangling nodes.  Levels set with
+ * `set_level` are overwritten by the next `update_levels` if the node is
+ * affected.
+ *
  * **Required network functions:**
  * - `size`
  * - `get_node`
@@ -90,6 +430,11 @@ struct depth_view_params
 
       // print depth
       std::cout << "Depth: " << aig_depth.depth() << "\n";
+
+      // maintain levels and required levels incrementally
+      depth_view_params ps;
+      ps.incremental = true;
+      depth_view aig_timing{aig, unit_cost<aig_network>(), ps};
    \endverbatim
  */
 template<class Ntk, class NodeCostFn = unit_cost<Ntk>, bool has_depth_interface = has_depth_v<Ntk>&& has_level_v<Ntk>&& has_update_levels_v<Ntk>>
@@ -127,6 +472,11 @@ public:
     static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
+    if ( _ps.incremental )
+    {
+      update_levels();
+    }
+
     add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
   }
 
@@ -153,7 +503,7 @@ public:
 
   /*! \brief Copy constructor. */
   explicit depth_view( depth_view<Ntk, NodeCostFn, false> const& other )
-      : Ntk( other ), _ps( other._ps ), _levels( other._levels ), _crit_path( other._crit_path ), _depth( other._depth ), _cost_fn( other._cost_fn )
+      : Ntk( other ), _ps( other._ps ), _levels( other._levels ), _crit_path( other._crit_path ), _depth( other._depth ), _cost_fn( other._cost_fn ), _timing( other._timing )
   {
     add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
   }
@@ -173,6 +523,7 @@ public:
     _crit_path = other._crit_path;
     _depth = other._depth;
     _cost_fn = other._cost_fn;
+    _timing = other._timing;
 
     /* register new event in the other network */
     add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
@@ -197,9 +548,35 @@ public:
 
   bool is_on_critical_path( node const& n ) const
   {
+    if ( _timing )
+    {
+      return slack( n ) == 0u && _timing->is_used( n );
+    }
     return _crit_path[n];
   }
 
+  /*! \brief Returns the required level of a node.
+   *
+   * This is the largest level of the node that does not increase the
+   * depth of the network.  Only available if `incremental` is set.
+   */
+  uint32_t required_level( node const& n ) const
+  {
+    assert( _timing );
+    const auto height = _timing->height( n );
+    return height < _depth ? _depth - height : 0u;
+  }
+
+  /*! \brief Returns the difference between required level and level.
+   *
+   * Only available if `incremental` is set.
+   */
+  uint32_t slack( node const& n ) const
+  {
+    const auto required = required_level( n );
+    return _levels[n] < required ? required - _levels[n] : 0u;
+  }
+
   void set_level( node const& n, uint32_t level )
   {
     _levels[n] = level;
@@ -212,11 +589,27 @@ public:
 
   void update_levels()
   {
+    if ( _timing )
+    {
+      _depth = _timing->update();
+      return;
+    }
+
     _levels.reset( 0 );
     _crit_path.reset( false );
 
     this->incr_trav_id();
     compute_levels();
+
+    if ( _ps.incremental )
+    {
+      /* dangling nodes may be used later */
+      this->foreach_gate( [&]( auto const& n ) {
+        compute_levels( n );
+      } );
+      _timing = std::make_shared<detail::depth_view_timing<Ntk, NodeCostFn>>( *this, _levels, _cost_fn, _ps );
+      _depth = _timing->compute();
+    }
   }
 
   void resize_levels()
@@ -326,6 +719,7 @@ private:
   node_map<uint32_t, Ntk> _crit_path;
   uint32_t _depth{};
   NodeCostFn _cost_fn;
+  std::shared_ptr<detail::depth_view_timing<Ntk, NodeCostFn>> _timing;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
 };
@@ -336,4 +730,4 @@ depth_view( T const& ) -> depth_view<T>;
 template<class T, class NodeCostFn = unit_cost<T>>
 depth_view( T const&, NodeCostFn const&, depth_view_params const& ) -> depth_view<T, NodeCostFn>;
 
-} // namespace mockturtle
\ No newline at end of file
+} // namespace mockturtle
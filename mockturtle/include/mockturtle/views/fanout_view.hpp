@@ -37,11 +37,12 @@
 #include "../networks/detail/foreach.hpp"
 #include "../networks/events.hpp"
 #include "../traits.hpp"
-#include "../utils/node_map.hpp"
+#include "../utils/fanout_index.hpp"
 #include "immutable_view.hpp"
 
 #include <cstdint>
 #include <stack>
+#include <type_traits>
 #include <vector>
 
 namespace mockturtle
@@ -54,6 +55,72 @@ struct fanout_view_params
   bool update_on_delete{ true };
 };
 
+/*! \brief Static listener that keeps the fanouts of all nodes.
+ *
+ * A network instantiated with this listener, e.g.,
+ * `basic_aig_network<aig_storage, fanout_listener<>>`, updates the fanout
+ * lists when nodes are added, modified, or deleted without calling any
+ * run-time events.  A `fanout_view` on top of such a network uses the
+ * fanouts of the listener instead of computing its own.  Other views
+ * (e.g., `depth_view`) still register run-time events.
+ *
+ * The listener can be combined with other static listeners using
+ * `listeners`.  It does not support concurrent creation of nodes (see
+ * `concurrent_storage`).
+ */
+template<typename Node = uint64_t>
+struct fanout_listener
+{
+  template<class Ntk>
+  void on_add( Ntk const& ntk, node<Ntk> const& n )
+  {
+    fanouts.resize( ntk.size() );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanouts.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+  }
+
+  template<class Ntk, class Children>
+  void on_modified( Ntk const& ntk, node<Ntk> const& n, Children const& previous_children )
+  {
+    for ( auto const& f : previous_children )
+    {
+      fanouts.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+    }
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanouts.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+  }
+
+  template<class Ntk>
+  void on_delete( Ntk const& ntk, node<Ntk> const& n )
+  {
+    fanouts.clear( ntk.node_to_index( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanouts.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+  }
+
+  /*! \brief Fanouts of all nodes that have been a fanin of some gate. */
+  fanout_index<Node> fanouts;
+};
+
+namespace detail
+{
+
+template<class Ntk, class = void>
+struct has_fanout_listener : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_fanout_listener<Ntk, std::void_t<decltype( std::declval<Ntk const&>().events().listener )>>
+    : std::is_base_of<fanout_listener<node<Ntk>>, std::decay_t<decltype( std::declval<Ntk const&>().events().listener )>>
+{
+};
+
+} // namespace detail
+
 /*! \brief Implements `foreach_fanout` methods for networks.
  *
  * This view computes the fanout of each node of the network.
@@ -61,6 +128,12 @@ struct fanout_view_params
  * fanout are computed at construction and can be recomputed by
  * calling the `update_fanout` method.
  *
+ * The fanouts of all nodes are kept in one array in compressed sparse row
+ * format (see `fanout_index`), which is updated through network events.
+ * If the network has a `fanout_listener` as static listener, the view
+ * uses its fanouts, does not register any events, and ignores the
+ * `update_on_*` parameters.
+ *
  * **Required network functions:**
  * - `foreach_node`
  * - `foreach_fanin`
@@ -90,25 +163,31 @@ public:
   using signal = typename Ntk::signal;
 
   explicit fanout_view( fanout_view_params const& ps = {} )
-      : Ntk(), _fanout( *this ), _ps( ps )
+      : Ntk(), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    update_fanout();
+    if constexpr ( !use_listener )
+    {
+      update_fanout();
+    }
 
     register_events();
   }
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
-      : Ntk( ntk ), _fanout( ntk ), _ps( ps )
+      : Ntk( ntk ), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    update_fanout();
+    if constexpr ( !use_listener )
+    {
+      update_fanout();
+    }
 
     register_events();
   }
@@ -146,7 +225,12 @@ public:
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+    const auto index = this->node_to_index( n );
+    auto const& fanouts = fanout_lists();
+    if ( index < fanouts.num_nodes() )
+    {
+      detail::foreach_element( fanouts.begin( index ), fanouts.end( index ), fn );
+    }
   }
 
   void update_fanout()
@@ -156,7 +240,9 @@ public:
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    const auto index = this->node_to_index( n );
+    auto const& fanouts = fanout_lists();
+    return index < fanouts.num_nodes() ? fanouts.to_vector( index ) : std::vector<node>{};
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -186,7 +272,7 @@ public:
       if ( skip )
         continue;
 
-      const auto parents = _fanout[_old];
+      const auto parents = fanout( _old );
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -208,14 +294,45 @@ public:
   }
 
 private:
+  static constexpr bool use_listener = detail::has_fanout_listener<Ntk>::value;
+
+  fanout_index<node>& fanout_lists()
+  {
+    if constexpr ( use_listener )
+    {
+      return static_cast<fanout_listener<node>&>( Ntk::events().listener ).fanouts;
+    }
+    else
+    {
+      return _fanout;
+    }
+  }
+
+  fanout_index<node> const& fanout_lists() const
+  {
+    if constexpr ( use_listener )
+    {
+      return static_cast<fanout_listener<node> const&>( Ntk::events().listener ).fanouts;
+    }
+    else
+    {
+      return _fanout;
+    }
+  }
+
   void register_events()
   {
+    if constexpr ( use_listener )
+    {
+      return;
+    }
+
     if ( _ps.update_on_add )
     {
       add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
-        _fanout.resize();
+        _fanout.resize( this->size() );
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          _fanout.push_back( this->node_to_index( this->get_node( f ) ), n );
         } );
       } );
     }
@@ -223,13 +340,12 @@ private:
     if ( _ps.update_on_modified )
     {
       modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
-        (void)previous;
         for ( auto const& f : previous )
         {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          _fanout.erase( this->node_to_index( this->get_node( f ) ), n );
         }
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          _fanout.push_back( this->node_to_index( this->get_node( f ) ), n );
         } );
       } );
     }
@@ -237,9 +353,9 @@ private:
     if ( _ps.update_on_delete )
     {
       delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
-        _fanout[n].clear();
+        _fanout.clear( this->node_to_index( n ) );
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          _fanout.erase( this->node_to_index( this->get_node( f ) ), n );
         } );
       } );
     }
@@ -265,20 +381,16 @@ private:
 
   void compute_fanout()
   {
-    _fanout.reset();
-
-    this->foreach_gate( [&]( auto const& n ) {
-      this->foreach_fanin( n, [&]( auto const& c ) {
-        auto& fanout = _fanout[c];
-        if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-        {
-          fanout.push_back( n );
-        }
+    fanout_lists().build( this->size(), [&]( auto&& add ) {
+      this->foreach_gate( [&]( auto const& n ) {
+        this->foreach_fanin( n, [&]( auto const& c ) {
+          add( this->node_to_index( this->get_node( c ) ), n );
+        } );
       } );
     } );
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  fanout_index<node> _fanout;
   fanout_view_params _ps;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
@@ -0,0 +1,522 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file incremental_simulation_view.hpp
+  \brief Keeps simulation values up to date with network edits
+*/
+
+#pragma once
+
+#include "../algorithms/simulation.hpp"
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/fanout_index.hpp"
+#include "../utils/node_map.hpp"
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for incremental_simulation_view. */
+struct incremental_simulation_stats
+{
+  /*! \brief Number of nodes that were simulated for all patterns. */
+  uint64_t num_simulated{ 0u };
+
+  /*! \brief Number of nodes that were simulated for appended patterns only. */
+  uint64_t num_extended{ 0u };
+
+  /*! \brief Number of nodes that were marked dirty by network edits. */
+  uint64_t num_invalidated{ 0u };
+};
+
+namespace detail
+{
+
+/* Simulation values, dirty flags, and fanouts.  The state is shared by all
+ * copies of an incremental_simulation_view and registers its own events,
+ * such that each network event is recorded once. */
+template<class Ntk>
+class incremental_simulation_state
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  incremental_simulation_state( Ntk const& ntk, partial_simulator const& sim )
+      : ntk( ntk ), sim( sim ), values( this->ntk ), dirty( this->ntk, 1u ), pi_indices( this->ntk, UINT32_MAX )
+  {
+    this->ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      assert( i < sim.get_patterns().size() && "simulator must have patterns for all PIs" );
+      pi_indices[n] = i;
+    } );
+
+    fanout.build( this->ntk.size(), [&]( auto&& add ) {
+      this->ntk.foreach_gate( [&]( auto const& n ) {
+        this->ntk.foreach_fanin( n, [&]( auto const& f ) {
+          add( this->ntk.node_to_index( this->ntk.get_node( f ) ), n );
+        } );
+      } );
+    } );
+
+    add_event = this->ntk.events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    modified_event = this->ntk.events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    delete_event = this->ntk.events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+  incremental_simulation_state( incremental_simulation_state const& ) = delete;
+  incremental_simulation_state& operator=( incremental_simulation_state const& ) = delete;
+
+  ~incremental_simulation_state()
+  {
+    ntk.events().release_add_event( add_event );
+    ntk.events().release_modified_event( modified_event );
+    ntk.events().release_delete_event( delete_event );
+  }
+
+  kitty::partial_truth_table const& value( node const& n )
+  {
+    invalidate();
+    simulate( n );
+    return values[n];
+  }
+
+  void update()
+  {
+    invalidate();
+    ntk.foreach_node( [&]( auto const& n ) {
+      simulate( n );
+    } );
+  }
+
+  bool is_dirty( node const& n )
+  {
+    invalidate();
+    return !is_up_to_date( n );
+  }
+
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    sim.add_pattern( pattern );
+  }
+
+  void add_patterns( std::vector<kitty::partial_truth_table> const& patterns )
+  {
+    assert( patterns.size() == sim.get_patterns().size() );
+    if ( patterns.empty() || patterns[0].num_bits() == 0u )
+    {
+      return;
+    }
+
+    std::vector<kitty::partial_truth_table> extended = sim.get_patterns();
+    for ( auto i = 0u; i < extended.size(); ++i )
+    {
+      append_bits( extended[i], patterns[i] );
+    }
+    sim = partial_simulator( extended );
+  }
+
+  partial_simulator const& simulator() const
+  {
+    return sim.get();
+  }
+
+  incremental_simulation_stats const& stats() const
+  {
+    return st;
+  }
+
+  void set_level( simd_level level )
+  {
+    sim.set_level( level );
+  }
+
+private:
+  /* simd_simulator that can be reassigned from a partial_simulator */
+  struct simulator_holder : simd_simulator<>
+  {
+    using simd_simulator<>::simd_simulator;
+
+    simulator_holder& operator=( partial_simulator const& other )
+    {
+      static_cast<partial_simulator&>( *this ) = other;
+      return *this;
+    }
+
+    partial_simulator const& get() const
+    {
+      return *this;
+    }
+  };
+
+  static void append_bits( kitty::partial_truth_table& tt, kitty::partial_truth_table bits )
+  {
+    assert( bits.num_bits() == 0u || bits.num_blocks() > 0u );
+    bits.mask_bits();
+    const auto offset = tt.num_bits();
+    tt.resize( offset + bits.num_bits() );
+    for ( auto w = 0u; w < bits.num_blocks(); ++w )
+    {
+      const auto pos = offset + 64u * w;
+      tt._bits[pos / 64u] |= bits._bits[w] << ( pos % 64u );
+      if ( pos % 64u != 0u && pos / 64u + 1u < tt.num_blocks() )
+      {
+        tt._bits[pos / 64u + 1u] |= bits._bits[w] >> ( 64u - pos % 64u );
+      }
+    }
+  }
+
+  bool is_up_to_date( node const& n ) const
+  {
+    return ntk.node_to_index( n ) < values.size() && !dirty[n] && values[n].num_bits() == sim.num_bits();
+  }
+
+  /* marks the transitive fanout of all modified nodes as dirty */
+  void invalidate()
+  {
+    values.resize();
+    dirty.resize( 1u );
+
+    while ( !modified.empty() )
+    {
+      const auto n = modified.back();
+      modified.pop_back();
+      if ( ntk.is_dead( n ) )
+      {
+        continue;
+      }
+
+      /* the roots are already dirty, their fanouts may not be */
+      std::for_each( fanout.begin( ntk.node_to_index( n ) ), fanout.end( ntk.node_to_index( n ) ), [&]( auto const& p ) {
+        mark_dirty( p );
+      } );
+      while ( !stack.empty() )
+      {
+        const auto p = stack.back();
+        stack.pop_back();
+        std::for_each( fanout.begin( ntk.node_to_index( p ) ), fanout.end( ntk.node_to_index( p ) ), [&]( auto const& q ) {
+          mark_dirty( q );
+        } );
+      }
+    }
+  }
+
+  void mark_dirty( node const& n )
+  {
+    if ( !dirty[n] && !ntk.is_dead( n ) )
+    {
+      dirty[n] = 1u;
+      ++st.num_invalidated;
+      stack.push_back( n );
+    }
+  }
+
+  /* simulates the dirty nodes and appended patterns in the fan-in cone of `root` */
+  void simulate( node const& root )
+  {
+    if ( is_up_to_date( root ) )
+    {
+      return;
+    }
+
+    stack.push_back( root );
+    while ( !stack.empty() )
+    {
+      const auto n = stack.back();
+      if ( is_up_to_date( n ) )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      bool ready = true;
+      if ( !ntk.is_constant( n ) && !ntk.is_ci( n ) )
+      {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          if ( !is_up_to_date( ntk.get_node( f ) ) )
+          {
+            stack.push_back( ntk.get_node( f ) );
+            ready = false;
+          }
+        } );
+      }
+
+      if ( ready )
+      {
+        stack.pop_back();
+        compute( n );
+      }
+    }
+  }
+
+  void compute( node const& n )
+  {
+    auto& result = values[n];
+    if ( ntk.is_constant( n ) )
+    {
+      ++st.num_simulated;
+      result = sim.compute_constant( ntk.constant_value( n ) );
+    }
+    else if ( ntk.is_ci( n ) )
+    {
+      ++st.num_simulated;
+      result = sim.compute_pi( pi_index( n ) );
+    }
+    else if ( simd_op_of( ntk, n ) != simd_op::none )
+    {
+      /* only the words of the appended patterns are simulated */
+      const uint64_t first_word = dirty[n] ? 0u : result.num_bits() / 64u;
+      ++( first_word == 0u ? st.num_simulated : st.num_extended );
+      result.resize( sim.num_bits() );
+      const auto words_of = [&]( auto const& f ) -> uint64_t const* {
+        return values[f]._bits.data();
+      };
+      simd_compute_gate( ntk, n, sim.kernel(), result._bits.data(), words_of, first_word, result.num_blocks() );
+      result.mask_bits();
+    }
+    else
+    {
+      ++st.num_simulated;
+      fanin_values.resize( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = values[ntk.get_node( f )];
+      } );
+      result = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+    dirty[n] = 0u;
+  }
+
+  /* the simulator has no patterns for PIs created after construction */
+  uint32_t pi_index( node const& n ) const
+  {
+    assert( ntk.node_to_index( n ) < pi_indices.size() && pi_indices[n] < sim.get_patterns().size() && "PI has no simulation patterns" );
+    return pi_indices[n];
+  }
+
+  void on_add( node const& n )
+  {
+    values.resize();
+    dirty.resize( 1u );
+    fanout.resize( ntk.size() );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+  }
+
+  void on_modified( node const& n, std::vector<signal> const& previous )
+  {
+    for ( auto const& f : previous )
+    {
+      fanout.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+    }
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.push_back( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+
+    values.resize();
+    dirty.resize( 1u );
+    if ( !dirty[n] )
+    {
+      ++st.num_invalidated;
+    }
+    dirty[n] = 1u;
+    modified.push_back( n );
+  }
+
+  void on_delete( node const& n )
+  {
+    fanout.clear( ntk.node_to_index( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanout.erase( ntk.node_to_index( ntk.get_node( f ) ), n );
+    } );
+
+    values.resize();
+    dirty.resize( 1u );
+    dirty[n] = 1u;
+    values[n] = kitty::partial_truth_table();
+  }
+
+private:
+  Ntk ntk;
+  simulator_holder sim;
+  incremental_simulation_stats st;
+
+  node_map<kitty::partial_truth_table, Ntk> values;
+  node_map<uint8_t, Ntk> dirty;
+  node_map<uint32_t, Ntk> pi_indices;
+  fanout_index<node> fanout;
+  std::vector<node> modified;
+  std::vector<node> stack;
+  std::vector<kitty::partial_truth_table> fanin_values;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+} // namespace detail
+
+/*! \brief Keeps simulation values up to date with network edits.
+ *
+ * This view stores one simulation value (a `kitty::partial_truth_table`)
+ * per node and subscribes to the events of the network.  When the fan-ins
+ * of a node are modified (e.g., by `substitute_node`), the node and its
+ * transitive fanout are marked dirty; new nodes are dirty as well.  Dirty
+ * nodes are re-simulated on demand, i.e., when their value is requested
+ * with `value` or when `update` is called, and nodes that are not dirty
+ * keep their values.
+ *
+ * Patterns appended with `add_pattern` or `add_patterns` are simulated on
+ * demand as well, and for AND, XOR, majority, and if-then-else gates only
+ * the words that contain new patterns are computed, using the kernels of
+ * `simd_simulator`.  Other gates are simulated with the `compute` method of
+ * the network.
+ *
+ * The simulator must have patterns for all PIs of the network, and no PIs
+ * may be created while the view is in use, since the simulator has no
+ * patterns for them.
+ *
+ * The view keeps its own fanouts, hence it does not require a
+ * `fanout_view`.  Copies of the view share their state.  References
+ * returned by `value` are valid until the next call to a method of the view
+ * or until the network is modified.
+ *
+ * **Required network functions:**
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `is_constant`
+ * - `is_ci`
+ * - `foreach_pi`
+ * - `is_dead`
+ * - `compute<kitty::partial_truth_table>`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      partial_simulator sim( aig.num_pis(), 256 );
+      incremental_simulation_view sim_aig{ aig, sim };
+
+      const auto tt = sim_aig.value( n );
+      sim_aig.substitute_node( n, g );  // marks the fanouts of `n` dirty
+      sim_aig.add_pattern( cex );       // only new words are simulated
+      sim_aig.update();
+   \endverbatim
+ */
+template<class Ntk>
+class incremental_simulation_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit incremental_simulation_view( Ntk const& ntk, partial_simulator const& sim )
+      : Ntk( ntk ), _state( std::make_shared<detail::incremental_simulation_state<Ntk>>( ntk, sim ) )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+  }
+
+  /*! \brief Simulation value of `n`, re-simulates the dirty nodes in its fan-in cone. */
+  kitty::partial_truth_table const& value( node const& n ) const
+  {
+    return _state->value( n );
+  }
+
+  /*! \brief Re-simulates all dirty nodes. */
+  void update() const
+  {
+    _state->update();
+  }
+
+  /*! \brief Whether `n` needs to be re-simulated. */
+  bool is_dirty( node const& n ) const
+  {
+    return _state->is_dirty( n );
+  }
+
+  /*! \brief Appends one pattern (one value per PI). */
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    _state->add_pattern( pattern );
+  }
+
+  /*! \brief Appends several patterns (one truth table per PI). */
+  void add_patterns( std::vector<kitty::partial_truth_table> const& patterns )
+  {
+    _state->add_patterns( patterns );
+  }
+
+  /*! \brief Number of simulated patterns. */
+  uint32_t num_patterns() const
+  {
+    return _state->simulator().num_bits();
+  }
+
+  /*! \brief Simulator with all patterns. */
+  partial_simulator const& simulator() const
+  {
+    return _state->simulator();
+  }
+
+  /*! \brief Restricts the instruction set of the simulation kernels. */
+  void set_simd_level( simd_level level )
+  {
+    _state->set_level( level );
+  }
+
+  /*! \brief Statistics on simulated and invalidated nodes. */
+  incremental_simulation_stats const& simulation_stats() const
+  {
+    return _state->stats();
+  }
+
+private:
+  std::shared_ptr<detail::incremental_simulation_state<Ntk>> _state;
+};
+
+template<class T>
+incremental_simulation_view( T const&, partial_simulator const& ) -> incremental_simulation_view<T>;
+
+} // namespace mockturtle
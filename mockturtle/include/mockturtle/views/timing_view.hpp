@@ -0,0 +1,633 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file timing_view.hpp
+  \brief Incremental static timing analysis of mapped networks
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/bucket_queue.hpp"
+#include "../utils/fanout_index.hpp"
+#include "../utils/node_map.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+struct timing_view_params
+{
+  /*! \brief Use the load-dependent delay model of the library.
+   *
+   * If true, the delay of a pin is its block delay plus its fanout delay
+   * times the load of the gate, i.e., the sum of the input loads of the
+   * fanout pins.  Otherwise, only the block delays are used, as in the
+   * mapper and in `binding_view::compute_worst_delay`.
+   */
+  bool load_dependent{ false };
+
+  /*! \brief Required time at the POs (the worst arrival time if not positive). */
+  double required_time{ 0.0 };
+};
+
+/*! \brief Arrival time, required time, and slack of a node. */
+struct node_timing
+{
+  double arrival{ 0.0 };
+  double required{ 0.0 };
+  double slack{ 0.0 };
+};
+
+/*! \brief Implements incremental static timing analysis on mapped networks.
+ *
+ * This view computes the arrival time of each node, i.e., the largest
+ * delay from the PIs to the node, and the largest delay from the node to
+ * the POs, using the pin-to-pin delays of the gates bound to the nodes
+ * of a `binding_view`.  The required time of a node is the required time
+ * at the POs minus its delay to the POs, and its slack is the difference
+ * between required and arrival time.  Nodes without binding have no
+ * delay.
+ *
+ * Binding changes made through `add_binding`, `add_binding_with_check`,
+ * and `remove_binding` of the view, e.g., when resizing or rebinding a
+ * gate, are recorded when they happen.  On `update_timing`, arrival time
+ * changes are propagated to the transitive fanout and delay changes to
+ * the POs to the transitive fanin of the recorded nodes, in order of
+ * their levels, using bucket queues, such that only the affected cones
+ * are visited.  Several changes can be recorded before a single update.
+ * Structural changes of the network require a call to `compute_timing`.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `foreach_po`
+ * - `visited`
+ * - `set_visited`
+ * - `incr_trav_id`
+ * - `is_constant`
+ * - `is_pi`
+ * - `has_binding`
+ * - `get_binding`
+ * - `add_binding`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      // map a network
+      binding_view<klut_network> res = map( aig, tech_lib );
+
+      // analyze the timing of the mapped network
+      timing_view sta{res};
+      std::cout << "Worst delay: " << sta.worst_delay() << "\n";
+      for ( auto const& n : sta.critical_path() )
+      {
+        std::cout << n << " " << sta.slack( n ) << "\n";
+      }
+
+      // resize a gate and update the timing in the affected cones
+      sta.add_binding( n, larger_gate_id );
+      sta.update_timing();
+   \endverbatim
+ */
+template<class Ntk>
+class timing_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Standard constructor.
+   *
+   * \param ntk Mapped network
+   */
+  explicit timing_view( Ntk const& ntk, timing_view_params const& ps = {} )
+      : Ntk( ntk ), _ps( ps ), _levels( *this ), _arrival( *this ), _tail( *this ), _load( *this ), _queued( *this ), _po_refs( *this )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+    static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+    static_assert( has_incr_trav_id_v<Ntk>, "Ntk does not implement the incr_trav_id method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+
+    compute_timing();
+  }
+
+  /*! \brief Copy constructor. */
+  timing_view( timing_view<Ntk> const& other )
+      : Ntk( other ), _ps( other._ps ), _levels( *this ), _arrival( *this ), _tail( *this ), _load( *this ), _queued( *this ), _po_refs( *this )
+  {
+    compute_timing();
+  }
+
+  timing_view<Ntk>& operator=( timing_view<Ntk> const& other ) = delete;
+
+  /*! \brief Binds a node to a gate and records the change. */
+  void add_binding( node const& n, uint32_t gate_id )
+  {
+    Ntk::add_binding( n, gate_id );
+    record_pin_changes( n );
+  }
+
+  /*! \brief Binds a node to a gate with the same function and records the change. */
+  bool add_binding_with_check( node const& n, uint32_t gate_id )
+  {
+    if ( !Ntk::add_binding_with_check( n, gate_id ) )
+    {
+      return false;
+    }
+    record_pin_changes( n );
+    return true;
+  }
+
+  /*! \brief Removes the binding of a node and records the change. */
+  void remove_binding( node const& n )
+  {
+    Ntk::remove_binding( n );
+    record_pin_changes( n );
+  }
+
+  /*! \brief Computes the timing of all nodes. */
+  void compute_timing()
+  {
+    _levels.resize();
+    _arrival.resize();
+    _tail.resize();
+    _load.resize();
+    _queued.resize();
+    _po_refs.resize();
+
+    _queued.reset( 0 );
+    _po_refs.reset( 0 );
+    _load.reset( 0.0 );
+    _arrival_queue.clear();
+    _required_queue.clear();
+    _loads_changed.clear();
+
+    _fanout.build( this->size(), [&]( auto&& add ) {
+      this->foreach_gate( [&]( auto const& n ) {
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          add( this->node_to_index( this->get_node( f ) ), n );
+        } );
+      } );
+    } );
+
+    this->foreach_po( [&]( auto const& f ) {
+      ++_po_refs[this->get_node( f )];
+    } );
+
+    if ( _ps.load_dependent )
+    {
+      this->foreach_node( [&]( auto const& n ) {
+        _load[n] = gate_load( n );
+      } );
+    }
+
+    /* dangling nodes are included, as they may be used later */
+    const auto topo_order = topological_order();
+    for ( auto const& n : topo_order )
+    {
+      _levels[n] = gate_level( n );
+      _arrival[n] = gate_arrival( n );
+    }
+    for ( auto it = topo_order.rbegin(); it != topo_order.rend(); ++it )
+    {
+      _tail[*it] = gate_tail( *it );
+    }
+
+    compute_worst_delay();
+  }
+
+  /*! \brief Propagates all recorded binding changes. */
+  void update_timing()
+  {
+    for ( auto const& n : _loads_changed )
+    {
+      _queued[n] &= ~4u;
+      const auto load = gate_load( n );
+      if ( load == _load[n] )
+      {
+        continue;
+      }
+
+      /* the pin delays of the gate depend on its load */
+      _load[n] = load;
+      push_arrival( n );
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        push_required( this->get_node( f ) );
+      } );
+    }
+    _loads_changed.clear();
+
+    propagate_arrival();
+    propagate_required();
+  }
+
+  /*! \brief Returns the arrival time of a node. */
+  double arrival( node const& n ) const
+  {
+    assert( is_updated() );
+    return _arrival[n];
+  }
+
+  /*! \brief Returns the required time of a node.
+   *
+   * This is the latest arrival time of the node that does not violate
+   * the required time at the POs.
+   */
+  double required( node const& n ) const
+  {
+    assert( is_updated() );
+    return required_time() - _tail[n];
+  }
+
+  /*! \brief Returns the difference between required and arrival time. */
+  double slack( node const& n ) const
+  {
+    return required( n ) - arrival( n );
+  }
+
+  /*! \brief Returns arrival time, required time, and slack of several nodes. */
+  std::vector<node_timing> timing( std::vector<node> const& nodes ) const
+  {
+    assert( is_updated() );
+    const auto required_po = required_time();
+
+    std::vector<node_timing> result;
+    result.reserve( nodes.size() );
+    for ( auto const& n : nodes )
+    {
+      const auto required = required_po - _tail[n];
+      result.push_back( { _arrival[n], required, required - _arrival[n] } );
+    }
+    return result;
+  }
+
+  /*! \brief Returns the largest arrival time of the POs. */
+  double worst_delay() const
+  {
+    assert( is_updated() );
+    return _worst_delay;
+  }
+
+  /*! \brief Returns the required time at the POs. */
+  double required_time() const
+  {
+    return _ps.required_time > 0.0 ? _ps.required_time : worst_delay();
+  }
+
+  /*! \brief Returns the delay from the fanin at position `pin` to the node. */
+  double pin_delay( node const& n, uint32_t pin ) const
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) || !this->has_binding( n ) )
+    {
+      return 0.0;
+    }
+
+    auto const& p = this->get_binding( n ).pins[pin];
+    if ( !_ps.load_dependent )
+    {
+      return std::max( p.rise_block_delay, p.fall_block_delay );
+    }
+    return std::max( p.rise_block_delay + p.rise_fanout_delay * _load[n], p.fall_block_delay + p.fall_fanout_delay * _load[n] );
+  }
+
+  /*! \brief Returns the sum of the input loads of the fanout pins of a node. */
+  double load( node const& n ) const
+  {
+    return _ps.load_dependent ? _load[n] : gate_load( n );
+  }
+
+  /*! \brief Returns a path with the worst delay.
+   *
+   * The nodes are ordered from a PI or constant to the node driving the
+   * PO with the largest arrival time.  The path is empty if the network
+   * has no POs.
+   */
+  std::vector<node> critical_path() const
+  {
+    assert( is_updated() );
+
+    std::vector<node> path;
+    std::optional<node> root;
+    this->foreach_po( [&]( auto const& f ) {
+      const auto n = this->get_node( f );
+      if ( !root || _arrival[n] > _arrival[*root] )
+      {
+        root = n;
+      }
+    } );
+    if ( !root )
+    {
+      return path;
+    }
+
+    auto n = *root;
+    path.push_back( n );
+    while ( !this->is_constant( n ) && !this->is_pi( n ) && this->fanin_size( n ) > 0u )
+    {
+      /* follow the fanin that determines the arrival time */
+      node next{};
+      double worst = -1.0;
+      this->foreach_fanin( n, [&]( auto const& f, auto i ) {
+        const auto arrival = _arrival[this->get_node( f )] + pin_delay( n, i );
+        if ( arrival > worst )
+        {
+          worst = arrival;
+          next = this->get_node( f );
+        }
+      } );
+      n = next;
+      path.push_back( n );
+    }
+
+    std::reverse( path.begin(), path.end() );
+    return path;
+  }
+
+private:
+  std::vector<node> topological_order()
+  {
+    std::vector<node> order;
+    order.reserve( this->size() );
+
+    /* iterative DFS, nodes are added to the order after their fanins */
+    std::vector<std::pair<node, bool>> stack;
+    this->incr_trav_id();
+    this->foreach_node( [&]( auto const& root ) {
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        const auto [n, expanded] = stack.back();
+        stack.pop_back();
+        if ( expanded )
+        {
+          order.push_back( n );
+          continue;
+        }
+        if ( this->visited( n ) == this->trav_id() )
+        {
+          continue;
+        }
+        this->set_visited( n, this->trav_id() );
+        stack.emplace_back( n, true );
+
+        if ( this->is_constant( n ) || this->is_pi( n ) )
+        {
+          continue;
+        }
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          if ( this->visited( this->get_node( f ) ) != this->trav_id() )
+          {
+            stack.emplace_back( this->get_node( f ), false );
+          }
+        } );
+      }
+    } );
+
+    return order;
+  }
+
+  bool is_updated() const
+  {
+    return _arrival_queue.empty() && _required_queue.empty() && _loads_changed.empty();
+  }
+
+  uint32_t gate_level( node const& n ) const
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) )
+    {
+      return 0u;
+    }
+
+    uint32_t level{ 0 };
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, _levels[this->get_node( f )] );
+    } );
+    return level + 1u;
+  }
+
+  double gate_arrival( node const& n ) const
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) )
+    {
+      return 0.0;
+    }
+
+    double arrival{ 0.0 };
+    this->foreach_fanin( n, [&]( auto const& f, auto i ) {
+      arrival = std::max( arrival, _arrival[this->get_node( f )] + pin_delay( n, i ) );
+    } );
+    return arrival;
+  }
+
+  double gate_tail( node const& n ) const
+  {
+    double tail{ 0.0 };
+    const auto index = this->node_to_index( n );
+    std::for_each( _fanout.begin( index ), _fanout.end( index ), [&]( node const& fo ) {
+      this->foreach_fanin( fo, [&]( auto const& f, auto i ) {
+        if ( this->get_node( f ) == n )
+        {
+          tail = std::max( tail, _tail[fo] + pin_delay( fo, i ) );
+        }
+      } );
+    } );
+    return tail;
+  }
+
+  double gate_load( node const& n ) const
+  {
+    double load{ 0.0 };
+    const auto index = this->node_to_index( n );
+    std::for_each( _fanout.begin( index ), _fanout.end( index ), [&]( node const& fo ) {
+      if ( !this->has_binding( fo ) )
+      {
+        return;
+      }
+      auto const& g = this->get_binding( fo );
+      this->foreach_fanin( fo, [&]( auto const& f, auto i ) {
+        if ( this->get_node( f ) == n )
+        {
+          load += g.pins[i].input_load;
+        }
+      } );
+    } );
+    return load;
+  }
+
+  /* the pin delays of the node changed: its arrival time and the delays
+     to the POs of its fanins, and the loads of its fanins, are affected */
+  void record_pin_changes( node const& n )
+  {
+    push_arrival( n );
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      const auto fn = this->get_node( f );
+      push_required( fn );
+      if ( _ps.load_dependent && !( _queued[fn] & 4u ) )
+      {
+        _queued[fn] |= 4u;
+        _loads_changed.push_back( fn );
+      }
+    } );
+  }
+
+  void push_arrival( node const& n )
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) || ( _queued[n] & 1u ) )
+    {
+      return;
+    }
+    _queued[n] |= 1u;
+    _arrival_queue.push( _levels[n], n );
+  }
+
+  void push_required( node const& n )
+  {
+    if ( _queued[n] & 2u )
+    {
+      return;
+    }
+    _queued[n] |= 2u;
+    _required_queue.push( _levels[n], n );
+  }
+
+  /* arrival times change in the transitive fanout of recorded nodes */
+  void propagate_arrival()
+  {
+    bool worst_decreased = false;
+    while ( !_arrival_queue.empty() )
+    {
+      const auto n = _arrival_queue.pop_min();
+      _queued[n] &= ~1u;
+
+      const auto arrival = gate_arrival( n );
+      if ( arrival == _arrival[n] )
+      {
+        continue;
+      }
+
+      if ( _po_refs[n] > 0u )
+      {
+        if ( arrival > _worst_delay )
+        {
+          _worst_delay = arrival;
+        }
+        else if ( _arrival[n] == _worst_delay )
+        {
+          worst_decreased = true;
+        }
+      }
+      _arrival[n] = arrival;
+
+      const auto index = this->node_to_index( n );
+      std::for_each( _fanout.begin( index ), _fanout.end( index ), [&]( node const& fo ) {
+        push_arrival( fo );
+      } );
+    }
+
+    /* another PO may have the worst arrival time */
+    if ( worst_decreased )
+    {
+      compute_worst_delay();
+    }
+  }
+
+  /* delays to the POs change in the transitive fanin of recorded nodes */
+  void propagate_required()
+  {
+    while ( !_required_queue.empty() )
+    {
+      const auto n = _required_queue.pop_max();
+      _queued[n] &= ~2u;
+
+      const auto tail = gate_tail( n );
+      if ( tail == _tail[n] )
+      {
+        continue;
+      }
+      _tail[n] = tail;
+
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        push_required( this->get_node( f ) );
+      } );
+    }
+  }
+
+  void compute_worst_delay()
+  {
+    _worst_delay = 0.0;
+    this->foreach_po( [&]( auto const& f ) {
+      _worst_delay = std::max( _worst_delay, _arrival[this->get_node( f )] );
+    } );
+  }
+
+private:
+  timing_view_params _ps;
+
+  node_map<uint32_t, Ntk> _levels;
+  node_map<double, Ntk> _arrival;
+  node_map<double, Ntk> _tail; /* largest delay to the POs */
+  node_map<double, Ntk> _load;
+  node_map<uint8_t, Ntk> _queued;
+  node_map<uint32_t, Ntk> _po_refs;
+  double _worst_delay{ 0.0 };
+
+  fanout_index<node> _fanout;
+  bucket_queue<node> _arrival_queue;
+  bucket_queue<node> _required_queue;
+  std::vector<node> _loads_changed;
+};
+
+template<class T>
+timing_view( T const& ) -> timing_view<T>;
+
+template<class T>
+timing_view( T const&, timing_view_params const& ) -> timing_view<T>;
+
+} // namespace mockturtle
@@ -0,0 +1,162 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/activity_estimation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/read_patterns.hpp>
+#include <mockturtle/io/write_patterns.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+uint64_t reference_toggles( kitty::partial_truth_table const& tt )
+{
+  uint64_t count = 0u;
+  for ( auto b = 1u; b < tt.num_bits(); ++b )
+  {
+    count += kitty::get_bit( tt, b ) != kitty::get_bit( tt, b - 1 ) ? 1u : 0u;
+  }
+  return count;
+}
+
+template<class Ntk>
+void check_trace( Ntk const& ntk, uint32_t words_per_block )
+{
+  const partial_simulator sim( "patterns_activity.txt" );
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+
+  pattern_block_reader reader( "patterns_activity.txt", words_per_block );
+  activity_estimator est( ntk );
+  est.simulate_trace( reader );
+
+  CHECK( est.num_transitions() == sim.num_bits() - 1u );
+  CHECK( est.stats().num_patterns == sim.num_bits() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( est.toggles( n ) == reference_toggles( tts[n] ) );
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "count toggles in words", "[activity_estimation]" )
+{
+  std::vector<uint64_t> words{ UINT64_C( 0xaaaaaaaaaaaaaaaa ), UINT64_C( 0x1 ), UINT64_C( 0xf0 ) };
+  CHECK( detail::count_toggles( words.data(), 0u ) == 0u );
+  CHECK( detail::count_toggles( words.data(), 1u ) == 0u );
+  CHECK( detail::count_toggles( words.data(), 2u ) == 1u );
+  CHECK( detail::count_toggles( words.data(), 64u ) == 63u );
+  /* bit 63 is 1 and bit 64 is 1, bit 65 is 0 */
+  CHECK( detail::count_toggles( words.data(), 65u ) == 63u );
+  CHECK( detail::count_toggles( words.data(), 66u ) == 64u );
+  CHECK( detail::count_toggles( words.data(), 128u ) == 64u );
+  CHECK( detail::count_toggles( words.data(), 129u ) == 64u );
+  CHECK( detail::count_toggles( words.data(), 192u ) == 66u );
+}
+
+TEST_CASE( "toggles of traces", "[activity_estimation]" )
+{
+  auto aig = adder_network<aig_network>( 6u );
+  auto klut = adder_network<klut_network>( 6u );
+  aig.create_and( aig.po_at( 0u ), aig.make_signal( aig.pi_at( 6u ) ) ); /* dangling */
+  klut.create_and( klut.po_at( 0u ), klut.make_signal( klut.pi_at( 6u ) ) ); /* dangling */
+  write_patterns( partial_simulator( aig.num_pis(), 3000u ), "patterns_activity.txt" );
+
+  for ( auto words : { 1u, 3u, 64u } )
+  {
+    check_trace( aig, words );
+    check_trace( klut, words );
+  }
+
+  std::remove( "patterns_activity.txt" );
+}
+
+TEST_CASE( "switching activity of random patterns", "[activity_estimation]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto f = xag.create_and( a, b );
+  const auto g = xag.create_xor( f, !a );
+  xag.create_po( g );
+
+  activity_estimation_params ps;
+  ps.num_patterns = 1u << 16u;
+  activity_estimation_stats st;
+  const auto activity = estimate_switching_activity( xag, ps, &st );
+  CHECK( st.num_patterns == ps.num_patterns );
+  CHECK( st.num_blocks == ps.num_patterns / ( 64u * ps.words_per_block ) );
+  CHECK( activity.size() == xag.size() );
+  CHECK( activity[xag.node_to_index( xag.get_node( xag.get_constant( false ) ) )] == 0.0f );
+  CHECK( activity[xag.node_to_index( xag.get_node( a ) )] == Approx( 0.5 ).margin( 0.01 ) );
+  CHECK( activity[xag.node_to_index( xag.get_node( f ) )] == Approx( 0.375 ).margin( 0.01 ) );
+
+  /* signal probability 0.9 * 0.9 of the AND gate */
+  ps.input_probabilities = { 0.9, 0.9 };
+  const auto biased = estimate_switching_activity( xag, ps );
+  CHECK( biased[xag.node_to_index( xag.get_node( a ) )] == Approx( 2 * 0.9 * 0.1 ).margin( 0.01 ) );
+  CHECK( biased[xag.node_to_index( xag.get_node( f ) )] == Approx( 2 * 0.81 * 0.19 ).margin( 0.01 ) );
+
+  /* the activity does not depend on the number of threads */
+  ps.input_probabilities.clear();
+  ps.num_patterns = 10000u;
+  ps.words_per_block = 2u;
+  const auto single = estimate_switching_activity( xag, ps );
+  ps.num_threads = 3u;
+  CHECK( estimate_switching_activity( xag, ps ) == single );
+}
+
+TEST_CASE( "switching activity of a sequential network without patterns", "[activity_estimation]" )
+{
+  sequential<aig_network> aig;
+  const auto x = aig.create_pi();
+  const auto r = aig.create_ro();
+  aig.create_po( aig.create_and( x, r ) );
+  aig.create_ri( aig.create_xor( x, r ) );
+
+  activity_estimation_params ps;
+  ps.num_patterns = 0u;
+  activity_estimation_stats st;
+  const auto activity = estimate_switching_activity( aig, ps, &st );
+  CHECK( st.num_patterns == 0u );
+  CHECK( activity == std::vector<float>( aig.size(), 0.0f ) );
+}
+
+TEST_CASE( "toggles of random patterns match simulation", "[activity_estimation]" )
+{
+  auto aig = adder_network<aig_network>( 6u );
+  aig.create_and( aig.po_at( 0u ), aig.make_signal( aig.pi_at( 6u ) ) ); /* dangling */
+
+  /* one block is simulated by the estimator and the same random words are
+     simulated with simulate_nodes */
+  activity_estimation_params ps;
+  ps.words_per_block = 4u;
+  activity_estimator est( aig, ps );
+  est.simulate_random( 200u );
+
+  std::mt19937_64 rng( ps.seed );
+  std::vector<kitty::partial_truth_table> inputs( aig.num_pis(), kitty::partial_truth_table( 200u ) );
+  for ( auto& tt : inputs )
+  {
+    detail::random_words( detail::simd_words( tt ), tt.num_blocks(), 0.5, rng );
+    tt.mask_bits();
+  }
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( aig, partial_simulator( inputs ) );
+
+  CHECK( est.num_transitions() == 199u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( est.toggles( n ) == reference_toggles( tts[n] ) );
+  } );
+}
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* multiplier with complemented, PI, and constant outputs */
+template<class Ntk>
+Ntk test_network()
+{
+  auto ntk = multiplier_network<Ntk>( 6u );
+  const auto pi = [&]( uint32_t index ) { return ntk.make_signal( ntk.pi_at( index ) ); };
+  ntk.create_po( !ntk.create_xor( pi( 0u ), pi( 11u ) ) );
+  ntk.create_po( pi( 3u ) );
+  ntk.create_po( !pi( 7u ) );
+  ntk.create_po( ntk.get_constant( true ) );
+  return ntk;
+}
+
+template<class Ntk>
+void check_program( Ntk const& ntk )
+{
+  compiled_simulation_stats st;
+  auto program = compile_simulation( ntk, &st );
+  CHECK( program.num_pis() == ntk.num_pis() );
+  CHECK( program.num_pos() == ntk.num_pos() );
+  CHECK( st.num_instructions == program.instructions().size() );
+  CHECK( program.num_registers() < ntk.size() );
+
+  for ( auto num_bits : { 1u, 63u, 64u, 700u, 4099u } )
+  {
+    std::vector<kitty::partial_truth_table> inputs( ntk.num_pis(), kitty::partial_truth_table( num_bits ) );
+    for ( auto i = 0u; i < inputs.size(); ++i )
+    {
+      kitty::create_random( inputs[i], 17u * num_bits + i );
+    }
+    const auto expected = simulate<kitty::partial_truth_table>( ntk, partial_simulator( inputs ) );
+
+    CHECK( program.run( inputs ) == expected );
+
+    /* other instruction sets and reuse of the output storage */
+    std::vector<kitty::partial_truth_table> outputs;
+    program.set_level( simd_level::scalar );
+    program.run( inputs, outputs );
+    CHECK( outputs == expected );
+    program.set_level( simd_supported_level() );
+    program.run( inputs, outputs );
+    CHECK( outputs == expected );
+  }
+}
+
+} // namespace
+
+TEST_CASE( "compiled simulation of graph networks", "[compiled_simulation]" )
+{
+  check_program( test_network<aig_network>() );
+  check_program( test_network<xag_network>() );
+  check_program( test_network<mig_network>() );
+  check_program( test_network<xmg_network>() );
+}
+
+TEST_CASE( "compiled simulation of k-LUT networks", "[compiled_simulation]" )
+{
+  check_program( test_network<klut_network>() );
+
+  for ( auto k : { 3u, 4u, 6u } )
+  {
+    mapping_view<aig_network, true> mapped{ test_network<aig_network>() };
+    lut_mapping_params ps;
+    ps.cut_enumeration_ps.cut_size = k;
+    lut_mapping<mapping_view<aig_network, true>, true>( mapped, ps );
+    const auto klut = *collapse_mapped_network<klut_network>( mapped );
+    check_program( klut );
+  }
+}
+
+TEST_CASE( "registers of compiled simulation are reused", "[compiled_simulation]" )
+{
+  /* a chain of AND gates needs one register per PI and one for the chain */
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 32 );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  auto f = pis[0];
+  for ( auto i = 1u; i < pis.size(); ++i )
+  {
+    f = aig.create_and( f, pis[i] );
+  }
+  aig.create_po( f );
+  aig.create_and( pis[0], pis[1] ); /* dangling */
+
+  compiled_simulation_stats st;
+  auto program = compile_simulation( aig, &st );
+  CHECK( st.num_gates == 31u );
+  CHECK( program.instructions().size() == 31u );
+  CHECK( program.num_registers() == 32u );
+
+  std::vector<kitty::partial_truth_table> inputs( 32u, kitty::partial_truth_table( 130u ) );
+  for ( auto& tt : inputs )
+  {
+    tt = ~tt;
+  }
+  kitty::clear_bit( inputs[7], 129u );
+  const auto outputs = program.run( inputs );
+  CHECK( outputs.size() == 1u );
+  CHECK( kitty::count_ones( outputs[0] ) == 129u );
+  CHECK( !kitty::get_bit( outputs[0], 129u ) );
+}
@@ -7,6 +7,11 @@
 #include <mockturtle/algorithms/cut_enumeration.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include "../test_networks.hpp"
 
 using namespace mockturtle;
 
@@ -180,6 +185,96 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+namespace
+{
+
+template<class Ntk, class EnumerateFn>
+void check_concurrent_cut_enumeration( Ntk const& ntk, EnumerateFn&& enumerate )
+{
+  cut_enumeration_params ps;
+  ps.cut_size = 4;
+  const auto expected = enumerate( ps );
+
+  /* the topological order caches the truth tables in a different order,
+     hence only the runs with a number of threads must have the same function ids */
+  ps.num_threads = 1u;
+  const auto expected_concurrent = enumerate( ps );
+
+  for ( auto num_threads : { 1u, 2u, 3u, 4u } )
+  {
+    ps.num_threads = num_threads;
+    const auto cuts = enumerate( ps );
+    CHECK( cuts.total_cuts() == expected.total_cuts() );
+    CHECK( cuts.total_tuples() == expected.total_tuples() );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const& set = cuts.cuts( ntk.node_to_index( n ) );
+      auto const& expected_set = expected.cuts( ntk.node_to_index( n ) );
+      auto const& concurrent_set = expected_concurrent.cuts( ntk.node_to_index( n ) );
+      REQUIRE( set.size() == expected_set.size() );
+      for ( auto i = 0u; i < set.size(); ++i )
+      {
+        CHECK( std::equal( set[i].begin(), set[i].end(), expected_set[i].begin(), expected_set[i].end() ) );
+        CHECK( cuts.truth_table( set[i] ) == expected.truth_table( expected_set[i] ) );
+        CHECK( set[i]->func_id == concurrent_set[i]->func_id );
+      }
+    } );
+  }
+}
+
+/* cuts with up to 6 leaves are computed on words, the static truth tables
+   of the fast cut enumeration are the reference */
+template<class Ntk>
+void check_word_truth_tables( Ntk const& ntk, bool minimize )
+{
+  cut_enumeration_params ps;
+  ps.cut_size = 6;
+  ps.minimize_truth_table = minimize;
+  const auto cuts = cut_enumeration<Ntk, true>( ntk, ps );
+  const auto expected = fast_cut_enumeration<Ntk, 6, true>( ntk, ps );
+  CHECK( cuts.total_cuts() == expected.total_cuts() );
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    auto const& set = cuts.cuts( ntk.node_to_index( n ) );
+    auto const& expected_set = expected.cuts( ntk.node_to_index( n ) );
+    REQUIRE( set.size() == expected_set.size() );
+    for ( auto i = 0u; i < set.size(); ++i )
+    {
+      CHECK( std::equal( set[i].begin(), set[i].end(), expected_set[i].begin(), expected_set[i].end() ) );
+      CHECK( cuts.truth_table( set[i] ).num_vars() == set[i].size() );
+      CHECK( kitty::extend_to<6>( cuts.truth_table( set[i] ) ) == expected.truth_table( expected_set[i] ) );
+    }
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "compute truth tables of cuts with up to 6 leaves on words", "[cut_enumeration]" )
+{
+  for ( auto minimize : { false, true } )
+  {
+    check_word_truth_tables( multiplier_network<aig_network>( 8u ), minimize );
+    check_word_truth_tables( multiplier_network<xag_network>( 8u ), minimize );
+    check_word_truth_tables( multiplier_network<mig_network>( 8u ), minimize );
+    check_word_truth_tables( multiplier_network<xmg_network>( 8u ), minimize );
+    check_word_truth_tables( multiplier_network<klut_network>( 8u ), minimize );
+  }
+}
+
+TEST_CASE( "enumerate cuts concurrently by levels", "[cut_enumeration]" )
+{
+  const auto aig = multiplier_network<aig_network>( 8u );
+  check_concurrent_cut_enumeration( aig, [&]( auto const& ps ) { return cut_enumeration<aig_network, true>( aig, ps ); } );
+  check_concurrent_cut_enumeration( aig, [&]( auto const& ps ) { return fast_cut_enumeration<aig_network, 4, true>( aig, ps ); } );
+
+  const auto mig = multiplier_network<mig_network>( 8u );
+  check_concurrent_cut_enumeration( mig, [&]( auto const& ps ) { return cut_enumeration<mig_network, true>( mig, ps ); } );
+  check_concurrent_cut_enumeration( mig, [&]( auto const& ps ) { return fast_cut_enumeration<mig_network, 4, true>( mig, ps ); } );
+
+  const auto klut = multiplier_network<klut_network>( 8u );
+  check_concurrent_cut_enumeration( klut, [&]( auto const& ps ) { return cut_enumeration<klut_network, true>( klut, ps ); } );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
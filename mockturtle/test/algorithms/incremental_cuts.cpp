@@ -0,0 +1,208 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/incremental_cuts.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* rewrites AND( AND( p, q ), y ) into AND( p, AND( q, y ) ) for every
+   `step`-th gate with a regular AND fan-in, which preserves the functions */
+uint32_t reassociate( aig_network& aig, uint32_t step )
+{
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+
+  uint32_t count{ 0u };
+  for ( auto i = 0u; i < gates.size(); i += step )
+  {
+    const auto n = gates[i];
+    if ( aig.is_dead( n ) )
+    {
+      continue;
+    }
+
+    std::vector<aig_network::signal> fanins;
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    if ( aig.is_complemented( fanins[0] ) || !aig.is_and( aig.get_node( fanins[0] ) ) )
+    {
+      std::swap( fanins[0], fanins[1] );
+    }
+    const auto x = aig.get_node( fanins[0] );
+    if ( aig.is_complemented( fanins[0] ) || !aig.is_and( x ) )
+    {
+      continue;
+    }
+
+    std::vector<aig_network::signal> pq;
+    aig.foreach_fanin( x, [&]( auto const& f ) {
+      pq.push_back( f );
+    } );
+    aig.substitute_node( n, aig.create_and( pq[0], aig.create_and( pq[1], fanins[1] ) ) );
+    ++count;
+  }
+  return count;
+}
+
+/* substitutions may break the topological order of node indices, this view
+   visits the nodes in topological order but keeps their indices */
+class topo_order_view : public topo_view<aig_network>
+{
+public:
+  explicit topo_order_view( aig_network const& aig ) : topo_view<aig_network>( aig ) {}
+
+  uint32_t size() const { return aig_network::size(); }
+  uint32_t node_to_index( node const& n ) const { return aig_network::node_to_index( n ); }
+  node index_to_node( uint32_t index ) const { return aig_network::index_to_node( index ); }
+};
+
+template<class Cuts>
+void check_same_cuts( aig_network const& aig, Cuts& cuts, cut_enumeration_params const& ps )
+{
+  const topo_order_view topo{ aig };
+  const auto expected = cut_enumeration<topo_order_view, true>( topo, ps );
+
+  topo.foreach_node( [&]( auto const& n ) {
+    auto const& set = cuts.cuts( aig.node_to_index( n ) );
+    auto const& expected_set = expected.cuts( aig.node_to_index( n ) );
+    REQUIRE( set.size() == expected_set.size() );
+    for ( auto i = 0u; i < set.size(); ++i )
+    {
+      CHECK( std::equal( set[i].begin(), set[i].end(), expected_set[i].begin(), expected_set[i].end() ) );
+      CHECK( cuts.truth_table( set[i] ) == expected.truth_table( expected_set[i] ) );
+    }
+  } );
+}
+
+/* checks that each cut function composed with the simulation values of the
+   leaves gives the simulation value of the node */
+template<class Cuts>
+void check_cut_functions( aig_network const& aig, Cuts& cuts )
+{
+  const topo_order_view topo{ aig };
+  const partial_simulator sim( aig.num_pis(), 256 );
+  const auto values = simulate_nodes<kitty::partial_truth_table>( topo, sim );
+
+  topo.foreach_gate( [&]( auto const& n ) {
+    for ( auto const& cut : cuts.cuts( aig.node_to_index( n ) ) )
+    {
+      const auto tt = cuts.truth_table( *cut );
+      for ( auto b = 0u; b < 256u; ++b )
+      {
+        uint64_t minterm{ 0u };
+        auto i = 0u;
+        for ( auto leaf : *cut )
+        {
+          REQUIRE( !aig.is_dead( aig.index_to_node( leaf ) ) );
+          minterm |= static_cast<uint64_t>( kitty::get_bit( values[aig.index_to_node( leaf )], b ) ) << i++;
+        }
+        CHECK( kitty::get_bit( tt, minterm ) == kitty::get_bit( values[n], b ) );
+      }
+    }
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "recompute invalidated cuts on demand", "[incremental_cuts]" )
+{
+  auto aig = multiplier_network<aig_network>( 6u );
+
+  incremental_cuts_params ps;
+  ps.cut_enumeration_ps.cut_size = 4;
+  incremental_network_cuts<aig_network, true> cuts( aig, ps );
+  check_same_cuts( aig, cuts, ps.cut_enumeration_ps );
+  CHECK( cuts.stats().num_computed == 0u );
+
+  const auto num_gates = aig.num_gates();
+  CHECK( reassociate( aig, 7u ) > 0u );
+
+  /* nodes added by the rewrites have no cuts yet */
+  aig.foreach_gate( [&]( auto const& n ) {
+    if ( aig.node_to_index( n ) > num_gates + aig.num_pis() )
+    {
+      CHECK( cuts.is_dirty( aig.node_to_index( n ) ) );
+    }
+  } );
+
+  check_same_cuts( aig, cuts, ps.cut_enumeration_ps );
+  CHECK( cuts.stats().num_computed > 0u );
+  CHECK( cuts.stats().num_computed < aig.num_gates() );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( !cuts.is_dirty( aig.node_to_index( n ) ) );
+  } );
+
+  /* a second round only recomputes the transitive fanout of its rewrites */
+  const auto num_computed = cuts.stats().num_computed;
+  CHECK( reassociate( aig, 5u ) > 0u );
+  cuts.update();
+  CHECK( cuts.stats().num_computed > num_computed );
+  check_same_cuts( aig, cuts, ps.cut_enumeration_ps );
+  check_cut_functions( aig, cuts );
+}
+
+TEST_CASE( "recompute cuts up to a maximum depth", "[incremental_cuts]" )
+{
+  for ( auto max_depth : { 0u, 1u, 3u } )
+  {
+    auto aig = multiplier_network<aig_network>( 6u );
+
+    incremental_cuts_params ps;
+    ps.cut_enumeration_ps.cut_size = 4;
+    ps.max_depth = max_depth;
+    incremental_network_cuts<aig_network, true> cuts( aig, ps );
+
+    incremental_cuts_params ps_all;
+    ps_all.cut_enumeration_ps.cut_size = 4;
+    incremental_network_cuts<aig_network, true> all_cuts( aig, ps_all );
+
+    CHECK( reassociate( aig, 3u ) > 0u );
+    CHECK( reassociate( aig, 4u ) > 0u );
+
+    cuts.update();
+    all_cuts.update();
+    CHECK( cuts.stats().num_computed < all_cuts.stats().num_computed );
+
+    /* kept cuts remain valid, since rewriting preserves the functions */
+    check_cut_functions( aig, cuts );
+    CHECK( cuts.stats().num_removed > 0u );
+  }
+}
+
+TEST_CASE( "compute cuts of PIs created after construction", "[incremental_cuts]" )
+{
+  auto aig = multiplier_network<aig_network>( 6u );
+
+  incremental_cuts_params ps;
+  ps.cut_enumeration_ps.cut_size = 4;
+  incremental_network_cuts<aig_network, true> cuts( aig, ps );
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  CHECK( cuts.is_dirty( aig.node_to_index( aig.get_node( a ) ) ) );
+
+  /* only `b` is used in a new gate, `a` is computed by `update` */
+  aig.create_po( aig.create_and( b, aig.make_signal( aig.index_to_node( aig.num_pis() + 1u ) ) ) );
+  cuts.update();
+  CHECK( !cuts.is_dirty( aig.node_to_index( aig.get_node( a ) ) ) );
+  CHECK( cuts.database().cuts( aig.node_to_index( aig.get_node( a ) ) ).size() == 1u );
+  check_same_cuts( aig, cuts, ps.cut_enumeration_ps );
+}
@@ -232,3 +232,35 @@ TEST_CASE( "XAG: DSD-R -fallback-> NPN-R", "[klut_to_graph]" )
   default_simulator<kitty::dynamic_truth_table> sim( table.num_vars() );
   CHECK( simulate<kitty::dynamic_truth_table>( xag, sim )[0] == table );
 }
+
+TEST_CASE( "AIG, XAG, MIG, XMG with compact literals: DSD-R -fallback-> NPN-R", "[klut_to_graph]" )
+{
+  kitty::dynamic_truth_table table( 6u );
+  kitty::create_from_expression( table, "((ab){((cd)(ef))((!c!d)(!e!f))})" );
+
+  klut_network kLUT_ntk;
+
+  const auto x1 = kLUT_ntk.create_pi();
+  const auto x2 = kLUT_ntk.create_pi();
+  const auto x3 = kLUT_ntk.create_pi();
+  const auto x4 = kLUT_ntk.create_pi();
+  const auto x5 = kLUT_ntk.create_pi();
+  const auto x6 = kLUT_ntk.create_pi();
+
+  auto fn = [&]( kitty::dynamic_truth_table const& remainder, std::vector<klut_network::signal> const& children ) {
+    return kLUT_ntk.create_node( children, remainder );
+  };
+
+  kLUT_ntk.create_po( dsd_decomposition( kLUT_ntk, table, { x1, x2, x3, x4, x5, x6 }, fn ) );
+
+  const auto aig = convert_klut_to_graph<basic_aig_network<aig_compact_storage>>( kLUT_ntk );
+  const auto xag = convert_klut_to_graph<basic_xag_network<xag_compact_storage>>( kLUT_ntk );
+  const auto mig = convert_klut_to_graph<basic_mig_network<mig_compact_storage>>( kLUT_ntk );
+  const auto xmg = convert_klut_to_graph<basic_xmg_network<xmg_compact_storage>>( kLUT_ntk );
+
+  default_simulator<kitty::dynamic_truth_table> sim( table.num_vars() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == table );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, sim )[0] == table );
+  CHECK( simulate<kitty::dynamic_truth_table>( mig, sim )[0] == table );
+  CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim )[0] == table );
+}
@@ -9,6 +9,7 @@
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/io/super_reader.hpp>
@@ -332,6 +333,89 @@ TEST_CASE( "Map with supergates", "[mapper]" )
   CHECK( st.delay < 3.8f + eps );
 }
 
+TEST_CASE( "Map with switching power recovery", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  map_params ps;
+  ps.eswp_rounds = 2u;
+  map_stats st;
+  binding_view<klut_network> luts = map( aig, lib, ps, &st );
+  CHECK( st.power > 0.0 );
+
+  /* the same activity is estimated once and reused */
+  const auto activity = detail::switching_activity( aig, ps.switching_activity_patterns );
+  map_stats st_given;
+  binding_view<klut_network> luts_given = map( aig, lib, activity, ps, &st_given );
+  CHECK( luts_given.num_gates() == luts.num_gates() );
+  CHECK( st_given.area == st.area );
+  CHECK( st_given.delay == st.delay );
+  CHECK( st_given.power == st.power );
+  CHECK( st_given.time_switching_activity.count() == 0 );
+}
+
+TEST_CASE( "Map with multiple threads", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 32 ), b( 32 );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+  CHECK( aig.num_gates() > 4096u );
+
+  const partial_simulator sim( aig.num_pis(), 256u );
+  const auto expected = simulate<kitty::partial_truth_table>( aig, sim );
+
+  map_params ps;
+  map_stats st1;
+  binding_view<klut_network> luts1 = map( aig, lib, ps, &st1 );
+  CHECK( simulate<kitty::partial_truth_table>( luts1, sim ) == expected );
+
+  /* the result does not depend on the number of threads */
+  ps.num_threads = 2u;
+  map_stats st2;
+  binding_view<klut_network> luts2 = map( aig, lib, ps, &st2 );
+  CHECK( simulate<kitty::partial_truth_table>( luts2, sim ) == expected );
+
+  ps.num_threads = 4u;
+  map_stats st4;
+  binding_view<klut_network> luts4 = map( aig, lib, ps, &st4 );
+  CHECK( simulate<kitty::partial_truth_table>( luts4, sim ) == expected );
+
+  CHECK( luts4.num_gates() == luts2.num_gates() );
+  CHECK( st4.area == st2.area );
+  CHECK( st4.delay == st2.delay );
+
+  /* area recovery on partitions does not increase the delay */
+  CHECK( st2.delay <= st1.delay + 0.005 );
+}
+
 TEST_CASE( "Exact map of bad MAJ3 and constant output", "[mapper]" )
 {
   mig_npn_resynthesis resyn{ true };
@@ -1,10 +1,14 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/traits.hpp>
 #include <mockturtle/views/depth_view.hpp>
 
+#include <algorithm>
+#include <vector>
+
 using namespace mockturtle;
 
 TEST_CASE( "MIG depth optimization with associativity", "[mig_algebraic_rewriting]" )
@@ -139,3 +143,34 @@ TEST_CASE( "MIG aggressive depth optimization", "[mig_algebraic_rewriting]" )
 
   CHECK( depth_mig.depth() == 2 );
 }
+
+TEST_CASE( "MIG depth optimization with incremental levels", "[mig_algebraic_rewriting]" )
+{
+  for ( auto strategy : { mig_algebraic_depth_rewriting_params::dfs, mig_algebraic_depth_rewriting_params::selective, mig_algebraic_depth_rewriting_params::aggressive } )
+  {
+    mig_network mig;
+    std::vector<mig_network::signal> a( 16u ), b( 16u );
+    std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+    auto carry = mig.get_constant( false );
+    carry_ripple_adder_inplace( mig, a, b, carry );
+    std::for_each( a.begin(), a.end(), [&]( auto const& f ) { mig.create_po( f ); } );
+    mig.create_po( carry );
+
+    mig_algebraic_depth_rewriting_params ps;
+    ps.strategy = strategy;
+
+    auto mig_full = mig.clone();
+    depth_view depth_full{ mig_full };
+    mig_algebraic_depth_rewriting( depth_full, ps );
+
+    depth_view_params dps;
+    dps.incremental = true;
+    depth_view depth_incremental{ mig, unit_cost<mig_network>(), dps };
+    mig_algebraic_depth_rewriting( depth_incremental, ps );
+
+    CHECK( depth_incremental.depth() < 32u );
+    CHECK( depth_incremental.depth() == depth_full.depth() );
+    CHECK( depth_incremental.num_gates() == depth_full.num_gates() );
+  }
+}
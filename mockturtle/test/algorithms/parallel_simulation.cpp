@@ -0,0 +1,134 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/parallel_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* adds the complemented XOR of the LSBs of the multiplier operands as output */
+template<class Ntk>
+void add_xnor_po( Ntk& ntk )
+{
+  ntk.create_po( ntk.create_not( ntk.create_xor( ntk.make_signal( ntk.pi_at( 0u ) ), ntk.make_signal( ntk.pi_at( 8u ) ) ) ) );
+}
+
+template<class Ntk, class Simulator>
+void check_parallel_simulation( Ntk const& ntk, Simulator const& sim, parallel_simulation_params::partition_t partition, bool by_words )
+{
+  const auto expected_nodes = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+  const auto expected_pos = simulate<kitty::partial_truth_table>( ntk, sim );
+
+  for ( auto num_threads : { 1u, 2u, 4u } )
+  {
+    parallel_simulation_params ps;
+    ps.num_threads = num_threads;
+    ps.partition = partition;
+    ps.gates_per_task = 3u;
+    parallel_simulation_stats st;
+
+    const auto nodes = parallel_simulate_nodes<kitty::partial_truth_table>( ntk, sim, ps, &st );
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( nodes[n] == expected_nodes[n] );
+    } );
+    CHECK( parallel_simulate<kitty::partial_truth_table>( ntk, sim, ps ) == expected_pos );
+    CHECK( st.num_threads == num_threads );
+    CHECK( st.by_words == by_words );
+    CHECK( ( by_words || st.num_levels > 0u ) );
+  }
+}
+
+} // namespace
+
+TEST_CASE( "Parallel simulation of networks by levels", "[parallel_simulation]" )
+{
+  using partition_t = parallel_simulation_params::partition_t;
+
+  auto aig = multiplier_network<aig_network>( 8u );
+  auto xag = multiplier_network<xag_network>( 8u );
+  auto mig = multiplier_network<mig_network>( 8u );
+  auto klut = multiplier_network<klut_network>( 8u );
+  add_xnor_po( aig );
+  add_xnor_po( xag );
+  add_xnor_po( mig );
+  add_xnor_po( klut );
+
+  for ( auto num_patterns : { 1u, 100u, 1000u } )
+  {
+    check_parallel_simulation( aig, partial_simulator( aig.num_pis(), num_patterns ), partition_t::automatic, false );
+    check_parallel_simulation( xag, partial_simulator( xag.num_pis(), num_patterns ), partition_t::automatic, false );
+    check_parallel_simulation( mig, partial_simulator( mig.num_pis(), num_patterns ), partition_t::automatic, false );
+    check_parallel_simulation( klut, partial_simulator( klut.num_pis(), num_patterns ), partition_t::automatic, false );
+
+    check_parallel_simulation( aig, simd_simulator<>( aig.num_pis(), num_patterns ), partition_t::levels, false );
+    check_parallel_simulation( klut, simd_simulator<>( klut.num_pis(), num_patterns ), partition_t::automatic, false );
+  }
+}
+
+TEST_CASE( "Parallel simulation of networks by words", "[parallel_simulation]" )
+{
+  using partition_t = parallel_simulation_params::partition_t;
+
+  auto aig = multiplier_network<aig_network>( 8u );
+  auto xag = multiplier_network<xag_network>( 8u );
+  auto mig = multiplier_network<mig_network>( 8u );
+  auto xmg = multiplier_network<xmg_network>( 8u );
+  add_xnor_po( aig );
+  add_xnor_po( xag );
+  add_xnor_po( mig );
+  add_xnor_po( xmg );
+
+  for ( auto num_patterns : { 1u, 100u, 1000u, 3000u } )
+  {
+    check_parallel_simulation( aig, simd_simulator<>( aig.num_pis(), num_patterns ), partition_t::words, true );
+    check_parallel_simulation( xag, simd_simulator<>( xag.num_pis(), num_patterns ), partition_t::words, true );
+    check_parallel_simulation( mig, simd_simulator<>( mig.num_pis(), num_patterns ), partition_t::words, true );
+    check_parallel_simulation( xmg, simd_simulator<>( xmg.num_pis(), num_patterns ), partition_t::words, true );
+  }
+
+  /* enough words for all threads */
+  check_parallel_simulation( aig, simd_simulator<>( aig.num_pis(), 64u * 64u ), partition_t::automatic, true );
+}
+
+TEST_CASE( "Parallel simulation with static truth tables and Booleans", "[parallel_simulation]" )
+{
+  auto aig = multiplier_network<aig_network>( 8u );
+  add_xnor_po( aig );
+
+  parallel_simulation_params ps;
+  ps.num_threads = 3u;
+  ps.gates_per_task = 2u;
+
+  {
+    const auto expected = simulate_nodes<kitty::static_truth_table<16u>>( aig );
+    const auto nodes = parallel_simulate_nodes<kitty::static_truth_table<16u>>( aig, default_simulator<kitty::static_truth_table<16u>>(), ps );
+    aig.foreach_node( [&]( auto const& n ) {
+      CHECK( nodes[n] == expected[n] );
+    } );
+
+    simd_simulator<kitty::static_truth_table<16u>> sim;
+    ps.partition = parallel_simulation_params::partition_t::words;
+    CHECK( parallel_simulate<kitty::static_truth_table<16u>>( aig, sim, ps ) == simulate<kitty::static_truth_table<16u>>( aig ) );
+    ps.partition = parallel_simulation_params::partition_t::automatic;
+  }
+
+  std::vector<bool> assignment( aig.num_pis() );
+  for ( auto i = 0u; i < assignment.size(); ++i )
+  {
+    assignment[i] = ( i % 3u ) == 1u;
+  }
+  const default_simulator<bool> sim( assignment );
+  CHECK( parallel_simulate<bool>( aig, sim, ps ) == simulate<bool>( aig, sim ) );
+}
@@ -30,6 +30,7 @@
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/views/depth_view.hpp>
 #include <mockturtle/views/mapping_view.hpp>
@@ -583,4 +584,65 @@ TEST_CASE( "Test quality of 6-input windowing for AIG", "[quality]" )
   CHECK( v == result );
 }
 
+TEST_CASE( "Test quality of networks with compact literals", "[quality]" )
+{
+  using aig_compact_network = basic_aig_network<aig_compact_storage>;
+  using xag_compact_network = basic_xag_network<xag_compact_storage>;
+  using mig_compact_network = basic_mig_network<mig_compact_storage>;
+  using xmg_compact_network = basic_xmg_network<xmg_compact_storage>;
+
+  /* same results as for the networks with 64-bit literals */
+  const auto v1 = foreach_benchmark<aig_compact_network>( []( auto& ntk, auto ) {
+    return cut_enumeration( ntk ).total_cuts();
+  } );
+  CHECK( v1 == std::vector<std::size_t>{ { 19, 1387, 3154, 1717, 5466, 2362, 4551, 6994, 11849, 34181, 12442 } } );
+
+  xag_npn_resynthesis<aig_compact_network> aig_resyn;
+  const auto v2 = foreach_benchmark<aig_compact_network>( [&]( auto& ntk, auto ) {
+    const auto before = ntk.num_gates();
+    cut_rewriting_params ps;
+    ps.cut_enumeration_ps.cut_size = 4;
+    ps.min_cand_cut_size = 2;
+    ps.min_cand_cut_size_override = 3;
+    cut_rewriting_with_compatibility_graph( ntk, aig_resyn, ps );
+    ntk = cleanup_dangling( ntk );
+    return before - ntk.num_gates();
+  } );
+  CHECK( v2 == std::vector<uint32_t>{ { 0, 17, 4, 9, 60, 16, 113, 93, 250, 17, 21 } } );
+
+  xag_npn_resynthesis<xag_compact_network> xag_resyn;
+  const auto v3 = foreach_benchmark<xag_compact_network>( [&]( auto& ntk, auto ) {
+    const auto before = ntk.num_gates();
+    cut_rewriting_params ps;
+    ps.cut_enumeration_ps.cut_size = 4;
+    ps.min_cand_cut_size = 2;
+    ps.min_cand_cut_size_override = 3;
+    cut_rewriting_with_compatibility_graph( ntk, xag_resyn, ps );
+    ntk = cleanup_dangling( ntk );
+    return before - ntk.num_gates();
+  } );
+  CHECK( v3 == std::vector<uint32_t>{ { 0, 31, 152, 50, 176, 79, 215, 138, 412, 869, 293 } } );
+
+  const auto v4 = foreach_benchmark<mig_compact_network>( []( auto& ntk, auto ) {
+    uint32_t const before = ntk.num_gates();
+    depth_view dntk{ ntk };
+    fanout_view fntk{ dntk };
+    mig_resubstitution( fntk );
+    ntk = cleanup_dangling( ntk );
+    return before - ntk.num_gates();
+  } );
+  CHECK( v4 == std::vector<uint32_t>{ { 1, 58, 6, 18, 6, 20, 102, 88, 165, 466, 63 } } );
+
+  const auto v5 = foreach_benchmark<xmg_compact_network>( [&]( auto& ntk, auto ) {
+    const auto before = ntk.num_gates();
+    resubstitution_params ps;
+    ps.max_pis = 8u;
+    ps.max_inserts = 1u;
+    xmg_resubstitution( ntk, ps );
+    ntk = cleanup_dangling( ntk );
+    return before - ntk.num_gates();
+  } );
+  CHECK( v5 == std::vector<uint32_t>{ { 0, 38, 46, 22, 62, 72, 76, 75, 273, 865, 190 } } );
+}
+
 #endif
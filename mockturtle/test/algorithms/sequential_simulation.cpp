@@ -0,0 +1,160 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* 3-bit counter with enable, the POs are the counter bits and the carry out */
+template<class Ntk>
+Ntk counter_network()
+{
+  Ntk ntk;
+  const auto enable = ntk.create_pi();
+  std::vector<typename Ntk::signal> bits;
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    bits.push_back( ntk.create_ro() );
+  }
+
+  std::vector<typename Ntk::signal> next;
+  auto carry = enable;
+  for ( auto const& b : bits )
+  {
+    next.push_back( ntk.create_xor( b, carry ) );
+    carry = ntk.create_and( b, carry );
+  }
+
+  for ( auto const& b : bits )
+  {
+    ntk.create_po( b );
+  }
+  ntk.create_po( carry );
+  for ( auto const& f : next )
+  {
+    ntk.create_ri( f );
+  }
+  return ntk;
+}
+
+template<class Ntk>
+void check_counter()
+{
+  auto ntk = counter_network<Ntk>();
+  /* start at 5 */
+  mockturtle::register_t one;
+  one.init = 1;
+  ntk.set_register( 0u, one );
+  ntk.set_register( 2u, one );
+
+  const uint32_t num_traces = 150u;
+  sequential_simulator<Ntk> sim( ntk, num_traces );
+  std::vector<uint32_t> expected( num_traces, 5u );
+
+  std::default_random_engine rng( 7u );
+  std::vector<kitty::partial_truth_table> inputs( 1u, kitty::partial_truth_table( num_traces ) );
+  for ( auto cycle = 0u; cycle < 20u; ++cycle )
+  {
+    kitty::create_random( inputs[0], rng() );
+    sim.step( inputs );
+
+    for ( auto t = 0u; t < num_traces; ++t )
+    {
+      const bool enable = kitty::get_bit( inputs[0], t );
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        CHECK( kitty::get_bit( sim.po_value( i ), t ) == ( ( expected[t] >> i ) & 1u ) );
+      }
+      CHECK( kitty::get_bit( sim.po_value( 3u ), t ) == ( enable && expected[t] == 7u ) );
+      expected[t] = ( expected[t] + ( enable ? 1u : 0u ) ) & 7u;
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        CHECK( kitty::get_bit( sim.register_value( i ), t ) == ( ( expected[t] >> i ) & 1u ) );
+      }
+    }
+  }
+  CHECK( sim.num_cycles() == 20u );
+
+  sim.reset();
+  CHECK( sim.num_cycles() == 0u );
+  inputs[0] = ~kitty::partial_truth_table( num_traces );
+  sim.step( inputs );
+  CHECK( kitty::count_ones( sim.po_value( 0u ) ) == num_traces );
+  CHECK( kitty::count_ones( sim.po_value( 1u ) ) == 0u );
+  CHECK( kitty::count_ones( sim.po_value( 2u ) ) == num_traces );
+}
+
+} // namespace
+
+TEST_CASE( "Simulate a counter over several cycles", "[sequential_simulation]" )
+{
+  check_counter<sequential<aig_network>>();
+  check_counter<sequential<xag_network>>();
+  check_counter<sequential<klut_network>>();
+}
+
+TEST_CASE( "Toggle counts of sequential simulation", "[sequential_simulation]" )
+{
+  /* shift register of length 3 */
+  sequential<aig_network> aig;
+  const auto x = aig.create_pi();
+  const auto r0 = aig.create_ro();
+  const auto r1 = aig.create_ro();
+  const auto r2 = aig.create_ro();
+  aig.create_po( r2 );
+  aig.create_po( aig.create_and( x, r0 ) );
+  aig.create_ri( x );
+  aig.create_ri( r0 );
+  aig.create_ri( r1 );
+
+  sequential_simulation_params ps;
+  ps.num_traces = 100u;
+  ps.num_cycles = 30u;
+  ps.input_switching_probability = 0.25;
+  sequential_simulation_stats st;
+  const auto result = simulate_sequential( aig, ps, &st );
+  CHECK( st.num_cycles == 30u );
+  CHECK( result.po_values.size() == 30u );
+
+  /* the output is the input delayed by 3 cycles, reconstruct the inputs */
+  std::vector<kitty::partial_truth_table> inputs;
+  for ( auto cycle = 3u; cycle < 30u; ++cycle )
+  {
+    inputs.push_back( result.po_values[cycle][0] );
+  }
+
+  /* toggles of r2 in cycles 1..29, the first toggle is from reset value 0 */
+  uint64_t expected = kitty::count_ones( result.po_values[3][0] );
+  for ( auto i = 1u; i < inputs.size(); ++i )
+  {
+    expected += kitty::count_ones( inputs[i] ^ inputs[i - 1] );
+  }
+  CHECK( result.toggles[aig.node_to_index( aig.get_node( r2 ) )] == expected );
+
+  /* inputs change with probability 0.25 */
+  const auto rate = result.toggle_rates[aig.node_to_index( aig.get_node( x ) )];
+  CHECK( rate > 0.2f );
+  CHECK( rate < 0.3f );
+  CHECK( result.toggle_rates[aig.node_to_index( aig.get_node( r2 ) )] < 0.3f );
+
+  /* switching activity of sequential networks measures toggles over cycles */
+  const auto activity = detail::switching_activity( aig, 1024u );
+  CHECK( activity.size() == aig.size() );
+  CHECK( activity[aig.node_to_index( aig.get_node( x ) )] > 0.4f );
+  CHECK( activity[aig.node_to_index( aig.get_node( r0 ) )] > 0.4f );
+  CHECK( activity[aig.node_to_index( aig.get_node( aig.get_constant( false ) ) )] == 0.0f );
+}
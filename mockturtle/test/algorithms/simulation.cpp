@@ -1,11 +1,17 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
 
 #include <kitty/static_truth_table.hpp>
 
+#include "../test_networks.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "Simulate XOR AIG circuit with Booleans", "[simulation]" )
@@ -307,3 +313,113 @@ TEST_CASE( "Bit packing", "[simulation]" )
   CHECK( ( sim.compute_pi( 3 )._bits[0] & 0x0f ) == 0x0d ); /* x3 = xx1x101 -> x1101 */
   CHECK( ( sim.compute_pi( 4 )._bits[0] & 0x1f ) == 0x1d ); /* x4 = x1x1101 -> 11101 */
 }
+
+TEST_CASE( "Simulate with simd_simulator", "[simulation]" )
+{
+  const auto check_simd_simulation = []( auto ntk, uint32_t num_patterns ) {
+    using Ntk = decltype( ntk );
+
+    /* an ITE (a majority in MIGs and XMGs) with a new PI as condition */
+    const auto carry = ntk.create_pi();
+    ntk.create_po( ntk.create_ite( carry, ntk.create_not( ntk.po_at( 0u ) ), ntk.po_at( 1u ) ) );
+    ntk.create_po( ntk.create_not( carry ) );
+
+    const partial_simulator sim( ntk.num_pis(), num_patterns );
+    const auto expected_nodes = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+    const auto expected_pos = simulate<kitty::partial_truth_table>( ntk, sim );
+
+    for ( auto level : { simd_level::scalar, simd_level::avx2, simd_level::avx512 } )
+    {
+      simd_simulator<> simd_sim( sim );
+      simd_sim.set_level( level );
+      CHECK( simd_sim.level() <= simd_supported_level() );
+
+      const auto nodes = simulate_nodes<kitty::partial_truth_table>( ntk, simd_sim );
+      ntk.foreach_node( [&]( auto const& n ) {
+        CHECK( nodes[n] == expected_nodes[n] );
+      } );
+      CHECK( simulate<kitty::partial_truth_table>( ntk, simd_sim ) == expected_pos );
+
+      if constexpr ( has_compute_inplace_v<Ntk, kitty::partial_truth_table> )
+      {
+        unordered_node_map<kitty::partial_truth_table, Ntk> node_to_value( ntk );
+        simulate_nodes( ntk, node_to_value, simd_sim, true );
+        ntk.foreach_gate( [&]( auto const& n ) {
+          CHECK( node_to_value[n] == expected_nodes[n] );
+        } );
+      }
+    }
+  };
+
+  for ( auto num_patterns : { 1u, 64u, 1000u, 4096u } )
+  {
+    check_simd_simulation( multiplier_network<aig_network>( 8u ), num_patterns );
+    check_simd_simulation( multiplier_network<xag_network>( 8u ), num_patterns );
+    check_simd_simulation( multiplier_network<mig_network>( 8u ), num_patterns );
+    check_simd_simulation( multiplier_network<xmg_network>( 8u ), num_patterns );
+    check_simd_simulation( multiplier_network<klut_network>( 8u ), num_patterns );
+  }
+}
+
+TEST_CASE( "Simulate static truth tables with simd_simulator", "[simulation]" )
+{
+  xmg_network xmg;
+  std::vector<xmg_network::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&]() { return xmg.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xmg.create_pi(); } );
+  auto carry = xmg.get_constant( false );
+  carry_ripple_adder_inplace( xmg, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { xmg.create_po( f ); } );
+  xmg.create_po( !carry );
+
+  CHECK( simulate<kitty::static_truth_table<8u>>( xmg, simd_simulator<kitty::static_truth_table<8u>>() ) ==
+         simulate<kitty::static_truth_table<8u>>( xmg, default_simulator<kitty::static_truth_table<8u>>() ) );
+
+  aig_network aig;
+  const auto x = aig.create_pi();
+  const auto y = aig.create_pi();
+  aig.create_po( aig.create_xor( x, y ) );
+  aig.create_po( !aig.create_and( x, !y ) );
+
+  const auto tts = simulate<kitty::static_truth_table<2u>>( aig, simd_simulator<kitty::static_truth_table<2u>>() );
+  CHECK( tts[0]._bits == 0x6 );
+  CHECK( tts[1]._bits == 0xd );
+}
+
+TEST_CASE( "Incremental simulation with simd_simulator", "[simulation]" )
+{
+  const auto aig = multiplier_network<aig_network>( 8u );
+  partial_simulator sim( aig.num_pis(), 64u );
+  simd_simulator<> simd_sim( sim );
+
+  unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig ), node_to_value( aig );
+  simulate_nodes( aig, expected, sim, true );
+  simulate_nodes( aig, node_to_value, simd_sim, true );
+
+  /* stay within one more block, since only the last block is re-simulated */
+  std::vector<bool> pattern( aig.num_pis() );
+  for ( auto i = 0u; i < 40u; ++i )
+  {
+    for ( auto j = 0u; j < pattern.size(); ++j )
+    {
+      pattern[j] = ( ( i * 7u + j * 13u ) % 5u ) < 2u;
+    }
+    sim.add_pattern( pattern );
+    simd_sim.add_pattern( pattern );
+
+    /* re-simulate only the cone of one output every few patterns */
+    if ( i % 10u == 0u )
+    {
+      const auto n = aig.get_node( aig.po_at( i % aig.num_pos() ) );
+      simulate_node( aig, n, expected, sim );
+      simulate_node( aig, n, node_to_value, simd_sim );
+      CHECK( node_to_value[n] == expected[n] );
+    }
+  }
+
+  simulate_nodes( aig, expected, sim, false );
+  simulate_nodes( aig, node_to_value, simd_sim, false );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( node_to_value[n] == expected[n] );
+  } );
+}
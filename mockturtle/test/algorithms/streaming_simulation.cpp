@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/streaming_simulation.hpp>
+#include <mockturtle/io/read_patterns.hpp>
+#include <mockturtle/io/write_patterns.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+void check_reducers( Ntk const& ntk, uint32_t words_per_block )
+{
+  const partial_simulator sim( "patterns_stream.txt" );
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+  const auto pos = simulate<kitty::partial_truth_table>( ntk, sim );
+
+  pattern_block_reader reader( "patterns_stream.txt", words_per_block );
+  popcount_reducer<Ntk> ones( ntk, true );
+  toggle_reducer<Ntk> toggles( ntk );
+  mismatch_reducer<Ntk> mismatches( ntk );
+  const auto st = simulate_stream( ntk, reader, ones, toggles, mismatches );
+
+  REQUIRE( st );
+  CHECK( st->num_patterns == sim.num_bits() );
+  CHECK( st->num_blocks == ( sim.num_bits() + 64u * words_per_block - 1u ) / ( 64u * words_per_block ) );
+  CHECK( mismatches.equivalent() );
+
+  for ( auto i = 0u; i < pos.size(); ++i )
+  {
+    CHECK( ones.po_ones( i ) == kitty::count_ones( pos[i] ) );
+    CHECK( !mismatches.first_mismatch( i ) );
+  }
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( ones.node_ones_at( ntk.node_to_index( n ) ) == kitty::count_ones( tts[n] ) );
+
+    uint64_t expected = 0u;
+    for ( auto b = 1u; b < tts[n].num_bits(); ++b )
+    {
+      expected += kitty::get_bit( tts[n], b ) != kitty::get_bit( tts[n], b - 1 ) ? 1u : 0u;
+    }
+    CHECK( toggles.toggles( ntk.node_to_index( n ) ) == expected );
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "Streaming simulation with reducers", "[streaming_simulation]" )
+{
+  const auto aig = adder_network<aig_network>( 6u );
+  const auto klut = adder_network<klut_network>( 6u );
+  write_patterns( partial_simulator( aig.num_pis(), 2000u ), "patterns_stream.txt" );
+
+  for ( auto words : { 1u, 2u, 5u, 64u } )
+  {
+    check_reducers( aig, words );
+    check_reducers( klut, words );
+  }
+
+  std::remove( "patterns_stream.txt" );
+}
+
+TEST_CASE( "Detect mismatches with streaming simulation", "[streaming_simulation]" )
+{
+  const auto aig = adder_network<aig_network>( 6u );
+
+  /* the MSB of the sum is replaced by an AND */
+  auto faulty = aig.clone();
+  std::vector<aig_network::signal> pis;
+  faulty.foreach_pi( [&]( auto const& n ) {
+    pis.push_back( faulty.make_signal( n ) );
+  } );
+  faulty.replace_in_outputs( faulty.get_node( faulty.po_at( 5 ) ), faulty.create_and( pis[5], pis[11] ) );
+
+  const partial_simulator sim( aig.num_pis(), 3000u );
+  write_patterns( sim, "patterns_mismatch.txt" );
+  const auto expected = simulate<kitty::partial_truth_table>( aig, sim );
+  const auto actual = simulate<kitty::partial_truth_table>( faulty, sim );
+
+  pattern_block_reader reader( "patterns_mismatch.txt", 2u );
+  mismatch_reducer<aig_network> mismatches( aig );
+  CHECK( simulate_stream( faulty, reader, mismatches ) );
+
+  CHECK( !mismatches.equivalent() );
+  for ( auto i = 0u; i < aig.num_pos(); ++i )
+  {
+    /* the pattern file is rounded up to full hex characters */
+    auto diff = expected[i] ^ actual[i];
+    CHECK( mismatches.num_mismatches( i ) == kitty::count_ones( diff ) );
+    if ( kitty::count_ones( diff ) > 0u )
+    {
+      CHECK( mismatches.first_mismatch( i ) == static_cast<uint64_t>( kitty::find_first_one_bit( diff ) ) );
+    }
+    else
+    {
+      CHECK( !mismatches.first_mismatch( i ) );
+    }
+  }
+
+  std::remove( "patterns_mismatch.txt" );
+}
+
+TEST_CASE( "Streaming simulation with a mismatching pattern file", "[streaming_simulation]" )
+{
+  const auto aig = adder_network<aig_network>( 6u );
+
+  /* one PI fewer than the network */
+  write_patterns( partial_simulator( aig.num_pis() - 1u, 200u ), "patterns_short.txt" );
+  pattern_block_reader reader( "patterns_short.txt", 1u );
+  CHECK( reader.is_valid() );
+  CHECK( reader.num_pis() == aig.num_pis() - 1u );
+
+  popcount_reducer<aig_network> ones( aig );
+  CHECK( !simulate_stream( aig, reader, ones ) );
+  CHECK( ones.po_ones( 0u ) == 0u );
+
+  /* one PI more than the network */
+  write_patterns( partial_simulator( aig.num_pis() + 1u, 200u ), "patterns_short.txt" );
+  pattern_block_reader reader_long( "patterns_short.txt", 1u );
+  CHECK( !simulate_stream( aig, reader_long, ones ) );
+
+  std::remove( "patterns_short.txt" );
+}
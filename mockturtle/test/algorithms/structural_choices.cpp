@@ -0,0 +1,155 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/structural_choices.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+#include <mockturtle/views/choice_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+using namespace mockturtle;
+
+std::string const choices_library = "GATE   inv1    1 O=!a;            PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                    "GATE   nand2   2 O=!(a*b);        PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                    "GATE   and2    3 O=a*b;           PIN * NONINV 1 999 1.2 0.2 1.2 0.2\n"
+                                    "GATE   xor2    5 O=a^b;           PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                                    "GATE   maj3    4 O=a*b+a*c+b*c;   PIN * NONINV 1 999 2.0 0.2 2.0 0.2\n"
+                                    "GATE   buf     2 O=a;             PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                                    "GATE   zero    0 O=CONST0;\n"
+                                    "GATE   one     0 O=CONST1;";
+
+namespace
+{
+
+aig_network adder( uint32_t bitwidth, bool lookahead )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+
+  if ( lookahead )
+  {
+    carry_lookahead_adder_inplace( aig, a, b, carry );
+  }
+  else
+  {
+    carry_ripple_adder_inplace( aig, a, b, carry );
+  }
+
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+  return aig;
+}
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> simulate_outputs( Ntk const& ntk )
+{
+  return simulate<kitty::dynamic_truth_table>( ntk, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+}
+
+} // namespace
+
+TEST_CASE( "Structural choices of two adders", "[structural_choices]" )
+{
+  const auto ripple = adder( 8u, false );
+  const auto lookahead = adder( 8u, true );
+
+  structural_choices_stats st;
+  const auto choices = structural_choices( std::vector<aig_network>{ ripple, lookahead }, {}, &st );
+
+  CHECK( choices.num_pis() == 16u );
+  CHECK( choices.num_pos() == 9u );
+  CHECK( st.num_equivalences > 0u );
+  CHECK( choices.num_choices() == st.num_choices );
+  CHECK( choices.num_choices() > 0u );
+  CHECK( simulate_outputs( choices ) == simulate_outputs( ripple ) );
+
+  /* the fanins are representatives and the alternatives precede them */
+  std::vector<uint32_t> position( choices.size() );
+  choices.foreach_node( [&]( auto const& n, auto i ) {
+    position[choices.node_to_index( n )] = i;
+  } );
+  choices.foreach_gate( [&]( auto const& n ) {
+    choices.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( !choices.is_choice( choices.get_node( f ) ) );
+      CHECK( position[choices.node_to_index( choices.get_node( f ) )] < position[choices.node_to_index( n )] );
+    } );
+    choices.foreach_choice( n, [&]( auto const& a ) {
+      CHECK( choices.get_choice_representative( a ) == n );
+      CHECK( position[choices.node_to_index( a )] < position[choices.node_to_index( n )] );
+    } );
+  } );
+
+  /* a single structure is reduced */
+  const auto reduced = structural_choices( std::vector<aig_network>{ ripple } );
+  CHECK( reduced.num_gates() <= ripple.num_gates() );
+  CHECK( simulate_outputs( reduced ) == simulate_outputs( ripple ) );
+}
+
+TEST_CASE( "LUT mapping of structural choices", "[structural_choices]" )
+{
+  const auto ripple = adder( 8u, false );
+  const auto lookahead = adder( 8u, true );
+  const auto choices = structural_choices( std::vector<aig_network>{ ripple, lookahead } );
+
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+
+  mapping_view<choice_view<aig_network>, true> mapped{ choices };
+  lut_mapping<decltype( mapped ), true>( mapped, ps );
+
+  mapping_view<aig_network, true> mapped_ripple{ ripple };
+  lut_mapping<decltype( mapped_ripple ), true>( mapped_ripple, ps );
+
+  mapping_view<aig_network, true> mapped_lookahead{ lookahead };
+  lut_mapping<decltype( mapped_lookahead ), true>( mapped_lookahead, ps );
+
+  const auto luts = *collapse_mapped_network<klut_network>( mapped );
+  CHECK( simulate_outputs( luts ) == simulate_outputs( ripple ) );
+  CHECK( mapped.num_cells() <= std::min( mapped_ripple.num_cells(), mapped_lookahead.num_cells() ) );
+}
+
+TEST_CASE( "Technology mapping of structural choices", "[structural_choices]" )
+{
+  std::vector<gate> gates;
+  std::istringstream in( choices_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+  tech_library<3> lib( gates );
+
+  const auto ripple = adder( 8u, false );
+  const auto lookahead = adder( 8u, true );
+  const auto choices = structural_choices( std::vector<aig_network>{ ripple, lookahead } );
+
+  map_params ps;
+  map_stats st, st_ripple, st_lookahead;
+  const auto res = map( choices, lib, ps, &st );
+  map( ripple, lib, ps, &st_ripple );
+  map( lookahead, lib, ps, &st_lookahead );
+
+  CHECK( simulate_outputs( res ) == simulate_outputs( ripple ) );
+  CHECK( st.delay <= std::min( st_ripple.delay, st_lookahead.delay ) );
+
+  /* the result does not depend on the number of threads */
+  ps.num_threads = 4u;
+  map_stats st_threads;
+  const auto res_threads = map( choices, lib, ps, &st_threads );
+  CHECK( simulate_outputs( res_threads ) == simulate_outputs( ripple ) );
+  CHECK( st_threads.area == st.area );
+  CHECK( st_threads.delay == st.delay );
+}
@@ -0,0 +1,321 @@
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <mockturtle/io/binary_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void create_full_adder( Ntk& ntk )
+{
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+
+  const auto sum = ntk.create_xor( ntk.create_xor( a, b ), c );
+  const auto carry = ntk.create_maj( a, b, c );
+  ntk.create_po( sum );
+  ntk.create_po( !carry );
+}
+
+template<class Ntk>
+void check_same_storage( Ntk const& ntk, Ntk const& ntk2 )
+{
+  CHECK( ntk.size() == ntk2.size() );
+  CHECK( ntk.num_pis() == ntk2.num_pis() );
+  CHECK( ntk.num_pos() == ntk2.num_pos() );
+  CHECK( ntk.num_gates() == ntk2.num_gates() );
+  CHECK( ntk._storage->nodes == ntk2._storage->nodes );
+  CHECK( ntk._storage->inputs == ntk2._storage->inputs );
+  CHECK( ntk._storage->outputs == ntk2._storage->outputs );
+  CHECK( ntk._storage->hash == ntk2._storage->hash );
+  CHECK( ntk._storage->trav_id == ntk2._storage->trav_id );
+}
+
+template<class Ntk>
+void check_roundtrip( std::string const& filename )
+{
+  Ntk ntk;
+  create_full_adder( ntk );
+  ntk.incr_trav_id();
+
+  /* a dead node is kept, but is not part of structural hashing */
+  const auto f = ntk.create_and( ntk.make_signal( ntk.pi_at( 0 ) ), ntk.make_signal( ntk.pi_at( 2 ) ) );
+  ntk.take_out_node( ntk.get_node( f ) );
+
+  write_binary_network( ntk, filename );
+  const auto ntk2 = read_binary_network<Ntk>( filename );
+  std::remove( filename.c_str() );
+
+  REQUIRE( ntk2 );
+  check_same_storage( ntk, *ntk2 );
+}
+
+TEST_CASE( "write and read networks in binary format", "[binary_network]" )
+{
+  check_roundtrip<aig_network>( "aig.bin" );
+  check_roundtrip<xag_network>( "xag.bin" );
+  check_roundtrip<mig_network>( "mig.bin" );
+  check_roundtrip<xmg_network>( "xmg.bin" );
+}
+
+TEST_CASE( "write and read k-LUT network in binary format", "[binary_network]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt( 3u );
+  kitty::create_from_hex_string( tt, "e1" );
+  const auto f1 = klut.create_node( { a, b, c }, tt );
+  const auto f2 = klut.create_and( f1, c );
+  klut.create_po( f2 );
+  klut.create_po( klut.create_not( f1 ) );
+
+  write_binary_network( klut, "klut.bin" );
+  const auto klut2 = read_binary_network<klut_network>( "klut.bin" );
+  std::remove( "klut.bin" );
+
+  REQUIRE( klut2 );
+  CHECK( klut.size() == klut2->size() );
+  CHECK( klut._storage->fanins == klut2->_storage->fanins );
+  CHECK( klut._storage->inputs == klut2->_storage->inputs );
+  CHECK( klut._storage->outputs == klut2->_storage->outputs );
+  CHECK( klut._storage->hash == klut2->_storage->hash );
+  CHECK( klut._storage->data.cache.size() == klut2->_storage->data.cache.size() );
+
+  klut.foreach_node( [&]( auto const& n ) {
+    CHECK( klut.node_function( n ) == klut2->node_function( n ) );
+    CHECK( klut.fanout_size( n ) == klut2->fanout_size( n ) );
+  } );
+
+  /* structural hashing and the truth table cache are restored */
+  auto klut3 = *klut2;
+  CHECK( klut3.create_node( { a, b, c }, tt ) == f1 );
+  CHECK( klut3.create_and( f1, c ) == f2 );
+  CHECK( klut3.size() == klut.size() );
+}
+
+TEST_CASE( "write and read sequential network in binary format", "[binary_network]" )
+{
+  sequential<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r = aig.create_ro();
+  aig.create_po( aig.create_and( a, r ) );
+  aig.create_ri( aig.create_xor( b, r ) );
+
+  mockturtle::register_t reg;
+  reg.control = "clk";
+  reg.init = 1;
+  reg.type = "re";
+  aig.set_register( 0, reg );
+
+  write_binary_network( aig, "seq.bin" );
+  const auto aig2 = read_binary_network<sequential<aig_network>>( "seq.bin" );
+
+  /* a register count that does not fit into the section is rejected before allocating the registers */
+  {
+    const auto entry = offsetof( detail::binary_network_header, sections ) +
+                       static_cast<uint32_t>( detail::binary_network_section::registers ) * sizeof( detail::binary_network_section_entry ) +
+                       offsetof( detail::binary_network_section_entry, count );
+    std::fstream fs( "seq.bin", std::ios::in | std::ios::out | std::ios::binary );
+    fs.seekp( entry );
+    const auto count = UINT64_C( 1 ) << 60u;
+    fs.write( reinterpret_cast<char const*>( &count ), sizeof( count ) );
+  }
+  CHECK( !read_binary_network<sequential<aig_network>>( "seq.bin" ) );
+  std::remove( "seq.bin" );
+
+  REQUIRE( aig2 );
+  CHECK( aig2->num_pis() == 2u );
+  CHECK( aig2->num_pos() == 1u );
+  CHECK( aig2->num_registers() == 1u );
+  CHECK( aig2->register_at( 0 ).control == "clk" );
+  CHECK( aig2->register_at( 0 ).init == 1 );
+  CHECK( aig2->register_at( 0 ).type == "re" );
+  CHECK( aig._storage->nodes == aig2->_storage->nodes );
+  CHECK( aig._storage->outputs == aig2->_storage->outputs );
+}
+
+TEST_CASE( "map network with copy-on-write storage from binary file", "[binary_network]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  /* more than one page of nodes */
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    fs.push_back( aig.create_and( fs[( i * 7919u ) % fs.size()], !fs[( i * 104729u + 1u ) % fs.size()] ) );
+  }
+  aig.create_po( fs.back() );
+
+  /* both storage types use the same format */
+  write_binary_network( aig, "aig_cow.bin" );
+  auto cow = read_binary_network<aig_cow_network>( "aig_cow.bin" );
+  REQUIRE( cow );
+  CHECK( cow->_storage->hash.is_deferred() );
+  CHECK( cow->size() == aig.size() );
+  CHECK( cow->num_gates() == aig.num_gates() );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( cow->fanout_size( n ) == aig.fanout_size( n ) );
+  } );
+
+  /* structural hashing is rebuilt on first access */
+  const auto size = cow->size();
+  CHECK( cow->create_and( fs[64], !fs[65] ) == aig.create_and( fs[64], !fs[65] ) );
+  CHECK( !cow->_storage->hash.is_deferred() );
+  CHECK( cow->_storage->hash.size() == aig._storage->hash.size() );
+  CHECK( cow->size() == size );
+
+  /* modifications are not written back into the file */
+  cow->substitute_node( aig.get_node( fs[100] ), fs[0] );
+  cow->create_po( cow->create_and( fs[1], fs[2] ) );
+  auto cow2 = read_binary_network<aig_cow_network>( "aig_cow.bin" );
+  std::remove( "aig_cow.bin" );
+  REQUIRE( cow2 );
+  CHECK( cow2->size() == aig.size() );
+  CHECK( cow2->num_pos() == 1u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( cow2->fanout_size( n ) == aig.fanout_size( n ) );
+  } );
+
+  /* snapshots share the mapped pages */
+  cow2->fork();
+  cow2->create_po( cow2->create_and( fs[3], fs[4] ) );
+  cow2->rollback();
+  CHECK( cow2->num_pos() == 1u );
+  CHECK( cow2->size() == aig.size() );
+}
+
+TEST_CASE( "map trusted binary file without validation", "[binary_network]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  aig_network aig;
+  create_full_adder( aig );
+  write_binary_network( aig, "aig_trusted.bin" );
+
+  auto cow = read_binary_network<aig_cow_network>( "aig_trusted.bin", false );
+  auto copy = read_binary_network<aig_network>( "aig_trusted.bin", false );
+  std::remove( "aig_trusted.bin" );
+  REQUIRE( cow );
+  REQUIRE( copy );
+  CHECK( cow->_storage->hash.is_deferred() );
+  CHECK( cow->size() == aig.size() );
+  CHECK( copy->size() == aig.size() );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( cow->fanout_size( n ) == aig.fanout_size( n ) );
+    CHECK( copy->fanout_size( n ) == aig.fanout_size( n ) );
+  } );
+
+  /* the hash table is rebuilt from the mapped nodes */
+  aig.foreach_gate( [&]( auto const& n ) {
+    std::vector<aig_network::signal> children;
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      children.push_back( f );
+    } );
+    CHECK( cow->create_and( children[0], children[1] ) == aig.make_signal( n ) );
+  } );
+  CHECK( cow->size() == aig.size() );
+}
+
+TEST_CASE( "reject incompatible binary network files", "[binary_network]" )
+{
+  aig_network aig;
+  aig.create_po( aig.create_and( aig.create_pi(), aig.create_pi() ) );
+  write_binary_network( aig, "aig.bin" );
+
+  CHECK( read_binary_network<aig_network>( "aig.bin" ) );
+  CHECK( !read_binary_network<xag_network>( "aig.bin" ) );
+  CHECK( !read_binary_network<mig_network>( "aig.bin" ) );
+  CHECK( !read_binary_network<aig_network>( "missing.bin" ) );
+
+  /* corrupt the magic number */
+  {
+    std::fstream fs( "aig.bin", std::ios::in | std::ios::out | std::ios::binary );
+    fs.put( 'x' );
+  }
+  CHECK( !read_binary_network<aig_network>( "aig.bin" ) );
+  std::remove( "aig.bin" );
+}
+
+/* overwrites a word at a byte position of a section */
+template<typename T>
+void patch_section( std::string const& filename, detail::binary_network_section id, uint64_t position, T value )
+{
+  std::fstream fs( filename, std::ios::in | std::ios::out | std::ios::binary );
+  detail::binary_network_header header;
+  fs.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+  fs.seekp( header.sections[static_cast<uint32_t>( id )].offset + position );
+  fs.write( reinterpret_cast<char const*>( &value ), sizeof( value ) );
+}
+
+TEST_CASE( "reject binary network files with invalid indexes", "[binary_network]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+  using section = detail::binary_network_section;
+
+  aig_network aig;
+  create_full_adder( aig );
+  const auto node_size = sizeof( aig_network::storage::element_type::node_type );
+
+  const auto check_aig = [&]( section id, uint64_t position, uint64_t value, bool always_checked ) {
+    write_binary_network( aig, "aig.bin" );
+    CHECK( read_binary_network<aig_network>( "aig.bin" ) );
+    CHECK( read_binary_network<aig_cow_network>( "aig.bin" ) );
+    patch_section( "aig.bin", id, position, value );
+    CHECK( !read_binary_network<aig_network>( "aig.bin" ) );
+    CHECK( !read_binary_network<aig_cow_network>( "aig.bin" ) );
+
+    /* without validation, the nodes are not read when opening the file */
+    CHECK( read_binary_network<aig_cow_network>( "aig.bin", false ).has_value() == !always_checked );
+    std::remove( "aig.bin" );
+  };
+
+  /* hashed node, fan-in of the last gate, primary input, primary output */
+  check_aig( section::strash, 0u, aig.size(), false );
+  check_aig( section::nodes, ( aig.size() - 1u ) * node_size, uint64_t( aig.size() ) << 1u, false );
+  check_aig( section::inputs, 0u, aig.size(), true );
+  check_aig( section::outputs, 0u, uint64_t( aig.size() ) << 1u, true );
+
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  klut.create_po( klut.create_and( a, b ) );
+  const auto gate_offset = 4u * sizeof( klut_network::storage::element_type::node_type );
+
+  const auto check_klut = [&]( section id, uint64_t position, auto value ) {
+    write_binary_network( klut, "klut.bin" );
+    CHECK( read_binary_network<klut_network>( "klut.bin" ) );
+    patch_section( "klut.bin", id, position, value );
+    CHECK( !read_binary_network<klut_network>( "klut.bin" ) );
+    std::remove( "klut.bin" );
+  };
+
+  /* hashed node, fan-in offset and size, fan-in, function literal */
+  check_klut( section::strash, sizeof( uint64_t ), uint64_t( klut.size() ) );
+  check_klut( section::nodes, gate_offset, uint32_t( 1u ) );
+  check_klut( section::nodes, gate_offset + sizeof( uint32_t ), uint32_t( 3u ) );
+  check_klut( section::fanins, 0u, uint64_t( klut.size() ) );
+  check_klut( section::nodes, gate_offset + 2u * sizeof( uint64_t ), uint32_t( 1000u ) );
+
+  /* truth table with more words than stored, rejected before allocating it */
+  check_klut( section::truth_tables, 0u, uint64_t( 32u ) );
+}
@@ -0,0 +1,89 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/read_patterns.hpp>
+#include <mockturtle/io/write_patterns.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "read patterns in blocks", "[read_patterns]" )
+{
+  const partial_simulator sim( 5u, 1003u );
+  write_patterns( sim, "patterns_blocks.txt" );
+  const auto patterns = sim.get_patterns();
+
+  for ( auto words : { 1u, 3u, 16u, 100u } )
+  {
+    pattern_block_reader reader( "patterns_blocks.txt", words );
+    CHECK( reader.is_valid() );
+    CHECK( reader.num_pis() == 5u );
+    CHECK( reader.num_patterns() == 1004u ); /* rounded up to hex characters */
+
+    std::vector<kitty::partial_truth_table> block;
+    uint64_t num_patterns = 0u;
+    while ( reader.next( block ) )
+    {
+      CHECK( reader.block_offset() == num_patterns );
+      CHECK( block.size() == 5u );
+      for ( auto i = 0u; i < 5u; ++i )
+      {
+        CHECK( block[i].num_bits() <= 64u * words );
+        for ( auto b = 0u; b < block[i].num_bits(); ++b )
+        {
+          const auto bit = num_patterns + b;
+          CHECK( kitty::get_bit( block[i], b ) == ( bit < 1003u && kitty::get_bit( patterns[i], bit ) ) );
+        }
+      }
+      num_patterns += block[0].num_bits();
+    }
+    CHECK( num_patterns == 1004u );
+  }
+
+  /* restrict the number of patterns */
+  pattern_block_reader reader( "patterns_blocks.txt", 4u, 300u );
+  CHECK( reader.num_patterns() == 300u );
+  std::vector<kitty::partial_truth_table> block;
+  CHECK( reader.next( block ) );
+  CHECK( block[0].num_bits() == 256u );
+  CHECK( reader.next( block ) );
+  CHECK( block[0].num_bits() == 44u );
+  CHECK( !reader.next( block ) );
+
+  reader.rewind();
+  CHECK( reader.next( block ) );
+  CHECK( reader.block_offset() == 0u );
+
+  std::remove( "patterns_blocks.txt" );
+}
+
+TEST_CASE( "reject pattern files with lines of different length", "[read_patterns]" )
+{
+  {
+    std::ofstream out( "patterns_invalid.txt" );
+    out << "0f3a\n12\n";
+  }
+  CHECK( !pattern_block_reader( "patterns_invalid.txt" ).is_valid() );
+  std::remove( "patterns_invalid.txt" );
+
+  CHECK( !pattern_block_reader( "patterns_missing.txt" ).is_valid() );
+}
+
+TEST_CASE( "reject pattern files with invalid characters", "[read_patterns]" )
+{
+  {
+    std::ofstream out( "patterns_invalid.txt" );
+    out << "0f3a\n1g2b\n";
+  }
+  pattern_block_reader reader( "patterns_invalid.txt" );
+  CHECK( !reader.is_valid() );
+
+  std::vector<kitty::partial_truth_table> block;
+  CHECK( !reader.next( block ) );
+  std::remove( "patterns_invalid.txt" );
+}
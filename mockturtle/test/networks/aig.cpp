@@ -1,13 +1,19 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/views/topo_view.hpp>
 
 using namespace mockturtle;
 
@@ -963,3 +969,390 @@ TEST_CASE( "substitute node with dependency in aig_network", "[aig]" )
     CHECK( aig.is_dead( aig.get_node( s ) ) == false );
   } );
 }
+
+TEST_CASE( "compact AIG with dead nodes", "[aig]" )
+{
+  aig_network aig;
+
+  CHECK( has_compact_v<aig_network> );
+  static_assert( has_compact_v<basic_aig_network<aig_soa_storage>> );
+  static_assert( has_compact_v<basic_aig_network<aig_cow_storage>> );
+  static_assert( !has_compact_v<basic_aig_network<aig_concurrent_storage>> );
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, !c );
+  aig.create_po( f2 );
+  aig.create_po( !f1 );
+
+  /* f4 is created after f2 but becomes its fan-in */
+  const auto f3 = aig.create_and( a, c );
+  const auto f4 = aig.create_and( !f3, b );
+  aig.substitute_node( aig.get_node( f1 ), f4 );
+
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( aig.size() == 8u );
+
+  /* simulate in topological order, since the node order is not topological before compaction */
+  const auto tts_before = simulate<kitty::static_truth_table<3u>>( topo_view{ aig } );
+
+  node_map<uint32_t, aig_network> values( aig );
+  aig.foreach_node( [&]( auto const& n ) { values[n] = static_cast<uint32_t>( n ); } );
+
+  const auto old_to_new = aig.compact();
+
+  CHECK( aig.size() == 7u );
+  CHECK( aig.num_gates() == 3u );
+  CHECK( old_to_new.size() == 8u );
+  CHECK( old_to_new[aig.get_node( f1 )] == std::numeric_limits<uint64_t>::max() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == tts_before );
+
+  /* nodes are in topological order and the hash table is rebuilt */
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( !aig.is_dead( n ) );
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( aig.get_node( f ) < n );
+    } );
+  } );
+  const auto new_f3 = aig.make_signal( old_to_new[aig.get_node( f3 )] );
+  const auto new_f4 = aig.make_signal( old_to_new[aig.get_node( f4 )] );
+  CHECK( aig.create_and( b, !new_f3 ) == new_f4 );
+  CHECK( aig.size() == 7u );
+
+  values.remap( old_to_new );
+  CHECK( values.size() == aig.size() );
+  for ( auto i = 0u; i < old_to_new.size(); ++i )
+  {
+    if ( old_to_new[i] != std::numeric_limits<uint64_t>::max() )
+    {
+      CHECK( values[old_to_new[i]] == i );
+    }
+  }
+}
+
+TEST_CASE( "copy-on-write snapshots in AIGs", "[aig]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  CHECK( is_network_type_v<aig_cow_network> );
+  CHECK( has_fork_v<aig_cow_network> );
+  CHECK( has_commit_v<aig_cow_network> );
+  CHECK( has_rollback_v<aig_cow_network> );
+  CHECK( !has_fork_v<aig_network> );
+
+  aig_cow_network aig;
+  std::vector<aig_cow_network::signal> pis( 16u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, std::vector( pis.begin(), pis.begin() + 8u ), std::vector( pis.begin() + 8u, pis.end() ) ) )
+  {
+    aig.create_po( f );
+  }
+
+  const auto size = aig.size();
+  const auto num_gates = aig.num_gates();
+  const auto tts = simulate<kitty::static_truth_table<16u>>( aig );
+
+  /* rollback restores the state of fork */
+  aig.fork();
+  CHECK( aig._storage->nodes.num_shared_pages() > 0u );
+  const auto g = aig.create_and( pis[0], !pis[15] );
+  aig.create_po( g );
+  aig.substitute_node( aig.get_node( aig.po_at( 3u ) ), g );
+  CHECK( aig.num_pos() == 17u );
+  CHECK( aig.size() != size );
+  aig.rollback();
+
+  CHECK( aig._storage->snapshots.empty() );
+  CHECK( aig.size() == size );
+  CHECK( aig.num_gates() == num_gates );
+  CHECK( aig.num_pos() == 16u );
+  CHECK( simulate<kitty::static_truth_table<16u>>( aig ) == tts );
+
+  /* structural hashing sees the restored hash table */
+  const auto h = aig.create_and( pis[0], !pis[15] );
+  CHECK( aig.size() == size + 1u );
+  CHECK( aig.create_and( !pis[15], pis[0] ) == h );
+
+  /* nested snapshots, the inner one is committed */
+  aig.fork();
+  aig.create_po( h );
+  aig.fork();
+  aig.create_po( aig.create_and( h, pis[1] ) );
+  aig.commit();
+  CHECK( aig.num_pos() == 18u );
+  CHECK( aig.num_gates() == num_gates + 2u );
+  aig.rollback();
+  CHECK( aig.num_pos() == 16u );
+  CHECK( aig.num_gates() == num_gates + 1u );
+
+  /* clones share pages but are independent */
+  aig.create_po( h );
+  auto copy = aig.clone();
+  copy.substitute_node( aig.get_node( h ), copy.get_constant( false ) );
+  CHECK( copy.num_gates() == num_gates );
+  CHECK( aig.num_gates() == num_gates + 1u );
+  CHECK( !aig.is_dead( aig.get_node( h ) ) );
+  CHECK( aig.po_at( 16u ) == h );
+  const auto tts_after = simulate<kitty::static_truth_table<16u>>( aig );
+  CHECK( std::equal( tts.begin(), tts.end(), tts_after.begin() ) );
+}
+
+TEST_CASE( "read-only traversal of a forked AIG copies no pages", "[aig]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  aig_cow_network aig;
+  std::vector<aig_cow_network::signal> as( 32u ), bs( 32u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, as, bs ) )
+  {
+    aig.create_po( f );
+  }
+
+  aig.fork();
+  const auto num_pages = aig._storage->nodes.num_shared_pages();
+  CHECK( num_pages > 1u );
+
+  uint64_t checksum{ 0 };
+  aig.foreach_node( [&]( auto const& n ) {
+    checksum += aig.is_constant( n ) + aig.is_pi( n ) + aig.is_ci( n ) + aig.is_dead( n );
+    checksum += aig.fanout_size( n ) + aig.value( n ) + aig.visited( n );
+    if ( aig.is_pi( n ) )
+    {
+      checksum += aig.pi_index( n );
+      return;
+    }
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      checksum += aig.get_node( f ) + aig.is_complemented( f );
+    } );
+    checksum += aig.is_and( n );
+  } );
+  aig.foreach_pi( [&]( auto const& n ) { checksum += n; } );
+  aig.foreach_po( [&]( auto const& f ) { checksum += aig.get_node( f ); } );
+  CHECK( checksum > 0u );
+
+  partial_simulator sim( aig.num_pis(), 64u );
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+  CHECK( tts.size() == aig.size() );
+
+  /* no page has been copied */
+  CHECK( aig._storage->nodes.num_shared_pages() == num_pages );
+  aig.commit();
+}
+
+TEST_CASE( "substitution in a forked AIG copies only the modified pages", "[aig]" )
+{
+  using aig_cow_network = basic_aig_network<aig_cow_storage>;
+
+  aig_cow_network aig;
+  std::vector<aig_cow_network::signal> as( 64u ), bs( 64u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, as, bs ) )
+  {
+    aig.create_po( f );
+  }
+
+  aig.fork();
+  const auto num_pages = aig._storage->nodes.num_shared_pages();
+  CHECK( num_pages > 4u );
+
+  /* the fanouts of a partial product are all on the first page */
+  const auto n = aig.get_node( aig.create_and( as[0u], bs[0u] ) );
+  const auto size = aig.size();
+  aig.substitute_node( n, aig.create_and( as[1u], bs[1u] ) );
+  CHECK( aig.size() == size );
+  CHECK( aig._storage->nodes.num_shared_pages() >= num_pages - 2u );
+
+  aig.rollback();
+  CHECK( aig.size() == size );
+  CHECK( aig.fanout_size( n ) > 0u );
+}
+
+namespace
+{
+
+struct event_counter
+{
+  template<class Ntk>
+  void on_add( Ntk const&, node<Ntk> const& )
+  {
+    ++num_added;
+  }
+
+  template<class Ntk>
+  void on_delete( Ntk const&, node<Ntk> const& n )
+  {
+    deleted.push_back( n );
+  }
+
+  uint32_t num_added{ 0 };
+  std::vector<uint64_t> deleted;
+};
+
+struct level_listener
+{
+  template<class Ntk>
+  void on_add( Ntk const& ntk, node<Ntk> const& n )
+  {
+    levels.resize( ntk.size() );
+    uint32_t level{ 0 };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.get_node( f )] + 1u );
+    } );
+    levels[n] = level;
+  }
+
+  template<class Ntk, class Children>
+  void on_modified( Ntk const& ntk, node<Ntk> const& n, Children const& previous_children )
+  {
+    CHECK( previous_children.size() == 2u );
+    previous.assign( previous_children.begin(), previous_children.end() );
+    on_add( ntk, n );
+  }
+
+  std::vector<uint32_t> levels;
+  std::vector<aig_signal> previous;
+};
+
+} // namespace
+
+TEST_CASE( "static event listeners in AIGs", "[aig]" )
+{
+  using aig_listener_network = basic_aig_network<aig_storage, listeners<event_counter, level_listener>>;
+
+  CHECK( is_network_type_v<aig_listener_network> );
+  CHECK( is_aig_network_type_v<aig_listener_network> );
+
+  aig_listener_network aig;
+  auto& counter = static_cast<event_counter&>( aig.events().listener );
+  auto& levels = static_cast<level_listener&>( aig.events().listener );
+
+  std::vector<uint64_t> dynamic_added;
+  auto add_event = aig.events().register_add_event( [&]( auto const& n ) {
+    /* static listeners are called first */
+    CHECK( counter.num_added == dynamic_added.size() + 1u );
+    dynamic_added.push_back( n );
+  } );
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, !a );
+  aig.create_and( b, a ); /* structural hashing, no event */
+  aig.create_po( f3 );
+
+  CHECK( counter.num_added == 3u );
+  CHECK( dynamic_added == std::vector<uint64_t>{ aig.get_node( f1 ), aig.get_node( f2 ), aig.get_node( f3 ) } );
+  CHECK( levels.levels[aig.get_node( f3 )] == 3u );
+
+  /* f2 is deleted and f3 is modified */
+  aig.substitute_node( aig.get_node( f2 ), f1 );
+  CHECK( counter.deleted == std::vector<uint64_t>{ aig.get_node( f2 ) } );
+  CHECK( levels.previous == std::vector<aig_signal>{ !a, f2 } );
+  CHECK( levels.levels[aig.get_node( f3 )] == 2u );
+
+  aig.events().release_add_event( add_event );
+  aig.create_and( a, c );
+  CHECK( counter.num_added == 4u );
+  CHECK( dynamic_added.size() == 3u );
+}
+
+TEST_CASE( "concurrent node creation in AIGs", "[aig]" )
+{
+  using aig_concurrent_network = basic_aig_network<aig_concurrent_storage>;
+
+  aig_network aig;
+  aig_concurrent_network conc;
+
+  std::vector<aig_network::signal> as( 6u ), bs( 6u );
+  std::vector<aig_concurrent_network::signal> cas( 6u ), cbs( 6u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  std::generate( cas.begin(), cas.end(), [&]() { return conc.create_pi(); } );
+  std::generate( cbs.begin(), cbs.end(), [&]() { return conc.create_pi(); } );
+
+  for ( auto const& f : carry_ripple_multiplier( aig, as, bs ) )
+  {
+    aig.create_po( f );
+  }
+
+  /* all threads build the same multiplier, which must be shared */
+  std::vector<std::vector<aig_concurrent_network::signal>> outputs( 4u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < outputs.size(); ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      outputs[t] = carry_ripple_multiplier( conc, cas, cbs );
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  for ( auto t = 1u; t < outputs.size(); ++t )
+  {
+    CHECK( outputs[t] == outputs[0] );
+  }
+  for ( auto const& f : outputs[0] )
+  {
+    conc.create_po( f );
+  }
+
+  CHECK( conc.size() == aig.size() );
+  CHECK( conc.num_gates() == aig.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<12u>>( conc ) == simulate<kitty::static_truth_table<12u>>( aig ) );
+
+  /* fan-out sizes only count the shared nodes once */
+  uint32_t fanout_aig{ 0 }, fanout_conc{ 0 };
+  aig.foreach_node( [&]( auto const& n ) { fanout_aig += aig.fanout_size( n ); } );
+  conc.foreach_node( [&]( auto const& n ) { fanout_conc += conc.fanout_size( n ); } );
+  CHECK( fanout_conc == fanout_aig );
+
+  /* gates are in topological order */
+  conc.foreach_gate( [&]( auto const& n ) {
+    conc.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( conc.get_node( f ) < n );
+    } );
+  } );
+}
+
+TEST_CASE( "compact literals in AIGs", "[aig]" )
+{
+  using aig_compact_network = basic_aig_network<aig_compact_storage>;
+
+  CHECK( is_network_type_v<aig_compact_network> );
+  CHECK( sizeof( aig_compact_storage::node_type::pointer_type ) == 4u );
+  CHECK( sizeof( aig_compact_storage::node_type ) < sizeof( aig_storage::node_type ) );
+
+  aig_compact_network ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_and( a, b );
+  auto const f2 = ntk.create_and( b, a );
+  auto const f3 = ntk.create_and( f1, c );
+  ntk.create_po( f3 );
+  ntk.create_po( !f1 );
+
+  /* structural hashing */
+  CHECK( f1 == f2 );
+  CHECK( ntk.num_gates() == 2u );
+  CHECK( ntk.fanout_size( ntk.get_node( f1 ) ) == 2u );
+  CHECK( ntk.is_complemented( ntk.po_at( 1u ) ) );
+
+  node_map<uint32_t, aig_compact_network> ids( ntk );
+  ntk.foreach_node( [&]( auto const& n, auto i ) {
+    ids[n] = i;
+  } );
+  CHECK( ids[f3] == ntk.size() - 1u );
+
+  aig_network ref = cleanup_dangling<aig_compact_network, aig_network>( ntk );
+  CHECK( simulate<kitty::static_truth_table<3u>>( ntk ) == simulate<kitty::static_truth_table<3u>>( ref ) );
+}
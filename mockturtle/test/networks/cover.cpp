@@ -522,3 +522,40 @@ TEST_CASE( "visited values in cover networks", "[cover]" )
     CHECK( cover.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "copy-on-write snapshots in cover networks", "[cover]" )
+{
+  using cover_cow_network = basic_cover_network<cover_cow_storage>;
+
+  CHECK( has_fork_v<cover_cow_network> );
+  CHECK( has_commit_v<cover_cow_network> );
+  CHECK( has_rollback_v<cover_cow_network> );
+  CHECK( !has_fork_v<cover_network> );
+
+  cover_cow_network cover;
+  const auto a = cover.create_pi();
+  const auto b = cover.create_pi();
+
+  std::vector<kitty::cube> _nand{ kitty::cube( "00" ), kitty::cube( "01" ), kitty::cube( "11" ) };
+  const auto n1 = cover.create_cover_node( { a, b }, std::make_pair( _nand, true ) );
+  const auto n2 = cover.create_cover_node( { a, n1 }, std::make_pair( _nand, true ) );
+  cover.create_po( n2 );
+
+  const auto size = cover.size();
+  const auto num_covers = cover._storage->data.covers.size();
+
+  cover.fork();
+  const auto n3 = cover.create_and( a, b );
+  cover.substitute_node( n1, n3 );
+  CHECK( cover.size() == size + 1u );
+  CHECK( cover.fanout_size( n3 ) == 1u );
+  cover.rollback();
+
+  CHECK( cover.size() == size );
+  CHECK( cover.fanout_size( n1 ) == 1u );
+  std::vector<cover_cow_network::node> fanins;
+  cover.foreach_fanin( n2, [&]( auto const& f ) { fanins.push_back( cover.get_node( f ) ); } );
+  CHECK( fanins == std::vector<cover_cow_network::node>{ a, n1 } );
+  CHECK( cover._storage->data.covers.size() == num_covers );
+  CHECK( cover.create_cover_node( { a, n1 }, std::make_pair( _nand, true ) ) == size );
+}
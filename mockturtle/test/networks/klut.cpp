@@ -284,6 +284,45 @@ TEST_CASE( "subsitute node by another", "[klut]" )
   } );
 }
 
+TEST_CASE( "fan-ins of k-LUT nodes are stored in one pool", "[klut]" )
+{
+  klut_network klut;
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt_and( 2u ), tt_maj( 3u );
+  kitty::create_from_hex_string( tt_and, "8" );
+  kitty::create_from_hex_string( tt_maj, "e8" );
+
+  const auto n1 = klut.create_node( { a, b }, tt_and );
+  const auto n2 = klut.create_node( { a, b, c }, tt_maj );
+  const auto n3 = klut.create_node( { n1, n2 }, tt_and );
+  klut.create_po( n3 );
+
+  CHECK( klut._storage->fanins.size() == 7u );
+  CHECK( klut.fanin_size( n1 ) == 2u );
+  CHECK( klut.fanin_size( n2 ) == 3u );
+
+  /* structural hashing does not grow the pool */
+  CHECK( klut.create_node( { a, b, c }, tt_maj ) == n2 );
+  CHECK( klut._storage->fanins.size() == 7u );
+
+  /* substitution rewrites the fan-ins in place */
+  klut.substitute_node( n1, c );
+  CHECK( klut._storage->fanins.size() == 7u );
+
+  std::vector<klut_network::node> fanins;
+  klut.foreach_fanin( n3, [&]( auto const& f ) { fanins.push_back( klut.get_node( f ) ); } );
+  CHECK( fanins == std::vector<klut_network::node>{ c, n2 } );
+
+  /* the old structure of a modified node is not matched anymore */
+  const auto n4 = klut.create_node( { n1, n2 }, tt_and );
+  CHECK( n4 != n3 );
+  CHECK( klut.create_node( { n1, n2 }, tt_and ) == n4 );
+}
+
 TEST_CASE( "structural properties of a k-LUT network", "[klut]" )
 {
   klut_network klut;
@@ -457,3 +496,72 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "copy-on-write snapshots in k-LUT networks", "[klut]" )
+{
+  using klut_cow_network = basic_klut_network<klut_cow_storage>;
+  using node = klut_cow_network::node;
+
+  CHECK( is_network_type_v<klut_cow_network> );
+  CHECK( has_fork_v<klut_cow_network> );
+  CHECK( has_commit_v<klut_cow_network> );
+  CHECK( has_rollback_v<klut_cow_network> );
+  CHECK( !has_fork_v<klut_network> );
+
+  klut_cow_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto f1 = klut.create_maj( a, b, c );
+  const auto f2 = klut.create_xor( f1, c );
+  klut.create_po( f2 );
+
+  const auto size = klut.size();
+
+  /* rollback restores the state of fork */
+  klut.fork();
+  CHECK( klut._storage->nodes.num_shared_pages() > 0u );
+  CHECK( klut._storage->fanins.num_shared_pages() > 0u );
+  klut.create_po( klut.create_and( a, f2 ) );
+  klut.substitute_node( klut.get_node( f1 ), klut.create_or( a, b ) );
+  CHECK( klut.size() == size + 2u );
+  CHECK( klut.num_pos() == 2u );
+  klut.rollback();
+
+  CHECK( klut._storage->snapshots.empty() );
+  CHECK( klut.size() == size );
+  CHECK( klut.num_pos() == 1u );
+  CHECK( klut.fanout_size( f1 ) == 1u );
+
+  std::vector<node> fanins;
+  klut.foreach_fanin( f2, [&]( auto const& f ) { fanins.push_back( klut.get_node( f ) ); } );
+  CHECK( fanins == std::vector<node>{ f1, c } );
+
+  /* structural hashing sees the restored hash table */
+  CHECK( klut.create_xor( f1, c ) == f2 );
+  const auto g = klut.create_and( a, f2 );
+  CHECK( klut.size() == size + 1u );
+
+  /* nested snapshots, the inner one is committed */
+  klut.fork();
+  klut.create_po( g );
+  klut.fork();
+  klut.create_po( klut.create_lt( g, b ) );
+  klut.commit();
+  CHECK( klut.num_pos() == 3u );
+  klut.rollback();
+  CHECK( klut.num_pos() == 1u );
+  CHECK( klut.size() == size + 1u );
+
+  /* read-only traversals copy no pages */
+  klut.fork();
+  const auto num_shared = klut._storage->nodes.num_shared_pages() + klut._storage->fanins.num_shared_pages();
+  uint64_t checksum{ 0 };
+  klut.foreach_gate( [&]( auto const& n ) {
+    checksum += klut.fanout_size( n ) + klut.value( n ) + klut.visited( n ) + klut.node_function( n ).num_vars();
+    klut.foreach_fanin( n, [&]( auto const& f ) { checksum += klut.get_node( f ); } );
+  } );
+  CHECK( checksum > 0u );
+  CHECK( klut._storage->nodes.num_shared_pages() + klut._storage->fanins.num_shared_pages() == num_shared );
+  klut.commit();
+}
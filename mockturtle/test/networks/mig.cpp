@@ -840,3 +840,143 @@ TEST_CASE( "substitute node with dependency in mig_network", "[mig]" )
     CHECK( mig.is_dead( mig.get_node( s ) ) == false );
   } );
 }
+
+TEST_CASE( "compact literals in MIGs", "[mig]" )
+{
+  using mig_compact_network = basic_mig_network<mig_compact_storage>;
+
+  CHECK( is_network_type_v<mig_compact_network> );
+  CHECK( sizeof( mig_compact_storage::node_type::pointer_type ) == 4u );
+  CHECK( sizeof( mig_compact_storage::node_type ) < sizeof( mig_storage::node_type ) );
+
+  mig_compact_network ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_maj( a, b, c );
+  auto const f2 = ntk.create_maj( c, a, b );
+  auto const f3 = ntk.create_maj( f1, !a, c );
+  ntk.create_po( f3 );
+  ntk.create_po( !f1 );
+
+  /* structural hashing */
+  CHECK( f1 == f2 );
+  CHECK( ntk.num_gates() == 2u );
+  CHECK( ntk.fanout_size( ntk.get_node( f1 ) ) == 2u );
+  CHECK( ntk.is_complemented( ntk.po_at( 1u ) ) );
+
+  node_map<uint32_t, mig_compact_network> ids( ntk );
+  ntk.foreach_node( [&]( auto const& n, auto i ) {
+    ids[n] = i;
+  } );
+  CHECK( ids[f3] == ntk.size() - 1u );
+
+  mig_network ref = cleanup_dangling<mig_compact_network, mig_network>( ntk );
+  CHECK( simulate<kitty::static_truth_table<3u>>( ntk ) == simulate<kitty::static_truth_table<3u>>( ref ) );
+}
+
+TEST_CASE( "copy-on-write snapshots in MIGs", "[mig]" )
+{
+  using mig_cow_network = basic_mig_network<mig_cow_storage>;
+
+  CHECK( is_network_type_v<mig_cow_network> );
+  CHECK( has_fork_v<mig_cow_network> );
+  CHECK( !has_rollback_v<mig_network> );
+
+  mig_cow_network mig;
+  auto const a = mig.create_pi();
+  auto const b = mig.create_pi();
+  auto const c = mig.create_pi();
+  auto const f1 = mig.create_maj( a, b, c );
+  auto const f2 = mig.create_maj( f1, !a, c );
+  mig.create_po( f2 );
+
+  auto const tts = simulate<kitty::static_truth_table<3u>>( mig );
+
+  mig.fork();
+  mig.substitute_node( mig.get_node( f1 ), mig.create_and( a, b ) );
+  CHECK( mig.is_dead( mig.get_node( f1 ) ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig ) != tts );
+  mig.rollback();
+
+  CHECK( !mig.is_dead( mig.get_node( f1 ) ) );
+  CHECK( mig.num_gates() == 2u );
+  CHECK( mig.fanout_size( mig.get_node( f1 ) ) == 1u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig ) == tts );
+  CHECK( mig.create_maj( c, b, a ) == f1 );
+
+  mig.fork();
+  mig.create_po( mig.create_maj( f1, f2, !b ) );
+  mig.commit();
+  CHECK( mig.num_pos() == 2u );
+  CHECK( mig.num_gates() == 3u );
+}
+
+namespace
+{
+
+struct mig_event_recorder
+{
+  template<class Ntk>
+  void on_add( Ntk const&, node<Ntk> const& n )
+  {
+    added.push_back( n );
+  }
+
+  template<class Ntk, class Children>
+  void on_modified( Ntk const&, node<Ntk> const& n, Children const& previous_children )
+  {
+    modified.push_back( n );
+    num_previous_children = previous_children.size();
+  }
+
+  template<class Ntk>
+  void on_delete( Ntk const&, node<Ntk> const& n )
+  {
+    deleted.push_back( n );
+  }
+
+  std::vector<uint64_t> added, modified, deleted;
+  uint32_t num_previous_children{ 0 };
+};
+
+} // namespace
+
+TEST_CASE( "static event listeners in MIGs", "[mig]" )
+{
+  using mig_listener_network = basic_mig_network<mig_storage, mig_event_recorder>;
+
+  CHECK( is_network_type_v<mig_listener_network> );
+  CHECK( is_mig_network_type_v<mig_listener_network> );
+
+  mig_listener_network mig;
+  auto const& recorder = mig.events().listener;
+
+  uint32_t dynamic_added{ 0 };
+  auto add_event = mig.events().register_add_event( [&]( auto const& ) {
+    /* static listeners are called first */
+    CHECK( recorder.added.size() == dynamic_added + 1u );
+    ++dynamic_added;
+  } );
+
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  const auto d = mig.create_pi();
+  const auto f1 = mig.create_maj( a, b, c );
+  const auto f2 = mig.create_maj( f1, c, d );
+  const auto f3 = mig.create_maj( f2, !a, b );
+  mig.create_maj( b, a, c ); /* structural hashing, no event */
+  mig.create_po( f3 );
+
+  CHECK( recorder.added == std::vector<uint64_t>{ mig.get_node( f1 ), mig.get_node( f2 ), mig.get_node( f3 ) } );
+  CHECK( dynamic_added == 3u );
+
+  /* f2 is deleted and f3 is modified */
+  mig.substitute_node( mig.get_node( f2 ), f1 );
+  CHECK( recorder.deleted == std::vector<uint64_t>{ mig.get_node( f2 ) } );
+  CHECK( recorder.modified == std::vector<uint64_t>{ mig.get_node( f3 ) } );
+  CHECK( recorder.num_previous_children == 3u );
+
+  mig.events().release_add_event( add_event );
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/traits.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk, class SoaNtk>
+void test_soa_storage()
+{
+  CHECK( is_network_type_v<SoaNtk> );
+  CHECK( has_substitute_node_v<SoaNtk> );
+  CHECK( has_value_v<SoaNtk> );
+  CHECK( has_visited_v<SoaNtk> );
+
+  Ntk ntk;
+  SoaNtk soa;
+
+  auto const build = []( auto& ntk ) {
+    auto const a = ntk.create_pi();
+    auto const b = ntk.create_pi();
+    auto const c = ntk.create_pi();
+    auto const f1 = ntk.create_and( a, b );
+    auto const f2 = ntk.create_xor( f1, c );
+    auto const f3 = ntk.create_maj( a, f1, !c );
+    ntk.create_po( f2 );
+    ntk.create_po( f3 );
+    ntk.create_po( ntk.create_and( a, b ) );
+  };
+  build( ntk );
+  build( soa );
+
+  CHECK( soa.size() == ntk.size() );
+  CHECK( soa.num_gates() == ntk.num_gates() );
+  soa.foreach_node( [&]( auto n ) {
+    CHECK( soa.fanout_size( n ) == ntk.fanout_size( n ) );
+    CHECK( soa.is_ci( n ) == ntk.is_ci( n ) );
+    soa.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      CHECK( f == ntk._storage->nodes[n].children[i] );
+    } );
+  } );
+
+  auto const tts = simulate<kitty::static_truth_table<3u>>( ntk );
+  CHECK( simulate<kitty::static_truth_table<3u>>( soa ) == tts );
+
+  soa.clear_values();
+  soa.clear_visited();
+  soa.foreach_node( [&]( auto n ) {
+    CHECK( soa.value( n ) == 0u );
+    CHECK( soa.visited( n ) == 0u );
+    soa.set_value( n, static_cast<uint32_t>( n ) );
+    soa.set_visited( n, static_cast<uint32_t>( n ) + 1u );
+  } );
+  soa.foreach_node( [&]( auto n ) {
+    CHECK( soa.incr_value( n ) == n );
+    CHECK( soa.value( n ) == n + 1u );
+    CHECK( soa.visited( n ) == n + 1u );
+  } );
+
+  /* substitution keeps both layouts in sync */
+  ntk.substitute_node( 4u, ntk.get_constant( false ) );
+  soa.substitute_node( 4u, soa.get_constant( false ) );
+  CHECK( soa.num_gates() == ntk.num_gates() );
+  soa.foreach_node( [&]( auto n ) {
+    CHECK( soa.is_dead( n ) == ntk.is_dead( n ) );
+    CHECK( soa.fanout_size( n ) == ntk.fanout_size( n ) );
+  } );
+  CHECK( simulate<kitty::static_truth_table<3u>>( soa ) == simulate<kitty::static_truth_table<3u>>( ntk ) );
+
+  auto const copy = soa.clone();
+  CHECK( copy._storage != soa._storage );
+  CHECK( copy.num_gates() == soa.num_gates() );
+}
+
+TEST_CASE( "structure-of-arrays storage layout", "[soa_storage]" )
+{
+  test_soa_storage<aig_network, basic_aig_network<aig_soa_storage>>();
+  test_soa_storage<xag_network, basic_xag_network<xag_soa_storage>>();
+}
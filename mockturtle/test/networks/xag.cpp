@@ -13,6 +13,7 @@
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/views/topo_view.hpp>
 
 using namespace mockturtle;
 
@@ -812,3 +813,52 @@ TEST_CASE( "substitute node with dependency in xag_network", "[xag]" )
     CHECK( xag.is_dead( xag.get_node( s ) ) == false );
   } );
 }
+
+TEST_CASE( "compact XAG with dead nodes", "[xag]" )
+{
+  xag_network xag;
+
+  static_assert( has_compact_v<xag_network> );
+  static_assert( has_compact_v<basic_xag_network<xag_soa_storage>> );
+  static_assert( has_compact_v<basic_xag_network<xag_cow_storage>> );
+  static_assert( !has_compact_v<basic_xag_network<xag_concurrent_storage>> );
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  const auto f1 = xag.create_xor( a, b );
+  const auto f2 = xag.create_and( f1, c );
+  const auto f3 = xag.create_xor( f2, a );
+  xag.create_po( f3 );
+
+  /* f5 is created last but replaces f1, hence the XOR f3 and the AND f2
+     get fan-ins with a different index order after renumbering */
+  const auto f4 = xag.create_and( b, c );
+  const auto f5 = xag.create_xor( f4, a );
+  xag.substitute_node( xag.get_node( f1 ), f5 );
+
+  /* simulate in topological order, since the node order is not topological before compaction */
+  const auto tts_before = simulate<kitty::static_truth_table<3u>>( topo_view{ xag } );
+  const auto num_ands = [&]() {
+    uint32_t num{ 0 };
+    xag.foreach_gate( [&]( auto const& n ) { num += xag.is_and( n ) ? 1 : 0; } );
+    return num;
+  };
+  const auto ands_before = num_ands();
+
+  const auto old_to_new = xag.compact();
+
+  CHECK( xag.size() == 8u );
+  CHECK( num_ands() == ands_before );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag ) == tts_before );
+  xag.foreach_gate( [&]( auto const& n ) {
+    xag.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( xag.get_node( f ) < n );
+    } );
+  } );
+
+  const auto new_f4 = xag.make_signal( old_to_new[xag.get_node( f4 )] );
+  const auto new_f5 = xag.make_signal( old_to_new[xag.get_node( f5 )] );
+  CHECK( xag.create_xor( a, new_f4 ) == new_f5 );
+  CHECK( xag.size() == 8u );
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
+
+#include <mockturtle/generators/arithmetic.hpp>
 
 namespace mockturtle
 {
@@ -25,4 +29,40 @@ public:
   uint64_t& _storage;
 };
 
+/*! \brief Adder of two `bitwidth`-bit numbers as test network
+ *
+ * The outputs are the sum bits followed by the complemented carry.
+ */
+template<class Ntk>
+Ntk adder_network( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  for ( auto const& f : a )
+  {
+    ntk.create_po( f );
+  }
+  ntk.create_po( ntk.create_not( carry ) );
+  return ntk;
+}
+
+/*! \brief Multiplier of two `bitwidth`-bit numbers as test network */
+template<class Ntk>
+Ntk multiplier_network( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( ntk, a, b ) )
+  {
+    ntk.create_po( f );
+  }
+  return ntk;
+}
+
 }
@@ -0,0 +1,46 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/bucket_queue.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "pop elements from bucket queue in order of keys", "[bucket_queue]" )
+{
+  bucket_queue<uint32_t> queue;
+  CHECK( queue.empty() );
+
+  queue.push( 5u, 50u );
+  queue.push( 2u, 20u );
+  queue.push( 7u, 70u );
+  queue.push( 2u, 21u );
+  CHECK( queue.size() == 4u );
+
+  std::vector<uint32_t> values;
+  values.push_back( queue.pop_min() );
+  values.push_back( queue.pop_min() );
+
+  /* keys may be smaller than the last popped key */
+  queue.push( 1u, 10u );
+  while ( !queue.empty() )
+  {
+    values.push_back( queue.pop_min() );
+  }
+  CHECK( values == std::vector<uint32_t>{ 21u, 20u, 10u, 50u, 70u } );
+
+  queue.push( 3u, 30u );
+  queue.push( 9u, 90u );
+  queue.push( 4u, 40u );
+  CHECK( queue.pop_max() == 90u );
+  queue.push( 12u, 120u );
+  CHECK( queue.pop_max() == 120u );
+  CHECK( queue.pop_max() == 40u );
+  CHECK( queue.pop_max() == 30u );
+  CHECK( queue.empty() );
+
+  queue.push( 6u, 60u );
+  queue.clear();
+  CHECK( queue.empty() );
+}
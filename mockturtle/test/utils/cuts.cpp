@@ -188,3 +188,104 @@ TEST_CASE( "merge three cuts", "[cuts]" )
   ct.merge( c3, cr, 10 );
   CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == std::vector{ 1u, 2u, 3u, 4u, 5u, 6u, 7u, 9u } );
 }
+
+TEST_CASE( "allocate cuts of a cut set on demand", "[cuts]" )
+{
+  using cut_type = cut<10, uint32_t>;
+
+  cut_set<cut_type, 6> set;
+  CHECK( set.capacity() == 0u );
+
+  /* irredundant cuts of the same size, the last inserted cut is the first */
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    cut_type c;
+    c.set_leaves( std::vector<uint32_t>{ 2u * i, 2u * i + 1u } );
+    c.data() = i;
+    set.insert( c );
+  }
+  CHECK( set.size() == 6 );
+  CHECK( set.capacity() == 6u );
+
+  set.limit( 3u );
+  set.shrink_to_fit();
+  CHECK( set.size() == 3 );
+  CHECK( set.capacity() == 3u );
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    CHECK( std::vector<uint32_t>( set[i].begin(), set[i].end() ) == std::vector<uint32_t>{ 14u - 2u * i, 15u - 2u * i } );
+    CHECK( set[i].data() == 7u - i );
+  }
+
+  /* copies allocate only the cuts in the set */
+  set.update_best( 2u );
+  const auto copy = set;
+  CHECK( copy.capacity() == 3u );
+  CHECK( copy[0].data() == 5u );
+  CHECK( copy[1].data() == 7u );
+  CHECK( copy[2].data() == 6u );
+
+  const uint32_t leaf{ 42u };
+  set.clear();
+  set.add_cut( &leaf, &leaf + 1 );
+  CHECK( set.size() == 1 );
+  CHECK( set.best().size() == 1u );
+  CHECK( *set.best().begin() == 42u );
+  CHECK( copy.size() == 3 );
+}
+
+TEST_CASE( "store cuts in a compact cut set", "[cuts]" )
+{
+  using cut_type = cut<10, uint32_t>;
+
+  /* leaves with 16 and 32 bits */
+  cut_set<cut_type, 10> set;
+  std::vector<std::vector<uint32_t>> leaves{ { 3u, 6u }, { 1u, 2u, 70000u }, {}, { 65535u, 65536u, 100000u } };
+  for ( auto i = 0u; i < leaves.size(); ++i )
+  {
+    set.add_cut( leaves[i].begin(), leaves[i].end() ).data() = i;
+  }
+
+  cut_arena arena;
+  compact_cut_set<compact_cut<uint32_t>, 10> compact;
+  CHECK( compact.size() == 0 );
+  compact.assign( set.begin(), set.end(), arena );
+  CHECK( compact.size() == 4 );
+  CHECK( arena.capacity() > 0u );
+
+  auto i = 0u;
+  for ( auto const& c : compact )
+  {
+    CHECK( c->size() == leaves[i].size() );
+    CHECK( std::vector<uint32_t>( c->begin(), c->end() ) == leaves[i] );
+    CHECK( c->signature() == set[i].signature() );
+    CHECK( c->data() == i );
+    ++i;
+  }
+
+  /* merge and dominance with cuts */
+  cut_type res;
+  CHECK( set[0].merge( compact[1], res, 5u ) );
+  CHECK( std::vector<uint32_t>( res.begin(), res.end() ) == std::vector<uint32_t>{ 1u, 2u, 3u, 6u, 70000u } );
+  CHECK( res.signature() == ( set[0].signature() | set[1].signature() ) );
+  CHECK( !set[3].merge( compact[0], res, 4u ) );
+  CHECK( set[2].merge( compact[0], res, 2u ) );
+  CHECK( std::vector<uint32_t>( res.begin(), res.end() ) == leaves[0] );
+  CHECK( set.is_dominated( compact[1] ) );
+
+  const cut_type copy( compact[3] );
+  CHECK( std::vector<uint32_t>( copy.begin(), copy.end() ) == leaves[3] );
+  CHECK( copy.data() == 3u );
+
+  /* data can be modified and cuts reordered */
+  ( *compact.begin() )->data() = 42u;
+  compact.update_best( 2u );
+  compact.limit( 3u );
+  CHECK( compact.size() == 3 );
+  CHECK( compact.best().size() == 0u );
+  CHECK( compact[1].data() == 42u );
+  CHECK( compact[2].data() == 1u );
+
+  /* the first cut is not copied again */
+  CHECK( set[0].data() == 0u );
+}
@@ -0,0 +1,83 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/fanout_index.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "build fanout index", "[fanout_index]" )
+{
+  /* edges (n, fanout); the edge (1, 3) is listed twice */
+  std::vector<std::pair<uint64_t, uint64_t>> const edges{ { 0, 2 }, { 1, 2 }, { 1, 3 }, { 1, 3 }, { 2, 3 } };
+
+  fanout_index<uint64_t> index;
+  index.build( 4u, [&]( auto&& add ) {
+    for ( auto const& [n, fo] : edges )
+    {
+      add( n, fo );
+    }
+  } );
+
+  CHECK( index.num_nodes() == 4u );
+  CHECK( index.to_vector( 0 ) == std::vector<uint64_t>{ 2 } );
+  CHECK( index.to_vector( 1 ) == std::vector<uint64_t>{ 2, 3 } );
+  CHECK( index.to_vector( 2 ) == std::vector<uint64_t>{ 3 } );
+  CHECK( index.size( 3 ) == 0u );
+  CHECK( index.begin( 3 ) == index.end( 3 ) );
+  CHECK( index.contains( 1, 3 ) );
+  CHECK( !index.contains( 0, 3 ) );
+  CHECK( index.num_garbage_slots() == 0u );
+
+  std::vector<uint64_t> fanouts;
+  std::copy( index.begin( 1 ), index.end( 1 ), std::back_inserter( fanouts ) );
+  CHECK( fanouts == std::vector<uint64_t>{ 2, 3 } );
+}
+
+TEST_CASE( "update fanout index", "[fanout_index]" )
+{
+  fanout_index<uint64_t> index;
+  index.reset( 3u );
+
+  /* interleave insertions to force relocations */
+  std::vector<std::vector<uint64_t>> expected( 3u );
+  for ( uint64_t i = 0u; i < 100u; ++i )
+  {
+    index.push_back( i % 3u, i );
+    expected[i % 3u].push_back( i );
+  }
+  for ( uint64_t n = 0u; n < 3u; ++n )
+  {
+    CHECK( index.to_vector( n ) == expected[n] );
+  }
+  CHECK( index.num_garbage_slots() <= index.num_slots() / 2u );
+
+  /* erase keeps the order of the remaining fanouts */
+  index.erase( 0u, 3u );
+  index.erase( 0u, 42u );
+  expected[0].erase( std::remove_if( expected[0].begin(), expected[0].end(), []( auto fo ) { return fo == 3u || fo == 42u; } ), expected[0].end() );
+  CHECK( index.to_vector( 0 ) == expected[0] );
+
+  index.clear( 1u );
+  CHECK( index.size( 1u ) == 0u );
+
+  /* new nodes start with empty lists */
+  index.resize( 5u );
+  CHECK( index.num_nodes() == 5u );
+  CHECK( index.size( 3u ) == 0u );
+  CHECK( index.size( 4u ) == 0u );
+  index.push_back( 4u, 7u );
+  index.push_back( 3u, 8u );
+  CHECK( index.to_vector( 3u ) == std::vector<uint64_t>{ 8 } );
+  CHECK( index.to_vector( 4u ) == std::vector<uint64_t>{ 7 } );
+
+  index.repack();
+  CHECK( index.num_garbage_slots() == 0u );
+  CHECK( index.to_vector( 0 ) == expected[0] );
+  CHECK( index.to_vector( 2 ) == expected[2] );
+  CHECK( index.to_vector( 3u ) == std::vector<uint64_t>{ 8 } );
+  CHECK( index.to_vector( 4u ) == std::vector<uint64_t>{ 7 } );
+}
@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <cstdint>
+#include <cstdio>
 #include <vector>
 
 #include <lorina/genlib.hpp>
@@ -410,4 +411,101 @@ TEST_CASE( "Complete library generation", "[tech_library]" )
 
     kitty::exact_np_enumeration( tt, test_enumeration );
   }
-}
\ No newline at end of file
+}
+
+template<unsigned NInputs, classification_type Configuration>
+void check_same_library( tech_library<NInputs, Configuration> const& lib1, tech_library<NInputs, Configuration> const& lib2 )
+{
+  CHECK( lib1.get_inverter_info() == lib2.get_inverter_info() );
+  CHECK( lib1.get_buffer_info() == lib2.get_buffer_info() );
+
+  kitty::static_truth_table<NInputs> tt;
+  do
+  {
+    auto const list1 = lib1.get_supergates( tt );
+    auto const list2 = lib2.get_supergates( tt );
+    REQUIRE( ( list1 == nullptr ) == ( list2 == nullptr ) );
+    if ( list1 == nullptr )
+    {
+      kitty::next_inplace( tt );
+      continue;
+    }
+
+    REQUIRE( list1->size() == list2->size() );
+    for ( auto i = 0u; i < list1->size(); ++i )
+    {
+      auto const& sg1 = ( *list1 )[i];
+      auto const& sg2 = ( *list2 )[i];
+      CHECK( sg1.root->id == sg2.root->id );
+      CHECK( sg1.root->root->name == sg2.root->root->name );
+      CHECK( sg1.area == sg2.area );
+      CHECK( sg1.tdelay == sg2.tdelay );
+      CHECK( sg1.permutation == sg2.permutation );
+      CHECK( sg1.polarity == sg2.polarity );
+    }
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+}
+
+TEST_CASE( "Library cache", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  std::remove( "tech_library.tlib" );
+
+  tech_library_params ps;
+  ps.cache_file = "tech_library.tlib";
+  tech_library<4> lib( gates, ps );
+  tech_library<4> lib_cached( gates, ps );
+  CHECK( lib_cached.max_gate_size() == lib.max_gate_size() );
+  check_same_library( lib, lib_cached );
+
+  /* a file written for different gates or template parameters is not read */
+  std::vector<gate> other_gates( gates.begin(), gates.end() - 3 );
+  tech_library<4> lib_other( other_gates );
+  CHECK( !lib_other.read_cache( "tech_library.tlib" ) );
+  CHECK( lib_other.get_buffer_info() != lib.get_buffer_info() );
+
+  tech_library<4, classification_type::p_configurations> lib_p( gates );
+  CHECK( !lib_p.read_cache( "tech_library.tlib" ) );
+
+  CHECK( lib_other.write_cache( "tech_library.tlib" ) );
+  CHECK( lib_cached.read_cache( "tech_library.tlib" ) == false );
+  CHECK( lib_other.read_cache( "tech_library.tlib" ) );
+
+  std::remove( "tech_library.tlib" );
+}
+
+TEST_CASE( "Supergate library cache", "[tech_library]" )
+{
+  std::vector<gate> gates;
+  super_lib super_data;
+
+  std::istringstream in_genlib( simple_library );
+  auto result = lorina::read_genlib( in_genlib, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  std::istringstream in_super( super_library );
+  result = lorina::read_super( in_super, mockturtle::super_reader( super_data ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates, super_data );
+  CHECK( lib.write_cache( "super_library.tlib" ) );
+
+  tech_library<3> lib_cached( gates, super_data );
+  CHECK( lib_cached.read_cache( "super_library.tlib" ) );
+  check_same_library( lib, lib_cached );
+
+  /* the cache of the library without supergates has a different key */
+  tech_library<3> lib_simple( gates );
+  CHECK( !lib_simple.read_cache( "super_library.tlib" ) );
+
+  std::remove( "super_library.tlib" );
+}
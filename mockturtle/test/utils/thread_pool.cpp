@@ -0,0 +1,81 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/thread_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "parallel loop visits every index once", "[thread_pool]" )
+{
+  for ( auto num_threads : { 1u, 2u, 4u, 7u } )
+  {
+    thread_pool pool( num_threads );
+    CHECK( pool.num_threads() == num_threads );
+
+    for ( auto grain : { 1u, 3u, 64u, 5000u } )
+    {
+      std::vector<std::atomic<uint32_t>> visits( 10000u );
+      std::atomic<uint32_t> max_thread{ 0u };
+      pool.parallel_for( 17u, visits.size(), grain, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+        CHECK( end - begin <= grain );
+        for ( auto i = begin; i < end; ++i )
+        {
+          ++visits[i];
+        }
+        auto expected = max_thread.load();
+        while ( thread > expected && !max_thread.compare_exchange_weak( expected, thread ) )
+          ;
+      } );
+
+      for ( auto i = 0u; i < visits.size(); ++i )
+      {
+        CHECK( visits[i] == ( i < 17u ? 0u : 1u ) );
+      }
+      CHECK( max_thread < num_threads );
+    }
+  }
+}
+
+TEST_CASE( "parallel loop on small and empty ranges", "[thread_pool]" )
+{
+  thread_pool pool( 4u );
+
+  uint32_t calls = 0u;
+  pool.parallel_for( 5u, 5u, 1u, [&]( uint64_t, uint64_t, uint32_t ) { ++calls; } );
+  CHECK( calls == 0u );
+
+  /* runs on the calling thread */
+  pool.parallel_for( 0u, 10u, 10u, [&]( uint64_t begin, uint64_t end, uint32_t thread ) {
+    CHECK( begin == 0u );
+    CHECK( end == 10u );
+    CHECK( thread == 0u );
+    ++calls;
+  } );
+  CHECK( calls == 1u );
+}
+
+TEST_CASE( "exceptions are rethrown by parallel loop", "[thread_pool]" )
+{
+  thread_pool pool( 3u );
+  CHECK_THROWS_AS( pool.parallel_for( 0u, 1000u, 1u, [&]( uint64_t begin, uint64_t, uint32_t ) {
+                     if ( begin == 500u )
+                     {
+                       throw std::runtime_error( "failure" );
+                     }
+                   } ),
+                   std::runtime_error );
+
+  /* the pool can still be used */
+  std::atomic<uint64_t> sum{ 0u };
+  pool.parallel_for( 0u, 1000u, 8u, [&]( uint64_t begin, uint64_t end, uint32_t ) {
+    for ( auto i = begin; i < end; ++i )
+    {
+      sum += i;
+    }
+  } );
+  CHECK( sum == 499500u );
+}
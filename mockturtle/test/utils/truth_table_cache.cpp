@@ -44,4 +44,8 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[7] == ~f_or );
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
+
+  CHECK( cache.normal( 2 ) == x1 );
+  CHECK( cache.normal( 3 ) == x1 );
+  CHECK( cache.normal( 9 ) == f_maj );
 }
@@ -0,0 +1,146 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/choice_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "create choice view on AIG", "[choice_view]" )
+{
+  CHECK( has_foreach_choice_v<choice_view<aig_network>> );
+  CHECK( !has_foreach_choice_v<aig_network> );
+  CHECK( is_topologically_sorted_v<choice_view<aig_network>> );
+
+  choice_view<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f = aig.create_and( aig.create_and( a, b ), c );
+  aig.create_po( f );
+
+  /* alternatives are created after the representative */
+  const auto g = aig.create_and( a, aig.create_and( b, c ) );
+  const auto h = aig.create_nand( aig.create_and( a, c ), b );
+
+  CHECK( aig.num_choices() == 0u );
+  CHECK( !aig.has_choices( aig.get_node( f ) ) );
+
+  aig.add_choice( aig.get_node( f ), g );
+  aig.add_choice( aig.get_node( f ), !h );
+
+  CHECK( aig.num_choices() == 2u );
+  CHECK( aig.has_choices( aig.get_node( f ) ) );
+  CHECK( !aig.is_choice( aig.get_node( f ) ) );
+  CHECK( aig.is_choice( aig.get_node( g ) ) );
+  CHECK( aig.is_choice( aig.get_node( h ) ) );
+  CHECK( !aig.has_choices( aig.get_node( g ) ) );
+  CHECK( aig.get_choice_representative( aig.get_node( g ) ) == aig.get_node( f ) );
+  CHECK( aig.get_choice_representative( aig.get_node( h ) ) == aig.get_node( f ) );
+  CHECK( aig.get_choice_representative( aig.get_node( a ) ) == aig.get_node( a ) );
+  CHECK( !aig.get_choice_phase( aig.get_node( g ) ) );
+  CHECK( !aig.get_choice_phase( aig.get_node( h ) ) );
+
+  std::vector<aig_network::node> choices;
+  aig.foreach_choice( aig.get_node( f ), [&]( auto const& n ) {
+    choices.push_back( n );
+  } );
+  CHECK( choices == std::vector<aig_network::node>{ aig.get_node( g ), aig.get_node( h ) } );
+
+  /* fanins and alternatives precede each node */
+  std::vector<aig_network::node> order;
+  aig.foreach_node( [&]( auto const& n ) {
+    order.push_back( n );
+  } );
+  CHECK( order.size() == aig.size() );
+
+  const auto position = [&]( auto const& n ) {
+    return std::distance( order.begin(), std::find( order.begin(), order.end(), n ) );
+  };
+  aig.foreach_gate( [&]( auto const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& fi ) {
+      CHECK( position( aig.get_node( fi ) ) < position( n ) );
+    } );
+  } );
+  CHECK( position( aig.get_node( g ) ) < position( aig.get_node( f ) ) );
+  CHECK( position( aig.get_node( h ) ) < position( aig.get_node( f ) ) );
+
+  uint32_t num_gates{ 0u };
+  aig.foreach_gate( [&]( auto const& n, auto i ) {
+    CHECK( i == num_gates++ );
+    CHECK( !aig.is_pi( n ) );
+  } );
+  CHECK( num_gates == aig.num_gates() );
+
+  /* topo_view keeps the order */
+  std::vector<aig_network::node> topo_order;
+  topo_view<choice_view<aig_network>>{ aig }.foreach_node( [&]( auto const& n ) {
+    topo_order.push_back( n );
+  } );
+  CHECK( topo_order == order );
+
+  /* the order is updated when nodes are added */
+  const auto d = aig.create_pi();
+  aig.create_po( aig.create_and( f, d ) );
+  uint32_t num_nodes{ 0u };
+  aig.foreach_node( [&]( auto const& ) {
+    ++num_nodes;
+  } );
+  CHECK( num_nodes == aig.size() );
+}
+
+TEST_CASE( "enumerate cuts of a choice network", "[choice_view]" )
+{
+  choice_view<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  /* complement of majority */
+  const auto f = aig.create_maj( a, b, c );
+  CHECK( aig.is_complemented( f ) );
+  aig.create_po( f );
+
+  /* majority as a product of sums */
+  const auto p1 = aig.create_or( a, b );
+  const auto p2 = aig.create_or( b, c );
+  const auto p3 = aig.create_or( a, c );
+  const auto g = aig.create_and( aig.create_and( p1, p2 ), p3 );
+  CHECK( !aig.is_complemented( g ) );
+  aig.add_choice( aig.get_node( f ), !g );
+
+  const auto cuts = cut_enumeration<choice_view<aig_network>, true>( aig );
+
+  const auto index = aig.node_to_index( aig.get_node( f ) );
+  std::vector<uint32_t> leaves{ aig.node_to_index( aig.get_node( p1 ) ), aig.node_to_index( aig.get_node( p2 ) ), aig.node_to_index( aig.get_node( p3 ) ) };
+  std::sort( leaves.begin(), leaves.end() );
+
+  bool found_inputs{ false }, found_alternative{ false };
+  for ( auto const& cut : cuts.cuts( index ) )
+  {
+    std::vector<uint32_t> cut_leaves( cut->begin(), cut->end() );
+    if ( cut_leaves == std::vector<uint32_t>{ 1u, 2u, 3u } )
+    {
+      found_inputs = true;
+      CHECK( cuts.truth_table( *cut )._bits[0] == 0x17u );
+    }
+    else if ( cut_leaves == leaves )
+    {
+      found_alternative = true;
+
+      /* complement of the AND of the complemented ORs */
+      CHECK( cuts.truth_table( *cut )._bits[0] == 0xfeu );
+    }
+  }
+  CHECK( found_inputs );
+  CHECK( found_alternative );
+
+  /* without choices, only the cuts of the own structure are enumerated */
+  const auto cuts_no_choices = cut_enumeration<aig_network, true>( aig );
+  CHECK( cuts_no_choices.cuts( index ).size() < cuts.cuts( index ).size() );
+}
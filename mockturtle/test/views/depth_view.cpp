@@ -7,6 +7,9 @@
 #include <mockturtle/traits.hpp>
 #include <mockturtle/views/depth_view.hpp>
 
+#include <cstdint>
+#include <vector>
+
 using namespace mockturtle;
 
 template<typename Ntk>
@@ -238,3 +241,149 @@ TEST_CASE( "compute levels during node construction after move assignment", "[de
 
   CHECK( dxag.depth() == 3u );
 }
+
+TEST_CASE( "compute required levels and slack", "[depth_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+  const auto e = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( c, f1 );
+  const auto f3 = aig.create_and( d, e );
+  const auto f = aig.create_and( f2, f3 );
+  aig.create_po( f );
+
+  depth_view_params ps;
+  ps.incremental = true;
+  depth_view depth_aig{ aig, unit_cost<aig_network>(), ps };
+  CHECK( depth_aig.depth() == 3u );
+  CHECK( depth_aig.required_level( aig.get_node( f ) ) == 3u );
+  CHECK( depth_aig.required_level( aig.get_node( f3 ) ) == 2u );
+  CHECK( depth_aig.required_level( aig.get_node( d ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( f3 ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( d ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( c ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( f1 ) ) == 0u );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( a ) ) );
+  CHECK( !depth_aig.is_on_critical_path( aig.get_node( c ) ) );
+  CHECK( !depth_aig.is_on_critical_path( aig.get_node( f3 ) ) );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( f ) ) );
+
+  /* move the critical path from f1 to f3 */
+  const auto g = depth_aig.create_and( depth_aig.create_and( c, d ), e );
+  depth_aig.substitute_node( aig.get_node( f3 ), g );
+  depth_aig.substitute_node( aig.get_node( f1 ), a );
+  depth_aig.update_levels();
+
+  CHECK( depth_aig.depth() == 3u );
+  CHECK( depth_aig.level( aig.get_node( f2 ) ) == 1u );
+  CHECK( depth_aig.level( aig.get_node( g ) ) == 2u );
+  CHECK( depth_aig.level( aig.get_node( f ) ) == 3u );
+  CHECK( depth_aig.slack( aig.get_node( f2 ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( a ) ) == 1u );
+  CHECK( depth_aig.slack( aig.get_node( g ) ) == 0u );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( c ) ) );
+  CHECK( depth_aig.is_on_critical_path( aig.get_node( d ) ) );
+  CHECK( !depth_aig.is_on_critical_path( aig.get_node( a ) ) );
+  CHECK( !depth_aig.is_on_critical_path( aig.get_node( b ) ) );
+}
+
+template<typename Ntk>
+void test_incremental_levels( bool count_complements )
+{
+  using signal = signal<Ntk>;
+
+  Ntk ntk;
+  depth_view_params ps;
+  ps.incremental = true;
+  ps.count_complements = count_complements;
+  depth_view dntk{ ntk, unit_cost<Ntk>(), ps };
+
+  uint64_t state{ 0x853c49e6748fea9b };
+  const auto next = [&]() {
+    state = state * UINT64_C( 6364136223846793005 ) + UINT64_C( 1442695040888963407 );
+    return static_cast<uint32_t>( state >> 33 );
+  };
+
+  std::vector<signal> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( dntk.create_pi() );
+  }
+  for ( auto i = 0u; i < 500u; ++i )
+  {
+    const auto size = static_cast<uint32_t>( fs.size() );
+    fs.push_back( dntk.create_and( fs[size - 1u - next() % 16u] ^ ( next() & 1u ), fs[next() % size] ^ ( next() & 1u ) ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    dntk.create_po( fs[fs.size() - 1u - 5u * i] ^ ( i & 1u ) );
+  }
+  dntk.update_levels();
+
+  /* checks whether `n` is in the transitive fanin of `f` */
+  const auto in_tfi = [&]( auto const& n, auto const& f ) {
+    std::vector<node<Ntk>> stack{ ntk.get_node( f ) };
+    ntk.incr_trav_id();
+    while ( !stack.empty() )
+    {
+      const auto m = stack.back();
+      stack.pop_back();
+      if ( m == n )
+      {
+        return true;
+      }
+      if ( ntk.visited( m ) == ntk.trav_id() )
+      {
+        continue;
+      }
+      ntk.set_visited( m, ntk.trav_id() );
+      ntk.foreach_fanin( m, [&]( auto const& fi ) { stack.push_back( ntk.get_node( fi ) ); } );
+    }
+    return false;
+  };
+
+  /* replace gates by shallower and deeper functions */
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const n = dntk.get_node( fs[16u + next() % 500u] );
+    auto const a = fs[next() % fs.size()];
+    auto const b = fs[next() % fs.size()];
+    if ( dntk.is_dead( n ) || dntk.is_dead( dntk.get_node( a ) ) || dntk.is_dead( dntk.get_node( b ) ) || in_tfi( n, a ) || in_tfi( n, b ) )
+    {
+      continue;
+    }
+    auto const g = dntk.create_and( a, b ^ ( next() & 1u ) );
+    if ( dntk.get_node( g ) != n && !in_tfi( n, g ) )
+    {
+      dntk.substitute_node( n, g );
+    }
+
+    if ( i % 8u == 0u )
+    {
+      dntk.update_levels();
+    }
+  }
+  dntk.update_levels();
+
+  depth_view full{ ntk, unit_cost<Ntk>(), ps };
+  CHECK( dntk.depth() == full.depth() );
+  CHECK( dntk.depth() == depth_view{ ntk, unit_cost<Ntk>(), { count_complements } }.depth() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( dntk.level( n ) == full.level( n ) );
+    CHECK( dntk.required_level( n ) == full.required_level( n ) );
+    CHECK( dntk.is_on_critical_path( n ) == full.is_on_critical_path( n ) );
+  } );
+}
+
+TEST_CASE( "update levels and required levels incrementally", "[depth_view]" )
+{
+  test_incremental_levels<aig_network>( false );
+  test_incremental_levels<aig_network>( true );
+  test_incremental_levels<xag_network>( false );
+  test_incremental_levels<mig_network>( true );
+}
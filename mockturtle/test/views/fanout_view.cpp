@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <set>
+#include <vector>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
@@ -271,4 +272,105 @@ TEST_CASE( "substitute node with complemented node in fanout view", "[fanout_vie
   CHECK( faig.fanout_size( faig.get_node( f2 ) ) == 1 );
 
   CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x7 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "incremental fanouts match recomputed fanouts", "[fanout_view]" )
+{
+  using node = node<aig_network>;
+
+  aig_network aig;
+  fanout_view faig( aig );
+
+  std::vector<signal<aig_network>> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( faig.create_pi() );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    fs.push_back( faig.create_and( fs[( 7u * i + 3u ) % fs.size()], !fs[( 13u * i + 5u ) % fs.size()] ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    faig.create_po( fs[fs.size() - 1u - i] );
+  }
+
+  /* substitute some gates, which also adds and deletes fanouts */
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    auto const n = faig.get_node( fs[8u + 9u * i] );
+    if ( faig.is_dead( n ) || faig.is_dead( faig.get_node( fs[i] ) ) || faig.is_dead( faig.get_node( fs[i + 1u] ) ) )
+    {
+      continue;
+    }
+    auto const g = faig.create_and( fs[i], fs[i + 1u] );
+    if ( faig.get_node( g ) != n )
+    {
+      faig.substitute_node( n, g );
+    }
+  }
+
+  fanout_view fresh( aig );
+  aig.foreach_node( [&]( node const& n ) {
+    std::set<node> incremental, recomputed;
+    faig.foreach_fanout( n, [&]( node const& fo ) { incremental.insert( fo ); } );
+    fresh.foreach_fanout( n, [&]( node const& fo ) { recomputed.insert( fo ); } );
+    CHECK( incremental == recomputed );
+  } );
+}
+
+TEST_CASE( "fanout view uses the fanouts of a static listener", "[fanout_view]" )
+{
+  using aig_with_fanouts = basic_aig_network<aig_storage, fanout_listener<>>;
+  using node = node<aig_with_fanouts>;
+
+  aig_with_fanouts aig;
+  fanout_view faig( aig );
+  CHECK( aig.events().on_add.empty() );
+  CHECK( aig.events().on_modified.empty() );
+  CHECK( aig.events().on_delete.empty() );
+
+  std::vector<signal<aig_with_fanouts>> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( faig.create_pi() );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    fs.push_back( faig.create_and( fs[( 7u * i + 3u ) % fs.size()], !fs[( 13u * i + 5u ) % fs.size()] ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    faig.create_po( fs[fs.size() - 1u - i] );
+  }
+
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    auto const n = faig.get_node( fs[8u + 9u * i] );
+    if ( faig.is_dead( n ) || faig.is_dead( faig.get_node( fs[i] ) ) || faig.is_dead( faig.get_node( fs[i + 1u] ) ) )
+    {
+      continue;
+    }
+    auto const g = faig.create_and( fs[i], fs[i + 1u] );
+    if ( faig.get_node( g ) != n )
+    {
+      faig.substitute_node( n, g );
+    }
+  }
+
+  /* a PI without fanouts that is created after all gates */
+  const auto late_pi = faig.get_node( faig.create_pi() );
+
+  std::vector<std::set<node>> expected( aig.size() );
+  aig.foreach_gate( [&]( node const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      expected[aig.get_node( f )].insert( n );
+    } );
+  } );
+  aig.foreach_node( [&]( node const& n ) {
+    std::set<node> fanouts;
+    faig.foreach_fanout( n, [&]( node const& fo ) { fanouts.insert( fo ); } );
+    CHECK( fanouts == expected[n] );
+  } );
+  CHECK( faig.fanout( late_pi ).empty() );
+}
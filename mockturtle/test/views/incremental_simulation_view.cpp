@@ -0,0 +1,164 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/incremental_simulation_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../test_networks.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class View>
+void check_values( View const& view )
+{
+  /* substitutions may break the topological order of node indices */
+  const topo_view topo{ view };
+  const auto expected = simulate_nodes<kitty::partial_truth_table>( topo, view.simulator() );
+  topo.foreach_node( [&]( auto const& n ) {
+    CHECK( view.value( n ) == expected[n] );
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "simulate nodes on demand with incremental_simulation_view", "[incremental_simulation_view]" )
+{
+  auto aig = multiplier_network<aig_network>( 6u );
+  incremental_simulation_view sim_aig{ aig, partial_simulator( aig.num_pis(), 200 ) };
+
+  CHECK( sim_aig.num_patterns() == 200u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( sim_aig.is_dirty( n ) );
+  } );
+
+  /* only the fan-in cone of the first output is simulated */
+  const auto po = aig.po_at( 0 );
+  sim_aig.value( aig.get_node( po ) );
+  CHECK( sim_aig.simulation_stats().num_simulated < aig.size() );
+
+  check_values( sim_aig );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( !sim_aig.is_dirty( n ) );
+  } );
+  CHECK( sim_aig.simulation_stats().num_simulated == aig.size() );
+
+  /* values do not change without edits */
+  sim_aig.update();
+  CHECK( sim_aig.simulation_stats().num_simulated == aig.size() );
+}
+
+TEST_CASE( "re-simulate the transitive fanout of substituted nodes", "[incremental_simulation_view]" )
+{
+  auto aig = multiplier_network<aig_network>( 6u );
+  incremental_simulation_view sim_aig{ aig, partial_simulator( aig.num_pis(), 130 ) };
+  sim_aig.update();
+
+  std::mt19937 rng( 5u );
+  std::vector<aig_network::signal> pis;
+  aig.foreach_pi( [&]( auto const& n ) {
+    pis.push_back( aig.make_signal( n ) );
+  } );
+
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    std::vector<aig_network::node> gates;
+    sim_aig.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+    const auto old_node = gates[rng() % gates.size()];
+    const auto new_signal = sim_aig.create_and( pis[rng() % pis.size()], !pis[rng() % pis.size()] );
+
+    const auto before = sim_aig.simulation_stats().num_simulated;
+    sim_aig.substitute_node( old_node, new_signal );
+
+    /* nodes outside the transitive fanout of the substitution are not dirty */
+    uint32_t num_dirty = 0u;
+    sim_aig.foreach_gate( [&]( auto const& n ) {
+      num_dirty += sim_aig.is_dirty( n ) ? 1u : 0u;
+    } );
+    CHECK( num_dirty < sim_aig.num_gates() );
+
+    sim_aig.update();
+    CHECK( sim_aig.simulation_stats().num_simulated - before == num_dirty );
+    check_values( sim_aig );
+  }
+}
+
+TEST_CASE( "append patterns to incremental_simulation_view", "[incremental_simulation_view]" )
+{
+  auto xag = multiplier_network<xag_network>( 6u );
+  incremental_simulation_view sim_xag{ xag, partial_simulator( xag.num_pis(), 60 ) };
+  sim_xag.update();
+
+  std::mt19937 rng( 11u );
+  for ( auto i = 0u; i < 80u; ++i )
+  {
+    std::vector<bool> pattern( xag.num_pis() );
+    for ( auto j = 0u; j < pattern.size(); ++j )
+    {
+      pattern[j] = rng() & 1u;
+    }
+    sim_xag.add_pattern( pattern );
+    if ( i % 7u == 0u )
+    {
+      check_values( sim_xag );
+    }
+  }
+  CHECK( sim_xag.num_patterns() == 140u );
+  check_values( sim_xag );
+  CHECK( sim_xag.simulation_stats().num_extended > 0u );
+
+  /* several words at once at an unaligned position */
+  std::vector<kitty::partial_truth_table> patterns( xag.num_pis(), kitty::partial_truth_table( 300 ) );
+  for ( auto& tt : patterns )
+  {
+    kitty::create_random( tt, rng() );
+  }
+  const auto num_simulated = sim_xag.simulation_stats().num_simulated;
+  sim_xag.add_patterns( patterns );
+  CHECK( sim_xag.num_patterns() == 440u );
+  check_values( sim_xag );
+  CHECK( sim_xag.simulation_stats().num_simulated - num_simulated == xag.num_pis() + 1u );
+
+  for ( auto i = 0u; i < xag.num_pis(); ++i )
+  {
+    for ( auto b = 0u; b < 300u; ++b )
+    {
+      CHECK( kitty::get_bit( sim_xag.simulator().compute_pi( i ), 140u + b ) == kitty::get_bit( patterns[i], b ) );
+    }
+  }
+}
+
+TEST_CASE( "incremental simulation of k-LUT networks", "[incremental_simulation_view]" )
+{
+  auto klut = multiplier_network<klut_network>( 6u );
+  incremental_simulation_view sim_klut{ klut, partial_simulator( klut.num_pis(), 100 ) };
+  check_values( sim_klut );
+
+  std::vector<bool> pattern( klut.num_pis(), true );
+  sim_klut.add_pattern( pattern );
+  check_values( sim_klut );
+
+  std::vector<klut_network::signal> pis;
+  klut.foreach_pi( [&]( auto const& n ) {
+    pis.push_back( klut.make_signal( n ) );
+  } );
+  std::vector<klut_network::node> gates;
+  klut.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+  sim_klut.substitute_node( gates[gates.size() / 2], sim_klut.create_xor( pis[0], pis[3] ) );
+  check_values( sim_klut );
+}
@@ -0,0 +1,323 @@
+#include <catch.hpp>
+
+#include <random>
+#include <sstream>
+
+#include <lorina/genlib.hpp>
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+#include <mockturtle/views/binding_view.hpp>
+#include <mockturtle/views/timing_view.hpp>
+
+using namespace mockturtle;
+
+std::string const sized_library = "GATE inv 1 O=!a; PIN * INV 1 999 1.0 0.5 1.0 0.5\n"
+                                  "GATE inv_x2 2 O=!a; PIN * INV 2 999 0.5 0.25 0.5 0.25\n"
+                                  "GATE and 5 O=a*b; PIN * NONINV 1 999 2.0 0.5 2.0 0.5\n"
+                                  "GATE and_x2 6 O=a*b; PIN * NONINV 2 999 1.0 0.25 1.0 0.25\n"
+                                  "GATE or 5 O=a+b; PIN * NONINV 1 999 3.0 0.5 3.0 0.5\n";
+
+std::string const mapping_library = "GATE   inv1    1 O=!a;               PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                    "GATE   inv2    2 O=!a;               PIN * INV 2 999 1.0 0.1 1.0 0.1\n"
+                                    "GATE   inv3    3 O=!a;               PIN * INV 3 999 1.1 0.09 1.1 0.09\n"
+                                    "GATE   nand2   2 O=!(a*b);           PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                    "GATE   nand2b  3 O=!(a*b);           PIN * INV 2 999 0.7 0.1 0.7 0.1\n"
+                                    "GATE   nor2    2 O=!(a+b);           PIN * INV 1 999 1.4 0.5 1.4 0.5\n"
+                                    "GATE   nor2b   3 O=!(a+b);           PIN * INV 2 999 1.0 0.2 1.0 0.2\n"
+                                    "GATE   and2    3 O=a*b;              PIN * NONINV 1 999 1.9 0.3 1.9 0.3\n"
+                                    "GATE   or2     3 O=a+b;              PIN * NONINV 1 999 2.4 0.3 2.4 0.3\n"
+                                    "GATE   xor2a   5 O=a*!b+!a*b;        PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                                    "GATE   xnor2a  5 O=a*b+!a*!b;        PIN * UNKNOWN 2 999 2.1 0.5 2.1 0.5\n"
+                                    "GATE   aoi21   3 O=!(a*b+c);         PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                                    "GATE   oai21   3 O=!((a+b)*c);       PIN * INV 1 999 1.6 0.4 1.6 0.4\n"
+                                    "GATE   buf     2 O=a;                PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                                    "GATE   zero    0 O=CONST0;\n"
+                                    "GATE   one     0 O=CONST1;";
+
+TEST_CASE( "Timing of a mapped network", "[timing_view]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( sized_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  binding_view<klut_network> ntk( gates );
+
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const d = ntk.create_pi();
+
+  auto const t1 = ntk.create_and( a, b );
+  auto const t2 = ntk.create_or( c, d );
+  auto const f = ntk.create_and( t1, t2 );
+  auto const g = ntk.create_not( t1 );
+
+  ntk.create_po( f );
+  ntk.create_po( g );
+
+  ntk.add_binding( ntk.get_node( t1 ), 2 );
+  ntk.add_binding( ntk.get_node( t2 ), 4 );
+  ntk.add_binding( ntk.get_node( f ), 2 );
+  ntk.add_binding( ntk.get_node( g ), 0 );
+
+  timing_view sta{ ntk };
+  CHECK( sta.arrival( ntk.get_node( a ) ) == 0.0 );
+  CHECK( sta.arrival( ntk.get_node( t1 ) ) == 2.0 );
+  CHECK( sta.arrival( ntk.get_node( t2 ) ) == 3.0 );
+  CHECK( sta.arrival( ntk.get_node( f ) ) == 5.0 );
+  CHECK( sta.arrival( ntk.get_node( g ) ) == 3.0 );
+  CHECK( sta.worst_delay() == 5.0 );
+  CHECK( sta.worst_delay() == ntk.compute_worst_delay() );
+
+  CHECK( sta.required( ntk.get_node( a ) ) == 1.0 );
+  CHECK( sta.required( ntk.get_node( c ) ) == 0.0 );
+  CHECK( sta.required( ntk.get_node( t1 ) ) == 3.0 );
+  CHECK( sta.required( ntk.get_node( g ) ) == 5.0 );
+  CHECK( sta.slack( ntk.get_node( t1 ) ) == 1.0 );
+  CHECK( sta.slack( ntk.get_node( t2 ) ) == 0.0 );
+  CHECK( sta.slack( ntk.get_node( g ) ) == 2.0 );
+
+  const auto timing = sta.timing( { ntk.get_node( t1 ), ntk.get_node( f ) } );
+  CHECK( timing.size() == 2u );
+  CHECK( timing[0].arrival == 2.0 );
+  CHECK( timing[0].required == 3.0 );
+  CHECK( timing[0].slack == 1.0 );
+  CHECK( timing[1].arrival == 5.0 );
+  CHECK( timing[1].slack == 0.0 );
+
+  const auto path = sta.critical_path();
+  CHECK( path.size() == 3u );
+  CHECK( path[0] == ntk.get_node( c ) );
+  CHECK( path[1] == ntk.get_node( t2 ) );
+  CHECK( path[2] == ntk.get_node( f ) );
+
+  /* resize the gates driving the POs */
+  sta.add_binding( sta.get_node( f ), 3 );
+  sta.add_binding( sta.get_node( g ), 1 );
+  sta.update_timing();
+  CHECK( ntk.get_binding_index( ntk.get_node( f ) ) == 3 );
+  CHECK( sta.arrival( ntk.get_node( f ) ) == 4.0 );
+  CHECK( sta.arrival( ntk.get_node( g ) ) == 2.5 );
+  CHECK( sta.worst_delay() == 4.0 );
+  CHECK( sta.required( ntk.get_node( t1 ) ) == 3.0 );
+  CHECK( sta.required( ntk.get_node( a ) ) == 1.0 );
+  CHECK( sta.slack( ntk.get_node( g ) ) == 1.5 );
+
+  /* fixed required time */
+  timing_view_params ps;
+  ps.required_time = 10.0;
+  timing_view sta_required{ ntk, ps };
+  CHECK( sta_required.worst_delay() == 4.0 );
+  CHECK( sta_required.slack( ntk.get_node( f ) ) == 6.0 );
+  CHECK( sta_required.slack( ntk.get_node( c ) ) == 6.0 );
+}
+
+TEST_CASE( "Timing with load-dependent delays", "[timing_view]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( sized_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  binding_view<klut_network> ntk( gates );
+
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const t1 = ntk.create_and( a, b );
+  auto const g1 = ntk.create_not( t1 );
+  auto const g2 = ntk.create_and( t1, c );
+
+  ntk.create_po( g1 );
+  ntk.create_po( g2 );
+
+  ntk.add_binding( ntk.get_node( t1 ), 2 );
+  ntk.add_binding( ntk.get_node( g1 ), 0 );
+  ntk.add_binding( ntk.get_node( g2 ), 2 );
+
+  timing_view_params ps;
+  ps.load_dependent = true;
+  timing_view sta{ ntk, ps };
+
+  CHECK( sta.load( ntk.get_node( t1 ) ) == 2.0 );
+  CHECK( sta.load( ntk.get_node( a ) ) == 1.0 );
+  CHECK( sta.arrival( ntk.get_node( t1 ) ) == 3.0 );
+  CHECK( sta.arrival( ntk.get_node( g1 ) ) == 4.0 );
+  CHECK( sta.arrival( ntk.get_node( g2 ) ) == 5.0 );
+  CHECK( sta.worst_delay() == 5.0 );
+
+  /* upsizing a fanout increases the load of its driver */
+  sta.add_binding( sta.get_node( g1 ), 1 );
+  sta.update_timing();
+  CHECK( sta.load( ntk.get_node( t1 ) ) == 3.0 );
+  CHECK( sta.arrival( ntk.get_node( t1 ) ) == 3.5 );
+  CHECK( sta.arrival( ntk.get_node( g1 ) ) == 4.0 );
+  CHECK( sta.arrival( ntk.get_node( g2 ) ) == 5.5 );
+  CHECK( sta.worst_delay() == 5.5 );
+  CHECK( sta.slack( ntk.get_node( g1 ) ) == 1.5 );
+  CHECK( sta.critical_path().back() == ntk.get_node( g2 ) );
+}
+
+TEST_CASE( "Incremental timing after rebinding", "[timing_view]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( mapping_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> as( 8u ), bs( 8u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, as, bs ) )
+  {
+    aig.create_po( f );
+  }
+
+  binding_view<klut_network> res = map( aig, lib );
+
+  /* gates with the same function */
+  std::vector<std::vector<uint32_t>> alternatives( gates.size() );
+  for ( auto const& g1 : gates )
+  {
+    for ( auto const& g2 : gates )
+    {
+      if ( g1.num_vars > 0u && g1.function == g2.function )
+      {
+        alternatives[g1.id].push_back( g2.id );
+      }
+    }
+  }
+
+  for ( auto load_dependent : { false, true } )
+  {
+    timing_view_params ps;
+    ps.load_dependent = load_dependent;
+    timing_view sta{ res, ps };
+    if ( !load_dependent )
+    {
+      CHECK( sta.worst_delay() == Approx( res.compute_worst_delay() ) );
+    }
+
+    std::vector<klut_network::node> nodes;
+    sta.foreach_gate( [&]( auto const& n ) {
+      if ( sta.has_binding( n ) && alternatives[sta.get_binding_index( n )].size() > 1u )
+      {
+        nodes.push_back( n );
+      }
+    } );
+    REQUIRE( !nodes.empty() );
+
+    std::mt19937 rng( 1u );
+    for ( auto round = 0u; round < 20u; ++round )
+    {
+      /* rebind a few gates at once */
+      for ( auto i = 0u; i < 1u + round % 4u; ++i )
+      {
+        const auto n = nodes[rng() % nodes.size()];
+        auto const& candidates = alternatives[sta.get_binding_index( n )];
+        sta.add_binding( n, candidates[rng() % candidates.size()] );
+      }
+      sta.update_timing();
+
+      /* the copy recomputes the timing from scratch */
+      timing_view<binding_view<klut_network>> reference{ sta };
+      CHECK( sta.worst_delay() == reference.worst_delay() );
+      sta.foreach_node( [&]( auto const& n ) {
+        CHECK( sta.arrival( n ) == reference.arrival( n ) );
+        CHECK( sta.required( n ) == reference.required( n ) );
+        if ( load_dependent )
+        {
+          CHECK( sta.load( n ) == reference.load( n ) );
+        }
+      } );
+
+      const auto path = sta.critical_path();
+      REQUIRE( !path.empty() );
+      CHECK( sta.arrival( path.back() ) == sta.worst_delay() );
+      for ( auto const& n : path )
+      {
+        CHECK( sta.slack( n ) == Approx( 0.0 ).margin( 1e-9 ) );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Incremental timing after removing bindings", "[timing_view]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( mapping_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> as( 4u ), bs( 4u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, as, bs ) )
+  {
+    aig.create_po( f );
+  }
+
+  binding_view<klut_network> res = map( aig, lib );
+
+  for ( auto load_dependent : { false, true } )
+  {
+    timing_view_params ps;
+    ps.load_dependent = load_dependent;
+    timing_view sta{ res, ps };
+
+    std::vector<klut_network::node> nodes;
+    sta.foreach_gate( [&]( auto const& n ) {
+      if ( sta.has_binding( n ) )
+      {
+        nodes.push_back( n );
+      }
+    } );
+    REQUIRE( nodes.size() > 10u );
+
+    std::mt19937 rng( 1u );
+    std::shuffle( nodes.begin(), nodes.end(), rng );
+    for ( auto round = 0u; round < 5u; ++round )
+    {
+      sta.remove_binding( nodes[2u * round] );
+      sta.remove_binding( nodes[2u * round + 1u] );
+      CHECK( !sta.has_binding( nodes[2u * round] ) );
+      sta.update_timing();
+
+      std::vector<double> arrivals, requireds, loads;
+      sta.foreach_node( [&]( auto const& n ) {
+        arrivals.push_back( sta.arrival( n ) );
+        requireds.push_back( sta.required( n ) );
+        loads.push_back( sta.load( n ) );
+      } );
+      const auto worst_delay = sta.worst_delay();
+
+      /* recompute the timing from scratch */
+      sta.compute_timing();
+      CHECK( sta.worst_delay() == worst_delay );
+      sta.foreach_node( [&]( auto const& n, auto i ) {
+        CHECK( sta.arrival( n ) == arrivals[i] );
+        CHECK( sta.required( n ) == requireds[i] );
+        CHECK( sta.load( n ) == loads[i] );
+      } );
+    }
+  }
+}